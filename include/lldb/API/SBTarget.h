@@ -586,6 +586,35 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of many load addresses at once.
+    ///
+    /// Much faster than calling ResolveLoadAddress() and
+    /// ResolveSymbolContextForAddress() for each address when there are
+    /// many of them: the addresses are sorted, grouped by the module
+    /// they are in and each module resolves all of its addresses in one
+    /// pass, with the modules done on multiple threads.
+    ///
+    /// @param[in] array
+    ///     The load addresses to resolve, in any order.
+    ///
+    /// @param[in] array_len
+    ///     The number of addresses in \a array.
+    ///
+    /// @param[in] resolve_scope
+    ///     The scope that should be resolved (see SymbolContext::Scope).
+    ///
+    /// @return
+    ///     A list with one symbol context for each address, in the same
+    ///     order as \a array. The symbol context of an address that
+    ///     isn't in a loaded section is empty. Use the block of a symbol
+    ///     context to walk the chain of inlined functions at its address.
+    //------------------------------------------------------------------
+    lldb::SBSymbolContextList
+    ResolveSymbolContextsForLoadAddresses (uint64_t* array,
+                                           size_t array_len,
+                                           uint32_t resolve_scope);
+
     //------------------------------------------------------------------
     /// Read target memory. If a target process is running then memory  
     /// is read from here. Otherwise the memory is read from the object
@@ -180,6 +180,27 @@ public:
     lldb::SBFrame
     GetFrameAtIndex (uint32_t idx);
 
+    //------------------------------------------------------------------
+    /// Get the pc of each frame of the thread's stack, for sampling.
+    ///
+    /// Much faster than getting the frames: no frames are made and no
+    /// symbols are looked up, and the stack is unwound using only the
+    /// compact unwind and eh_frame tables and frame pointers. The
+    /// backtrace can end early where those don't describe the stack.
+    ///
+    /// @param[out] pcs
+    ///     Filled in with the load address of the pc of each frame,
+    ///     the youngest frame first.
+    ///
+    /// @param[in] max_frames
+    ///     The number of elements of \a pcs.
+    ///
+    /// @return
+    ///     The number of pcs filled in.
+    //------------------------------------------------------------------
+    uint32_t
+    GetRawBacktrace (lldb::addr_t *pcs, uint32_t max_frames);
+
     lldb::SBFrame
     GetSelectedFrame ();
 
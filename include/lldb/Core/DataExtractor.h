@@ -644,7 +644,7 @@ public:
                      uint32_t eh_ptr_enc,
                      lldb::addr_t pc_rel_addr,
                      lldb::addr_t text_addr,
-                     lldb::addr_t data_addr);
+                     lldb::addr_t data_addr) const;
 
     //------------------------------------------------------------------
     /// Extract an integer of size \a byte_size from \a *offset_ptr.
@@ -0,0 +1,147 @@
+//===-- DemangledNameCache.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_DemangledNameCache_h_
+#define liblldb_DemangledNameCache_h_
+#if defined(__cplusplus)
+
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
+#include "lldb/lldb-private.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class DemangledNameCache DemangledNameCache.h "lldb/Core/DemangledNameCache.h"
+/// @brief An on disk cache of demangled names shared between debug
+/// sessions.
+///
+/// The cache file is memory mapped and indexed once, when the cache is
+/// created, and is never modified in place afterwards so lookups don't
+/// need any locking. Names that had to be demangled are collected in
+/// memory and appended to the file in batches. The batch is taken out
+/// of the cache under a short lock and written without holding it, so
+/// threads demangling names in parallel don't wait for the file I/O.
+/// When the file would grow beyond its size limit it is rewritten
+/// keeping only the most recently added names.
+///
+/// Names that failed to demangle are cached too, with an empty
+/// demangled name, so they aren't run through the demangler again.
+//----------------------------------------------------------------------
+class DemangledNameCache
+{
+public:
+    DemangledNameCache (const FileSpec &cache_dir, uint64_t max_byte_size);
+
+    ~DemangledNameCache ();
+
+    //------------------------------------------------------------------
+    /// Set up the cache that GetShared() returns. Only the first call
+    /// has any effect.
+    ///
+    /// @param[in] cache_dir
+    ///     The directory to keep the cache file in. Caching is disabled
+    ///     if this is empty.
+    ///
+    /// @param[in] max_byte_size
+    ///     The size the cache file is allowed to grow to.
+    //------------------------------------------------------------------
+    static void
+    Initialize (const FileSpec &cache_dir, uint64_t max_byte_size);
+
+    //------------------------------------------------------------------
+    /// Get the cache set up by Initialize().
+    ///
+    /// @return
+    ///     The shared cache, or NULL if caching is disabled or
+    ///     Initialize() hasn't been called yet.
+    //------------------------------------------------------------------
+    static DemangledNameCache *
+    GetShared ();
+
+    //------------------------------------------------------------------
+    /// Write the names that are still pending to the shared cache.
+    //------------------------------------------------------------------
+    static void
+    Terminate ();
+
+    //------------------------------------------------------------------
+    /// Find the demangled counterpart of \a mangled.
+    ///
+    /// @return
+    ///     NULL if \a mangled isn't in the cache, otherwise the
+    ///     demangled name, which is empty if demangling failed.
+    //------------------------------------------------------------------
+    const char *
+    Lookup (const ConstString &mangled) const;
+
+    //------------------------------------------------------------------
+    /// Add a name that was just demangled. \a demangled should be empty
+    /// if \a mangled couldn't be demangled.
+    //------------------------------------------------------------------
+    void
+    Insert (const ConstString &mangled, const ConstString &demangled);
+
+    //------------------------------------------------------------------
+    /// Write all pending names to the cache file.
+    //------------------------------------------------------------------
+    Error
+    Flush ();
+
+    FileSpec
+    GetCacheFileSpec () const;
+
+    static uint64_t
+    HashName (const char *cstr, size_t length);
+
+private:
+    typedef std::pair<ConstString, ConstString> NamePair;
+
+    struct IndexEntry
+    {
+        lldb::offset_t strings_offset;  // Offset of the mangled name in m_data_sp
+        uint32_t mangled_len;
+    };
+
+    void
+    Load ();
+
+    void
+    TakePendingLocked (std::vector<NamePair> &pending);
+
+    Error
+    Write (const std::vector<NamePair> &pending);
+
+    Error
+    Rewrite (const std::vector<NamePair> &pending);
+
+    FileSpec m_cache_dir;
+    const uint64_t m_max_byte_size;
+    lldb::DataBufferSP m_data_sp;
+    llvm::DenseMap<uint64_t, IndexEntry> m_index;
+    Mutex m_pending_mutex;      // Guards the m_pending* members, never held during file I/O
+    std::vector<NamePair> m_pending;
+    llvm::DenseSet<const char *> m_pending_names;
+    size_t m_pending_byte_size;
+    Mutex m_write_mutex;        // Serializes writes to the cache file
+
+    DISALLOW_COPY_AND_ASSIGN (DemangledNameCache);
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_DemangledNameCache_h_
@@ -844,6 +844,35 @@ public:
     ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve_scope,
                                     SymbolContext& sc, bool resolve_tail_call_address = false);
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol context of many addresses at once.
+    ///
+    /// Does what ResolveSymbolContextForAddress() does for each address
+    /// in \a so_addrs, but lets the symbol file look them all up in one
+    /// pass over its address tables. Addresses should be sorted by file
+    /// address for that to be fastest.
+    ///
+    /// @param[in] so_addrs
+    ///     The section offset based addresses to resolve. Addresses that
+    ///     aren't in this module resolve to nothing.
+    ///
+    /// @param[in] resolve_scope
+    ///     The scope that should be resolved (see SymbolContext::Scope).
+    ///
+    /// @param[out] sc_list
+    ///     Set to one SymbolContext for each address in \a so_addrs.
+    ///
+    /// @param[out] resolved_list
+    ///     Set to the scope that has been resolved for each address in
+    ///     \a so_addrs (see SymbolContext::Scope).
+    ///
+    /// @return
+    ///     The number of addresses that are in this module.
+    //------------------------------------------------------------------
+    size_t
+    ResolveSymbolContextsForAddresses (const std::vector<Address>& so_addrs, uint32_t resolve_scope,
+                                       std::vector<SymbolContext>& sc_list, std::vector<uint32_t>& resolved_list);
+
     //------------------------------------------------------------------
     /// Resolve items in the symbol context for a given file and line.
     ///
@@ -1161,6 +1190,15 @@ protected:
                                     uint32_t resolve_scope, 
                                     Address& so_addr, 
                                     SymbolContext& sc);
+
+    // Find the symbol for "so_addr", given what was already resolved, and
+    // return eSymbolContextSymbol if there is one.
+    uint32_t
+    ResolveSymbolInSymtab (const Address& so_addr,
+                           uint32_t resolve_scope,
+                           uint32_t resolved_flags,
+                           SymbolVendor &sym_vendor,
+                           SymbolContext& sc);
     
     void 
     SymbolIndicesToSymbolContextList (Symtab *symtab, 
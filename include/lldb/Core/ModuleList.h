@@ -504,6 +504,30 @@ public:
                                     uint32_t resolve_scope,
                                     SymbolContext& sc) const;
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol context of many section offset addresses.
+    ///
+    /// The addresses are grouped by the module they are in and each
+    /// module resolves its addresses in one go, sorted by file address,
+    /// with the modules done in parallel. Addresses that aren't section
+    /// offset resolve to nothing.
+    ///
+    /// @param[out] sc_list
+    ///     Set to one SymbolContext for each address in \a so_addrs.
+    ///
+    /// @param[out] resolved_list
+    ///     Set to the scope that has been resolved for each address in
+    ///     \a so_addrs (see SymbolContext::Scope).
+    ///
+    /// @return
+    ///     The number of addresses that resolved to anything.
+    //------------------------------------------------------------------
+    size_t
+    ResolveSymbolContextsForAddresses (const std::vector<Address>& so_addrs,
+                                       uint32_t resolve_scope,
+                                       std::vector<SymbolContext>& sc_list,
+                                       std::vector<uint32_t>& resolved_list) const;
+
     //------------------------------------------------------------------
     /// @copydoc Module::ResolveSymbolContextForFilePath (const char *,uint32_t,bool,uint32_t,SymbolContextList&)
     //------------------------------------------------------------------
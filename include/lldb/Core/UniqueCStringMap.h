@@ -81,6 +81,17 @@ public:
         m_map.push_back (e);
     }
 
+    //------------------------------------------------------------------
+    // Append all of the entries of another map to the end of this map.
+    // UniqueCStringMap<T>::Sort() must be called before doing any
+    // searches by name.
+    //------------------------------------------------------------------
+    void
+    Append (const UniqueCStringMap<T> &map)
+    {
+        m_map.insert (m_map.end(), map.m_map.begin(), map.m_map.end());
+    }
+
     void
     Clear ()
     {
@@ -212,6 +212,15 @@ namespace lldb_private
             return GetThreadByID (m_current_thread_id);
         }
 
+        // Called before the registers of every thread are read one thread at
+        // a time, e.g. to describe all of the threads in one packet. Derived
+        // classes can fetch them for all threads at once here so the register
+        // contexts can answer the reads that follow from memory.
+        virtual void
+        PrefetchThreadRegisters ()
+        {
+        }
+
         //----------------------------------------------------------------------
         // Access to inferior stdio
         //----------------------------------------------------------------------
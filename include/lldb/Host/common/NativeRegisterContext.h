@@ -36,11 +36,17 @@ public:
     // void
     // InvalidateIfNeeded (bool force);
 
+    // Discards any register values the context has cached. Threads call this
+    // whenever they are resumed. Contexts that don't cache any values don't
+    // need to override it.
+    virtual void
+    InvalidateAllRegisters ()
+    {
+    }
+
     //------------------------------------------------------------------
     // Subclasses must override these functions
     //------------------------------------------------------------------
-    // virtual void
-    // InvalidateAllRegisters () = 0;
 
     virtual uint32_t
     GetRegisterCount () const = 0;
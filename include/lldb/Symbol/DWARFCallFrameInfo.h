@@ -10,7 +10,7 @@
 #ifndef liblldb_DWARFCallFrameInfo_h_
 #define liblldb_DWARFCallFrameInfo_h_
 
-#include <map>
+#include <vector>
 
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Core/DataExtractor.h"
@@ -104,9 +104,8 @@ private:
         }
     };
 
-    typedef std::shared_ptr<CIE> CIESP;
-
-    typedef std::map<dw_offset_t, CIESP> cie_map_t;
+    // Sorted by cie_offset
+    typedef std::vector<CIE> cie_collection;
 
     // Start address (file address), size, offset of FDE location
     // used for finding an FDE for a given File address; the start address field is
@@ -122,11 +121,27 @@ private:
     void
     GetFDEIndex ();
 
+    //------------------------------------------------------------------
+    // Read the binary search table of the .eh_frame_hdr section, which
+    // the linker sorts by function address, so that FDEs can be found
+    // without scanning the whole section. Returns false if there is no
+    // usable table.
+    //------------------------------------------------------------------
+    bool
+    GetEHFrameHdrTable ();
+
+    bool
+    FindFDEInEHFrameHdrTable (lldb::addr_t file_addr, FDEEntryMap::Entry& fde_entry);
+
     bool
     FDEToUnwindPlan (uint32_t offset, Address startaddr, UnwindPlan& unwind_plan);
 
-    const CIE* 
-    GetCIE(dw_offset_t cie_offset);
+    // Copy the CIE at "cie_offset" into "cie", parsing it the first time
+    bool
+    GetCIE (dw_offset_t cie_offset, CIE &cie);
+
+    static const CIE *
+    FindCIE (const cie_collection &cies, dw_offset_t cie_offset);
     
     void
     GetCFIData();
@@ -135,7 +150,8 @@ private:
     lldb::SectionSP             m_section_sp;
     lldb::RegisterKind          m_reg_kind;
     Flags                       m_flags;
-    cie_map_t                   m_cie_map;
+    cie_collection              m_cies;
+    Mutex                       m_cies_mutex;
 
     DataExtractor               m_cfi_data;
     bool                        m_cfi_data_initialized;   // only copy the section into the DE once
@@ -144,10 +160,25 @@ private:
     bool                        m_fde_index_initialized;  // only scan the section for FDEs once
     Mutex                       m_fde_index_mutex;        // and isolate the thread that does it
 
+    // The .eh_frame_hdr binary search table, see GetEHFrameHdrTable()
+    struct EHFrameHdrTable
+    {
+        DataExtractor   data;
+        lldb::addr_t    data_addr;      // File address of the .eh_frame_hdr section
+        lldb::offset_t  table_offset;
+        uint32_t        fde_count;
+        uint32_t        entry_size;
+        uint8_t         table_enc;
+    };
+    EHFrameHdrTable             m_hdr_table;
+    bool                        m_hdr_table_initialized;  // only look for the table once
+    bool                        m_hdr_table_valid;
+
     bool                        m_is_eh_frame;
 
-    CIESP
-    ParseCIE (const uint32_t cie_offset);
+    // Returns false if there is no CIE at "cie_offset"
+    bool
+    ParseCIE (const uint32_t cie_offset, CIE &cie);
 
 };
 
@@ -17,6 +17,7 @@
 #include "lldb/Core/ModuleChild.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/RangeMap.h"
+#include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
 
@@ -39,6 +40,42 @@ private:
     DISALLOW_COPY_AND_ASSIGN (LineSequence);
 };
 
+//----------------------------------------------------------------------
+/// @class LineSequenceDecoder LineTable.h "lldb/Symbol/LineTable.h"
+/// @brief An abstract base class for symbol files that decode the
+/// sequences of a line table the first time they are needed.
+//----------------------------------------------------------------------
+class LineSequenceDecoder
+{
+public:
+    LineSequenceDecoder () {}
+
+    virtual
+    ~LineSequenceDecoder() {}
+
+    //------------------------------------------------------------------
+    /// Append the entries of a lazy sequence to \a sequence using
+    /// LineTable::AppendLineEntryToSequence().
+    ///
+    /// @param[in] line_table
+    ///     The line table the sequence belongs to.
+    ///
+    /// @param[in] decode_offset
+    ///     The offset given to LineTable::InsertLazySequence().
+    ///
+    /// @param[in] sequence
+    ///     A sequence container created by \a line_table.
+    ///
+    /// @return
+    ///     \b true if the sequence was decoded, \b false otherwise.
+    //------------------------------------------------------------------
+    virtual bool
+    DecodeSequence (LineTable &line_table, lldb::offset_t decode_offset, LineSequence *sequence) = 0;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (LineSequenceDecoder);
+};
+
 //----------------------------------------------------------------------
 /// @class LineTable LineTable.h "lldb/Symbol/LineTable.h"
 /// @brief A line table class.
@@ -107,6 +144,58 @@ public:
     void
     InsertSequence (LineSequence* sequence);
 
+    //------------------------------------------------------------------
+    /// Insert a sequence whose entries will be decoded the first time
+    /// they are needed.
+    ///
+    /// Only the address range, the number of entries and the files of
+    /// a lazy sequence are kept until the decoder set with
+    /// SetSequenceDecoder() is asked for its entries.
+    ///
+    /// @param[in] file_addr
+    ///     The file address of the first entry of the sequence.
+    ///
+    /// @param[in] end_file_addr
+    ///     The file address of the terminal entry of the sequence.
+    ///
+    /// @param[in] num_entries
+    ///     The number of entries decoding the sequence will append,
+    ///     including the terminal entry.
+    ///
+    /// @param[in] file_mask
+    ///     The bitwise OR of GetFileMask() for the file index of every
+    ///     entry of the sequence.
+    ///
+    /// @param[in] decode_offset
+    ///     The offset to hand to LineSequenceDecoder::DecodeSequence().
+    //------------------------------------------------------------------
+    void
+    InsertLazySequence (lldb::addr_t file_addr,
+                        lldb::addr_t end_file_addr,
+                        uint32_t num_entries,
+                        uint64_t file_mask,
+                        lldb::offset_t decode_offset);
+
+    // Set the decoder for the lazy sequences, this line table owns it.
+    void
+    SetSequenceDecoder (LineSequenceDecoder *decoder);
+
+    static uint64_t
+    GetFileMask (uint32_t file_idx)
+    {
+        return 1ull << (file_idx % 64);
+    }
+
+    uint32_t
+    GetNumSequences () const;
+
+    uint32_t
+    GetNumDecodedSequences () const;
+
+    // The number of bytes used by the sequences, decoded or not.
+    size_t
+    GetMemorySize () const;
+
     //------------------------------------------------------------------
     /// Dump all line entries in this line table to the stream \a s.
     ///
@@ -384,11 +473,74 @@ protected:
     //------------------------------------------------------------------
     typedef std::vector<lldb_private::Section*> section_collection; ///< The collection type for the sections.
     typedef std::vector<Entry>                  entry_collection;   ///< The collection type for the line entries.
+
+    //------------------------------------------------------------------
+    // The entries of a sequence are kept delta encoded: each entry is a
+    // flags byte followed by the ULEB128 address delta and SLEB128 line
+    // delta from the previous entry, and the column and file index when
+    // they change. Every kEntriesPerBlock entries a new block starts
+    // whose first entry is encoded relative to the start of the
+    // sequence, so an entry is found by decoding at most one block.
+    //------------------------------------------------------------------
+    enum
+    {
+        kEntriesPerBlock = 16
+    };
+
+    struct Block
+    {
+        lldb::addr_t file_addr;     ///< The file address of the first entry of the block.
+        uint32_t data_offset;       ///< The offset of the first entry of the block in Sequence::data.
+    };
+
+    struct Sequence
+    {
+        Sequence () :
+            file_addr (LLDB_INVALID_ADDRESS),
+            end_file_addr (LLDB_INVALID_ADDRESS),
+            entry_idx (0),
+            num_entries (0),
+            file_mask (0),
+            decode_offset (LLDB_INVALID_OFFSET),
+            is_decoded (false),
+            data (),
+            blocks ()
+        {
+        }
+
+        static bool
+        StartAddressLessThan (lldb::addr_t file_addr, const Sequence& sequence)
+        {
+            return file_addr < sequence.file_addr;
+        }
+
+        static bool
+        EntryIndexLessThan (uint32_t idx, const Sequence& sequence)
+        {
+            return idx < sequence.entry_idx;
+        }
+
+        lldb::addr_t file_addr;         ///< The file address of the first entry.
+        lldb::addr_t end_file_addr;     ///< The file address of the terminal entry, or LLDB_INVALID_ADDRESS if the sequence has none.
+        uint32_t entry_idx;             ///< The index of the first entry in the whole line table.
+        uint32_t num_entries;           ///< The number of entries, including the terminal entry.
+        uint64_t file_mask;             ///< The GetFileMask() bits of the file indexes of the entries.
+        lldb::offset_t decode_offset;   ///< The offset to decode the sequence from if it is lazy.
+        bool is_decoded;                ///< Whether "data" and "blocks" hold the entries yet.
+        std::vector<uint8_t> data;      ///< The delta encoded entries.
+        std::vector<Block> blocks;      ///< The start of every kEntriesPerBlock entries in "data".
+    };
+
+    typedef std::vector<Sequence> sequence_collection;
+
     //------------------------------------------------------------------
     // Member variables.
     //------------------------------------------------------------------
-    CompileUnit* m_comp_unit;   ///< The compile unit that this line table belongs to.
-    entry_collection m_entries; ///< The collection of line entries in this line table.
+    CompileUnit* m_comp_unit;           ///< The compile unit that this line table belongs to.
+    sequence_collection m_sequences;    ///< The sequences of this line table sorted by file address.
+    uint32_t m_num_entries;             ///< The number of entries in all of the sequences.
+    std::unique_ptr<LineSequenceDecoder> m_decoder_ap; ///< Decodes lazy sequences.
+    mutable Mutex m_mutex;              ///< Protects decoding lazy sequences.
 
     //------------------------------------------------------------------
     // Helper class
@@ -413,6 +565,36 @@ protected:
     bool
     ConvertEntryAtIndexToLineEntry (uint32_t idx, LineEntry &line_entry);
 
+    bool
+    ConvertEntryToLineEntry (const Entry &entry, lldb::addr_t next_file_addr, LineEntry &line_entry);
+
+    // Insert a sequence at its place in m_sequences and number the
+    // entries of it and the sequences after it.
+    void
+    InsertSequence (Sequence &sequence);
+
+    static void
+    EncodeEntries (const entry_collection &entries, Sequence &sequence);
+
+    // Decode the entries of "sequence" starting with the entry at index
+    // "first" of the sequence, appending them to "entries".
+    static void
+    DecodeEntries (const Sequence &sequence, uint32_t first, uint32_t count, entry_collection &entries);
+
+    // Returns the sequence at "sequence_idx" after decoding it if it is
+    // lazy, or NULL if it can't be decoded.
+    const Sequence *
+    GetDecodedSequence (uint32_t sequence_idx);
+
+    // Returns the index of the sequence with the entry at "idx".
+    uint32_t
+    FindSequenceIndexForEntry (uint32_t idx) const;
+
+    // Returns the file address of the entry after entries[idx], where
+    // "entries" were decoded from the sequence at "sequence_idx".
+    lldb::addr_t
+    GetNextEntryFileAddress (uint32_t sequence_idx, const entry_collection &entries, size_t idx) const;
+
 private:
     DISALLOW_COPY_AND_ASSIGN (LineTable);
 };
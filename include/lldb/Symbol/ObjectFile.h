@@ -365,11 +365,17 @@ public:
     /// Section list parsing can be deferred by ObjectFile instances
     /// until this accessor is called the first time.
     ///
+    /// @param[in] update_module_section_list
+    ///     If true, the sections are also added to the unified section
+    ///     list of the module. Object files that only hold data for
+    ///     another object file of the module, like split DWARF .dwo
+    ///     files, must not change the sections of the module.
+    ///
     /// @return
     ///     The list of sections contained in this object file.
     //------------------------------------------------------------------
     virtual SectionList *
-    GetSectionList ();
+    GetSectionList (bool update_module_section_list = true);
 
     virtual void
     CreateSections (SectionList &unified_section_list) = 0;
@@ -134,6 +134,20 @@ public:
     virtual clang::DeclContext* GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid) { return NULL; }
     virtual uint32_t        ResolveSymbolContext (const Address& so_addr, uint32_t resolve_scope, SymbolContext& sc) = 0;
     virtual uint32_t        ResolveSymbolContext (const FileSpec& file_spec, uint32_t line, bool check_inlines, uint32_t resolve_scope, SymbolContextList& sc_list) = 0;
+    //------------------------------------------------------------------
+    /// Resolve many addresses at once.
+    ///
+    /// Resolves each address in \a so_addrs into the matching element
+    /// of \a sc_list, which must have as many elements, and sets the
+    /// matching element of \a resolved_list to the scope that was
+    /// resolved. Symbol files that can look addresses up in one pass
+    /// when they are sorted by file address override this; the default
+    /// resolves them one at a time.
+    ///
+    /// @return
+    ///     The number of addresses that resolved to anything.
+    //------------------------------------------------------------------
+    virtual size_t          ResolveSymbolContexts (const std::vector<Address>& so_addrs, uint32_t resolve_scope, std::vector<SymbolContext>& sc_list, std::vector<uint32_t>& resolved_list);
     virtual uint32_t        FindGlobalVariables (const ConstString &name, const ClangNamespaceDecl *namespace_decl, bool append, uint32_t max_matches, VariableList& variables) = 0;
     virtual uint32_t        FindGlobalVariables (const RegularExpression& regex, bool append, uint32_t max_matches, VariableList& variables) = 0;
     virtual uint32_t        FindFunctions (const ConstString &name, const ClangNamespaceDecl *namespace_decl, uint32_t name_type_mask, bool include_inlines, bool append, SymbolContextList& sc_list) = 0;
@@ -95,6 +95,12 @@ public:
                           uint32_t resolve_scope,
                           SymbolContextList& sc_list);
 
+    virtual size_t
+    ResolveSymbolContexts (const std::vector<Address>& so_addrs,
+                           uint32_t resolve_scope,
+                           std::vector<SymbolContext>& sc_list,
+                           std::vector<uint32_t>& resolved_list);
+
     virtual size_t
     FindGlobalVariables (const ConstString &name,
                          const ClangNamespaceDecl *namespace_decl,
@@ -12,9 +12,12 @@
 #define liblldb_UnwindTable_h
 
 #include <map>
+#include <unordered_map>
 
 #include "lldb/lldb-private.h" 
 #include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/UnwindPlan.h"
 
 namespace lldb_private {
 
@@ -49,6 +52,59 @@ public:
     bool
     GetArchitecture (lldb_private::ArchSpec &arch);
 
+    //------------------------------------------------------------------
+    // What unwinding a frame whose pc is at a given address in this
+    // object file worked out: the symbol of the pc, the UnwindPlans to
+    // use and the row of the UnwindPlan for the pc. Saving it lets any
+    // thread, at any later stop, unwind a frame at the same pc without
+    // looking up the symbol and picking the UnwindPlans again.
+    //
+    // The UnwindPlans are picked with the help of the dynamic loader and
+    // the platform of a process, so what is saved is only used again for
+    // the same process.
+    //------------------------------------------------------------------
+    struct ResolvedFrame
+    {
+        uint32_t process_unique_id;     // Process::GetUniqueID() of the process that resolved it
+        SymbolContext sym_ctx;          // Without module_sp or target_sp, which would keep this object file alive
+        bool sym_ctx_valid;
+        bool is_trap_handler;
+        bool pc_backed_up;              // The frame's pc is one before the return address
+        Address start_pc;
+        int current_offset;
+        int current_offset_backed_up_one;
+        lldb::UnwindPlanSP fast_unwind_plan_sp;
+        lldb::UnwindPlanSP full_unwind_plan_sp;
+        lldb::UnwindPlanSP fallback_unwind_plan_sp;
+        UnwindPlan::RowSP active_row;
+        lldb::RegisterKind row_register_kind;
+    };
+
+    typedef std::shared_ptr<const ResolvedFrame> ResolvedFrameSP;
+
+    //------------------------------------------------------------------
+    // Find what the process with "process_unique_id" saved for a frame
+    // whose pc is at "file_addr". Frames that were interrupted, like frame
+    // zero, are unwound differently from frames that made a call so they
+    // are saved apart. A frame saved by another process is replaced when
+    // this one adds its own.
+    //------------------------------------------------------------------
+    ResolvedFrameSP
+    FindResolvedFrame (lldb::addr_t file_addr, bool behaves_like_zeroth_frame, uint32_t process_unique_id);
+
+    void
+    AddResolvedFrame (lldb::addr_t file_addr, bool behaves_like_zeroth_frame, const ResolvedFrameSP &resolved_frame_sp);
+
+    //------------------------------------------------------------------
+    // Get the row of the compact unwind or eh_frame UnwindPlan for the
+    // function containing "addr" that is in effect at "addr", for
+    // unwinding without symbols. Rows are saved once found so this is
+    // cheap for addresses that were looked up before. Returns an empty
+    // row if neither table covers "addr".
+    //------------------------------------------------------------------
+    UnwindPlan::RowSP
+    GetRawUnwindRow (const Address &addr, Target &target, lldb::RegisterKind &register_kind);
+
 private:
     void
     Dump (Stream &s);
@@ -65,6 +121,20 @@ private:
     bool                m_initialized;  // delay some initialization until ObjectFile is set up
     Mutex               m_mutex;
 
+    // Only held to look up or add entries, never while a frame is resolved
+    typedef std::unordered_map<lldb::addr_t, ResolvedFrameSP> ResolvedFrameMap;
+    Mutex               m_resolved_frames_mutex;
+    ResolvedFrameMap    m_resolved_call_frames;         // Frames that made a call
+    ResolvedFrameMap    m_resolved_interrupted_frames;  // Frame zero
+
+    struct RawUnwindRow
+    {
+        UnwindPlan::RowSP row_sp;
+        lldb::RegisterKind register_kind;
+    };
+    typedef std::unordered_map<lldb::addr_t, RawUnwindRow> RawUnwindRowMap;
+    RawUnwindRowMap     m_raw_unwind_rows;              // Also guarded by m_resolved_frames_mutex
+
     DWARFCallFrameInfo* m_eh_frame;
     CompactUnwindInfo  *m_compact_unwind;
     
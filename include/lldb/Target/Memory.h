@@ -26,10 +26,46 @@ namespace lldb_private {
     //----------------------------------------------------------------------
     // A class to track memory that was read from a live process between 
     // runs. 
+    //
+    // Memory is cached in aligned lines that are kept in one pool whose
+    // size is bounded by the "memory-cache-size" process setting. The
+    // pool is split into sets of a few lines each, and a line can only be
+    // cached in the set its address maps to, so looking one up only
+    // searches that set. When a set is full the least recently used line
+    // in it is replaced.
+    //
+    // Misses on consecutive lines, in either direction, are taken to be
+    // a sequential scan and read the lines after the missing one along
+    // with it, in a single read from the process, doubling how far ahead
+    // is read with each miss up to "memory-cache-prefetch-lines".
     //----------------------------------------------------------------------
     class MemoryCache
     {
     public:
+        struct Statistics
+        {
+            Statistics () :
+                hits (0),
+                misses (0),
+                reads (0),
+                bytes_read (0),
+                uncached_reads (0),
+                prefetched_lines (0),
+                prefetch_hits (0),
+                evictions (0)
+            {
+            }
+
+            uint64_t hits;              // Lines that were found in the cache
+            uint64_t misses;            // Lines that had to be read from the process
+            uint64_t reads;             // Reads from the process to fill lines
+            uint64_t bytes_read;        // Bytes read from the process to fill lines
+            uint64_t uncached_reads;    // Reads larger than a line that went straight to the process
+            uint64_t prefetched_lines;  // Lines read before anything asked for them
+            uint64_t prefetch_hits;     // Prefetched lines that were used afterwards
+            uint64_t evictions;         // Lines replaced to make room for others
+        };
+
         //------------------------------------------------------------------
         // Constructors and Destructors
         //------------------------------------------------------------------
@@ -37,6 +73,11 @@ namespace lldb_private {
         
         ~MemoryCache ();
         
+        //------------------------------------------------------------------
+        // Throw away all cached lines. The statistics are kept, and the
+        // size of the cache and its lines are updated from the process
+        // settings.
+        //------------------------------------------------------------------
         void
         Clear(bool clear_invalid_ranges = false);
         
@@ -48,12 +89,37 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        //------------------------------------------------------------------
+        // Read the lines that cover [addr, addr + size) from the process
+        // in one request and cache them, for memory that is likely to be
+        // read soon. At most half of the cache is filled this way. Returns
+        // the number of bytes that were read.
+        //------------------------------------------------------------------
+        size_t
+        Prefetch (lldb::addr_t addr, size_t size);
         
         uint32_t
         GetMemoryCacheLineSize() const
         {
             return m_cache_line_byte_size ;
         }
+
+        // The number of lines the cache can hold
+        uint32_t
+        GetCapacity () const
+        {
+            return m_num_sets * kNumWays;
+        }
+
+        uint32_t
+        GetNumCachedLines () const;
+
+        Statistics
+        GetStatistics () const;
+
+        void
+        ResetStatistics ();
         
         void
         AddInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size);
@@ -62,15 +128,66 @@ namespace lldb_private {
         RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size);
 
     protected:
-        typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
+        enum { kNumWays = 8 };
+
+        struct Line
+        {
+            lldb::addr_t addr;      // LLDB_INVALID_ADDRESS if the line is unused
+            uint32_t byte_size;     // Less than a full line if the read came up short
+            bool prefetched;        // Not used since it was prefetched
+            uint64_t last_used;
+        };
+
         typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
+
+        void
+        UpdateGeometry ();
+
+        lldb::addr_t
+        GetLineAddress (lldb::addr_t addr) const
+        {
+            return addr & ~((lldb::addr_t)m_cache_line_byte_size - 1);
+        }
+
+        uint8_t *
+        GetLineBytes (const Line &line)
+        {
+            return &m_line_bytes[(&line - &m_lines[0]) * m_cache_line_byte_size];
+        }
+
+        Line *
+        FindLine (lldb::addr_t line_addr);
+
+        // Get the line to cache "line_addr" in, replacing the least
+        // recently used line of its set if needed
+        Line &
+        AllocateLine (lldb::addr_t line_addr);
+
+        // Cache "byte_size" bytes from "bytes" as the line at "line_addr"
+        Line &
+        StoreLine (lldb::addr_t line_addr, const uint8_t *bytes, uint32_t byte_size, bool prefetched);
+
+        // Read the line at "line_addr", and the lines after it if the
+        // reads look sequential, and return it or NULL if it can't be read
+        Line *
+        FillLine (lldb::addr_t line_addr, Error &error);
+
         //------------------------------------------------------------------
         // Classes that inherit from MemoryCache can see and modify these
         //------------------------------------------------------------------
         Process &m_process;
-        uint32_t m_cache_line_byte_size;
-        Mutex m_mutex;
-        BlockMap m_cache;
+        uint32_t m_cache_line_byte_size;        // A power of two
+        uint32_t m_num_sets;
+        uint32_t m_max_prefetch_lines;
+        mutable Mutex m_mutex;
+        std::vector<Line> m_lines;              // kNumWays lines for each set, allocated on first use
+        std::vector<uint8_t> m_line_bytes;      // The bytes of each line of m_lines
+        std::vector<uint8_t> m_read_buffer;     // Reused for reads of more than one line
+        uint64_t m_clock;                       // Incremented each time a line is used
+        lldb::addr_t m_next_sequential_addr;    // The line after the last lines that were filled
+        lldb::addr_t m_prev_sequential_addr;    // The line before them
+        uint32_t m_num_prefetch_lines;          // How many lines to read ahead on the next sequential miss
+        Statistics m_stats;
         InvalidRanges m_invalid_ranges;
     private:
         DISALLOW_COPY_AND_ASSIGN (MemoryCache);
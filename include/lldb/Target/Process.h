@@ -66,6 +66,15 @@ public:
     uint64_t
     GetMemoryCacheLineSize () const;
 
+    uint64_t
+    GetMemoryCacheSize () const;
+
+    uint64_t
+    GetMemoryCachePrefetchLines () const;
+
+    uint64_t
+    GetStackPrefetchSize () const;
+
     Args
     GetExtraStartupCommands () const;
 
@@ -2126,6 +2135,31 @@ public:
                             size_t size,
                             Error &error);
     
+    //------------------------------------------------------------------
+    /// Get the cache that ReadMemory() reads through when the memory
+    /// cache isn't disabled.
+    //------------------------------------------------------------------
+    MemoryCache &
+    GetMemoryCache ()
+    {
+        return m_memory_cache;
+    }
+
+    //------------------------------------------------------------------
+    /// Read the stack above a thread's stack pointer into the memory
+    /// cache in one request.
+    ///
+    /// Unwinding a thread reads its frames a few bytes at a time, which
+    /// right after a stop would each be a separate read from the
+    /// process. This reads "stack-prefetch-size" bytes of stack at
+    /// once so the unwind finds them in the cache instead.
+    ///
+    /// @param[in] sp
+    ///     The stack pointer of the thread.
+    //------------------------------------------------------------------
+    void
+    PrefetchStackMemory (lldb::addr_t sp);
+
     //------------------------------------------------------------------
     /// Reads an unsigned integer of the specified byte size from 
     /// process memory.
@@ -13,6 +13,7 @@
 // C Includes
 // C++ Includes
 #include <map>
+#include <vector>
 
 // Other libraries and framework includes
 #include "llvm/ADT/DenseMap.h"
@@ -60,6 +61,17 @@ public:
     bool
     ResolveLoadAddress (lldb::addr_t load_addr, Address &so_addr) const;
 
+    //------------------------------------------------------------------
+    // Resolve each of "load_addrs" into the matching element of
+    // "so_addrs" like ResolveLoadAddress() does, taking the lock once.
+    // Addresses in the same section as the one before them are resolved
+    // without searching, so sorting them first is fastest. Addresses that
+    // aren't in a loaded section are left invalid. Returns the number of
+    // addresses that were resolved.
+    //------------------------------------------------------------------
+    size_t
+    ResolveLoadAddresses (const std::vector<lldb::addr_t> &load_addrs, std::vector<Address> &so_addrs) const;
+
     bool
     SetSectionLoadAddress (const lldb::SectionSP &section_sp, lldb::addr_t load_addr, bool warn_multiple = false);
 
@@ -196,6 +196,12 @@ public:
     void
     SetDisplayRuntimeSupportValues (bool b);
 
+    FileSpec
+    GetDemangleCachePath () const;
+
+    uint64_t
+    GetDemangleCacheMaxSize () const;
+
     const ProcessLaunchInfo &
     GetProcessLaunchInfo();
 
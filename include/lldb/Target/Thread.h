@@ -431,6 +431,28 @@ public:
         return GetStackFrameList()->GetNumFrames();
     }
 
+    //------------------------------------------------------------------
+    /// Get the pc of each frame of the stack, without making the
+    /// thread's StackFrames or resolving their symbols.
+    ///
+    /// The unwinder follows the eh_frame and compact unwind tables and
+    /// frame pointers only, so this is much faster than walking the
+    /// stack frames, but can stop early or miss frames where those
+    /// don't describe the stack, e.g. in hand written assembly.
+    ///
+    /// @param[out] pcs
+    ///     Filled in with the load address of the pc of each frame,
+    ///     the youngest first.
+    ///
+    /// @param[in] max_frames
+    ///     The most frames to unwind.
+    ///
+    /// @return
+    ///     The number of pcs in \a pcs.
+    //------------------------------------------------------------------
+    uint32_t
+    GetRawBacktrace (std::vector<lldb::addr_t> &pcs, uint32_t max_frames);
+
     virtual lldb::StackFrameSP
     GetStackFrameAtIndex (uint32_t idx)
     {
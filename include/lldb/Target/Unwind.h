@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <vector>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
@@ -78,6 +80,20 @@ public:
         return DoGetFrameInfoAtIndex (frame_idx, cfa, pc);
     }
     
+    //------------------------------------------------------------------
+    // Fill in "pcs" with the pc of each frame, up to "max_frames" of
+    // them, without making StackFrames or resolving any symbols. Meant
+    // for sampling stacks, so unwinders may trade accuracy in unusual
+    // frames for speed. Returns the number of pcs.
+    //------------------------------------------------------------------
+    uint32_t
+    GetRawBacktrace (std::vector<lldb::addr_t> &pcs, uint32_t max_frames)
+    {
+        Mutex::Locker locker(m_unwind_mutex);
+        pcs.clear();
+        return DoGetRawBacktrace (pcs, max_frames);
+    }
+
     lldb::RegisterContextSP
     CreateRegisterContextForFrame (StackFrame *frame)
     {
@@ -109,6 +125,21 @@ protected:
     virtual lldb::RegisterContextSP
     DoCreateRegisterContextForFrame (StackFrame *frame) = 0;
 
+    // Unwinders without a faster way just walk their frames
+    virtual uint32_t
+    DoGetRawBacktrace (std::vector<lldb::addr_t> &pcs, uint32_t max_frames)
+    {
+        lldb::addr_t cfa;
+        lldb::addr_t pc;
+        for (uint32_t idx = 0; idx < max_frames; idx++)
+        {
+            if (!DoGetFrameInfoAtIndex (idx, cfa, pc))
+                break;
+            pcs.push_back (pc);
+        }
+        return pcs.size();
+    }
+
     Thread &m_thread;
     Mutex  m_unwind_mutex;
 private:
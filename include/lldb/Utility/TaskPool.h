@@ -0,0 +1,104 @@
+//===--------------------- TaskPool.h ---------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_TaskPool_h_
+#define utility_TaskPool_h_
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace lldb_private
+{
+
+//----------------------------------------------------------------------
+// Global, lazily created pool of worker threads. The number of worker
+// threads is bounded by the number of CPUs on the host and the threads
+// are only spawned once there are tasks that need to run.
+//
+// Tasks must not block waiting on other tasks that have been added to
+// the pool after themselves, as there is no guarantee that a worker
+// thread will be available to run them. RunTasks and TaskMapOverInt
+// are safe to call from a task: the calling thread runs the work that
+// no worker thread picked up, and only waits for work that is already
+// running.
+//----------------------------------------------------------------------
+class TaskPool
+{
+public:
+    //------------------------------------------------------------------
+    // Add a new task to the task pool and return a std::future that
+    // can be used to wait for the result of the task.
+    //------------------------------------------------------------------
+    template <typename F, typename... Args>
+    static std::future<typename std::result_of<F(Args...)>::type>
+    AddTask (F&& f, Args&&... args);
+
+    //------------------------------------------------------------------
+    // Run all of the specified tasks on the task pool and wait until
+    // all of them are finished before returning. The calling thread
+    // runs the tasks that no worker thread has started.
+    //------------------------------------------------------------------
+    template <typename... T>
+    static void
+    RunTasks (T&&... tasks);
+
+    //------------------------------------------------------------------
+    // The maximum number of tasks that will run concurrently.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetMaxConcurrency ();
+
+private:
+    TaskPool () = delete;
+
+    static void
+    RunTasksImpl (const std::vector<std::function<void()>> &tasks);
+
+    static void
+    AddTaskImpl (std::function<void()>&& task_fn);
+};
+
+//----------------------------------------------------------------------
+// Run "func" once for every integer in the [begin, end) range on the
+// task pool and wait for all of them to finish. Each worker pulls the
+// next unprocessed index so uneven work items balance themselves out.
+//----------------------------------------------------------------------
+void
+TaskMapOverInt (size_t begin,
+                size_t end,
+                const std::function<void(size_t)> &func);
+
+template <typename F, typename... Args>
+std::future<typename std::result_of<F(Args...)>::type>
+TaskPool::AddTask (F&& f, Args&&... args)
+{
+    auto task_sp = std::make_shared<std::packaged_task<typename std::result_of<F(Args...)>::type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+    AddTaskImpl([task_sp]() { (*task_sp)(); });
+
+    return task_sp->get_future();
+}
+
+template <typename... T>
+void
+TaskPool::RunTasks (T&&... tasks)
+{
+    const std::vector<std::function<void()>> task_fns = { std::function<void()>(std::forward<T>(tasks))... };
+    RunTasksImpl(task_fns);
+}
+
+} // namespace lldb_private
+
+#endif // #ifndef utility_TaskPool_h_
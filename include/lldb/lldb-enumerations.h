@@ -609,7 +609,11 @@ namespace lldb {
         eSectionTypeELFDynamicLinkInfo,   // Elf SHT_DYNAMIC section
         eSectionTypeEHFrame,
         eSectionTypeCompactUnwind,        // compact unwind section in Mach-O, __TEXT,__unwind_info
-        eSectionTypeOther
+        eSectionTypeOther,
+        eSectionTypeDWARFGDBIndex,        // .gdb_index name index created by gold and lld
+        eSectionTypeDWARFDebugAddr,       // Split DWARF address table
+        eSectionTypeDWARFDebugStrOffsets, // Split DWARF string offsets table
+        eSectionTypeDWARFDebugCUIndex     // Split DWARF package (.dwp) compile unit index
     };
 
     FLAGS_ENUM(EmulateInstructionOptions)
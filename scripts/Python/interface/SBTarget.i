@@ -552,6 +552,19 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of a list of load addresses at once.
+    /// Returns an SBSymbolContextList with one symbol context for each
+    /// address, in the same order as the addresses. The symbol context of
+    /// an address that isn't in a loaded section is empty.
+    //------------------------------------------------------------------
+    ") ResolveSymbolContextsForLoadAddresses;
+    lldb::SBSymbolContextList
+    ResolveSymbolContextsForLoadAddresses (uint64_t* array,
+                                           size_t array_len,
+                                           uint32_t resolve_scope);
+
      %feature("docstring", "
     //------------------------------------------------------------------
     /// Read target memory. If a target process is running then memory  
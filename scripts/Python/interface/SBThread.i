@@ -273,6 +273,15 @@ public:
     lldb::SBFrame
     GetFrameAtIndex (uint32_t idx);
 
+    %feature("docstring", "
+    Returns a list of the pc of each frame of the thread's stack, up to
+    max_frames of them, without making the frames or looking up symbols.
+    The stack is unwound using only the compact unwind and eh_frame tables
+    and frame pointers, which is much faster and is meant for sampling.
+    ") GetRawBacktrace;
+    uint32_t
+    GetRawBacktrace (lldb::addr_t *pcs, uint32_t max_frames);
+
     lldb::SBFrame
     GetSelectedFrame ();
 
@@ -13,6 +13,8 @@
 
 #include "lldb/lldb-public.h"
 
+#include <algorithm>
+
 #include "lldb/API/SBBreakpoint.h"
 #include "lldb/API/SBDebugger.h"
 #include "lldb/API/SBEvent.h"
@@ -57,6 +59,7 @@
 #include "lldb/Target/LanguageRuntime.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/TargetList.h"
@@ -763,6 +766,44 @@ SBTarget::ResolveSymbolContextForAddress (const SBAddress& addr,
     return sc;
 }
 
+lldb::SBSymbolContextList
+SBTarget::ResolveSymbolContextsForLoadAddresses (uint64_t* array,
+                                                 size_t array_len,
+                                                 uint32_t resolve_scope)
+{
+    lldb::SBSymbolContextList sb_sc_list;
+    TargetSP target_sp(GetSP());
+    if (target_sp && array && array_len > 0)
+    {
+        Mutex::Locker api_locker (target_sp->GetAPIMutex());
+
+        // Resolve the addresses in order so the section lookups can start
+        // from the section of the address before
+        std::vector<size_t> order (array_len);
+        for (size_t i = 0; i < array_len; ++i)
+            order[i] = i;
+        std::stable_sort (order.begin(), order.end(), [array](size_t lhs, size_t rhs) { return array[lhs] < array[rhs]; });
+
+        std::vector<lldb::addr_t> sorted_load_addrs;
+        sorted_load_addrs.reserve (array_len);
+        for (size_t idx : order)
+            sorted_load_addrs.push_back (array[idx]);
+        std::vector<Address> sorted_so_addrs;
+        target_sp->GetSectionLoadList().ResolveLoadAddresses (sorted_load_addrs, sorted_so_addrs);
+
+        std::vector<Address> so_addrs (array_len);
+        for (size_t i = 0; i < array_len; ++i)
+            so_addrs[order[i]] = sorted_so_addrs[i];
+
+        std::vector<SymbolContext> sc_list;
+        std::vector<uint32_t> resolved_list;
+        target_sp->GetImages().ResolveSymbolContextsForAddresses (so_addrs, resolve_scope, sc_list, resolved_list);
+        for (const SymbolContext &sc : sc_list)
+            sb_sc_list->Append (sc);
+    }
+    return sb_sc_list;
+}
+
 size_t
 SBTarget::ReadMemory (const SBAddress addr,
                       void *buf,
@@ -1356,6 +1356,39 @@ SBThread::GetFrameAtIndex (uint32_t idx)
     return sb_frame;
 }
 
+uint32_t
+SBThread::GetRawBacktrace (lldb::addr_t *pcs, uint32_t max_frames)
+{
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+
+    uint32_t num_frames = 0;
+    Mutex::Locker api_locker;
+    ExecutionContext exe_ctx (m_opaque_sp.get(), api_locker);
+
+    if (pcs && exe_ctx.HasThreadScope())
+    {
+        Process::StopLocker stop_locker;
+        if (stop_locker.TryLock(&exe_ctx.GetProcessPtr()->GetRunLock()))
+        {
+            std::vector<addr_t> raw_pcs;
+            num_frames = exe_ctx.GetThreadPtr()->GetRawBacktrace (raw_pcs, max_frames);
+            std::copy (raw_pcs.begin(), raw_pcs.begin() + num_frames, pcs);
+        }
+        else
+        {
+            if (log)
+                log->Printf ("SBThread(%p)::GetRawBacktrace() => error: process is running",
+                             static_cast<void*>(exe_ctx.GetThreadPtr()));
+        }
+    }
+
+    if (log)
+        log->Printf ("SBThread(%p)::GetRawBacktrace (max_frames=%u) => %u",
+                     static_cast<void*>(exe_ctx.GetThreadPtr()), max_frames, num_frames);
+
+    return num_frames;
+}
+
 lldb::SBFrame
 SBThread::GetSelectedFrame ()
 {
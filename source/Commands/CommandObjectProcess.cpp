@@ -27,6 +27,7 @@
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Target/Memory.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StopInfo.h"
@@ -1596,6 +1597,117 @@ public:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessCacheStats
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessCacheStats
+
+class CommandObjectProcessCacheStats : public CommandObjectParsed
+{
+public:
+    CommandObjectProcessCacheStats (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process cache stats",
+                             "Show how well the memory cache of the current process is working.",
+                             "process cache stats",
+                             eFlagRequiresProcess)
+    {
+    }
+
+    ~CommandObjectProcessCacheStats ()
+    {
+    }
+
+protected:
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        Stream &strm = result.GetOutputStream();
+        Process *process = m_exe_ctx.GetProcessPtr();
+        MemoryCache &memory_cache = process->GetMemoryCache();
+        const MemoryCache::Statistics stats = memory_cache.GetStatistics();
+        const uint32_t line_byte_size = memory_cache.GetMemoryCacheLineSize();
+        const uint64_t num_line_reads = stats.hits + stats.misses;
+
+        if (process->GetDisableMemoryCache())
+            strm.PutCString ("The memory cache is disabled.\n");
+        strm.Printf ("Cached lines: %u of %u (%u bytes each)\n",
+                     memory_cache.GetNumCachedLines(),
+                     memory_cache.GetCapacity(),
+                     line_byte_size);
+        strm.Printf ("Hits: %" PRIu64 ", misses: %" PRIu64 " (%.1f%% hit rate)\n",
+                     stats.hits,
+                     stats.misses,
+                     num_line_reads ? 100.0 * stats.hits / num_line_reads : 0.0);
+        strm.Printf ("Reads from the process: %" PRIu64 " for %" PRIu64 " bytes, plus %" PRIu64 " too large to cache\n",
+                     stats.reads,
+                     stats.bytes_read,
+                     stats.uncached_reads);
+        strm.Printf ("Prefetched lines: %" PRIu64 ", %" PRIu64 " of which were used\n",
+                     stats.prefetched_lines,
+                     stats.prefetch_hits);
+        strm.Printf ("Evicted lines: %" PRIu64 "\n", stats.evictions);
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return result.Succeeded();
+    }
+};
+
+//-------------------------------------------------------------------------
+// CommandObjectProcessCacheClear
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessCacheClear
+
+class CommandObjectProcessCacheClear : public CommandObjectParsed
+{
+public:
+    CommandObjectProcessCacheClear (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process cache clear",
+                             "Throw away the memory cached for the current process and reset the cache statistics.",
+                             "process cache clear",
+                             eFlagRequiresProcess)
+    {
+    }
+
+    ~CommandObjectProcessCacheClear ()
+    {
+    }
+
+protected:
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        MemoryCache &memory_cache = m_exe_ctx.GetProcessPtr()->GetMemoryCache();
+        memory_cache.Clear();
+        memory_cache.ResetStatistics();
+        result.SetStatus (eReturnStatusSuccessFinishNoResult);
+        return result.Succeeded();
+    }
+};
+
+//-------------------------------------------------------------------------
+// CommandObjectProcessCache
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessCache
+
+class CommandObjectProcessCache : public CommandObjectMultiword
+{
+public:
+    CommandObjectProcessCache (CommandInterpreter &interpreter) :
+        CommandObjectMultiword (interpreter,
+                                "process cache",
+                                "A set of commands for the memory cache of the current process.",
+                                "process cache <subcommand>")
+    {
+        LoadSubCommand ("stats", CommandObjectSP (new CommandObjectProcessCacheStats (interpreter)));
+        LoadSubCommand ("clear", CommandObjectSP (new CommandObjectProcessCacheClear (interpreter)));
+    }
+
+    ~CommandObjectProcessCache ()
+    {
+    }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessHandle
 //-------------------------------------------------------------------------
@@ -1925,6 +2037,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
     LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
     LoadSubCommand ("save-core",   CommandObjectSP (new CommandObjectProcessSaveCore  (interpreter)));
+    LoadSubCommand ("cache",       CommandObjectSP (new CommandObjectProcessCache     (interpreter)));
 }
 
 CommandObjectMultiwordProcess::~CommandObjectMultiwordProcess ()
@@ -204,6 +204,9 @@ public:
                         error.SetErrorStringWithFormat("invalid boolean value for option '%c'", short_option);
                 }
                 break;
+                case 'r':
+                    m_raw_backtrace = true;
+                    break;
                 default:
                     error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
                     break;
@@ -218,6 +221,7 @@ public:
             m_count = UINT32_MAX;
             m_start = 0;
             m_extended_backtrace = false;
+            m_raw_backtrace = false;
         }
 
         const OptionDefinition*
@@ -234,6 +238,7 @@ public:
         uint32_t m_count;
         uint32_t m_start;
         bool     m_extended_backtrace;
+        bool     m_raw_backtrace;
     };
 
     CommandObjectThreadBacktrace (CommandInterpreter &interpreter) :
@@ -287,9 +292,32 @@ protected:
         }
     }
 
+    void
+    DoRawBacktrace (Thread &thread, CommandReturnObject &result)
+    {
+        Stream &strm = result.GetOutputStream();
+
+        uint32_t max_frames = UINT32_MAX;
+        if (m_options.m_count != UINT32_MAX && m_options.m_count < UINT32_MAX - m_options.m_start)
+            max_frames = m_options.m_start + m_options.m_count;
+
+        std::vector<addr_t> pcs;
+        thread.GetRawBacktrace (pcs, max_frames);
+        strm.Printf ("thread #%u: tid = 0x%4.4" PRIx64 ", %" PRIu64 " frames\n",
+                     thread.GetIndexID(), thread.GetID(), (uint64_t)pcs.size());
+        for (size_t idx = m_options.m_start; idx < pcs.size(); ++idx)
+            strm.Printf ("  frame #%" PRIu64 ": 0x%16.16" PRIx64 "\n", (uint64_t)idx, pcs[idx]);
+    }
+
     virtual bool
     HandleOneThread (Thread &thread, CommandReturnObject &result)
     {
+        if (m_options.m_raw_backtrace)
+        {
+            DoRawBacktrace (thread, result);
+            return true;
+        }
+
         Stream &strm = result.GetOutputStream();
 
         // Don't show source context when doing backtraces.
@@ -321,6 +349,7 @@ CommandObjectThreadBacktrace::CommandOptions::g_option_table[] =
 { LLDB_OPT_SET_1, false, "count", 'c', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeCount, "How many frames to display (-1 for all)"},
 { LLDB_OPT_SET_1, false, "start", 's', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeFrameIndex, "Frame in which to start the backtrace"},
 { LLDB_OPT_SET_1, false, "extended", 'e', OptionParser::eRequiredArgument, NULL, NULL, 0, eArgTypeBoolean, "Show the extended backtrace, if available"},
+{ LLDB_OPT_SET_1, false, "raw", 'r', OptionParser::eNoArgument, NULL, NULL, 0, eArgTypeNone, "Only show the pc of each frame, found quickly from the unwind tables and frame pointers without looking up symbols.  Meant for sampling the stacks of many threads."},
 { 0, false, NULL, 0, 0, NULL, NULL, 0, eArgTypeNone, NULL }
 };
 
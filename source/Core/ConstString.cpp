@@ -8,14 +8,23 @@
 //===----------------------------------------------------------------------===//
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Stream.h"
-#include "lldb/Host/Mutex.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/Support/RWMutex.h"
 
+#include <array>
 #include <mutex> // std::once
 
 using namespace lldb_private;
 
 
+//----------------------------------------------------------------------
+// The string pool is split into shards selected by the hash of the
+// string so that threads interning different strings rarely contend on
+// the same lock. Each shard has its own string map, and therefore its
+// own allocator, behind a reader/writer lock: looking up a string that
+// is already in the pool only takes the reader side.
+//----------------------------------------------------------------------
 class Pool
 {
 public:
@@ -23,25 +32,6 @@ public:
     typedef llvm::StringMap<StringPoolValueType, llvm::BumpPtrAllocator> StringPool;
     typedef llvm::StringMapEntry<StringPoolValueType> StringPoolEntryType;
     
-    //------------------------------------------------------------------
-    // Default constructor
-    //
-    // Initialize the member variables and create the empty string.
-    //------------------------------------------------------------------
-    Pool () :
-        m_mutex (Mutex::eMutexTypeRecursive),
-        m_string_map ()
-    {
-    }
-
-    //------------------------------------------------------------------
-    // Destructor
-    //------------------------------------------------------------------
-    ~Pool ()
-    {
-    }
-
-
     static StringPoolEntryType &
     GetStringMapEntryFromKeyData (const char *keyData)
     {
@@ -54,6 +44,8 @@ public:
     {
         if (ccstr)
         {
+            // The key of an entry never changes once it has been added,
+            // so there is no need to lock anything here.
             const StringPoolEntryType&entry = GetStringMapEntryFromKeyData (ccstr);
             return entry.getKey().size();
         }
@@ -64,7 +56,11 @@ public:
     GetMangledCounterpart (const char *ccstr) const
     {
         if (ccstr)
+        {
+            const PoolShard &shard = GetShard (llvm::StringRef (ccstr, GetConstCStringLength (ccstr)));
+            llvm::sys::SmartScopedReader<false> locker (shard.m_mutex);
             return GetStringMapEntryFromKeyData (ccstr).getValue();
+        }
         return 0;
     }
 
@@ -73,8 +69,8 @@ public:
     {
         if (key_ccstr && value_ccstr)
         {
-            GetStringMapEntryFromKeyData (key_ccstr).setValue(value_ccstr);
-            GetStringMapEntryFromKeyData (value_ccstr).setValue(key_ccstr);
+            SetCounterpart (key_ccstr, value_ccstr);
+            SetCounterpart (value_ccstr, key_ccstr);
             return true;
         }
         return false;
@@ -92,12 +88,7 @@ public:
     GetConstCStringWithLength (const char *cstr, size_t cstr_len)
     {
         if (cstr)
-        {
-            Mutex::Locker locker (m_mutex);
-            llvm::StringRef string_ref (cstr, cstr_len);
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
-            return entry.getKeyData();
-        }
+            return GetConstCStringWithStringRef (llvm::StringRef (cstr, cstr_len));
         return NULL;
     }
 
@@ -106,8 +97,18 @@ public:
     {
         if (string_ref.data())
         {
-            Mutex::Locker locker (m_mutex);
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
+            PoolShard &shard = GetShard (string_ref);
+            {
+                // Most strings are already in the pool, so try a lookup with
+                // the shared lock first.
+                llvm::sys::SmartScopedReader<false> locker (shard.m_mutex);
+                StringPool::const_iterator pos = shard.m_string_map.find (string_ref);
+                if (pos != shard.m_string_map.end())
+                    return pos->getKeyData();
+            }
+
+            llvm::sys::SmartScopedWriter<false> locker (shard.m_mutex);
+            StringPoolEntryType& entry = *shard.m_string_map.insert (std::make_pair (string_ref, (StringPoolValueType)NULL)).first;
             return entry.getKeyData();
         }
         return NULL;
@@ -118,15 +119,21 @@ public:
     {
         if (demangled_cstr)
         {
-            Mutex::Locker locker (m_mutex);
-            // Make string pool entry with the mangled counterpart already set
-            StringPoolEntryType& entry = *m_string_map.insert (std::make_pair (llvm::StringRef (demangled_cstr), mangled_ccstr)).first;
+            const char *demangled_ccstr = NULL;
+            {
+                const llvm::StringRef string_ref (demangled_cstr);
+                PoolShard &shard = GetShard (string_ref);
+                llvm::sys::SmartScopedWriter<false> locker (shard.m_mutex);
+                // Make string pool entry with the mangled counterpart already set
+                StringPoolEntryType& entry = *shard.m_string_map.insert (std::make_pair (string_ref, mangled_ccstr)).first;
+
+                // Extract the const version of the demangled_cstr
+                demangled_ccstr = entry.getKeyData();
+            }
 
-            // Extract the const version of the demangled_cstr
-            const char *demangled_ccstr = entry.getKeyData();
             // Now assign the demangled const string as the counterpart of the
             // mangled const string...
-            GetStringMapEntryFromKeyData (mangled_ccstr).setValue(demangled_ccstr);
+            SetCounterpart (mangled_ccstr, demangled_ccstr);
             // Return the constant demangled C string
             return demangled_ccstr;
         }
@@ -152,12 +159,15 @@ public:
     size_t
     MemorySize() const
     {
-        Mutex::Locker locker (m_mutex);
         size_t mem_size = sizeof(Pool);
-        const_iterator end = m_string_map.end();
-        for (const_iterator pos = m_string_map.begin(); pos != end; ++pos)
+        for (const PoolShard &shard : m_shards)
         {
-            mem_size += sizeof(StringPoolEntryType) + pos->getKey().size();
+            llvm::sys::SmartScopedReader<false> locker (shard.m_mutex);
+            const_iterator end = shard.m_string_map.end();
+            for (const_iterator pos = shard.m_string_map.begin(); pos != end; ++pos)
+            {
+                mem_size += sizeof(StringPoolEntryType) + pos->getKey().size();
+            }
         }
         return mem_size;
     }
@@ -169,11 +179,45 @@ protected:
     typedef StringPool::iterator iterator;
     typedef StringPool::const_iterator const_iterator;
 
+    struct PoolShard
+    {
+        mutable llvm::sys::SmartRWMutex<false> m_mutex;
+        StringPool m_string_map;
+    };
+
+    enum { kNumShards = 256 };
+
+    PoolShard &
+    GetShard (const llvm::StringRef &string_ref)
+    {
+        return m_shards[GetShardIndex (string_ref)];
+    }
+
+    const PoolShard &
+    GetShard (const llvm::StringRef &string_ref) const
+    {
+        return m_shards[GetShardIndex (string_ref)];
+    }
+
+    static uint8_t
+    GetShardIndex (const llvm::StringRef &string_ref)
+    {
+        const uint32_t h = llvm::HashString (string_ref);
+        return (uint8_t)((h >> 24) ^ (h >> 16) ^ (h >> 8) ^ h);
+    }
+
+    void
+    SetCounterpart (const char *ccstr, const char *counterpart_ccstr)
+    {
+        PoolShard &shard = GetShard (llvm::StringRef (ccstr, GetConstCStringLength (ccstr)));
+        llvm::sys::SmartScopedWriter<false> locker (shard.m_mutex);
+        GetStringMapEntryFromKeyData (ccstr).setValue (counterpart_ccstr);
+    }
+
     //------------------------------------------------------------------
     // Member variables
     //------------------------------------------------------------------
-    mutable Mutex m_mutex;
-    StringPool m_string_map;
+    std::array<PoolShard, kNumShards> m_shards;
 };
 
 //----------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #include "llvm/ADT/StringRef.h"
 
 #include "lldb/lldb-private.h"
+#include "lldb/Core/DemangledNameCache.h"
 #include "lldb/Core/FormatEntity.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
@@ -420,6 +421,8 @@ Debugger::Terminate ()
 {
     assert(lldb_initialized && "Debugger::Terminate called without a matching Debugger::Initialize!");
 
+    DemangledNameCache::Terminate ();
+
     // Clear our master list of debugger objects
     Mutex::Locker locker (GetDebuggerListMutex ());
     GetDebuggerList().clear();
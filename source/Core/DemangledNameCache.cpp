@@ -0,0 +1,419 @@
+//===-- DemangledNameCache.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/DemangledNameCache.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Logging.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/Host.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// "LDMC" when read as a little endian 32 bit integer
+const uint32_t kCacheMagic = 0x434d444c;
+// Bump this whenever the record layout or the output of the demangler
+// changes.
+const uint32_t kCacheVersion = 1;
+const lldb::offset_t kHeaderByteSize = 8;
+
+// Every record is the 64 bit hash of the mangled name, the lengths of
+// both names and then both names with NULL terminators.
+const lldb::offset_t kRecordHeaderByteSize = 16;
+
+// Pending names are written out once they would take up this much
+// space in the cache file.
+const size_t kFlushThreshold = 256 * 1024;
+
+const char *kCacheFileName = "demangled-names";
+
+struct Record
+{
+    uint64_t hash;
+    lldb::offset_t offset;
+    uint32_t mangled_len;
+    uint32_t demangled_len;
+
+    lldb::offset_t
+    GetByteSize () const
+    {
+        return kRecordHeaderByteSize + mangled_len + 1 + demangled_len + 1;
+    }
+};
+
+lldb::offset_t
+GetRecordByteSize (const ConstString &mangled, const ConstString &demangled)
+{
+    return kRecordHeaderByteSize + mangled.GetLength() + 1 + demangled.GetLength() + 1;
+}
+
+void
+PutHeader (StreamString &strm)
+{
+    strm.PutHex32 (kCacheMagic);
+    strm.PutHex32 (kCacheVersion);
+}
+
+bool
+ReadHeader (const DataExtractor &data, lldb::offset_t &offset)
+{
+    return data.GetU32 (&offset) == kCacheMagic && data.GetU32 (&offset) == kCacheVersion;
+}
+
+void
+PutRecord (StreamString &strm, const ConstString &mangled, const ConstString &demangled)
+{
+    strm.PutHex64 (DemangledNameCache::HashName (mangled.GetCString(), mangled.GetLength()));
+    strm.PutHex32 ((uint32_t)mangled.GetLength());
+    strm.PutHex32 ((uint32_t)demangled.GetLength());
+    strm.Write (mangled.GetCString(), mangled.GetLength() + 1);
+    strm.Write (demangled.AsCString(""), demangled.GetLength() + 1);
+}
+
+// Returns false at the end of the data and at the first truncated or
+// corrupt record, which is what a session that crashed while appending
+// to the cache file leaves behind.
+bool
+ReadRecord (const DataExtractor &data, lldb::offset_t &offset, Record &record)
+{
+    record.offset = offset;
+    if (!data.ValidOffsetForDataOfSize (offset, kRecordHeaderByteSize))
+        return false;
+    record.hash = data.GetU64 (&offset);
+    record.mangled_len = data.GetU32 (&offset);
+    record.demangled_len = data.GetU32 (&offset);
+    if (record.hash > (UINT64_MAX >> 1))
+        return false;
+
+    const lldb::offset_t strings_size = (lldb::offset_t)record.mangled_len + record.demangled_len + 2;
+    const char *strings = (const char *)data.PeekData (offset, strings_size);
+    if (strings == NULL || strings[record.mangled_len] != '\0' || strings[strings_size - 1] != '\0')
+        return false;
+    offset += strings_size;
+    return true;
+}
+
+Error
+WriteCacheFile (const char *path, uint32_t options, const StreamString &strm)
+{
+    File file;
+    Error error = file.Open (path, options, lldb::eFilePermissionsFileDefault);
+    if (error.Fail())
+        return error;
+
+    // A single write so that records appended by concurrent debug
+    // sessions don't interleave.
+    size_t bytes_written = strm.GetSize();
+    error = file.Write (strm.GetData(), bytes_written);
+    file.Close();
+    if (error.Success() && bytes_written != strm.GetSize())
+        error.SetErrorString ("short write to demangled name cache file");
+    return error;
+}
+
+std::atomic<DemangledNameCache *> g_shared_cache (NULL);
+
+}  // anonymous namespace
+
+DemangledNameCache::DemangledNameCache (const FileSpec &cache_dir, uint64_t max_byte_size) :
+    m_cache_dir (cache_dir),
+    m_max_byte_size (max_byte_size),
+    m_data_sp (),
+    m_index (),
+    m_pending_mutex (Mutex::eMutexTypeNormal),
+    m_pending (),
+    m_pending_names (),
+    m_pending_byte_size (0),
+    m_write_mutex (Mutex::eMutexTypeNormal)
+{
+    Load ();
+}
+
+DemangledNameCache::~DemangledNameCache ()
+{
+    Flush ();
+}
+
+void
+DemangledNameCache::Initialize (const FileSpec &cache_dir, uint64_t max_byte_size)
+{
+    static std::once_flag g_once_flag;
+    std::call_once (g_once_flag, [&cache_dir, max_byte_size]() {
+        if (cache_dir)
+            g_shared_cache = new DemangledNameCache (cache_dir, max_byte_size);
+    });
+}
+
+DemangledNameCache *
+DemangledNameCache::GetShared ()
+{
+    return g_shared_cache;
+}
+
+void
+DemangledNameCache::Terminate ()
+{
+    // The shared cache is leaked on purpose, other threads might still be
+    // demangling names.
+    DemangledNameCache *shared_cache = g_shared_cache;
+    if (shared_cache)
+        shared_cache->Flush ();
+}
+
+uint64_t
+DemangledNameCache::HashName (const char *cstr, size_t length)
+{
+    // 64 bit FNV-1a, the hashes are stored in the cache file so this must
+    // never change without bumping kCacheVersion.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (uint8_t)cstr[i];
+        hash *= 0x100000001b3ull;
+    }
+    // llvm::DenseMap reserves the two largest keys.
+    return hash >> 1;
+}
+
+FileSpec
+DemangledNameCache::GetCacheFileSpec () const
+{
+    FileSpec cache_file (m_cache_dir);
+    cache_file.AppendPathComponent (kCacheFileName);
+    return cache_file;
+}
+
+void
+DemangledNameCache::Load ()
+{
+    const FileSpec cache_file (GetCacheFileSpec());
+    if (!cache_file.Exists())
+        return;
+
+    DataBufferSP data_sp (cache_file.MemoryMapFileContents());
+    if (!data_sp || data_sp->GetByteSize() == 0)
+        return;
+
+    DataExtractor data (data_sp, eByteOrderLittle, 4);
+    lldb::offset_t offset = 0;
+    if (!ReadHeader (data, offset))
+        return;
+
+    Record record;
+    while (ReadRecord (data, offset, record))
+    {
+        IndexEntry entry;
+        entry.strings_offset = record.offset + kRecordHeaderByteSize;
+        entry.mangled_len = record.mangled_len;
+        // Later records win, they were demangled more recently.
+        m_index[record.hash] = entry;
+    }
+    m_data_sp = data_sp;
+}
+
+const char *
+DemangledNameCache::Lookup (const ConstString &mangled) const
+{
+    if (m_index.empty() || !mangled)
+        return NULL;
+
+    const size_t mangled_len = mangled.GetLength();
+    auto pos = m_index.find (HashName (mangled.GetCString(), mangled_len));
+    if (pos == m_index.end() || pos->second.mangled_len != mangled_len)
+        return NULL;
+
+    const char *strings = (const char *)m_data_sp->GetBytes() + pos->second.strings_offset;
+    if (::memcmp (strings, mangled.GetCString(), mangled_len) != 0)
+        return NULL;
+    return strings + mangled_len + 1;
+}
+
+void
+DemangledNameCache::Insert (const ConstString &mangled, const ConstString &demangled)
+{
+    if (!mangled)
+        return;
+
+    std::vector<NamePair> pending;
+    {
+        Mutex::Locker locker (m_pending_mutex);
+        if (!m_pending_names.insert (mangled.GetCString()).second)
+            return;
+        m_pending.push_back (NamePair (mangled, demangled));
+        m_pending_byte_size += GetRecordByteSize (mangled, demangled);
+        if (m_pending_byte_size < kFlushThreshold)
+            return;
+        TakePendingLocked (pending);
+    }
+    Write (pending);
+}
+
+Error
+DemangledNameCache::Flush ()
+{
+    std::vector<NamePair> pending;
+    {
+        Mutex::Locker locker (m_pending_mutex);
+        TakePendingLocked (pending);
+    }
+    return Write (pending);
+}
+
+void
+DemangledNameCache::TakePendingLocked (std::vector<NamePair> &pending)
+{
+    pending.swap (m_pending);
+    m_pending_names.clear();
+    m_pending_byte_size = 0;
+}
+
+Error
+DemangledNameCache::Write (const std::vector<NamePair> &pending)
+{
+    Error error;
+    if (pending.empty())
+        return error;
+
+    uint64_t pending_byte_size = 0;
+    for (const NamePair &names : pending)
+        pending_byte_size += GetRecordByteSize (names.first, names.second);
+
+    // Only one batch is written at a time, Rewrite() uses the same
+    // temporary file for every thread of this process.
+    Mutex::Locker locker (m_write_mutex);
+    if (!m_cache_dir.IsDirectory())
+        error = FileSystem::MakeDirectory (m_cache_dir.GetPath().c_str(), eFilePermissionsDirectoryDefault);
+
+    if (error.Success())
+    {
+        // Append to the existing file unless that would make it too big,
+        // or it is missing or was written by a different version.
+        const FileSpec cache_file (GetCacheFileSpec());
+        bool can_append = false;
+        if (cache_file.Exists() && cache_file.GetByteSize() + pending_byte_size <= m_max_byte_size)
+        {
+            DataBufferSP header_sp (cache_file.MemoryMapFileContents (0, kHeaderByteSize));
+            if (header_sp && header_sp->GetByteSize() == kHeaderByteSize)
+            {
+                DataExtractor header (header_sp, eByteOrderLittle, 4);
+                lldb::offset_t offset = 0;
+                can_append = ReadHeader (header, offset);
+            }
+        }
+
+        if (can_append)
+        {
+            StreamString strm (Stream::eBinary, 4, eByteOrderLittle);
+            for (const NamePair &names : pending)
+                PutRecord (strm, names.first, names.second);
+            error = WriteCacheFile (cache_file.GetPath().c_str(),
+                                    File::eOpenOptionWrite | File::eOpenOptionAppend,
+                                    strm);
+        }
+        else
+            error = Rewrite (pending);
+    }
+
+    Log *log (lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_SYMBOLS));
+    if (log && error.Fail())
+        log->Printf ("DemangledNameCache::Flush failed to write %" PRIu64 " names to %s: %s",
+                     (uint64_t)pending.size(),
+                     m_cache_dir.GetPath().c_str(),
+                     error.AsCString());
+    return error;
+}
+
+Error
+DemangledNameCache::Rewrite (const std::vector<NamePair> &pending)
+{
+    // Start from the file as it is now rather than what was loaded as
+    // other debug sessions might have appended to it in the meantime.
+    const FileSpec cache_file (GetCacheFileSpec());
+    DataExtractor data;
+    std::vector<Record> records;
+    if (cache_file.Exists())
+    {
+        DataBufferSP data_sp (cache_file.MemoryMapFileContents());
+        if (data_sp && data_sp->GetByteSize() > 0)
+        {
+            data.SetData (data_sp);
+            data.SetByteOrder (eByteOrderLittle);
+            lldb::offset_t offset = 0;
+            Record record;
+            if (ReadHeader (data, offset))
+            {
+                while (ReadRecord (data, offset, record))
+                    records.push_back (record);
+            }
+        }
+    }
+
+    // Only fill half of the limit so the file can be appended to for a
+    // while before it has to be rewritten again. The pending names are
+    // the most recently used so they are kept first, followed by the
+    // newest records of the existing file.
+    const uint64_t byte_size_limit = m_max_byte_size / 2;
+    uint64_t byte_size = kHeaderByteSize;
+    size_t num_pending = 0;
+    for (; num_pending < pending.size(); ++num_pending)
+    {
+        const uint64_t record_size = GetRecordByteSize (pending[num_pending].first, pending[num_pending].second);
+        if (byte_size + record_size > byte_size_limit)
+            break;
+        byte_size += record_size;
+    }
+    size_t first_record = records.size();
+    while (first_record > 0 && byte_size + records[first_record - 1].GetByteSize() <= byte_size_limit)
+    {
+        --first_record;
+        byte_size += records[first_record].GetByteSize();
+    }
+
+    StreamString strm (Stream::eBinary, 4, eByteOrderLittle);
+    PutHeader (strm);
+    for (size_t i = first_record; i < records.size(); ++i)
+        strm.Write (data.PeekData (records[i].offset, records[i].GetByteSize()), records[i].GetByteSize());
+    for (size_t i = 0; i < num_pending; ++i)
+        PutRecord (strm, pending[i].first, pending[i].second);
+
+    // Write to a temporary file and rename it into place so that other
+    // debug sessions never see a partially written cache file.
+    const std::string cache_path (cache_file.GetPath());
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", cache_path.c_str(), (uint64_t)Host::GetCurrentProcessID());
+
+    Error error = WriteCacheFile (tmp_path.GetData(),
+                                  File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate,
+                                  strm);
+    if (error.Success())
+    {
+        std::error_code ec = llvm::sys::fs::rename (tmp_path.GetData(), cache_path.c_str());
+        if (ec)
+            error.SetErrorString (ec.message().c_str());
+    }
+
+    if (error.Fail())
+        FileSystem::Unlink (tmp_path.GetData());
+    return error;
+}
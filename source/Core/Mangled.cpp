@@ -4983,6 +4983,7 @@ __cxa_demangle(const char* mangled_name, char* buf, size_t* n, int* status)
 #include "llvm/ADT/DenseMap.h"
 
 #include "lldb/Core/ConstString.h"
+#include "lldb/Core/DemangledNameCache.h"
 #include "lldb/Core/Mangled.h"
 #include "lldb/Core/RegularExpression.h"
 #include "lldb/Core/Stream.h"
@@ -5218,7 +5219,23 @@ Mangled::GetDemangledName () const
         const char *mangled_cstr = m_mangled.GetCString();
         if (cstring_is_mangled(mangled_cstr))
         {
+            DemangledNameCache *demangled_name_cache = NULL;
+            const char *cached_demangled_name = NULL;
             if (!m_mangled.GetMangledCounterpart(m_demangled))
+            {
+                // Check the demangled names saved by earlier debug sessions
+                demangled_name_cache = DemangledNameCache::GetShared();
+                if (demangled_name_cache)
+                    cached_demangled_name = demangled_name_cache->Lookup(m_mangled);
+            }
+
+            if (cached_demangled_name)
+            {
+                // An empty name means an earlier session failed to demangle it
+                if (cached_demangled_name[0])
+                    m_demangled.SetCStringWithMangledCounterpart(cached_demangled_name, m_mangled);
+            }
+            else if (!m_demangled)
             {
                 // We didn't already mangle this name, demangle it and if all goes well
                 // add it to our map.
@@ -5254,6 +5271,9 @@ Mangled::GetDemangledName () const
                     m_demangled.SetCStringWithMangledCounterpart(demangled_name, m_mangled);
                     free (demangled_name);
                 }
+
+                if (demangled_name_cache)
+                    demangled_name_cache->Insert(m_mangled, m_demangled);
             }
         }
         if (!m_demangled)
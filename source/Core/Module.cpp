@@ -545,6 +545,60 @@ Module::ResolveFileAddress (lldb::addr_t vm_addr, Address& so_addr)
     return false;
 }
 
+uint32_t
+Module::ResolveSymbolInSymtab (const Address& so_addr, uint32_t resolve_scope, uint32_t resolved_flags,
+                               SymbolVendor &sym_vendor, SymbolContext& sc)
+{
+    Symtab *symtab = sym_vendor.GetSymtab();
+    if (symtab && so_addr.IsSectionOffset())
+    {
+        sc.symbol = symtab->FindSymbolContainingFileAddress(so_addr.GetFileAddress());
+        if (!sc.symbol &&
+            resolve_scope & eSymbolContextFunction && !(resolved_flags & eSymbolContextFunction))
+        {
+            bool verify_unique = false; // No need to check again since ResolveSymbolContext failed to find a symbol at this address.
+            if (ObjectFile *obj_file = sc.module_sp->GetObjectFile())
+                sc.symbol = obj_file->ResolveSymbolForAddress(so_addr, verify_unique);
+        }
+
+        if (sc.symbol)
+        {
+            if (sc.symbol->IsSynthetic())
+            {
+                // We have a synthetic symbol so lets check if the object file
+                // from the symbol file in the symbol vendor is different than
+                // the object file for the module, and if so search its symbol
+                // table to see if we can come up with a better symbol. For example
+                // dSYM files on MacOSX have an unstripped symbol table inside of
+                // them.
+                ObjectFile *symtab_objfile = symtab->GetObjectFile();
+                if (symtab_objfile && symtab_objfile->IsStripped())
+                {
+                    SymbolFile *symfile = sym_vendor.GetSymbolFile();
+                    if (symfile)
+                    {
+                        ObjectFile *symfile_objfile = symfile->GetObjectFile();
+                        if (symfile_objfile != symtab_objfile)
+                        {
+                            Symtab *symfile_symtab = symfile_objfile->GetSymtab();
+                            if (symfile_symtab)
+                            {
+                                Symbol *symbol = symfile_symtab->FindSymbolContainingFileAddress(so_addr.GetFileAddress());
+                                if (symbol && !symbol->IsSynthetic())
+                                {
+                                    sc.symbol = symbol;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            return eSymbolContextSymbol;
+        }
+    }
+    return 0;
+}
+
 uint32_t
 Module::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve_scope, SymbolContext& sc,
                                         bool resolve_tail_call_address)
@@ -582,55 +636,7 @@ Module::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve
 
         // Resolve the symbol if requested, but don't re-look it up if we've already found it.
         if (resolve_scope & eSymbolContextSymbol && !(resolved_flags & eSymbolContextSymbol))
-        {
-            Symtab *symtab = sym_vendor->GetSymtab();
-            if (symtab && so_addr.IsSectionOffset())
-            {
-                sc.symbol = symtab->FindSymbolContainingFileAddress(so_addr.GetFileAddress());
-                if (!sc.symbol &&
-                    resolve_scope & eSymbolContextFunction && !(resolved_flags & eSymbolContextFunction))
-                {
-                    bool verify_unique = false; // No need to check again since ResolveSymbolContext failed to find a symbol at this address.
-                    if (ObjectFile *obj_file = sc.module_sp->GetObjectFile())
-                        sc.symbol = obj_file->ResolveSymbolForAddress(so_addr, verify_unique);
-                }
-
-                if (sc.symbol)
-                {
-                    if (sc.symbol->IsSynthetic())
-                    {
-                        // We have a synthetic symbol so lets check if the object file
-                        // from the symbol file in the symbol vendor is different than
-                        // the object file for the module, and if so search its symbol
-                        // table to see if we can come up with a better symbol. For example
-                        // dSYM files on MacOSX have an unstripped symbol table inside of
-                        // them.
-                        ObjectFile *symtab_objfile = symtab->GetObjectFile();
-                        if (symtab_objfile && symtab_objfile->IsStripped())
-                        {
-                            SymbolFile *symfile = sym_vendor->GetSymbolFile();
-                            if (symfile)
-                            {
-                                ObjectFile *symfile_objfile = symfile->GetObjectFile();
-                                if (symfile_objfile != symtab_objfile)
-                                {
-                                    Symtab *symfile_symtab = symfile_objfile->GetSymtab();
-                                    if (symfile_symtab)
-                                    {
-                                        Symbol *symbol = symfile_symtab->FindSymbolContainingFileAddress(so_addr.GetFileAddress());
-                                        if (symbol && !symbol->IsSynthetic())
-                                        {
-                                            sc.symbol = symbol;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    resolved_flags |= eSymbolContextSymbol;
-                }
-            }
-        }
+            resolved_flags |= ResolveSymbolInSymtab (so_addr, resolve_scope, resolved_flags, *sym_vendor, sc);
 
         // For function symbols, so_addr may be off by one.  This is a convention consistent
         // with FDE row indices in eh_frame sections, but requires extra logic here to permit
@@ -671,6 +677,72 @@ Module::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve
     return resolved_flags;
 }
 
+size_t
+Module::ResolveSymbolContextsForAddresses (const std::vector<Address>& so_addrs, uint32_t resolve_scope,
+                                           std::vector<SymbolContext>& sc_list, std::vector<uint32_t>& resolved_list)
+{
+    Mutex::Locker locker (m_mutex);
+    Timer scoped_timer(__PRETTY_FUNCTION__,
+                       "Module::ResolveSymbolContextsForAddresses (%" PRIu64 " addresses, resolve_scope = 0x%8.8x)",
+                       (uint64_t)so_addrs.size(), resolve_scope);
+
+    sc_list.resize (so_addrs.size());
+    resolved_list.assign (so_addrs.size(), 0);
+
+    // Only look up the addresses that are in this module
+    std::vector<size_t> module_addr_idxs;
+    std::vector<Address> module_addrs;
+    for (size_t i = 0; i < so_addrs.size(); ++i)
+    {
+        // Clear the result symbol context in case we don't find anything, but don't clear the target
+        sc_list[i].Clear(false);
+        SectionSP section_sp (so_addrs[i].GetSection());
+        if (section_sp && section_sp->GetModule().get() == this)
+        {
+            sc_list[i].module_sp = shared_from_this();
+            resolved_list[i] = eSymbolContextModule;
+            module_addr_idxs.push_back (i);
+            module_addrs.push_back (so_addrs[i]);
+        }
+    }
+
+    SymbolVendor* sym_vendor = GetSymbolVendor();
+    if (module_addrs.empty() || !sym_vendor)
+        return module_addrs.size();
+
+    // Resolve the compile unit, function, block, line table or line
+    // entry if requested, all in one go so the symbol file can share
+    // its work between them
+    if (resolve_scope & eSymbolContextCompUnit    ||
+        resolve_scope & eSymbolContextFunction    ||
+        resolve_scope & eSymbolContextBlock       ||
+        resolve_scope & eSymbolContextLineEntry   )
+    {
+        std::vector<SymbolContext> module_sc_list;
+        module_sc_list.reserve (module_addr_idxs.size());
+        for (size_t idx : module_addr_idxs)
+            module_sc_list.push_back (sc_list[idx]);
+        std::vector<uint32_t> module_resolved_list;
+        sym_vendor->ResolveSymbolContexts (module_addrs, resolve_scope, module_sc_list, module_resolved_list);
+        for (size_t i = 0; i < module_addr_idxs.size(); ++i)
+        {
+            sc_list[module_addr_idxs[i]] = module_sc_list[i];
+            resolved_list[module_addr_idxs[i]] |= module_resolved_list[i];
+        }
+    }
+
+    // Resolve the symbol if requested, but don't re-look it up if we've already found it.
+    if (resolve_scope & eSymbolContextSymbol)
+    {
+        for (size_t idx : module_addr_idxs)
+        {
+            if (!(resolved_list[idx] & eSymbolContextSymbol))
+                resolved_list[idx] |= ResolveSymbolInSymtab (so_addrs[idx], resolve_scope, resolved_list[idx], *sym_vendor, sc_list[idx]);
+        }
+    }
+    return module_addrs.size();
+}
+
 uint32_t
 Module::ResolveSymbolContextForFilePath 
 (
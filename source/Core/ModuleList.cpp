@@ -13,6 +13,8 @@
 #include <stdint.h>
 
 // C++ Includes
+#include <algorithm>
+#include <map>
 #include <mutex> // std::once
 
 // Other libraries and framework includes
@@ -25,6 +27,7 @@
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/VariableList.h"
+#include "lldb/Utility/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -828,6 +831,77 @@ ModuleList::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t res
     return resolved_flags;
 }
 
+size_t
+ModuleList::ResolveSymbolContextsForAddresses (const std::vector<Address>& so_addrs,
+                                               uint32_t resolve_scope,
+                                               std::vector<SymbolContext>& sc_list,
+                                               std::vector<uint32_t>& resolved_list) const
+{
+    sc_list.resize (so_addrs.size());
+    resolved_list.assign (so_addrs.size(), 0);
+
+    // Group the addresses by module...
+    struct ModuleAddresses
+    {
+        ModuleSP module_sp;
+        std::vector<std::pair<addr_t, size_t>> file_addrs;  // File address and index in so_addrs
+    };
+    std::vector<ModuleAddresses> module_addrs;
+    std::map<Module *, size_t> module_to_idx;
+    for (size_t i = 0; i < so_addrs.size(); ++i)
+    {
+        ModuleSP module_sp (so_addrs[i].GetModule());
+        if (!module_sp)
+        {
+            sc_list[i].Clear(false);
+            continue;
+        }
+        auto insert_result = module_to_idx.insert (std::make_pair (module_sp.get(), module_addrs.size()));
+        if (insert_result.second)
+        {
+            module_addrs.push_back (ModuleAddresses());
+            module_addrs.back().module_sp = module_sp;
+        }
+        module_addrs[insert_result.first->second].file_addrs.push_back (std::make_pair (so_addrs[i].GetFileAddress(), i));
+    }
+
+    // ...and let each module resolve all of its addresses at once, in file
+    // address order. Each module has its own lock so they can be done in
+    // parallel. Resolving can index the module, which uses the task pool
+    // too; that is safe from a worker thread since TaskMapOverInt and
+    // TaskPool::RunTasks run the work no other worker started themselves.
+    auto resolve_module_addrs = [&so_addrs, &module_addrs, resolve_scope, &sc_list, &resolved_list](size_t module_idx)
+    {
+        ModuleAddresses &addrs = module_addrs[module_idx];
+        std::stable_sort (addrs.file_addrs.begin(), addrs.file_addrs.end(),
+                          [](const std::pair<addr_t, size_t> &lhs, const std::pair<addr_t, size_t> &rhs) { return lhs.first < rhs.first; });
+
+        std::vector<Address> sorted_addrs;
+        std::vector<SymbolContext> sorted_sc_list;
+        sorted_addrs.reserve (addrs.file_addrs.size());
+        sorted_sc_list.reserve (addrs.file_addrs.size());
+        for (const auto &file_addr : addrs.file_addrs)
+        {
+            sorted_addrs.push_back (so_addrs[file_addr.second]);
+            sorted_sc_list.push_back (sc_list[file_addr.second]);
+        }
+
+        std::vector<uint32_t> sorted_resolved_list;
+        addrs.module_sp->ResolveSymbolContextsForAddresses (sorted_addrs, resolve_scope, sorted_sc_list, sorted_resolved_list);
+        for (size_t i = 0; i < addrs.file_addrs.size(); ++i)
+        {
+            sc_list[addrs.file_addrs[i].second] = sorted_sc_list[i];
+            resolved_list[addrs.file_addrs[i].second] = sorted_resolved_list[i];
+        }
+    };
+    if (module_addrs.size() > 1)
+        TaskMapOverInt (0, module_addrs.size(), resolve_module_addrs);
+    else if (module_addrs.size() == 1)
+        resolve_module_addrs (0);
+
+    return so_addrs.size() - std::count (resolved_list.begin(), resolved_list.end(), 0u);
+}
+
 uint32_t
 ModuleList::ResolveSymbolContextForFilePath 
 (
@@ -810,6 +810,10 @@ IRExecutionUnit::CommitAllocations (lldb::ProcessSP &process_sp)
         case lldb::eSectionTypeDWARFAppleTypes:
         case lldb::eSectionTypeDWARFAppleNamespaces:
         case lldb::eSectionTypeDWARFAppleObjC:
+        case lldb::eSectionTypeDWARFGDBIndex:
+        case lldb::eSectionTypeDWARFDebugAddr:
+        case lldb::eSectionTypeDWARFDebugStrOffsets:
+        case lldb::eSectionTypeDWARFDebugCUIndex:
             err.Clear();
             break;
         default:
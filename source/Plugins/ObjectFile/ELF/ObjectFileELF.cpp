@@ -1565,6 +1565,10 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             static ConstString g_sect_name_dwarf_debug_ranges (".debug_ranges");
             static ConstString g_sect_name_dwarf_debug_str (".debug_str");
             static ConstString g_sect_name_eh_frame (".eh_frame");
+            static ConstString g_sect_name_gdb_index (".gdb_index");
+            static ConstString g_sect_name_dwarf_debug_addr (".debug_addr");
+            static ConstString g_sect_name_dwarf_debug_str_offsets (".debug_str_offsets");
+            static ConstString g_sect_name_dwarf_debug_cu_index (".debug_cu_index");
 
             SectionType sect_type = eSectionTypeOther;
 
@@ -1595,8 +1599,13 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             // .debug_ranges – Address ranges used in DW_AT_ranges attributes
             // .debug_str – String table used in .debug_info
             // MISSING? .gnu_debugdata - "mini debuginfo / MiniDebugInfo" section, http://sourceware.org/gdb/onlinedocs/gdb/MiniDebugInfo.html
-            // MISSING? .debug-index - http://src.chromium.org/viewvc/chrome/trunk/src/build/gdb-add-index?pathrev=144644
+            // .gdb_index - Name and address index created by gold, lld and gdb-add-index
             // MISSING? .debug_types - Type descriptions from DWARF 4? See http://gcc.gnu.org/wiki/DwarfSeparateTypeInfo
+            // .debug_addr – Address table used by split DWARF
+            // .debug_str_offsets – String offsets table used by split DWARF
+            // .debug_cu_index – Index of the compile units in a split DWARF package (.dwp)
+            // .debug_*.dwo – The sections of a split DWARF object (.dwo) or package (.dwp) file,
+            //                which are given the same types as the sections they replace
             else if (name == g_sect_name_dwarf_debug_abbrev)    sect_type = eSectionTypeDWARFDebugAbbrev;
             else if (name == g_sect_name_dwarf_debug_aranges)   sect_type = eSectionTypeDWARFDebugAranges;
             else if (name == g_sect_name_dwarf_debug_frame)     sect_type = eSectionTypeDWARFDebugFrame;
@@ -1609,6 +1618,20 @@ ObjectFileELF::CreateSections(SectionList &unified_section_list)
             else if (name == g_sect_name_dwarf_debug_ranges)    sect_type = eSectionTypeDWARFDebugRanges;
             else if (name == g_sect_name_dwarf_debug_str)       sect_type = eSectionTypeDWARFDebugStr;
             else if (name == g_sect_name_eh_frame)              sect_type = eSectionTypeEHFrame;
+            else if (name == g_sect_name_gdb_index)             sect_type = eSectionTypeDWARFGDBIndex;
+            else if (name == g_sect_name_dwarf_debug_addr)      sect_type = eSectionTypeDWARFDebugAddr;
+            else if (name == g_sect_name_dwarf_debug_str_offsets) sect_type = eSectionTypeDWARFDebugStrOffsets;
+            else if (name == g_sect_name_dwarf_debug_cu_index)  sect_type = eSectionTypeDWARFDebugCUIndex;
+            else if (name.GetStringRef().endswith(".dwo"))
+            {
+                const ConstString dwo_name (name.GetStringRef().drop_back(4));
+                if      (dwo_name == g_sect_name_dwarf_debug_abbrev)        sect_type = eSectionTypeDWARFDebugAbbrev;
+                else if (dwo_name == g_sect_name_dwarf_debug_info)          sect_type = eSectionTypeDWARFDebugInfo;
+                else if (dwo_name == g_sect_name_dwarf_debug_line)          sect_type = eSectionTypeDWARFDebugLine;
+                else if (dwo_name == g_sect_name_dwarf_debug_loc)           sect_type = eSectionTypeDWARFDebugLoc;
+                else if (dwo_name == g_sect_name_dwarf_debug_str)           sect_type = eSectionTypeDWARFDebugStr;
+                else if (dwo_name == g_sect_name_dwarf_debug_str_offsets)   sect_type = eSectionTypeDWARFDebugStrOffsets;
+            }
 
             switch (header.sh_type)
             {
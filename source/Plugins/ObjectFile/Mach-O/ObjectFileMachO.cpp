@@ -1322,6 +1322,10 @@ ObjectFileMachO::GetAddressClass (lldb::addr_t file_addr)
                     case eSectionTypeDWARFAppleTypes:
                     case eSectionTypeDWARFAppleNamespaces:
                     case eSectionTypeDWARFAppleObjC:
+                    case eSectionTypeDWARFGDBIndex:
+                    case eSectionTypeDWARFDebugAddr:
+                    case eSectionTypeDWARFDebugStrOffsets:
+                    case eSectionTypeDWARFDebugCUIndex:
                         return eAddressClassDebug;
 
                     case eSectionTypeEHFrame:
@@ -13,13 +13,17 @@
 
 // C Includes
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <string.h>
 #include <stdint.h>
 #include <unistd.h>
 
 // C++ Includes
+#include <algorithm>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <string>
 
 // Other libraries and framework includes
@@ -46,6 +50,7 @@
 #include "Plugins/Process/POSIX/ProcessPOSIXLog.h"
 #include "Plugins/Process/Utility/LinuxSignals.h"
 #include "Utility/StringExtractor.h"
+#include "NativeRegisterContextLinux_x86_64.h"
 #include "NativeThreadLinux.h"
 #include "ProcFileReader.h"
 #include "Procfs.h"
@@ -340,6 +345,94 @@ namespace
     }
 #endif
 
+    //------------------------------------------------------------------------------
+    // process_vm_readv moves a whole range of the inferior's memory with one
+    // syscall instead of one PTRACE_PEEKDATA per word, and it doesn't need to be
+    // called from the thread that is tracing the inferior. Older kernels and C
+    // libraries don't have it, so call it through syscall() and check once
+    // whether the running kernel supports it.
+
+    ssize_t
+    ProcessVmReadv (::pid_t pid, lldb::addr_t vm_addr, void *buf, size_t size)
+    {
+#if defined (__NR_process_vm_readv)
+        struct iovec local_iov;
+        struct iovec remote_iov;
+        local_iov.iov_base = buf;
+        local_iov.iov_len = size;
+        remote_iov.iov_base = reinterpret_cast<void *>(vm_addr);
+        remote_iov.iov_len = size;
+        return syscall (__NR_process_vm_readv, pid, &local_iov, 1, &remote_iov, 1, 0);
+#else
+        errno = ENOSYS;
+        return -1;
+#endif
+    }
+
+    bool
+    ProcessVmReadvSupported ()
+    {
+        static bool g_supported = false;
+        static std::once_flag g_once_flag;
+
+        std::call_once (g_once_flag, []() {
+            // Read a word of our own memory to see if the kernel knows the syscall.
+            uint32_t source = 0x47424742;
+            uint32_t dest = 0;
+            const ssize_t result = ProcessVmReadv (::getpid(), reinterpret_cast<lldb::addr_t>(&source), &dest, sizeof dest);
+            g_supported = result == sizeof dest && source == dest;
+
+            Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+            if (log)
+                log->Printf ("NativeProcessLinux::%s process_vm_readv is %s", __FUNCTION__,
+                        g_supported ? "supported" : "not supported, falling back to PTRACE_PEEKDATA");
+        });
+
+        return g_supported;
+    }
+
+    //------------------------------------------------------------------------------
+    // Writes to /proc/<pid>/mem go through the same forced access path in the
+    // kernel that PTRACE_POKEDATA uses, so unlike process_vm_writev they can also
+    // patch read-only pages such as the inferior's code. Any process allowed to
+    // ptrace the inferior may write there, from any thread.
+    //
+    // Returns the number of bytes written before the first failure.
+
+    lldb::addr_t
+    ProcMemWrite (lldb::pid_t pid, lldb::addr_t vm_addr, const void *buf, lldb::addr_t size, Error &error)
+    {
+        char mem_path[64];
+        ::snprintf (mem_path, sizeof mem_path, "/proc/%" PRIu64 "/mem", pid);
+        const int fd = ::open (mem_path, O_WRONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            error.SetErrorToErrno ();
+            return 0;
+        }
+
+        const unsigned char *src = static_cast<const unsigned char*>(buf);
+        lldb::addr_t bytes_written = 0;
+        while (bytes_written < size)
+        {
+            const ssize_t result = ::pwrite (fd, src + bytes_written, size - bytes_written, vm_addr + bytes_written);
+            if (result > 0)
+                bytes_written += result;
+            else if (result < 0 && errno == EINTR)
+                continue;
+            else
+            {
+                if (result < 0)
+                    error.SetErrorToErrno ();
+                else
+                    error.SetErrorString ("no bytes written");
+                break;
+            }
+        }
+        ::close (fd);
+        return bytes_written;
+    }
+
     //------------------------------------------------------------------------------
     // Static implementations of NativeProcessLinux::ReadMemory and
     // NativeProcessLinux::WriteMemory.  This enables mutual recursion between these
@@ -1100,9 +1193,11 @@ EnsureFDFlags(int fd, int flags)
 //   - SIGCHLD (delivered over a signalfd file descriptor): These signals notify us of events in
 //     the inferior process. Upon receiving this signal we do a waitpid to get more information
 //     and dispatch to NativeProcessLinux::MonitorCallback.
-//   - requests for ptrace operations: These initiated via the DoOperation method, which funnels
-//     them to the Monitor thread via m_operation member. The Monitor thread is signaled over a
-//     pipe, and the completion of the operation is signalled over the semaphore.
+//   - requests for ptrace operations: These initiated via the DoOperation and DoOperations
+//     methods, which queue them up for the Monitor thread in m_requests. Any number of threads
+//     can queue requests at the same time. The Monitor thread is signaled over a pipe, runs all
+//     queued requests in one go, and signals the completion of each request over the
+//     semaphore belonging to that request.
 //   - thread exit event: this is signaled from the Monitor destructor by closing the write end
 //     of the command pipe.
 class NativeProcessLinux::Monitor {
@@ -1118,11 +1213,22 @@ private:
     int        m_signal_fd = -1;
     HostThread m_thread;
 
-    // current operation which must be executed on the priviliged thread
-    Mutex      m_operation_mutex;
-    Operation *m_operation = nullptr;
-    sem_t      m_operation_sem;
-    Error      m_operation_error;
+    // A batch of operations which must be executed on the priviliged thread. The
+    // requesting thread owns the request and waits on "done" until all of the
+    // operations have been executed.
+    struct OperationRequest
+    {
+        Operation *const *operations;
+        size_t            num_operations;
+        sem_t             done;
+    };
+
+    // requests waiting to be picked up by the priviliged thread
+    Mutex                          m_requests_mutex;
+    std::deque<OperationRequest *> m_requests;
+
+    sem_t      m_initial_operation_sem;
+    Error      m_initial_operation_error;
 
     static constexpr char operation_command = 'o';
 
@@ -1136,21 +1242,24 @@ private:
     bool
     HandleCommands();
 
+    void
+    ExecuteRequests();
+
     void
     MainLoop();
 
     static void *
     RunMonitor(void *arg);
 
-    Error
-    WaitForOperation();
+    static Error
+    WaitForSemaphore(sem_t *sem);
 public:
     Monitor(const InitialOperation &initial_operation,
             NativeProcessLinux *native_process)
         : m_initial_operation_up(new InitialOperation(initial_operation)),
           m_native_process(native_process)
     {
-        sem_init(&m_operation_sem, 0, 0);
+        sem_init(&m_initial_operation_sem, 0, 0);
     }
 
     ~Monitor();
@@ -1160,6 +1269,10 @@ public:
 
     void
     DoOperation(Operation *op);
+
+    // Executes all of the operations in a single wake-up of the Monitor thread, in order.
+    void
+    DoOperations(Operation *const *ops, size_t num_ops);
 };
 constexpr char NativeProcessLinux::Monitor::operation_command;
 
@@ -1198,27 +1311,75 @@ NativeProcessLinux::Monitor::Initialize()
         return Error("Failed to create monitor thread for NativeProcessLinux.");
 
     // Wait for initial operation to complete.
-    return WaitForOperation();
+    Error wait_error = WaitForSemaphore(&m_initial_operation_sem);
+    if (wait_error.Fail())
+        return wait_error;
+    return m_initial_operation_error;
 }
 
 void
 NativeProcessLinux::Monitor::DoOperation(Operation *op)
 {
+    DoOperations(&op, 1);
+}
+
+void
+NativeProcessLinux::Monitor::DoOperations(Operation *const *ops, size_t num_ops)
+{
+    if (num_ops == 0)
+        return;
+
     if (m_thread.EqualsThread(pthread_self())) {
-        // If we're on the Monitor thread, we can simply execute the operation.
-        op->Execute(m_native_process);
+        // If we're on the Monitor thread, we can simply execute the operations.
+        for (size_t i = 0; i < num_ops; ++i)
+            ops[i]->Execute(m_native_process);
         return;
     }
 
-    // Otherwise we need to pass the operation to the Monitor thread so it can handle it.
-    Mutex::Locker lock(m_operation_mutex);
-
-    m_operation = op;
+    // Otherwise we need to pass the operations to the Monitor thread so it can handle them.
+    // The queue lock is only held while adding the request, so other threads can queue up
+    // their own requests while the Monitor thread is busy with this one.
+    OperationRequest request;
+    request.operations = ops;
+    request.num_operations = num_ops;
+    sem_init(&request.done, 0, 0);
+    {
+        Mutex::Locker lock(m_requests_mutex);
+        m_requests.push_back(&request);
+    }
 
     // notify the thread that an operation is ready to be processed
     write(m_pipefd[WRITE], &operation_command, sizeof operation_command);
 
-    WaitForOperation();
+    Error error = WaitForSemaphore(&request.done);
+    if (error.Fail())
+    {
+        Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+        if (log)
+            log->Printf("NativeProcessLinux::Monitor::%s waiting for the operations failed: %s",
+                    __FUNCTION__, error.AsCString());
+
+        // The request lives in this stack frame, so we must not return while the Monitor thread
+        // can still get to it. If it hasn't been picked up yet, take it back off the queue.
+        // Otherwise the Monitor thread is executing it and will post "done" when it's finished
+        // with it, so keep waiting for that.
+        bool still_queued = false;
+        {
+            Mutex::Locker lock(m_requests_mutex);
+            auto pos = std::find(m_requests.begin(), m_requests.end(), &request);
+            if (pos != m_requests.end())
+            {
+                m_requests.erase(pos);
+                still_queued = true;
+            }
+        }
+        if (!still_queued)
+        {
+            while (WaitForSemaphore(&request.done).Fail())
+                ;
+        }
+    }
+    sem_destroy(&request.done);
 }
 
 NativeProcessLinux::Monitor::~Monitor()
@@ -1231,7 +1392,7 @@ NativeProcessLinux::Monitor::~Monitor()
         close(m_pipefd[READ]);
     if (m_signal_fd >= 0)
         close(m_signal_fd);
-    sem_destroy(&m_operation_sem);
+    sem_destroy(&m_initial_operation_sem);
 }
 
 void
@@ -1362,10 +1523,9 @@ NativeProcessLinux::Monitor::HandleCommands()
         switch (command)
         {
         case operation_command:
-            m_operation->Execute(m_native_process);
-
-            // notify calling thread that operation is complete
-            sem_post(&m_operation_sem);
+            // A single wake-up may find several queued requests, in which case the
+            // command bytes of the other requests will find the queue empty.
+            ExecuteRequests();
             break;
         default:
             if (log)
@@ -1375,13 +1535,32 @@ NativeProcessLinux::Monitor::HandleCommands()
     }
 }
 
+void
+NativeProcessLinux::Monitor::ExecuteRequests()
+{
+    std::deque<OperationRequest *> requests;
+    {
+        Mutex::Locker lock(m_requests_mutex);
+        requests.swap(m_requests);
+    }
+
+    for (OperationRequest *request : requests)
+    {
+        for (size_t i = 0; i < request->num_operations; ++i)
+            request->operations[i]->Execute(m_native_process);
+
+        // notify calling thread that its operations are complete
+        sem_post(&request->done);
+    }
+}
+
 void
 NativeProcessLinux::Monitor::MainLoop()
 {
-    ::pid_t child_pid = (*m_initial_operation_up)(m_operation_error);
+    ::pid_t child_pid = (*m_initial_operation_up)(m_initial_operation_error);
     m_initial_operation_up.reset();
     m_child_pid = -getpgid(child_pid),
-    sem_post(&m_operation_sem);
+    sem_post(&m_initial_operation_sem);
 
     while (true)
     {
@@ -1416,10 +1595,10 @@ NativeProcessLinux::Monitor::MainLoop()
 }
 
 Error
-NativeProcessLinux::Monitor::WaitForOperation()
+NativeProcessLinux::Monitor::WaitForSemaphore(sem_t *sem)
 {
     Error error;
-    while (sem_wait(&m_operation_sem) != 0)
+    while (sem_wait(sem) != 0)
     {
         if (errno == EINTR)
             continue;
@@ -1428,7 +1607,7 @@ NativeProcessLinux::Monitor::WaitForOperation()
         return error;
     }
 
-    return m_operation_error;
+    return error;
 }
 
 void *
@@ -3354,6 +3533,49 @@ NativeProcessLinux::GetArchitecture (ArchSpec &arch) const
     return true;
 }
 
+void
+NativeProcessLinux::PrefetchThreadRegisters ()
+{
+    // Only the x86 register context answers register reads from its GPR buffer.
+    switch (m_arch.GetMachine ())
+    {
+        case llvm::Triple::x86:
+        case llvm::Triple::x86_64:
+            break;
+        default:
+            return;
+    }
+
+    // Don't hold the threads mutex while we wait for the monitor thread: it
+    // takes the same mutex while it handles inferior events.
+    std::vector<NativeRegisterContextSP> reg_ctxs;
+    {
+        Mutex::Locker locker (m_threads_mutex);
+        for (auto thread_sp : m_threads)
+        {
+            NativeRegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext ();
+            if (reg_ctx_sp)
+                reg_ctxs.push_back (reg_ctx_sp);
+        }
+    }
+
+    std::vector<GPRReadRequest> requests;
+    requests.reserve (reg_ctxs.size ());
+    for (const auto &reg_ctx_sp : reg_ctxs)
+    {
+        auto reg_ctx = static_cast<NativeRegisterContextLinux_x86_64 *> (reg_ctx_sp.get ());
+        requests.push_back ({ reg_ctx->GetThreadID (), reg_ctx->GetGPRBuffer (), reg_ctx->GetGPRSize (), Error () });
+    }
+
+    ReadGPRs (requests);
+
+    for (size_t i = 0; i < requests.size (); ++i)
+    {
+        if (requests[i].error.Success ())
+            static_cast<NativeRegisterContextLinux_x86_64 *> (reg_ctxs[i].get ())->SetGPRBufferValid ();
+    }
+}
+
 Error
 NativeProcessLinux::GetSoftwareBreakpointPCOffset (NativeRegisterContextSP context_sp, uint32_t &actual_opcode_size)
 {
@@ -3606,16 +3828,74 @@ NativeProcessLinux::GetCrashReasonForSIGBUS(const siginfo_t *info)
 Error
 NativeProcessLinux::ReadMemory (lldb::addr_t addr, void *buf, lldb::addr_t size, lldb::addr_t &bytes_read)
 {
-    ReadOperation op(addr, buf, size, bytes_read);
-    m_monitor_up->DoOperation(&op);
-    return op.GetError ();
+    if (!ProcessVmReadvSupported ())
+    {
+        ReadOperation op(addr, buf, size, bytes_read);
+        m_monitor_up->DoOperation(&op);
+        return op.GetError ();
+    }
+
+    Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+    static const lldb::addr_t page_size = ::sysconf (_SC_PAGESIZE);
+    unsigned char *dst = static_cast<unsigned char*>(buf);
+
+    bytes_read = 0;
+    while (bytes_read < size)
+    {
+        // The kernel copies everything up to the first page it can't read in
+        // one go, no need to funnel this through the monitor thread.
+        const ssize_t result = ProcessVmReadv (GetID (), addr + bytes_read, dst + bytes_read, size - bytes_read);
+        if (result > 0)
+        {
+            bytes_read += result;
+            continue;
+        }
+
+        // process_vm_readv won't read pages the inferior itself can't read (e.g.
+        // execute only code) which PTRACE_PEEKDATA can still get at, so fall back
+        // to ptrace for the remainder of the current page only.
+        const lldb::addr_t page_addr = addr + bytes_read;
+        const lldb::addr_t page_bytes = std::min<lldb::addr_t> (size - bytes_read, page_size - (page_addr % page_size));
+        if (log)
+            log->Printf ("NativeProcessLinux::%s process_vm_readv failed at 0x%" PRIx64 ": %s, using PTRACE_PEEKDATA for %" PRIu64 " bytes",
+                    __FUNCTION__, page_addr, strerror (errno), page_bytes);
+
+        lldb::addr_t page_bytes_read = 0;
+        ReadOperation op(page_addr, dst + bytes_read, page_bytes, page_bytes_read);
+        m_monitor_up->DoOperation(&op);
+        bytes_read += page_bytes_read;
+        if (op.GetError ().Fail ())
+            return op.GetError ();
+    }
+    return Error ();
 }
 
 Error
 NativeProcessLinux::WriteMemory (lldb::addr_t addr, const void *buf, lldb::addr_t size, lldb::addr_t &bytes_written)
 {
-    WriteOperation op(addr, buf, size, bytes_written);
+    bytes_written = 0;
+
+    // Writes of up to a word (e.g. breakpoint opcodes) are a single
+    // PTRACE_POKEDATA anyway, only bigger ones are worth opening the mem file for.
+    if (size > sizeof(void*))
+    {
+        Error error;
+        bytes_written = ProcMemWrite (GetID (), addr, buf, size, error);
+        if (bytes_written == size)
+            return error;
+
+        Log *log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_MEMORY));
+        if (log)
+            log->Printf ("NativeProcessLinux::%s writing /proc/%" PRIu64 "/mem failed after %" PRIu64 " of %" PRIu64 " bytes: %s, using PTRACE_POKEDATA for the rest",
+                    __FUNCTION__, GetID (), bytes_written, size, error.AsCString ());
+    }
+
+    // Write whatever is left a word at a time on the monitor thread, and
+    // report the total number of bytes that made it into the inferior.
+    lldb::addr_t remainder_written = 0;
+    WriteOperation op(addr + bytes_written, static_cast<const unsigned char*>(buf) + bytes_written, size - bytes_written, remainder_written);
     m_monitor_up->DoOperation(&op);
+    bytes_written += remainder_written;
     return op.GetError ();
 }
 
@@ -3645,6 +3925,25 @@ NativeProcessLinux::ReadGPR(lldb::tid_t tid, void *buf, size_t buf_size)
     return op.GetError();
 }
 
+void
+NativeProcessLinux::ReadGPRs(std::vector<GPRReadRequest> &requests)
+{
+    std::vector<std::unique_ptr<ReadGPROperation>> ops;
+    std::vector<Operation *> op_ptrs;
+    ops.reserve(requests.size());
+    op_ptrs.reserve(requests.size());
+    for (const GPRReadRequest &request : requests)
+    {
+        ops.emplace_back(new ReadGPROperation(request.tid, request.buf, request.buf_size));
+        op_ptrs.push_back(ops.back().get());
+    }
+
+    m_monitor_up->DoOperations(op_ptrs.data(), op_ptrs.size());
+
+    for (size_t i = 0; i < requests.size(); ++i)
+        requests[i].error = ops[i]->GetError();
+}
+
 Error
 NativeProcessLinux::ReadFPR(lldb::tid_t tid, void *buf, size_t buf_size)
 {
@@ -16,6 +16,7 @@
 
 // C++ Includes
 #include <unordered_set>
+#include <vector>
 
 // Other libraries and framework includes
 #include "lldb/Core/ArchSpec.h"
@@ -104,6 +105,9 @@ namespace process_linux {
         bool
         GetArchitecture (ArchSpec &arch) const override;
 
+        void
+        PrefetchThreadRegisters () override;
+
         Error
         SetBreakpoint (lldb::addr_t addr, uint32_t size, bool hardware) override;
 
@@ -137,6 +141,20 @@ namespace process_linux {
         Error
         ReadGPR(lldb::tid_t tid, void *buf, size_t buf_size);
 
+        struct GPRReadRequest
+        {
+            lldb::tid_t tid;
+            void *buf;
+            size_t buf_size;
+            Error error;
+        };
+
+        /// Reads the general purpose registers of several threads with a
+        /// single round trip to the monitor thread. The result of each read
+        /// is returned in the error of its request.
+        void
+        ReadGPRs(std::vector<GPRReadRequest> &requests);
+
         /// Reads generic floating point registers into the specified buffer.
         Error
         ReadFPR(lldb::tid_t tid, void *buf, size_t buf_size);
@@ -337,7 +337,8 @@ NativeRegisterContextLinux_x86_64::NativeRegisterContextLinux_x86_64 (NativeThre
     m_iovec (),
     m_ymm_set (),
     m_reg_info (),
-    m_gpr_x86_64 ()
+    m_gpr_x86_64 (),
+    m_gpr_valid (false)
 {
     // Set up data about ranges of valid registers.
     switch (reg_info_interface_p->GetTargetArchitecture ().GetMachine ())
@@ -461,6 +462,16 @@ NativeRegisterContextLinux_x86_64::ReadRegisterRaw (uint32_t reg_index, Register
         return error;
     }
 
+    if (m_gpr_valid && IsGPR (reg_index) &&
+        reg_info->byte_offset + sizeof (unsigned long) <= GetGPRSize ())
+    {
+        // Same result as the PTRACE_PEEKUSER below, without the round trip to the monitor thread.
+        unsigned long data;
+        ::memcpy (&data, reinterpret_cast<const uint8_t *> (&m_gpr_x86_64) + reg_info->byte_offset, sizeof data);
+        reg_value = static_cast<lldb::addr_t> (data);
+        return error;
+    }
+
     NativeProcessLinux *const process_p = reinterpret_cast<NativeProcessLinux*> (process_sp.get ());
     return process_p->ReadRegisterValue(m_thread.GetID(),
                                         reg_info->byte_offset,
@@ -645,6 +656,9 @@ NativeRegisterContextLinux_x86_64::WriteRegister(const uint32_t reg,
         return error;
     }
 
+    // The GPR buffer no longer matches the thread.
+    m_gpr_valid = false;
+
     NativeProcessLinux *const process_p = reinterpret_cast<NativeProcessLinux*> (process_sp.get ());
     return process_p->WriteRegisterValue(m_thread.GetID(),
                                          register_to_write_info_p->byte_offset,
@@ -878,6 +892,18 @@ NativeRegisterContextLinux_x86_64::GetByteOrder() const
     return byte_order;
 }
 
+void
+NativeRegisterContextLinux_x86_64::InvalidateAllRegisters ()
+{
+    m_gpr_valid = false;
+}
+
+size_t
+NativeRegisterContextLinux_x86_64::GetGPRSize () const
+{
+    return GetRegisterInfoInterface ().GetGPRSize ();
+}
+
 bool
 NativeRegisterContextLinux_x86_64::IsGPR(uint32_t reg_index) const
 {
@@ -1042,6 +1068,9 @@ NativeRegisterContextLinux_x86_64::WriteGPR()
     NativeProcessProtocolSP process_sp (m_thread.GetProcess ());
     if (!process_sp)
         return false;
+
+    // If the write fails we can't tell what the thread's GPRs are.
+    m_gpr_valid = false;
     NativeProcessLinux *const process_p = reinterpret_cast<NativeProcessLinux*> (process_sp.get ());
 
     return process_p->WriteGPR (m_thread.GetID (), &m_gpr_x86_64, GetRegisterInfoInterface ().GetGPRSize ()).Success();
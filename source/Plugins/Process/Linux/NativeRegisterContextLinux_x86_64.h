@@ -75,6 +75,28 @@ namespace process_linux {
         uint32_t
         NumSupportedHardwareWatchpoints() override;
 
+        void
+        InvalidateAllRegisters () override;
+
+        // NativeProcessLinux::PrefetchThreadRegisters() reads the GPRs of all
+        // threads into these buffers at once, and marks the ones it filled in
+        // as valid. GPR reads are then answered from the buffer until the
+        // thread resumes or one of its GPRs is written.
+        void *
+        GetGPRBuffer ()
+        {
+            return &m_gpr_x86_64;
+        }
+
+        size_t
+        GetGPRSize () const;
+
+        void
+        SetGPRBufferValid ()
+        {
+            m_gpr_valid = true;
+        }
+
     private:
 
         // Private member types.
@@ -117,6 +139,7 @@ namespace process_linux {
         YMM m_ymm_set;
         RegInfo m_reg_info;
         uint64_t m_gpr_x86_64[k_num_gpr_registers_x86_64];
+        bool m_gpr_valid;
 
         // Private member methods.
         Error
@@ -323,6 +323,10 @@ NativeThreadLinux::SetRunning ()
     m_stop_info.reason = StopReason::eStopReasonNone;
     m_stop_description.clear();
 
+    // Whatever registers the context has cached are about to change.
+    if (m_reg_context_sp)
+        m_reg_context_sp->InvalidateAllRegisters ();
+
     // If watchpoints have been set, but none on this thread,
     // then this is a new thread. So set all existing watchpoints.
     if (m_watchpoint_index_map.empty())
@@ -350,6 +354,9 @@ NativeThreadLinux::SetStepping ()
     m_state = new_state;
 
     m_stop_info.reason = StopReason::eStopReasonNone;
+
+    if (m_reg_context_sp)
+        m_reg_context_sp->InvalidateAllRegisters ();
 }
 
 void
@@ -131,7 +131,6 @@ RegisterContextLLDB::IsUnwindPlanValidForCurrentPC(lldb::UnwindPlanSP unwind_pla
 void
 RegisterContextLLDB::InitializeZerothFrame()
 {
-    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
     ExecutionContext exe_ctx(m_thread.shared_from_this());
     RegisterContextSP reg_ctx_sp = m_thread.GetRegisterContext();
 
@@ -172,6 +171,56 @@ RegisterContextLLDB::InitializeZerothFrame()
         UnwindLogMsg ("using architectural default unwind method");
     }
 
+    // Frames at the same pc were unwound the same way the last time
+    UnwindPlan::RowSP active_row;
+    lldb::RegisterKind row_register_kind = eRegisterKindGeneric;
+    UnwindTable *unwind_table = pc_module_sp && pc_module_sp->GetObjectFile() ? &pc_module_sp->GetObjectFile()->GetUnwindTable() : NULL;
+    const addr_t pc_file_addr = m_current_pc.GetFileAddress();
+    UnwindTable::ResolvedFrameSP resolved_frame_sp;
+    if (unwind_table)
+        resolved_frame_sp = unwind_table->FindResolvedFrame (pc_file_addr, true, process->GetUniqueID());
+    if (resolved_frame_sp)
+    {
+        UseResolvedFrame (*resolved_frame_sp, current_pc, pc_module_sp, active_row, row_register_kind);
+    }
+    else
+    {
+        if (!ResolveZerothFrame (current_pc, pc_module_sp, active_row, row_register_kind))
+        {
+            UnwindLogMsg ("could not find an unwindplan row for this frame's pc");
+            m_frame_type = eNotAValidFrame;
+            return;
+        }
+        if (unwind_table && m_sym_ctx_valid)
+            unwind_table->AddResolvedFrame (pc_file_addr, true, MakeResolvedFrame (false, active_row, row_register_kind));
+    }
+
+    if (!ReadCFAValueForRow (row_register_kind, active_row, m_cfa))
+    {
+        UnwindLogMsg ("could not read CFA register for this frame.");
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64 " using %s UnwindPlan",
+            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()),
+            (uint64_t) m_cfa,
+            m_full_unwind_plan_sp->GetSourceName().GetCString());
+}
+
+// Look up the symbol for the pc of the zeroth frame, find the start of its function and pick the
+// UnwindPlans to use for it and the row of the full UnwindPlan for the pc.
+
+bool
+RegisterContextLLDB::ResolveZerothFrame (addr_t current_pc,
+                                         const ModuleSP &pc_module_sp,
+                                         UnwindPlan::RowSP &active_row,
+                                         RegisterKind &row_register_kind)
+{
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+    Process *process = exe_ctx.GetProcessPtr();
+
     // We require either a symbol or function in the symbols context to be successfully
     // filled in or this context is of no use to us.
     const uint32_t resolve_scope = eSymbolContextFunction | eSymbolContextSymbol;
@@ -240,8 +289,6 @@ RegisterContextLLDB::InitializeZerothFrame()
     m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
     m_full_unwind_plan_sp = GetFullUnwindPlanForFrame ();
 
-    UnwindPlan::RowSP active_row;
-    lldb::RegisterKind row_register_kind = eRegisterKindGeneric;
     if (m_full_unwind_plan_sp && m_full_unwind_plan_sp->PlanValidAtAddress (m_current_pc))
     {
         active_row = m_full_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
@@ -254,25 +301,7 @@ RegisterContextLLDB::InitializeZerothFrame()
         }
     }
 
-    if (!active_row.get())
-    {
-        UnwindLogMsg ("could not find an unwindplan row for this frame's pc");
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-
-
-    if (!ReadCFAValueForRow (row_register_kind, active_row, m_cfa))
-    {
-        UnwindLogMsg ("could not read CFA register for this frame.");
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-
-    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64 " using %s UnwindPlan",
-            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()),
-            (uint64_t) m_cfa,
-            m_full_unwind_plan_sp->GetSourceName().GetCString());
+    return active_row.get() != NULL;
 }
 
 // Initialize a RegisterContextLLDB for the non-zeroth frame -- rely on the RegisterContextLLDB "below" it
@@ -446,6 +475,76 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         return;
     }
 
+    // Frames at the same pc were unwound the same way the last time,
+    // unless the frame below was interrupted rather than making a call
+    UnwindPlan::RowSP active_row;
+    RegisterKind row_register_kind = eRegisterKindGeneric;
+    UnwindTable *unwind_table = NULL;
+    const addr_t pc_file_addr = m_current_pc.GetFileAddress();
+    UnwindTable::ResolvedFrameSP resolved_frame_sp;
+    if (GetNextFrame()->m_frame_type != eTrapHandlerFrame &&
+        GetNextFrame()->m_frame_type != eDebuggerFrame &&
+        pc_module_sp->GetObjectFile())
+    {
+        unwind_table = &pc_module_sp->GetObjectFile()->GetUnwindTable();
+        resolved_frame_sp = unwind_table->FindResolvedFrame (pc_file_addr, false, process->GetUniqueID());
+    }
+    if (resolved_frame_sp)
+    {
+        UseResolvedFrame (*resolved_frame_sp, pc, pc_module_sp, active_row, row_register_kind);
+    }
+    else
+    {
+        if (!ResolveNonZerothFrame (pc, pc_module_sp, active_row, row_register_kind))
+        {
+            m_frame_type = eNotAValidFrame;
+            UnwindLogMsg ("could not find unwind row for this pc");
+            return;
+        }
+        if (unwind_table && m_sym_ctx_valid)
+        {
+            const bool pc_backed_up = m_current_pc.GetFileAddress() != pc_file_addr;
+            unwind_table->AddResolvedFrame (pc_file_addr, false, MakeResolvedFrame (pc_backed_up, active_row, row_register_kind));
+        }
+    }
+
+    if (!ReadCFAValueForRow (row_register_kind, active_row, m_cfa))
+    {
+        UnwindLogMsg ("failed to get cfa");
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    UnwindLogMsg ("m_cfa = 0x%" PRIx64, m_cfa);
+
+    if (CheckIfLoopingStack ())
+    {
+        TryFallbackUnwindPlan();
+        if (CheckIfLoopingStack ())
+        {
+            UnwindLogMsg ("same CFA address as next frame, assuming the unwind is looping - stopping");
+            m_frame_type = eNotAValidFrame;
+            return;
+        }
+    }
+
+    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64,
+            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()), (uint64_t) m_cfa);
+}
+
+// Look up the symbol for the pc of a non-zeroth frame, find the start of its function and pick the
+// UnwindPlans to use for it and the row of the UnwindPlan for the pc.
+
+bool
+RegisterContextLLDB::ResolveNonZerothFrame (addr_t pc,
+                                            const ModuleSP &pc_module_sp,
+                                            UnwindPlan::RowSP &active_row,
+                                            RegisterKind &row_register_kind)
+{
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+    Process *process = exe_ctx.GetProcessPtr();
+
     bool resolve_tail_call_address = true; // m_current_pc can be one past the address range of the function...
                                            // This will handle the case where the saved pc does not point to 
                                            // a function/symbol because it is beyond the bounds of the correct
@@ -565,9 +664,6 @@ RegisterContextLLDB::InitializeNonZerothFrame()
     // We've set m_frame_type and m_sym_ctx before this call.
     m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
 
-    UnwindPlan::RowSP active_row;
-    RegisterKind row_register_kind = eRegisterKindGeneric;
-
     // Try to get by with just the fast UnwindPlan if possible - the full UnwindPlan may be expensive to get
     // (e.g. if we have to parse the entire eh_frame section of an ObjectFile for the first time.)
 
@@ -599,35 +695,64 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         }
     }
 
-    if (!active_row.get())
-    {
-        m_frame_type = eNotAValidFrame;
-        UnwindLogMsg ("could not find unwind row for this pc");
-        return;
-    }
-
-    if (!ReadCFAValueForRow (row_register_kind, active_row, m_cfa))
-    {
-        UnwindLogMsg ("failed to get cfa");
-        m_frame_type = eNotAValidFrame;
-        return;
-    }
-
-    UnwindLogMsg ("m_cfa = 0x%" PRIx64, m_cfa);
+    return active_row.get() != NULL;
+}
 
-    if (CheckIfLoopingStack ())
-    {
-        TryFallbackUnwindPlan();
-        if (CheckIfLoopingStack ())
-        {
-            UnwindLogMsg ("same CFA address as next frame, assuming the unwind is looping - stopping");
-            m_frame_type = eNotAValidFrame;
-            return;
-        }
-    }
+void
+RegisterContextLLDB::UseResolvedFrame (const UnwindTable::ResolvedFrame &resolved_frame,
+                                       addr_t pc,
+                                       const ModuleSP &pc_module_sp,
+                                       UnwindPlan::RowSP &active_row,
+                                       RegisterKind &row_register_kind)
+{
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+    m_sym_ctx = resolved_frame.sym_ctx;
+    m_sym_ctx.module_sp = pc_module_sp;
+    m_sym_ctx.target_sp = exe_ctx.GetTargetSP();
+    m_sym_ctx_valid = resolved_frame.sym_ctx_valid;
+    m_frame_type = resolved_frame.is_trap_handler ? eTrapHandlerFrame : eNormalFrame;
+    m_start_pc = resolved_frame.start_pc;
+    m_current_offset = resolved_frame.current_offset;
+    m_current_offset_backed_up_one = resolved_frame.current_offset_backed_up_one;
+    if (resolved_frame.pc_backed_up)
+    {
+        m_current_pc.SetLoadAddress (pc - 1, exe_ctx.GetTargetPtr());
+    }
+    m_fast_unwind_plan_sp = resolved_frame.fast_unwind_plan_sp;
+    m_full_unwind_plan_sp = resolved_frame.full_unwind_plan_sp;
+    m_fallback_unwind_plan_sp = resolved_frame.fallback_unwind_plan_sp;
+    active_row = resolved_frame.active_row;
+    row_register_kind = resolved_frame.row_register_kind;
+
+    UnwindLogMsg ("with pc value of 0x%" PRIx64 ", reusing the unwind of '%s' for this pc",
+                  pc, GetSymbolOrFunctionName(m_sym_ctx).AsCString(""));
+}
 
-    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64,
-            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()), (uint64_t) m_cfa);
+UnwindTable::ResolvedFrameSP
+RegisterContextLLDB::MakeResolvedFrame (bool pc_backed_up,
+                                        const UnwindPlan::RowSP &active_row,
+                                        RegisterKind row_register_kind)
+{
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+    UnwindTable::ResolvedFrame *resolved_frame = new UnwindTable::ResolvedFrame();
+    resolved_frame->process_unique_id = exe_ctx.GetProcessRef().GetUniqueID();
+    // The UnwindTable belongs to the module, so holding on to the module
+    // or the target here would keep them alive forever.
+    resolved_frame->sym_ctx = m_sym_ctx;
+    resolved_frame->sym_ctx.module_sp.reset();
+    resolved_frame->sym_ctx.target_sp.reset();
+    resolved_frame->sym_ctx_valid = m_sym_ctx_valid;
+    resolved_frame->is_trap_handler = m_frame_type == eTrapHandlerFrame;
+    resolved_frame->pc_backed_up = pc_backed_up;
+    resolved_frame->start_pc = m_start_pc;
+    resolved_frame->current_offset = m_current_offset;
+    resolved_frame->current_offset_backed_up_one = m_current_offset_backed_up_one;
+    resolved_frame->fast_unwind_plan_sp = m_fast_unwind_plan_sp;
+    resolved_frame->full_unwind_plan_sp = m_full_unwind_plan_sp;
+    resolved_frame->fallback_unwind_plan_sp = m_fallback_unwind_plan_sp;
+    resolved_frame->active_row = active_row;
+    resolved_frame->row_register_kind = row_register_kind;
+    return UnwindTable::ResolvedFrameSP (resolved_frame);
 }
 
 bool
@@ -15,6 +15,7 @@
 #include "lldb/lldb-private.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Utility/RegisterNumber.h"
 #include "UnwindLLDB.h"
@@ -116,6 +117,33 @@ private:
     void
     InitializeNonZerothFrame();
 
+    // Look up the symbol of the frame's pc and pick the UnwindPlans and
+    // the row to unwind it with. Returns false if there is no row for it.
+    bool
+    ResolveZerothFrame (lldb::addr_t current_pc,
+                        const lldb::ModuleSP &pc_module_sp,
+                        lldb_private::UnwindPlan::RowSP &active_row,
+                        lldb::RegisterKind &row_register_kind);
+
+    bool
+    ResolveNonZerothFrame (lldb::addr_t pc,
+                           const lldb::ModuleSP &pc_module_sp,
+                           lldb_private::UnwindPlan::RowSP &active_row,
+                           lldb::RegisterKind &row_register_kind);
+
+    // Set the frame up the way an earlier frame at the same pc was
+    void
+    UseResolvedFrame (const lldb_private::UnwindTable::ResolvedFrame &resolved_frame,
+                      lldb::addr_t pc,
+                      const lldb::ModuleSP &pc_module_sp,
+                      lldb_private::UnwindPlan::RowSP &active_row,
+                      lldb::RegisterKind &row_register_kind);
+
+    lldb_private::UnwindTable::ResolvedFrameSP
+    MakeResolvedFrame (bool pc_backed_up,
+                       const lldb_private::UnwindPlan::RowSP &active_row,
+                       lldb::RegisterKind row_register_kind);
+
     SharedPtr
     GetNextFrame () const;
 
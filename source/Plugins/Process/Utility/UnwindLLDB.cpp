@@ -7,12 +7,18 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Target/ABI.h"
+#include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Process.h"
@@ -98,6 +104,14 @@ UnwindLLDB::AddFirstFrame ()
     if (!reg_ctx_sp->IsValid())
         goto unwind_done;
 
+    // The memory cache was flushed when the thread last ran, so read the
+    // stack that the frames are likely to be found in all at once
+    {
+        ProcessSP process_sp (m_thread.GetProcess());
+        if (process_sp)
+            process_sp->PrefetchStackMemory (reg_ctx_sp->GetSP (LLDB_INVALID_ADDRESS));
+    }
+
     if (!reg_ctx_sp->GetCFA (first_cursor_sp->cfa))
         goto unwind_done;
 
@@ -413,3 +427,290 @@ UnwindLLDB::SearchForSavedLocationForRegister (uint32_t lldb_regnum, lldb_privat
     }
     return false;
 }
+
+namespace {
+
+// A copy of the stack that a raw backtrace reads saved registers from,
+// so that the unwind makes a few large reads instead of one per frame
+class StackSnapshot
+{
+public:
+    StackSnapshot (Process &process, addr_t sp, size_t initial_size) :
+        m_process (process),
+        m_base (sp),
+        m_data (),
+        m_initial_size (std::max<size_t> (initial_size, 4096)),
+        m_complete (false)
+    {
+    }
+
+    bool
+    ReadPointer (addr_t addr, addr_t &value)
+    {
+        const uint32_t addr_size = m_process.GetAddressByteSize();
+        if (addr < m_base || (addr + addr_size > m_base + m_data.size() && !Extend (addr + addr_size)))
+        {
+            // Not in the stack being copied, e.g. a dereferenced CFA
+            Error error;
+            value = m_process.ReadPointerFromMemory (addr, error);
+            return error.Success();
+        }
+        DataExtractor data (&m_data[0], m_data.size(), m_process.GetByteOrder(), addr_size);
+        lldb::offset_t offset = addr - m_base;
+        value = data.GetPointer (&offset);
+        return true;
+    }
+
+private:
+    // The most stack to copy, anything above it is read directly
+    static const size_t kMaxSize = 8 * 1024 * 1024;
+
+    // Copy more of the stack so it reaches "end_addr"
+    bool
+    Extend (addr_t end_addr)
+    {
+        if (m_complete || end_addr - m_base > kMaxSize)
+            return false;
+
+        // Read twice as much as last time, so deep stacks take few reads
+        const size_t old_size = m_data.size();
+        size_t new_size = std::max<size_t> (std::max<size_t> (old_size * 2, m_initial_size), end_addr - m_base);
+        new_size = std::min (new_size, kMaxSize);
+        m_data.resize (new_size);
+
+        Error error;
+        size_t bytes_read = m_process.ReadMemoryFromInferior (m_base + old_size, &m_data[old_size], new_size - old_size, error);
+        if (bytes_read == 0)
+        {
+            // The read may have run past the end of the stack, and some
+            // processes fail the whole read if it does
+            const size_t needed_size = ((end_addr - m_base + 4095) & ~(addr_t)4095) - old_size;
+            if (needed_size < new_size - old_size)
+                bytes_read = m_process.ReadMemoryFromInferior (m_base + old_size, &m_data[old_size], needed_size, error);
+        }
+        m_data.resize (old_size + bytes_read);
+        if (m_data.size() < new_size)
+            m_complete = true;
+        return m_base + m_data.size() >= end_addr;
+    }
+
+    Process &m_process;
+    const addr_t m_base;
+    std::vector<uint8_t> m_data;
+    const size_t m_initial_size;
+    bool m_complete;    // The stack ends within m_data
+};
+
+// The registers a raw backtrace follows from frame to frame
+enum RawRegister
+{
+    eRawRegisterPC = 0,
+    eRawRegisterSP,
+    eRawRegisterFP,
+    eRawRegisterRA,
+    kNumRawRegisters
+};
+
+const uint32_t g_raw_register_generic_nums[kNumRawRegisters] =
+{
+    LLDB_REGNUM_GENERIC_PC,
+    LLDB_REGNUM_GENERIC_SP,
+    LLDB_REGNUM_GENERIC_FP,
+    LLDB_REGNUM_GENERIC_RA
+};
+
+struct RawFrame
+{
+    addr_t regs[kNumRawRegisters];  // LLDB_INVALID_ADDRESS if not known
+    addr_t cfa;                     // The CFA of the frame this one was unwound from
+};
+
+class RawUnwinder
+{
+public:
+    RawUnwinder (RegisterContext &reg_ctx, StackSnapshot &stack) :
+        m_reg_ctx (reg_ctx),
+        m_stack (stack)
+    {
+        for (uint32_t kind = 0; kind < kNumRegisterKinds; ++kind)
+            m_regnums_computed[kind] = false;
+    }
+
+    // Fill in "caller" by applying "row", in "register_kind" numbering,
+    // to "frame". Returns false if the row needs a register or memory
+    // that isn't known.
+    bool
+    UnwindFrame (const RawFrame &frame, UnwindPlan::Row &row, RegisterKind register_kind, RawFrame &caller)
+    {
+        if (register_kind >= kNumRegisterKinds)
+            return false;
+        const uint32_t *regnums = GetRegisterNumbers (register_kind);
+
+        UnwindPlan::Row::CFAValue &cfa_value = row.GetCFAValue();
+        const addr_t cfa_reg_value = GetRegisterValue (frame, regnums, cfa_value.GetRegisterNumber());
+        if (cfa_reg_value == LLDB_INVALID_ADDRESS)
+            return false;
+        if (cfa_value.IsRegisterPlusOffset())
+            caller.cfa = cfa_reg_value + cfa_value.GetOffset();
+        else if (!cfa_value.IsRegisterDereferenced() || !m_stack.ReadPointer (cfa_reg_value, caller.cfa))
+            return false;
+
+        for (uint32_t i = 0; i < kNumRawRegisters; ++i)
+            caller.regs[i] = GetCallerRegisterValue (frame, regnums, row, caller.cfa, (RawRegister)i);
+
+        // The caller's stack pointer is the CFA unless the row says otherwise
+        if (caller.regs[eRawRegisterSP] == frame.regs[eRawRegisterSP])
+            caller.regs[eRawRegisterSP] = caller.cfa;
+
+        // Where there is no rule for the pc, it is in the return address
+        // register, which is not preserved across the caller's own call
+        if (regnums[eRawRegisterPC] == LLDB_INVALID_REGNUM || !HasRule (row, regnums[eRawRegisterPC]))
+            caller.regs[eRawRegisterPC] = caller.regs[eRawRegisterRA];
+        caller.regs[eRawRegisterRA] = LLDB_INVALID_ADDRESS;
+        return caller.regs[eRawRegisterPC] != LLDB_INVALID_ADDRESS;
+    }
+
+private:
+    const uint32_t *
+    GetRegisterNumbers (RegisterKind register_kind)
+    {
+        uint32_t *regnums = m_regnums[register_kind];
+        if (!m_regnums_computed[register_kind])
+        {
+            for (uint32_t i = 0; i < kNumRawRegisters; ++i)
+            {
+                if (!m_reg_ctx.ConvertBetweenRegisterKinds (eRegisterKindGeneric, g_raw_register_generic_nums[i], register_kind, regnums[i]))
+                    regnums[i] = LLDB_INVALID_REGNUM;
+            }
+            m_regnums_computed[register_kind] = true;
+        }
+        return regnums;
+    }
+
+    static addr_t
+    GetRegisterValue (const RawFrame &frame, const uint32_t *regnums, uint32_t regnum)
+    {
+        if (regnum == LLDB_INVALID_REGNUM)
+            return LLDB_INVALID_ADDRESS;
+        for (uint32_t i = 0; i < kNumRawRegisters; ++i)
+        {
+            if (regnums[i] == regnum)
+                return frame.regs[i];
+        }
+        return LLDB_INVALID_ADDRESS;
+    }
+
+    static bool
+    HasRule (const UnwindPlan::Row &row, uint32_t regnum)
+    {
+        UnwindPlan::Row::RegisterLocation location;
+        return row.GetRegisterInfo (regnum, location) && !location.IsUnspecified();
+    }
+
+    addr_t
+    GetCallerRegisterValue (const RawFrame &frame, const uint32_t *regnums, const UnwindPlan::Row &row, addr_t cfa, RawRegister reg)
+    {
+        UnwindPlan::Row::RegisterLocation location;
+        if (regnums[reg] == LLDB_INVALID_REGNUM || !row.GetRegisterInfo (regnums[reg], location))
+            return frame.regs[reg];
+
+        addr_t value = LLDB_INVALID_ADDRESS;
+        switch (location.GetLocationType())
+        {
+            case UnwindPlan::Row::RegisterLocation::unspecified:
+            case UnwindPlan::Row::RegisterLocation::same:
+                return frame.regs[reg];
+            case UnwindPlan::Row::RegisterLocation::atCFAPlusOffset:
+                if (!m_stack.ReadPointer (cfa + location.GetOffset(), value))
+                    return LLDB_INVALID_ADDRESS;
+                return value;
+            case UnwindPlan::Row::RegisterLocation::isCFAPlusOffset:
+                return cfa + location.GetOffset();
+            case UnwindPlan::Row::RegisterLocation::inOtherRegister:
+                return GetRegisterValue (frame, regnums, location.GetRegisterNumber());
+            default:
+                // Undefined, or a DWARF expression which is not worth
+                // evaluating for a raw backtrace
+                return LLDB_INVALID_ADDRESS;
+        }
+    }
+
+    RegisterContext &m_reg_ctx;
+    StackSnapshot &m_stack;
+    uint32_t m_regnums[kNumRegisterKinds][kNumRawRegisters];
+    bool m_regnums_computed[kNumRegisterKinds];
+};
+
+}  // anonymous namespace
+
+uint32_t
+UnwindLLDB::DoGetRawBacktrace (std::vector<addr_t> &pcs, uint32_t max_frames)
+{
+    ProcessSP process_sp (m_thread.GetProcess());
+    RegisterContextSP reg_ctx_sp (m_thread.GetRegisterContext());
+    if (!process_sp || !reg_ctx_sp || max_frames == 0)
+        return 0;
+
+    Target &target = process_sp->GetTarget();
+    ABI *abi = process_sp->GetABI().get();
+
+    // Frames without compact unwind or eh_frame rows, such as JITted
+    // code, are assumed to follow the frame pointer chain
+    UnwindPlan default_plan (eRegisterKindGeneric);
+    UnwindPlan::RowSP default_row_sp;
+    if (abi && abi->CreateDefaultUnwindPlan (default_plan))
+        default_row_sp = default_plan.GetRowForFunctionOffset (0);
+
+    RawFrame frame;
+    for (uint32_t i = 0; i < kNumRawRegisters; ++i)
+    {
+        const uint32_t regnum = reg_ctx_sp->ConvertRegisterKindToRegisterNumber (eRegisterKindGeneric, g_raw_register_generic_nums[i]);
+        frame.regs[i] = regnum == LLDB_INVALID_REGNUM ? LLDB_INVALID_ADDRESS : reg_ctx_sp->ReadRegisterAsUnsigned (regnum, LLDB_INVALID_ADDRESS);
+    }
+    frame.cfa = LLDB_INVALID_ADDRESS;
+    if (frame.regs[eRawRegisterPC] == LLDB_INVALID_ADDRESS || frame.regs[eRawRegisterSP] == LLDB_INVALID_ADDRESS)
+        return 0;
+
+    StackSnapshot stack (*process_sp, frame.regs[eRawRegisterSP], process_sp->GetStackPrefetchSize());
+    RawUnwinder unwinder (*reg_ctx_sp, stack);
+
+    while (true)
+    {
+        addr_t pc = frame.regs[eRawRegisterPC];
+        if (abi)
+            pc = abi->FixCodeAddress (pc);
+        if (pc == 0 || pc == LLDB_INVALID_ADDRESS)
+            break;
+        pcs.push_back (pc);
+        if (pcs.size() >= max_frames)
+            break;
+
+        // The pc of a frame that made a call is the return address, which
+        // may be past the end of its function
+        const addr_t lookup_pc = pcs.size() == 1 ? pc : pc - 1;
+        UnwindPlan::RowSP row_sp;
+        RegisterKind register_kind = eRegisterKindGeneric;
+        Address lookup_addr;
+        if (target.GetSectionLoadList().ResolveLoadAddress (lookup_pc, lookup_addr))
+        {
+            ModuleSP module_sp (lookup_addr.GetModule());
+            ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : NULL;
+            if (objfile)
+                row_sp = objfile->GetUnwindTable().GetRawUnwindRow (lookup_addr, target, register_kind);
+        }
+
+        // Stacks grow down, so a caller whose CFA isn't above this frame's
+        // means the unwind has gone astray
+        RawFrame caller;
+        bool found_caller = row_sp &&
+                            unwinder.UnwindFrame (frame, *row_sp, register_kind, caller) &&
+                            caller.cfa > frame.regs[eRawRegisterSP];
+        if (!found_caller && default_row_sp)
+            found_caller = unwinder.UnwindFrame (frame, *default_row_sp, default_plan.GetRegisterKind(), caller) &&
+                           caller.cfa > frame.regs[eRawRegisterSP];
+        if (!found_caller || (frame.cfa != LLDB_INVALID_ADDRESS && caller.cfa <= frame.cfa))
+            break;
+        frame = caller;
+    }
+    return pcs.size();
+}
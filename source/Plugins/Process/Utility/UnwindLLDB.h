@@ -79,6 +79,15 @@ protected:
     lldb::RegisterContextSP
     DoCreateRegisterContextForFrame (lldb_private::StackFrame *frame);
 
+    //------------------------------------------------------------------
+    // Walk the stack using only the compact unwind and eh_frame rows for
+    // each pc, or the ABI's frame pointer based default UnwindPlan where
+    // there are none. Doesn't make RegisterContextLLDBs, look up symbols
+    // or inspect instructions, and reads the stack in a few large reads.
+    //------------------------------------------------------------------
+    virtual uint32_t
+    DoGetRawBacktrace (std::vector<lldb::addr_t> &pcs, uint32_t max_frames);
+
     typedef std::shared_ptr<RegisterContextLLDB> RegisterContextLLDBSP;
 
     // Needed to retrieve the "next" frame (e.g. frame 2 needs to retrieve frame 1's RegisterContextLLDB)
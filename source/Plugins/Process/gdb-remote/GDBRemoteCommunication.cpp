@@ -19,6 +19,7 @@
 // Other libraries and framework includes
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/StreamGDBRemote.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/ConnectionFileDescriptor.h"
 #include "lldb/Host/FileSpec.h"
@@ -31,6 +32,8 @@
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Target/Process.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Compression.h"
 
 // Project includes
 #include "ProcessGDBRemoteLog.h"
@@ -155,6 +158,11 @@ GDBRemoteCommunication::GDBRemoteCommunication(const char *comm_name,
     m_private_is_running (false),
     m_history (512),
     m_send_acks (true),
+    m_send_compression_type (CompressionType::None),
+    m_recv_compression_type (CompressionType::None),
+    m_compression_min_size (384),
+    m_compression_bytes_in (0),
+    m_compression_bytes_out (0),
     m_listen_url ()
 {
 }
@@ -219,6 +227,14 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
 {
     if (IsConnected())
     {
+        std::string encoded_payload;
+        if (m_send_compression_type != CompressionType::None)
+        {
+            EncodeCompressedPayload (payload, payload_length, encoded_payload);
+            payload = encoded_payload.data();
+            payload_length = encoded_payload.size();
+        }
+
         StreamString packet(0, 4, eByteOrderBig);
 
         packet.PutChar('$');
@@ -244,6 +260,12 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
                         binary_start_offset = second_comma - packet_data + 1;
                 }
             }
+            else if (m_send_compression_type != CompressionType::None && packet_data[1] == 'C')
+            {
+                const char *colon = strchr(packet_data, ':');
+                if (colon)
+                    binary_start_offset = colon - packet_data + 1;
+            }
 
             // If logging was just enabled and we have history, then dump out what
             // we have to the log so we get the historical context. The Dump() call that
@@ -558,33 +580,7 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
             // run-length encoding in the process.
             // Reserve enough byte for the most common case (no RLE used)
             packet_str.reserve(m_bytes.length());
-            for (std::string::const_iterator c = m_bytes.begin() + content_start; c != m_bytes.begin() + content_end; ++c)
-            {
-                if (*c == '*')
-                {
-                    // '*' indicates RLE. Next character will give us the
-                    // repeat count and previous character is what is to be
-                    // repeated.
-                    char char_to_repeat = packet_str.back();
-                    // Number of time the previous character is repeated
-                    int repeat_count = *++c + 3 - ' ';
-                    // We have the char_to_repeat and repeat_count. Now push
-                    // it in the packet.
-                    for (int i = 0; i < repeat_count; ++i)
-                        packet_str.push_back(char_to_repeat);
-                }
-                else if (*c == 0x7d)
-                {
-                    // 0x7d is the escape character.  The next character is to
-                    // be XOR'd with 0x20.
-                    char escapee = *++c ^ 0x20;
-                    packet_str.push_back(escapee);
-                }
-                else
-                {
-                    packet_str.push_back(*c);
-                }
-            }
+            ExpandPayload (m_bytes.data() + content_start, m_bytes.data() + content_end, packet_str);
 
             if (m_bytes[0] == '$')
             {
@@ -621,6 +617,13 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                         log->Printf ("error: invalid checksum in packet: '%s'\n", m_bytes.c_str());
                 }
             }
+
+            if (success && m_bytes[0] == '$' && m_recv_compression_type != CompressionType::None)
+            {
+                success = DecodeCompressedPayload (packet_str);
+                if (!success && log)
+                    log->Printf ("error: invalid compressed packet: '%.*s'", (int)(total_length), m_bytes.c_str());
+            }
             
             m_bytes.erase(0, total_length);
             packet.SetFilePos(0);
@@ -631,6 +634,126 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
     return false;
 }
 
+void
+GDBRemoteCommunication::ExpandPayload (const char *begin, const char *end, std::string &payload)
+{
+    for (const char *c = begin; c != end; ++c)
+    {
+        if (*c == '*')
+        {
+            // '*' indicates RLE. Next character will give us the
+            // repeat count and previous character is what is to be
+            // repeated.
+            char char_to_repeat = payload.back();
+            // Number of time the previous character is repeated
+            int repeat_count = *++c + 3 - ' ';
+            // We have the char_to_repeat and repeat_count. Now push
+            // it in the packet.
+            for (int i = 0; i < repeat_count; ++i)
+                payload.push_back(char_to_repeat);
+        }
+        else if (*c == 0x7d)
+        {
+            // 0x7d is the escape character.  The next character is to
+            // be XOR'd with 0x20.
+            char escapee = *++c ^ 0x20;
+            payload.push_back(escapee);
+        }
+        else
+        {
+            payload.push_back(*c);
+        }
+    }
+}
+
+void
+GDBRemoteCommunication::EncodeCompressedPayload (const char *payload,
+                                                 size_t payload_length,
+                                                 std::string &encoded_payload)
+{
+    if (payload_length >= m_compression_min_size && m_send_compression_type == CompressionType::Zlib)
+    {
+        llvm::SmallVector<char, 0> compressed;
+        if (llvm::zlib::compress (llvm::StringRef (payload, payload_length),
+                                  compressed,
+                                  llvm::zlib::BestSpeedCompression) == llvm::zlib::StatusOK)
+        {
+            StreamGDBRemote strm;
+            strm.Printf ("C%" PRIu64 ":", (uint64_t)payload_length);
+            strm.PutEscapedBytes (compressed.data(), compressed.size());
+            // Escaping can make incompressible data bigger than it was.
+            if (strm.GetSize() <= payload_length)
+            {
+                m_compression_bytes_in += payload_length;
+                m_compression_bytes_out += strm.GetSize();
+
+                Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+                if (log)
+                    log->Printf ("GDBRemoteCommunication::%s compressed %" PRIu64 " bytes to %" PRIu64 " bytes, %" PRIu64 " bytes saved in total",
+                                 __FUNCTION__,
+                                 (uint64_t)payload_length,
+                                 (uint64_t)strm.GetSize(),
+                                 m_compression_bytes_in - m_compression_bytes_out);
+
+                encoded_payload.swap (strm.GetString());
+                return;
+            }
+        }
+    }
+
+    encoded_payload.reserve (payload_length + 1);
+    encoded_payload.push_back ('N');
+    encoded_payload.append (payload, payload_length);
+}
+
+bool
+GDBRemoteCommunication::DecodeCompressedPayload (std::string &payload)
+{
+    if (payload.empty())
+        return false;
+
+    if (payload[0] == 'N')
+    {
+        payload.erase (0, 1);
+        return true;
+    }
+
+    if (payload[0] != 'C' || m_recv_compression_type != CompressionType::Zlib)
+        return false;
+
+    const size_t colon_pos = payload.find (':');
+    if (colon_pos == std::string::npos)
+        return false;
+
+    bool success = false;
+    const uint64_t decompressed_size = StringConvert::ToUInt64 (payload.substr (1, colon_pos - 1).c_str(), 0, 10, &success);
+    if (!success || decompressed_size == 0)
+        return false;
+
+    llvm::SmallVector<char, 0> decompressed;
+    if (llvm::zlib::uncompress (llvm::StringRef (payload).substr (colon_pos + 1),
+                                decompressed,
+                                decompressed_size) != llvm::zlib::StatusOK)
+        return false;
+
+    m_compression_bytes_in += decompressed_size;
+    m_compression_bytes_out += payload.size();
+
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+    if (log)
+        log->Printf ("GDBRemoteCommunication::%s decompressed %" PRIu64 " bytes to %" PRIu64 " bytes, %" PRIu64 " bytes saved in total",
+                     __FUNCTION__,
+                     (uint64_t)payload.size(),
+                     decompressed_size,
+                     m_compression_bytes_in - m_compression_bytes_out);
+
+    // The payload that was compressed is escaped like any other packet, so
+    // binary replies like the one to "x" still need their escaping removed.
+    payload.clear();
+    ExpandPayload (decompressed.data(), decompressed.data() + decompressed.size(), payload);
+    return true;
+}
+
 Error
 GDBRemoteCommunication::StartListenThread (const char *hostname, uint16_t port)
 {
@@ -63,6 +63,12 @@ public:
         ErrorNoSequenceLock // We couldn't get the sequence lock for a multi-packet request
     };
 
+    enum class CompressionType
+    {
+        None = 0,   // Packets are sent as is
+        Zlib        // Packets above the minimum size are zlib compressed
+    };
+
     // Class to change the timeout for a given scope and restore it to the original value when the
     // created ScopedTimeout object got out of scope
     class ScopedTimeout
@@ -279,6 +285,26 @@ protected:
     bool
     WaitForNotRunningPrivate (const TimeValue *timeout_ptr);
 
+    //------------------------------------------------------------------
+    // Once compression is enabled every packet from the remote stub is
+    // framed as either "N<payload>" or "C<payload size>:<compressed
+    // payload>", with the compressed bytes binary escaped. The payload
+    // that was compressed keeps its own binary escaping, which is removed
+    // after inflating it.
+    //------------------------------------------------------------------
+    void
+    EncodeCompressedPayload (const char *payload,
+                             size_t payload_length,
+                             std::string &encoded_payload);
+
+    bool
+    DecodeCompressedPayload (std::string &payload);
+
+    // Append the bytes between "begin" and "end" to "payload", removing
+    // the 0x7d binary escaping and expanding the '*' run-length encoding
+    static void
+    ExpandPayload (const char *begin, const char *end, std::string &payload);
+
     //------------------------------------------------------------------
     // Classes that inherit from GDBRemoteCommunication can see and modify these
     //------------------------------------------------------------------
@@ -292,6 +318,11 @@ protected:
     Predicate<bool> m_private_is_running;
     History m_history;
     bool m_send_acks;
+    CompressionType m_send_compression_type;    // Compress the packets we send, only ever enabled by a server
+    CompressionType m_recv_compression_type;    // Decompress the packets we receive, only ever enabled by a client
+    uint32_t m_compression_min_size;            // Packets smaller than this are never compressed
+    uint64_t m_compression_bytes_in;            // Total payload bytes of the compressed packets before compression
+    uint64_t m_compression_bytes_out;           // Total payload bytes of the compressed packets after compression
     bool m_is_platform; // Set to true if this class represents a platform,
                         // false if this class represents a debug session for
                         // a single process
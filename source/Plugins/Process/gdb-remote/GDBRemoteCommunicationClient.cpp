@@ -19,6 +19,7 @@
 // Other libraries and framework includes
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Support/Compression.h"
 #include "lldb/Interpreter/Args.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/ModuleSpec.h"
@@ -81,8 +82,11 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient() :
     m_supports_qXfer_libraries_read (eLazyBoolCalculate),
     m_supports_qXfer_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_qXfer_features_read (eLazyBoolCalculate),
+    m_supports_read_all_registers (eLazyBoolCalculate),
+    m_supports_zlib_compression (eLazyBoolCalculate),
     m_supports_augmented_libraries_svr4_read (eLazyBoolCalculate),
     m_supports_jThreadExtendedInfo (eLazyBoolCalculate),
+    m_supports_jThreadsInfo (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -225,6 +229,50 @@ GDBRemoteCommunicationClient::GetQXferFeaturesReadSupported ()
     return (m_supports_qXfer_features_read == eLazyBoolYes);
 }
 
+bool
+GDBRemoteCommunicationClient::GetReadAllRegistersSupported ()
+{
+    if (m_supports_read_all_registers == eLazyBoolCalculate)
+    {
+        GetRemoteQSupported();
+    }
+    return (m_supports_read_all_registers == eLazyBoolYes);
+}
+
+bool
+GDBRemoteCommunicationClient::MaybeEnableCompression ()
+{
+    if (m_recv_compression_type != CompressionType::None)
+        return true;
+
+    if (GetSendAcks () || !llvm::zlib::isAvailable())
+        return false;
+
+    if (m_supports_zlib_compression == eLazyBoolCalculate)
+        GetRemoteQSupported();
+    if (m_supports_zlib_compression != eLazyBoolYes)
+        return false;
+
+    // Hold the sequence mutex until the framing has been switched over so
+    // no other thread can get a compressed reply before we expect one.
+    Mutex::Locker locker;
+    if (!GetSequenceMutex (locker, "GDBRemoteCommunicationClient::MaybeEnableCompression() failed due to not getting the sequence mutex"))
+        return false;
+
+    const char *packet = "QEnableCompression:type:zlib;";
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponseNoLock (packet, ::strlen (packet), response) == PacketResult::Success &&
+        response.IsOKResponse())
+    {
+        m_recv_compression_type = CompressionType::Zlib;
+        Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+        if (log)
+            log->Printf ("GDBRemoteCommunicationClient::%s enabled zlib packet compression", __FUNCTION__);
+        return true;
+    }
+    return false;
+}
+
 uint64_t
 GDBRemoteCommunicationClient::GetRemoteMaxPacketSize()
 {
@@ -333,6 +381,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_vCont_S = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
     m_supports_x = eLazyBoolCalculate;
+    m_supports_jThreadsInfo = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
     m_qHostInfo_is_valid = eLazyBoolCalculate;
     m_curr_pid_is_valid = eLazyBoolCalculate;
@@ -347,6 +396,8 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
     m_supports_qXfer_features_read = eLazyBoolCalculate;
+    m_supports_read_all_registers = eLazyBoolCalculate;
+    m_supports_zlib_compression = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
 
     m_supports_qProcessInfoPID = true;
@@ -386,6 +437,8 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
     m_supports_qXfer_libraries_svr4_read = eLazyBoolNo;
     m_supports_augmented_libraries_svr4_read = eLazyBoolNo;
     m_supports_qXfer_features_read = eLazyBoolNo;
+    m_supports_read_all_registers = eLazyBoolNo;
+    m_supports_zlib_compression = eLazyBoolNo;
     m_max_packet_size = UINT64_MAX;  // It's supposed to always be there, but if not, we assume no limit
 
     // build the qSupported packet
@@ -417,6 +470,26 @@ GDBRemoteCommunicationClient::GetRemoteQSupported ()
             m_supports_qXfer_libraries_read = eLazyBoolYes;
         if (::strstr (response_cstr, "qXfer:features:read+"))
             m_supports_qXfer_features_read = eLazyBoolYes;
+        if (::strstr (response_cstr, "read-all-registers+"))
+            m_supports_read_all_registers = eLazyBoolYes;
+        // Stubs that don't advertise this might still support the "x"
+        // packet, GetxPacketSupported() will probe for it.
+        if (::strstr (response_cstr, "binary-upload+"))
+            m_supports_x = eLazyBoolYes;
+
+        const char *compressions_str = ::strstr (response_cstr, "SupportedCompressions=");
+        if (compressions_str)
+        {
+            compressions_str += strlen("SupportedCompressions=");
+            std::string compressions (compressions_str, ::strcspn (compressions_str, ";"));
+            std::stringstream compressions_stream (compressions);
+            std::string compression;
+            while (std::getline (compressions_stream, compression, ','))
+            {
+                if (compression == "zlib")
+                    m_supports_zlib_compression = eLazyBoolYes;
+            }
+        }
 
         const char *packet_size_str = ::strstr (response_cstr, "PacketSize=");
         if (packet_size_str)
@@ -623,6 +696,82 @@ GDBRemoteCommunicationClient::SendPacketsAndConcatenateResponses
     }
 }
 
+GDBRemoteCommunicationClient::PacketResult
+GDBRemoteCommunicationClient::SendPacketsAndWaitForResponses (const std::vector<std::string> &payloads,
+                                                              std::vector<StringExtractorGDBRemote> &responses,
+                                                              uint32_t window_size)
+{
+    responses.clear();
+    if (payloads.empty())
+        return PacketResult::Success;
+
+    Log *log (ProcessGDBRemoteLog::GetLogIfAnyCategoryIsSet (GDBR_LOG_PROCESS | GDBR_LOG_PACKETS));
+    Mutex::Locker locker;
+    if (!GetSequenceMutex(locker,
+                          "GDBRemoteCommunicationClient::SendPacketsAndWaitForResponses() failed due to not getting the sequence mutex"))
+    {
+        if (log)
+            log->Printf("error: failed to get packet sequence mutex, not sending %" PRIu64 " packets starting with '%s'",
+                        (uint64_t)payloads.size(), payloads.front().c_str());
+        return PacketResult::ErrorNoSequenceLock;
+    }
+
+    if (window_size == 0 || GetSendAcks ())
+        window_size = 1;
+
+    PacketResult result = PacketResult::Success;
+    size_t num_sent = 0;
+    bool keep_sending = true;
+    while (true)
+    {
+        // Fill up the window before waiting for the oldest reply
+        while (keep_sending && num_sent < payloads.size() && num_sent - responses.size() < window_size)
+        {
+            const std::string &payload = payloads[num_sent];
+            result = SendPacketNoLock (payload.data(), payload.size());
+            if (result == PacketResult::Success)
+                ++num_sent;
+            else
+                keep_sending = false;
+        }
+
+        if (responses.size() == num_sent)
+            break;
+
+        StringExtractorGDBRemote response;
+        const PacketResult wait_result = WaitForPacketWithTimeoutMicroSecondsNoLock (response, GetPacketTimeoutInMicroSeconds ());
+        if (wait_result != PacketResult::Success)
+        {
+            if (log)
+                log->Printf("error: failed to get the response to '%s' with %" PRIu64 " packets still in flight",
+                            payloads[responses.size()].c_str(), (uint64_t)(num_sent - responses.size()));
+
+            // Every packet still in flight will get its reply sooner or
+            // later. Read and drop those replies now so the next packet we
+            // send doesn't get one of them as its reply. If they don't show
+            // up either there is no telling where the stream is, so drop the
+            // connection rather than let requests and replies get out of step.
+            for (size_t num_in_flight = num_sent - responses.size(); num_in_flight > 0 && IsConnected(); --num_in_flight)
+            {
+                StringExtractorGDBRemote late_response;
+                if (WaitForPacketWithTimeoutMicroSecondsNoLock (late_response, GetPacketTimeoutInMicroSeconds ()) != PacketResult::Success)
+                {
+                    if (log)
+                        log->Printf("error: disconnecting, %" PRIu64 " replies never arrived", (uint64_t)num_in_flight);
+                    Disconnect();
+                    break;
+                }
+            }
+            return wait_result;
+        }
+
+        if (!response.IsNormalResponse())
+            keep_sending = false;
+        responses.push_back (response);
+    }
+    return result;
+}
+
 GDBRemoteCommunicationClient::PacketResult
 GDBRemoteCommunicationClient::SendPacketAndWaitForResponse
 (
@@ -3014,6 +3163,32 @@ GDBRemoteCommunicationClient::GetThreadStopInfo (lldb::tid_t tid, StringExtracto
     return false;
 }
 
+StructuredData::ObjectSP
+GDBRemoteCommunicationClient::GetThreadsInfo ()
+{
+    StructuredData::ObjectSP object_sp;
+    if (m_supports_jThreadsInfo == eLazyBoolNo)
+        return object_sp;
+
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse("jThreadsInfo", response, false) == PacketResult::Success)
+    {
+        if (response.IsUnsupportedResponse())
+        {
+            m_supports_jThreadsInfo = eLazyBoolNo;
+        }
+        else if (response.IsNormalResponse())
+        {
+            m_supports_jThreadsInfo = eLazyBoolYes;
+            // The packet has already had the 0x7d xor quoting stripped out at the
+            // GDBRemoteCommunication packet receive level.
+            object_sp = StructuredData::ParseJSON (response.GetStringRef());
+            if (object_sp && object_sp->GetAsArray() == nullptr)
+                object_sp.reset();
+        }
+    }
+    return object_sp;
+}
 
 uint8_t
 GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type, bool insert,  addr_t addr, uint32_t length)
@@ -17,6 +17,7 @@
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/StructuredData.h"
 #include "lldb/Target/Process.h"
 
 #include "GDBRemoteCommunication.h"
@@ -73,6 +74,22 @@ public:
     SendPacketsAndConcatenateResponses (const char *send_payload_prefix,
                                         std::string &response_string);
 
+    // Send all of the independent packets in "payloads" and return their
+    // responses, in order, in "responses". Up to "window_size" packets are
+    // kept in flight at once so that a long run of requests (like the
+    // chunks of a large memory read) isn't bound by the round trip time
+    // of the connection. Packets are sent one at a time while acks are
+    // still enabled since the acks would be interleaved with the replies.
+    // No more packets are sent once a reply is not a normal response, but
+    // the replies to the packets already in flight are still collected.
+    // If a reply doesn't arrive in time the replies still in flight are
+    // read and thrown away, and the connection is closed if they don't
+    // arrive either, so later packets never get a stale reply.
+    PacketResult
+    SendPacketsAndWaitForResponses (const std::vector<std::string> &payloads,
+                                    std::vector<StringExtractorGDBRemote> &responses,
+                                    uint32_t window_size);
+
     lldb::StateType
     SendContinuePacketAndWaitForResponse (ProcessGDBRemote *process,
                                           const char *packet_payload,
@@ -374,6 +391,18 @@ public:
     GetThreadStopInfo (lldb::tid_t tid, 
                        StringExtractorGDBRemote &response);
 
+    //------------------------------------------------------------------
+    /// Get the stop info, name and expedited registers of every thread
+    /// in the process with a single "jThreadsInfo" packet.
+    ///
+    /// @return
+    ///     A StructuredData::Array with one dictionary per thread, or
+    ///     an empty shared pointer if the remote stub doesn't support
+    ///     the packet.
+    //------------------------------------------------------------------
+    StructuredData::ObjectSP
+    GetThreadsInfo ();
+
     bool
     SupportsGDBStoppointPacket (GDBStoppointType type)
     {
@@ -429,6 +458,27 @@ public:
     bool
     GetQXferFeaturesReadSupported ();
 
+    bool
+    GetReadAllRegistersSupported ();
+
+    // Stop using "g" for the registers of every thread of the process
+    // once it failed for one of them, e.g. because the stub can't read
+    // one of the registers
+    void
+    SetReadAllRegistersFailed ()
+    {
+        m_supports_read_all_registers = eLazyBoolNo;
+    }
+
+    //------------------------------------------------------------------
+    // Ask the remote stub to compress the packets it sends from now on
+    // if it supports a compression type we know about. This is only done
+    // on reliable connections, i.e. once acks have been disabled. Returns
+    // true if compression is enabled.
+    //------------------------------------------------------------------
+    bool
+    MaybeEnableCompression ();
+
     LazyBool
     SupportsAllocDeallocMemory () // const
     {
@@ -586,8 +636,11 @@ protected:
     LazyBool m_supports_qXfer_libraries_read;
     LazyBool m_supports_qXfer_libraries_svr4_read;
     LazyBool m_supports_qXfer_features_read;
+    LazyBool m_supports_read_all_registers;
+    LazyBool m_supports_zlib_compression;
     LazyBool m_supports_augmented_libraries_svr4_read;
     LazyBool m_supports_jThreadExtendedInfo;
+    LazyBool m_supports_jThreadsInfo;
 
     bool
         m_supports_qProcessInfoPID:1,
@@ -18,6 +18,7 @@
 
 // Other libraries and framework includes
 #include "llvm/ADT/Triple.h"
+#include "llvm/Support/Compression.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/StreamGDBRemote.h"
@@ -69,6 +70,8 @@ GDBRemoteCommunicationServerCommon::GDBRemoteCommunicationServerCommon(const cha
 {
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_A,
                                   &GDBRemoteCommunicationServerCommon::Handle_A);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_QEnableCompression,
+                                  &GDBRemoteCommunicationServerCommon::Handle_QEnableCompression);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_QEnvironment,
                                   &GDBRemoteCommunicationServerCommon::Handle_QEnvironment);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_QEnvironmentHexEncoded,
@@ -909,6 +912,10 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported (StringExtractorGDBRemote
     response.PutCString (";QStartNoAckMode+");
     response.PutCString (";QThreadSuffixSupported+");
     response.PutCString (";QListThreadsInStopReply+");
+    response.PutCString (";binary-upload+");
+    response.PutCString (";read-all-registers+");
+    if (llvm::zlib::isAvailable())
+        response.PutCString (";SupportedCompressions=zlib");
 #if defined(__linux__)
     response.PutCString (";qXfer:auxv:read+");
 #endif
@@ -950,6 +957,39 @@ GDBRemoteCommunicationServerCommon::Handle_QStartNoAckMode (StringExtractorGDBRe
     return packet_result;
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerCommon::Handle_QEnableCompression (StringExtractorGDBRemote &packet)
+{
+    packet.SetFilePos(::strlen ("QEnableCompression:"));
+    CompressionType compression_type = CompressionType::None;
+    uint32_t min_size = m_compression_min_size;
+    std::string name;
+    std::string value;
+    while (packet.GetNameColonValue (name, value))
+    {
+        if (name.compare ("type") == 0)
+        {
+            if (value.compare ("zlib") == 0 && llvm::zlib::isAvailable())
+                compression_type = CompressionType::Zlib;
+            else
+                return SendErrorResponse (0x60);
+        }
+        else if (name.compare ("minsize") == 0)
+        {
+            min_size = StringConvert::ToUInt32 (value.c_str(), min_size, 10);
+        }
+    }
+
+    if (compression_type == CompressionType::None)
+        return SendIllFormedResponse (packet, "QEnableCompression packet is missing the compression type");
+
+    // Send response first so the reply to this packet isn't compressed
+    PacketResult packet_result = SendOKResponse ();
+    m_send_compression_type = compression_type;
+    m_compression_min_size = min_size;
+    return packet_result;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerCommon::Handle_QSetSTDIN (StringExtractorGDBRemote &packet)
 {
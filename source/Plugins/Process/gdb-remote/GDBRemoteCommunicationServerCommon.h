@@ -136,6 +136,9 @@ protected:
     PacketResult
     Handle_QStartNoAckMode (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_QEnableCompression (StringExtractorGDBRemote &packet);
+
     PacketResult
     Handle_QSetSTDIN (StringExtractorGDBRemote &packet);
 
@@ -16,9 +16,11 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 // Other libraries and framework includes
 #include "llvm/ADT/Triple.h"
@@ -44,6 +46,7 @@
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeProcessProtocol.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
+#include "lldb/Utility/JSON.h"
 
 // Project includes
 #include "Utility/StringExtractorGDBRemote.h"
@@ -120,6 +123,10 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
                                   &GDBRemoteCommunicationServerLLGS::Handle_c);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_D,
                                   &GDBRemoteCommunicationServerLLGS::Handle_D);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_g,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_g);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_G,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_G);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_H,
                                   &GDBRemoteCommunicationServerLLGS::Handle_H);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_I,
@@ -127,7 +134,7 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_interrupt,
                                   &GDBRemoteCommunicationServerLLGS::Handle_interrupt);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_m,
-                                  &GDBRemoteCommunicationServerLLGS::Handle_m);
+                                  &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                   &GDBRemoteCommunicationServerLLGS::Handle_M);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_p,
@@ -164,6 +171,8 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
                                   &GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_qXfer_auxv_read,
                                   &GDBRemoteCommunicationServerLLGS::Handle_qXfer_auxv_read);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_jThreadsInfo,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_s,
                                   &GDBRemoteCommunicationServerLLGS::Handle_s);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_stop_reason,
@@ -174,6 +183,8 @@ GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers()
                                   &GDBRemoteCommunicationServerLLGS::Handle_vCont);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_vCont_actions,
                                   &GDBRemoteCommunicationServerLLGS::Handle_vCont_actions);
+    RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_x,
+                                  &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_Z,
                                   &GDBRemoteCommunicationServerLLGS::Handle_Z);
     RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_z,
@@ -454,6 +465,67 @@ WriteRegisterValueInHexFixedWidth (StreamString &response,
     }
 }
 
+static const char *
+GetStopReasonString (StopReason stop_reason)
+{
+    switch (stop_reason)
+    {
+    case eStopReasonTrace:
+        return "trace";
+    case eStopReasonBreakpoint:
+        return "breakpoint";
+    case eStopReasonWatchpoint:
+        return "watchpoint";
+    case eStopReasonSignal:
+        return "signal";
+    case eStopReasonException:
+        return "exception";
+    case eStopReasonExec:
+        return "exec";
+    case eStopReasonInstrumentation:
+    case eStopReasonInvalid:
+    case eStopReasonPlanComplete:
+    case eStopReasonThreadExiting:
+    case eStopReasonNone:
+        break;
+    }
+    return nullptr;
+}
+
+static JSONObject::SP
+GetExpeditedRegistersJSON (NativeRegisterContextSP &reg_ctx_sp)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_THREAD));
+
+    // Same set of registers that the T stop reply packet expedites: every
+    // register in the first register set that isn't contained in another one.
+    JSONObject::SP register_object_sp = std::make_shared<JSONObject>();
+    const RegisterSet *reg_set_p;
+    if (reg_ctx_sp->GetRegisterSetCount () == 0 || ((reg_set_p = reg_ctx_sp->GetRegisterSet (0)) == nullptr))
+        return register_object_sp;
+
+    for (const uint32_t *reg_num_p = reg_set_p->registers; *reg_num_p != LLDB_INVALID_REGNUM; ++reg_num_p)
+    {
+        const RegisterInfo *const reg_info_p = reg_ctx_sp->GetRegisterInfoAtIndex (*reg_num_p);
+        if (reg_info_p == nullptr || reg_info_p->value_regs != nullptr)
+            continue;
+
+        RegisterValue reg_value;
+        Error error = reg_ctx_sp->ReadRegister (reg_info_p, reg_value);
+        if (error.Fail ())
+        {
+            if (log)
+                log->Printf ("%s failed to read register '%s' index %" PRIu32 ": %s", __FUNCTION__, reg_info_p->name ? reg_info_p->name : "<unnamed-register>", *reg_num_p, error.AsCString ());
+            continue;
+        }
+
+        StreamString stream;
+        WriteRegisterValueInHexFixedWidth (stream, reg_ctx_sp, *reg_info_p, &reg_value);
+        register_object_sp->SetObject (std::to_string (*reg_num_p), std::make_shared<JSONString> (stream.GetString ()));
+    }
+    return register_object_sp;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread (lldb::tid_t tid)
 {
@@ -594,34 +666,7 @@ GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread (lldb::tid_t tid)
         }
     }
 
-    const char* reason_str = nullptr;
-    switch (tid_stop_info.reason)
-    {
-    case eStopReasonTrace:
-        reason_str = "trace";
-        break;
-    case eStopReasonBreakpoint:
-        reason_str = "breakpoint";
-        break;
-    case eStopReasonWatchpoint:
-        reason_str = "watchpoint";
-        break;
-    case eStopReasonSignal:
-        reason_str = "signal";
-        break;
-    case eStopReasonException:
-        reason_str = "exception";
-        break;
-    case eStopReasonExec:
-        reason_str = "exec";
-        break;
-    case eStopReasonInstrumentation:
-    case eStopReasonInvalid:
-    case eStopReasonPlanComplete:
-    case eStopReasonThreadExiting:
-    case eStopReasonNone:
-        break;
-    }
+    const char* reason_str = GetStopReasonString (tid_stop_info.reason);
     if (reason_str != nullptr)
     {
         response.Printf ("reason:%s;", reason_str);
@@ -1493,6 +1538,151 @@ GDBRemoteCommunicationServerLLGS::Handle_qsThreadInfo (StringExtractorGDBRemote
     return SendPacketNoLock ("l", 1);
 }
 
+static uint32_t
+GetRegisterFileByteSize (NativeRegisterContextSP &reg_context_sp)
+{
+    // The "g" and "G" packets lay the registers out at the byte offsets
+    // sent in the qRegisterInfo replies. Registers that are part of
+    // another register ("value_regs") don't take up any extra space.
+    uint32_t byte_size = 0;
+    const uint32_t reg_count = reg_context_sp->GetUserRegisterCount ();
+    for (uint32_t reg_index = 0; reg_index < reg_count; ++reg_index)
+    {
+        const RegisterInfo *reg_info = reg_context_sp->GetRegisterInfoAtIndex (reg_index);
+        if (reg_info && reg_info->value_regs == nullptr)
+            byte_size = std::max<uint32_t> (byte_size, reg_info->byte_offset + reg_info->byte_size);
+    }
+    return byte_size;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_g (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_THREAD));
+
+    // Get the thread to use.
+    packet.SetFilePos (strlen("g"));
+    NativeThreadProtocolSP thread_sp = GetThreadFromSuffix (packet);
+    if (!thread_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, no thread available", __FUNCTION__);
+        return SendErrorResponse (0x15);
+    }
+
+    // Get the thread's register context.
+    NativeRegisterContextSP reg_context_sp (thread_sp->GetRegisterContext ());
+    if (!reg_context_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64 " tid %" PRIu64 " failed, no register context available for the thread", __FUNCTION__, m_debugged_process_sp->GetID (), thread_sp->GetID ());
+        return SendErrorResponse (0x15);
+    }
+
+    // Send every register or none: if one of them can't be read, reply
+    // with an error so the debugger goes back to reading registers one
+    // at a time with "p" instead of taking a made up value for it.
+    std::vector<uint8_t> regs_buffer (GetRegisterFileByteSize (reg_context_sp), 0);
+    const uint32_t reg_count = reg_context_sp->GetUserRegisterCount ();
+    for (uint32_t reg_index = 0; reg_index < reg_count; ++reg_index)
+    {
+        const RegisterInfo *reg_info = reg_context_sp->GetRegisterInfoAtIndex (reg_index);
+        if (reg_info == nullptr || reg_info->value_regs != nullptr)
+            continue;
+
+        RegisterValue reg_value;
+        Error error = reg_context_sp->ReadRegister (reg_info, reg_value);
+        if (error.Fail ())
+        {
+            if (log)
+                log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, read of register %" PRIu32 " (%s) failed: %s", __FUNCTION__, reg_index, reg_info->name, error.AsCString ());
+            return SendErrorResponse (0x15);
+        }
+
+        const uint32_t byte_size = std::min<uint32_t> (reg_value.GetByteSize (), reg_info->byte_size);
+        if (reg_value.GetBytes () && byte_size > 0)
+            memcpy (&regs_buffer[reg_info->byte_offset], reg_value.GetBytes (), byte_size);
+    }
+
+    StreamGDBRemote response;
+    for (const uint8_t byte : regs_buffer)
+        response.PutHex8 (byte);
+
+    return SendPacketNoLock (response.GetData (), response.GetSize ());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_G (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_THREAD));
+
+    // Get process architecture.
+    ArchSpec process_arch;
+    if (!m_debugged_process_sp || !m_debugged_process_sp->GetArchitecture (process_arch))
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed to retrieve inferior architecture", __FUNCTION__);
+        return SendErrorResponse (0x49);
+    }
+
+    // Parse out the register file contents, the thread suffix follows it.
+    packet.SetFilePos (strlen("G"));
+    std::vector<uint8_t> regs_buffer (packet.GetBytesLeft () / 2, 0);
+    regs_buffer.resize (packet.GetHexBytesAvail (regs_buffer.data (), regs_buffer.size ()));
+
+    // Get the thread to use.
+    NativeThreadProtocolSP thread_sp = GetThreadFromSuffix (packet);
+    if (!thread_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, no thread available", __FUNCTION__);
+        return SendErrorResponse (0x28);
+    }
+
+    // Get the thread's register context.
+    NativeRegisterContextSP reg_context_sp (thread_sp->GetRegisterContext ());
+    if (!reg_context_sp)
+    {
+        if (log)
+            log->Printf ("GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64 " tid %" PRIu64 " failed, no register context available for the thread", __FUNCTION__, m_debugged_process_sp->GetID (), thread_sp->GetID ());
+        return SendErrorResponse (0x15);
+    }
+
+    if (regs_buffer.size () != GetRegisterFileByteSize (reg_context_sp))
+        return SendIllFormedResponse (packet, "G packet register file size is incorrect");
+
+    // Only write the registers that changed. A register that can't be
+    // read fails the write, the same way "g" fails to read it.
+    const uint32_t reg_count = reg_context_sp->GetUserRegisterCount ();
+    for (uint32_t reg_index = 0; reg_index < reg_count; ++reg_index)
+    {
+        const RegisterInfo *reg_info = reg_context_sp->GetRegisterInfoAtIndex (reg_index);
+        if (reg_info == nullptr || reg_info->value_regs != nullptr)
+            continue;
+
+        RegisterValue old_value;
+        Error error = reg_context_sp->ReadRegister (reg_info, old_value);
+        if (error.Success () &&
+            old_value.GetByteSize () == reg_info->byte_size &&
+            memcmp (old_value.GetBytes (), &regs_buffer[reg_info->byte_offset], reg_info->byte_size) == 0)
+            continue;
+
+        if (error.Success ())
+        {
+            RegisterValue reg_value (&regs_buffer[reg_info->byte_offset], reg_info->byte_size, process_arch.GetByteOrder ());
+            error = reg_context_sp->WriteRegister (reg_info, reg_value);
+        }
+        if (error.Fail ())
+        {
+            if (log)
+                log->Printf ("GDBRemoteCommunicationServerLLGS::%s failed, write of register %" PRIu32 " (%s) failed: %s", __FUNCTION__, reg_index, reg_info->name, error.AsCString ());
+            return SendErrorResponse (0x32);
+        }
+    }
+
+    return SendOKResponse();
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_p (StringExtractorGDBRemote &packet)
 {
@@ -1803,7 +1993,7 @@ GDBRemoteCommunicationServerLLGS::Handle_interrupt (StringExtractorGDBRemote &pa
 }
 
 GDBRemoteCommunication::PacketResult
-GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
+GDBRemoteCommunicationServerLLGS::Handle_memory_read (StringExtractorGDBRemote &packet)
 {
     Log *log (GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
 
@@ -1814,28 +2004,41 @@ GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
         return SendErrorResponse (0x15);
     }
 
-    // Parse out the memory address.
-    packet.SetFilePos (strlen("m"));
+    // Handles both the "m" packet, whose reply is hex encoded, and the "x"
+    // packet, whose reply is the raw memory with '#', '$', '}' and '*'
+    // escaped. The "x" packet is advertised with "binary-upload+" in the
+    // qSupported reply.
+    packet.SetFilePos (0);
+    const bool binary = (packet.GetChar() == 'x');
     if (packet.GetBytesLeft() < 1)
-        return SendIllFormedResponse(packet, "Too short m packet");
+        return SendIllFormedResponse(packet, "Too short memory read packet");
 
-    // Read the address.  Punting on validation.
+    // Read the address.  Punting on validation. The debugserver flavor of
+    // the "x" packet puts a "0x" prefix in front of the numbers.
     // FIXME replace with Hex U64 read with no default value that fails on failed read.
+    if (binary && packet.GetStringRef().compare(packet.GetFilePos(), 2, "0x") == 0)
+        packet.SetFilePos(packet.GetFilePos() + 2);
     const lldb::addr_t read_addr = packet.GetHexMaxU64(false, 0);
 
     // Validate comma.
     if ((packet.GetBytesLeft() < 1) || (packet.GetChar() != ','))
-        return SendIllFormedResponse(packet, "Comma sep missing in m packet");
+        return SendIllFormedResponse(packet, "Comma sep missing in memory read packet");
 
     // Get # bytes to read.
     if (packet.GetBytesLeft() < 1)
-        return SendIllFormedResponse(packet, "Length missing in m packet");
+        return SendIllFormedResponse(packet, "Length missing in memory read packet");
 
+    if (binary && packet.GetStringRef().compare(packet.GetFilePos(), 2, "0x") == 0)
+        packet.SetFilePos(packet.GetFilePos() + 2);
     const uint64_t byte_count = packet.GetHexMaxU64(false, 0);
     if (byte_count == 0)
     {
         if (log)
             log->Printf ("GDBRemoteCommunicationServerLLGS::%s nothing to read: zero-length packet", __FUNCTION__);
+        // A zero length "x" packet is how the debugger checks whether the
+        // packet is supported.
+        if (binary)
+            return SendOKResponse();
         return PacketResult::Success;
     }
 
@@ -1863,8 +2066,15 @@ GDBRemoteCommunicationServerLLGS::Handle_m (StringExtractorGDBRemote &packet)
     }
 
     StreamGDBRemote response;
-    for (lldb::addr_t i = 0; i < bytes_read; ++i)
-        response.PutHex8(buf[i]);
+    if (binary)
+    {
+        response.PutEscapedBytes(buf.data(), bytes_read);
+    }
+    else
+    {
+        for (lldb::addr_t i = 0; i < bytes_read; ++i)
+            response.PutHex8(buf[i]);
+    }
 
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
@@ -2604,6 +2814,82 @@ GDBRemoteCommunicationServerLLGS::Handle_qWatchpointSupportInfo (StringExtractor
     return SendPacketNoLock(response.GetData(), response.GetSize());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo (StringExtractorGDBRemote &packet)
+{
+    Log *log (GetLogIfAnyCategoriesSet (LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_THREAD));
+
+    // Ensure we have a debugged process.
+    if (!m_debugged_process_sp || (m_debugged_process_sp->GetID () == LLDB_INVALID_PROCESS_ID))
+        return SendErrorResponse (50);
+
+    if (log)
+        log->Printf ("GDBRemoteCommunicationServerLLGS::%s preparing thread info for pid %" PRIu64,
+                     __FUNCTION__, m_debugged_process_sp->GetID ());
+
+    // Reply with a JSON array that has one dictionary per thread containing
+    // everything a stop reply packet would tell the debugger about it. This
+    // lets the debugger find out about every thread in the process with one
+    // packet instead of a qThreadStopInfo and register reads for each thread.
+    // We are about to read the expedited registers of every thread, so let the
+    // process fetch them all at once instead of one thread at a time.
+    m_debugged_process_sp->PrefetchThreadRegisters ();
+
+    JSONArray threads_array;
+    uint32_t thread_index = 0;
+    NativeThreadProtocolSP thread_sp;
+    for (thread_sp = m_debugged_process_sp->GetThreadAtIndex (thread_index); thread_sp; ++thread_index, thread_sp = m_debugged_process_sp->GetThreadAtIndex (thread_index))
+    {
+        JSONObject::SP thread_obj_sp = std::make_shared<JSONObject>();
+        thread_obj_sp->SetObject ("tid", std::make_shared<JSONNumber> (static_cast<int64_t> (thread_sp->GetID ())));
+
+        const std::string thread_name = thread_sp->GetName ();
+        if (!thread_name.empty ())
+            thread_obj_sp->SetObject ("name", std::make_shared<JSONString> (thread_name));
+
+        struct ThreadStopInfo tid_stop_info;
+        std::string description;
+        if (thread_sp->GetStopReason (tid_stop_info, description))
+        {
+            thread_obj_sp->SetObject ("signal", std::make_shared<JSONNumber> (tid_stop_info.details.signal.signo & 0xff));
+
+            const char *reason_str = GetStopReasonString (tid_stop_info.reason);
+            if (reason_str != nullptr)
+                thread_obj_sp->SetObject ("reason", std::make_shared<JSONString> (reason_str));
+
+            if (!description.empty ())
+                thread_obj_sp->SetObject ("description", std::make_shared<JSONString> (description));
+            else if ((tid_stop_info.reason == eStopReasonException) && tid_stop_info.details.exception.type)
+            {
+                thread_obj_sp->SetObject ("metype", std::make_shared<JSONNumber> (static_cast<int64_t> (tid_stop_info.details.exception.type)));
+
+                JSONArray::SP medata_array_sp = std::make_shared<JSONArray>();
+                for (uint32_t i = 0; i < tid_stop_info.details.exception.data_count; ++i)
+                    medata_array_sp->AppendObject (std::make_shared<JSONNumber> (static_cast<int64_t> (tid_stop_info.details.exception.data[i])));
+                thread_obj_sp->SetObject ("medata", medata_array_sp);
+            }
+        }
+
+        NativeRegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext ();
+        if (reg_ctx_sp)
+            thread_obj_sp->SetObject ("registers", GetExpeditedRegistersJSON (reg_ctx_sp));
+
+        // No "qaddr" key: the native threads we debug have no dispatch queue
+        // address to report, which is also why our T packets don't send one.
+
+        threads_array.AppendObject (thread_obj_sp);
+    }
+
+    StreamString json;
+    threads_array.Write (json);
+
+    // The JSON text will contain '}' characters, so it needs to be escaped
+    // before it can be sent.
+    StreamGDBRemote response;
+    response.PutEscapedBytes (json.GetData (), json.GetSize ());
+    return SendPacketNoLock (response.GetData (), response.GetSize ());
+}
+
 void
 GDBRemoteCommunicationServerLLGS::FlushInferiorOutput ()
 {
@@ -162,6 +162,51 @@ GDBRemoteRegisterContext::GetPrimordialRegister(const RegisterInfo *reg_info,
     return false;
 }
 
+// Helper function for GDBRemoteRegisterContext::ReadRegisterBytes().
+bool
+GDBRemoteRegisterContext::FillRegistersWithGPacket(GDBRemoteCommunicationClient &gdb_comm)
+{
+    // The remote stub says it can send the whole register file in one
+    // packet. Fill in all of our registers at once instead of sending a
+    // "p" packet for each register we end up needing.
+    StringExtractorGDBRemote response;
+    if (!gdb_comm.ReadAllRegisters(m_thread.GetProtocolID(), response))
+        return false;
+
+    if (!response.IsNormalResponse())
+    {
+        // The stub couldn't read every register for this thread. Don't
+        // keep paying for a "g" packet before the "p" packets of every
+        // thread at every stop.
+        gdb_comm.SetReadAllRegistersFailed();
+        return false;
+    }
+
+    DataBufferHeap buffer (m_reg_data.GetByteSize(), 0);
+    if (response.GetHexBytes (buffer.GetBytes(), buffer.GetByteSize(), '\xcc') != buffer.GetByteSize() ||
+        response.GetBytesLeft() != 0)
+    {
+        // Our register layout doesn't match the layout of the "g" packet
+        // so don't bother asking again.
+        gdb_comm.SetReadAllRegistersFailed();
+        return false;
+    }
+
+    // Keep the values we already have, e.g. the expedited registers from
+    // the stop reply packet.
+    const RegisterInfo *reg_info;
+    for (uint32_t reg = 0; (reg_info = GetRegisterInfoAtIndex (reg)) != NULL; ++reg)
+    {
+        if (GetRegisterIsValid(reg) || reg_info->value_regs != NULL)
+            continue;
+        uint8_t *dst = const_cast<uint8_t*>(m_reg_data.PeekData(reg_info->byte_offset, reg_info->byte_size));
+        if (dst)
+            memcpy (dst, buffer.GetBytes() + reg_info->byte_offset, reg_info->byte_size);
+    }
+    SetAllRegisterValid (true);
+    return true;
+}
+
 bool
 GDBRemoteRegisterContext::ReadRegisterBytes (const RegisterInfo *reg_info, DataExtractor &data)
 {
@@ -189,6 +234,13 @@ GDBRemoteRegisterContext::ReadRegisterBytes (const RegisterInfo *reg_info, DataE
                 if (response.GetHexBytes ((void *)m_reg_data.GetDataStart(), m_reg_data.GetByteSize(), '\xcc') == m_reg_data.GetByteSize())
                     SetAllRegisterValid (true);
         }
+        else if (gdb_comm.GetReadAllRegistersSupported() &&
+                 !gdb_comm.AvoidGPackets((ProcessGDBRemote *)process) &&
+                 FillRegistersWithGPacket(gdb_comm))
+        {
+            // The remote stub sent us the whole register file, so every
+            // register is valid now.
+        }
         else if (reg_info->value_regs)
         {
             // Process this composite register request by delegating to the constituent
@@ -544,31 +596,21 @@ GDBRemoteRegisterContext::ReadAllRegisterValues (lldb::DataBufferSP &data_sp)
 
             if (use_g_packet && gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, false) == GDBRemoteCommunication::PacketResult::Success)
             {
-                int packet_len = 0;
-                if (thread_suffix_supported)
-                    packet_len = ::snprintf (packet, sizeof(packet), "g;thread:%4.4" PRIx64, m_thread.GetProtocolID());
-                else
-                    packet_len = ::snprintf (packet, sizeof(packet), "g");
-                assert (packet_len < ((int)sizeof(packet) - 1));
-    
-                if (gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, false) == GDBRemoteCommunication::PacketResult::Success)
+                if (response.IsErrorResponse())
+                    return false;
+
+                std::string &response_str = response.GetStringRef();
+                if (isxdigit(response_str[0]))
                 {
-                    if (response.IsErrorResponse())
-                        return false;
-    
-                    std::string &response_str = response.GetStringRef();
-                    if (isxdigit(response_str[0]))
+                    response_str.insert(0, 1, 'G');
+                    if (thread_suffix_supported)
                     {
-                        response_str.insert(0, 1, 'G');
-                        if (thread_suffix_supported)
-                        {
-                            char thread_id_cstr[64];
-                            ::snprintf (thread_id_cstr, sizeof(thread_id_cstr), ";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
-                            response_str.append (thread_id_cstr);
-                        }
-                        data_sp.reset (new DataBufferHeap (response_str.c_str(), response_str.size()));
-                        return true;
+                        char thread_id_cstr[64];
+                        ::snprintf (thread_id_cstr, sizeof(thread_id_cstr), ";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
+                        response_str.append (thread_id_cstr);
                     }
+                    data_sp.reset (new DataBufferHeap (response_str.c_str(), response_str.size()));
+                    return true;
                 }
             }
             else
@@ -652,120 +694,133 @@ GDBRemoteRegisterContext::WriteAllRegisterValues (const lldb::DataBufferSP &data
                                                           response,
                                                           false) == GDBRemoteCommunication::PacketResult::Success)
             {
-                // The data_sp contains the entire G response packet including the
-                // G, and if the thread suffix is supported, it has the thread suffix
-                // as well.
-                const char *G_packet = (const char *)data_sp->GetBytes();
-                size_t G_packet_len = data_sp->GetByteSize();
-                if (gdb_comm.SendPacketAndWaitForResponse (G_packet,
-                                                           G_packet_len,
-                                                           response,
-                                                           false) == GDBRemoteCommunication::PacketResult::Success)
+                if (response.IsOKResponse())
+                    return true;
+                else if (response.IsErrorResponse())
                 {
-                    if (response.IsOKResponse())
-                        return true;
-                    else if (response.IsErrorResponse())
+                    uint32_t num_restored = 0;
+                    // We need to manually go through all of the registers and
+                    // restore them manually
+
+                    response.GetStringRef().assign (G_packet, G_packet_len);
+                    response.SetFilePos(1); // Skip the leading 'G'
+
+                    // G_packet_len is hex-ascii characters plus prefix 'G' plus suffix thread specifier.
+                    // This means buffer will be a little more than 2x larger than necessary but we resize
+                    // it down once we've extracted all hex ascii chars from the packet.
+                    DataBufferHeap buffer (G_packet_len, 0);
+                    DataExtractor restore_data (buffer.GetBytes(),
+                                                buffer.GetByteSize(),
+                                                m_reg_data.GetByteOrder(),
+                                                m_reg_data.GetAddressByteSize());
+
+                    const uint32_t bytes_extracted = response.GetHexBytes ((void *)restore_data.GetDataStart(),
+                                                                           restore_data.GetByteSize(),
+                                                                           '\xcc');
+
+                    if (bytes_extracted < restore_data.GetByteSize())
+                        restore_data.SetData(restore_data.GetDataStart(), bytes_extracted, m_reg_data.GetByteOrder());
+
+                    const RegisterInfo *reg_info;
+
+                    // The g packet contents may either include the slice registers (registers defined in
+                    // terms of other registers, e.g. eax is a subset of rax) or not.  The slice registers 
+                    // should NOT be in the g packet, but some implementations may incorrectly include them.
+                    // 
+                    // If the slice registers are included in the packet, we must step over the slice registers 
+                    // when parsing the packet -- relying on the RegisterInfo byte_offset field would be incorrect.
+                    // If the slice registers are not included, then using the byte_offset values into the
+                    // data buffer is the best way to find individual register values.
+
+                    uint64_t size_including_slice_registers = 0;
+                    uint64_t size_not_including_slice_registers = 0;
+                    uint64_t size_by_highest_offset = 0;
+
+                    for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx)
                     {
-                        uint32_t num_restored = 0;
-                        // We need to manually go through all of the registers and
-                        // restore them manually
-    
-                        response.GetStringRef().assign (G_packet, G_packet_len);
-                        response.SetFilePos(1); // Skip the leading 'G'
-
-                        // G_packet_len is hex-ascii characters plus prefix 'G' plus suffix thread specifier.
-                        // This means buffer will be a little more than 2x larger than necessary but we resize
-                        // it down once we've extracted all hex ascii chars from the packet.
-                        DataBufferHeap buffer (G_packet_len, 0);
-                        DataExtractor restore_data (buffer.GetBytes(),
-                                                    buffer.GetByteSize(),
-                                                    m_reg_data.GetByteOrder(),
-                                                    m_reg_data.GetAddressByteSize());
-    
-                        const uint32_t bytes_extracted = response.GetHexBytes ((void *)restore_data.GetDataStart(),
-                                                                               restore_data.GetByteSize(),
-                                                                               '\xcc');
-    
-                        if (bytes_extracted < restore_data.GetByteSize())
-                            restore_data.SetData(restore_data.GetDataStart(), bytes_extracted, m_reg_data.GetByteOrder());
-    
-                        const RegisterInfo *reg_info;
-
-                        // The g packet contents may either include the slice registers (registers defined in
-                        // terms of other registers, e.g. eax is a subset of rax) or not.  The slice registers 
-                        // should NOT be in the g packet, but some implementations may incorrectly include them.
-                        // 
-                        // If the slice registers are included in the packet, we must step over the slice registers 
-                        // when parsing the packet -- relying on the RegisterInfo byte_offset field would be incorrect.
-                        // If the slice registers are not included, then using the byte_offset values into the
-                        // data buffer is the best way to find individual register values.
-
-                        uint64_t size_including_slice_registers = 0;
-                        uint64_t size_not_including_slice_registers = 0;
-                        uint64_t size_by_highest_offset = 0;
-
-                        for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx)
-                        {
-                            size_including_slice_registers += reg_info->byte_size;
-                            if (reg_info->value_regs == NULL)
-                                size_not_including_slice_registers += reg_info->byte_size;
-                            if (reg_info->byte_offset >= size_by_highest_offset)
-                                size_by_highest_offset = reg_info->byte_offset + reg_info->byte_size;
-                        }
+                        size_including_slice_registers += reg_info->byte_size;
+                        if (reg_info->value_regs == NULL)
+                            size_not_including_slice_registers += reg_info->byte_size;
+                        if (reg_info->byte_offset >= size_by_highest_offset)
+                            size_by_highest_offset = reg_info->byte_offset + reg_info->byte_size;
+                    }
 
-                        bool use_byte_offset_into_buffer;
-                        if (size_by_highest_offset == restore_data.GetByteSize())
-                        {
-                            // The size of the packet agrees with the highest offset: + size in the register file
-                            use_byte_offset_into_buffer = true;
-                        }
-                        else if (size_not_including_slice_registers == restore_data.GetByteSize())
+                    bool use_byte_offset_into_buffer;
+                    if (size_by_highest_offset == restore_data.GetByteSize())
+                    {
+                        // The size of the packet agrees with the highest offset: + size in the register file
+                        use_byte_offset_into_buffer = true;
+                    }
+                    else if (size_not_including_slice_registers == restore_data.GetByteSize())
+                    {
+                        // The size of the packet is the same as concatenating all of the registers sequentially,
+                        // skipping the slice registers
+                        use_byte_offset_into_buffer = true;
+                    }
+                    else if (size_including_slice_registers == restore_data.GetByteSize())
+                    {
+                        // The slice registers are present in the packet (when they shouldn't be).
+                        // Don't try to use the RegisterInfo byte_offset into the restore_data, it will
+                        // point to the wrong place.
+                        use_byte_offset_into_buffer = false;
+                    }
+                    else {
+                        // None of our expected sizes match the actual g packet data we're looking at.
+                        // The most conservative approach here is to use the running total byte offset.
+                        use_byte_offset_into_buffer = false;
+                    }
+
+                    // In case our register definitions don't include the correct offsets,
+                    // keep track of the size of each reg & compute offset based on that.
+                    uint32_t running_byte_offset = 0;
+                    for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx, running_byte_offset += reg_info->byte_size)
+                    {
+                        // Skip composite aka slice registers (e.g. eax is a slice of rax).
+                        if (reg_info->value_regs)
+                            continue;
+
+                        const uint32_t reg = reg_info->kinds[eRegisterKindLLDB];
+
+                        uint32_t register_offset;
+                        if (use_byte_offset_into_buffer)
                         {
-                            // The size of the packet is the same as concatenating all of the registers sequentially,
-                            // skipping the slice registers
-                            use_byte_offset_into_buffer = true;
+                            register_offset = reg_info->byte_offset;
                         }
-                        else if (size_including_slice_registers == restore_data.GetByteSize())
+                        else
                         {
-                            // The slice registers are present in the packet (when they shouldn't be).
-                            // Don't try to use the RegisterInfo byte_offset into the restore_data, it will
-                            // point to the wrong place.
-                            use_byte_offset_into_buffer = false;
-                        }
-                        else {
-                            // None of our expected sizes match the actual g packet data we're looking at.
-                            // The most conservative approach here is to use the running total byte offset.
-                            use_byte_offset_into_buffer = false;
+                            register_offset = running_byte_offset;
                         }
 
-                        // In case our register definitions don't include the correct offsets,
-                        // keep track of the size of each reg & compute offset based on that.
-                        uint32_t running_byte_offset = 0;
-                        for (uint32_t reg_idx=0; (reg_info = GetRegisterInfoAtIndex (reg_idx)) != NULL; ++reg_idx, running_byte_offset += reg_info->byte_size)
+                        // Only write down the registers that need to be written
+                        // if we are going to be doing registers individually.
+                        bool write_reg = true;
+                        const uint32_t reg_byte_size = reg_info->byte_size;
+
+                        const char *restore_src = (const char *)restore_data.PeekData(register_offset, reg_byte_size);
+                        if (restore_src)
                         {
-                            // Skip composite aka slice registers (e.g. eax is a slice of rax).
-                            if (reg_info->value_regs)
-                                continue;
+                            StreamString packet;
+                            packet.Printf ("P%x=", reg);
+                            packet.PutBytesAsRawHex8 (restore_src,
+                                                      reg_byte_size,
+                                                      lldb::endian::InlHostByteOrder(),
+                                                      lldb::endian::InlHostByteOrder());
 
-                            const uint32_t reg = reg_info->kinds[eRegisterKindLLDB];
+                            if (thread_suffix_supported)
+                                packet.Printf (";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
 
-                            uint32_t register_offset;
-                            if (use_byte_offset_into_buffer)
-                            {
-                                register_offset = reg_info->byte_offset;
-                            }
-                            else
+                            SetRegisterIsValid(reg, false);
+                            if (gdb_comm.SendPacketAndWaitForResponse(packet.GetString().c_str(),
+                                                                      packet.GetString().size(),
+                                                                      response,
+                                                                      false) == GDBRemoteCommunication::PacketResult::Success)
                             {
-                                register_offset = running_byte_offset;
+                                const char *current_src = (const char *)m_reg_data.PeekData(register_offset, reg_byte_size);
+                                if (current_src)
+                                    write_reg = memcmp (current_src, restore_src, reg_byte_size) != 0;
                             }
 
-                            // Only write down the registers that need to be written
-                            // if we are going to be doing registers individually.
-                            bool write_reg = true;
-                            const uint32_t reg_byte_size = reg_info->byte_size;
-    
-                            const char *restore_src = (const char *)restore_data.PeekData(register_offset, reg_byte_size);
-                            if (restore_src)
+                            if (write_reg)
                             {
                                 StreamString packet;
                                 packet.Printf ("P%x=", reg);
@@ -783,37 +838,13 @@ GDBRemoteRegisterContext::WriteAllRegisterValues (const lldb::DataBufferSP &data
                                                                           response,
                                                                           false) == GDBRemoteCommunication::PacketResult::Success)
                                 {
-                                    const char *current_src = (const char *)m_reg_data.PeekData(register_offset, reg_byte_size);
-                                    if (current_src)
-                                        write_reg = memcmp (current_src, restore_src, reg_byte_size) != 0;
-                                }
-    
-                                if (write_reg)
-                                {
-                                    StreamString packet;
-                                    packet.Printf ("P%x=", reg);
-                                    packet.PutBytesAsRawHex8 (restore_src,
-                                                              reg_byte_size,
-                                                              lldb::endian::InlHostByteOrder(),
-                                                              lldb::endian::InlHostByteOrder());
-    
-                                    if (thread_suffix_supported)
-                                        packet.Printf (";thread:%4.4" PRIx64 ";", m_thread.GetProtocolID());
-    
-                                    SetRegisterIsValid(reg, false);
-                                    if (gdb_comm.SendPacketAndWaitForResponse(packet.GetString().c_str(),
-                                                                              packet.GetString().size(),
-                                                                              response,
-                                                                              false) == GDBRemoteCommunication::PacketResult::Success)
-                                    {
-                                        if (response.IsOKResponse())
-                                            ++num_restored;
-                                    }
+                                    if (response.IsOKResponse())
+                                        ++num_restored;
                                 }
                             }
                         }
-                        return num_restored > 0;
                     }
+                    return num_restored > 0;
                 }
             }
             else
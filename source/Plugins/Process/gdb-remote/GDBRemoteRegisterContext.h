@@ -162,6 +162,8 @@ private:
     // Helper function for ReadRegisterBytes().
     bool GetPrimordialRegister(const RegisterInfo *reg_info,
                                GDBRemoteCommunicationClient &gdb_comm);
+    // Helper function for ReadRegisterBytes().
+    bool FillRegistersWithGPacket(GDBRemoteCommunicationClient &gdb_comm);
     // Helper function for WriteRegisterBytes().
     bool SetPrimordialRegister(const RegisterInfo *reg_info,
                                GDBRemoteCommunicationClient &gdb_comm);
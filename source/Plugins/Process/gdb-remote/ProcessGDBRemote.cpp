@@ -108,13 +108,17 @@ namespace {
     {
         { "packet-timeout" , OptionValue::eTypeUInt64 , true , 1, NULL, NULL, "Specify the default packet timeout in seconds." },
         { "target-definition-file" , OptionValue::eTypeFileSpec , true, 0 , NULL, NULL, "The file that provides the description for remote target registers." },
+        { "memory-read-window" , OptionValue::eTypeUInt64 , true , 4, NULL, NULL, "The maximum number of memory read packets to keep in flight when reading a large block of memory. Set to 1 to send one packet at a time." },
+        { "packet-compression" , OptionValue::eTypeBoolean, true , true, NULL, NULL, "If true, ask the remote stub to compress large packets if it supports a compression type lldb knows about." },
         {  NULL            , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
     };
     
     enum
     {
         ePropertyPacketTimeout,
-        ePropertyTargetDefinitionFile
+        ePropertyTargetDefinitionFile,
+        ePropertyMemoryReadWindow,
+        ePropertyPacketCompression
     };
     
     class PluginProperties : public Properties
@@ -159,6 +163,20 @@ namespace {
             const uint32_t idx = ePropertyTargetDefinitionFile;
             return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
         }
+
+        uint64_t
+        GetMemoryReadWindow()
+        {
+            const uint32_t idx = ePropertyMemoryReadWindow;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64(NULL, idx, g_properties[idx].default_uint_value);
+        }
+
+        bool
+        GetPacketCompression()
+        {
+            const uint32_t idx = ePropertyPacketCompression;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(NULL, idx, g_properties[idx].default_uint_value != 0);
+        }
     };
     
     typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -279,6 +297,8 @@ ProcessGDBRemote::ProcessGDBRemote(Target& target, Listener &listener) :
     m_async_broadcaster (NULL, "lldb.process.gdb-remote.async-broadcaster"),
     m_async_thread_state_mutex(Mutex::eMutexTypeRecursive),
     m_thread_ids (),
+    m_threads_info_sp (),
+    m_thread_id_to_thread_info (),
     m_continue_c_tids (),
     m_continue_C_tids (),
     m_continue_s_tids (),
@@ -1057,6 +1077,8 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
     m_gdb_comm.GetHostInfo ();
     m_gdb_comm.GetVContSupported ('c');
     m_gdb_comm.GetVAttachOrWaitSupported();
+    if (GetGlobalPluginProperties()->GetPacketCompression())
+        m_gdb_comm.MaybeEnableCompression ();
     
     size_t num_cmds = GetExtraStartupCommands().GetArgumentCount();
     for (size_t idx = 0; idx < num_cmds; idx++)
@@ -1565,12 +1587,84 @@ ProcessGDBRemote::ClearThreadIDList ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
     m_thread_ids.clear();
+    m_threads_info_sp.reset();
+    m_thread_id_to_thread_info.clear();
+}
+
+bool
+ProcessGDBRemote::UpdateThreadsInfo ()
+{
+    Mutex::Locker locker(m_thread_list_real.GetMutex());
+    if (m_threads_info_sp)
+        return true;
+
+    // Get the stop info, name and expedited registers of every thread in
+    // one packet. ThreadGDBRemote::CalculateStopInfo() will use this
+    // instead of sending a qThreadStopInfo packet per thread.
+    m_threads_info_sp = m_gdb_comm.GetThreadsInfo();
+    if (!m_threads_info_sp)
+        return false;
+
+    StructuredData::Array *thread_infos = m_threads_info_sp->GetAsArray();
+    const size_t num_thread_infos = thread_infos->GetSize();
+    for (size_t i = 0; i < num_thread_infos; ++i)
+    {
+        StructuredData::Dictionary *thread_dict = thread_infos->GetItemAtIndex(i)->GetAsDictionary();
+        lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+        if (thread_dict && thread_dict->GetValueForKeyAsInteger ("tid", tid) && tid != LLDB_INVALID_THREAD_ID)
+            m_thread_id_to_thread_info[tid] = thread_dict;
+    }
+
+    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
+    if (log)
+        log->Printf ("ProcessGDBRemote::%s got info for %" PRIu64 " threads", __FUNCTION__, (uint64_t)m_thread_id_to_thread_info.size());
+    return true;
+}
+
+bool
+ProcessGDBRemote::CalculateThreadStopInfo (ThreadGDBRemote *thread)
+{
+    const lldb::tid_t tid = thread->GetProtocolID();
+    {
+        Mutex::Locker locker(m_thread_list_real.GetMutex());
+        if (UpdateThreadsInfo())
+        {
+            ThreadInfoMap::iterator pos = m_thread_id_to_thread_info.find(tid);
+            if (pos != m_thread_id_to_thread_info.end())
+                return SetThreadStopInfo (pos->second).get() != NULL;
+        }
+    }
+
+    StringExtractorGDBRemote stop_packet;
+    if (m_gdb_comm.GetThreadStopInfo(tid, stop_packet))
+        return SetThreadStopInfo (stop_packet) == eStateStopped;
+    return false;
 }
 
 bool
 ProcessGDBRemote::UpdateThreadIDList ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
+
+    // If the remote stub supports "jThreadsInfo", the same packet that
+    // gives us the thread IDs also has the stop info for all threads.
+    if (UpdateThreadsInfo())
+    {
+        // Keep the order the remote stub listed the threads in so thread
+        // index IDs get handed out the same way as with qfThreadInfo.
+        m_thread_ids.clear();
+        StructuredData::Array *thread_infos = m_threads_info_sp->GetAsArray();
+        const size_t num_thread_infos = thread_infos->GetSize();
+        for (size_t i = 0; i < num_thread_infos; ++i)
+        {
+            StructuredData::Dictionary *thread_dict = thread_infos->GetItemAtIndex(i)->GetAsDictionary();
+            lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+            if (thread_dict && thread_dict->GetValueForKeyAsInteger ("tid", tid) && tid != LLDB_INVALID_THREAD_ID)
+                m_thread_ids.push_back (tid);
+        }
+        return true;
+    }
+
     bool sequence_mutex_unavailable = false;
     m_gdb_comm.GetCurrentThreadIDs (m_thread_ids, sequence_mutex_unavailable);
     if (sequence_mutex_unavailable)
@@ -1643,6 +1737,290 @@ ProcessGDBRemote::UpdateThreadList (ThreadList &old_thread_list, ThreadList &new
 }
 
 
+ThreadSP
+ProcessGDBRemote::SetThreadStopInfo (lldb::tid_t tid,
+                                     ExpeditedRegisterMap &expedited_register_map,
+                                     uint8_t signo,
+                                     const std::string &thread_name,
+                                     const std::string &reason,
+                                     const std::string &description,
+                                     uint32_t exc_type,
+                                     const std::vector<addr_t> &exc_data,
+                                     addr_t thread_dispatch_qaddr)
+{
+    ThreadSP thread_sp;
+
+    if (tid != LLDB_INVALID_THREAD_ID)
+    {
+        // m_thread_list_real does have its own mutex, but we need to
+        // hold onto the mutex between the call to m_thread_list_real.FindThreadByID(...)
+        // and the m_thread_list_real.AddThread(...) so it doesn't change on us
+        Mutex::Locker locker (m_thread_list_real.GetMutex ());
+        thread_sp = m_thread_list_real.FindThreadByProtocolID(tid, false);
+
+        if (!thread_sp)
+        {
+            // Create the thread if we need to
+            thread_sp.reset (new ThreadGDBRemote (*this, tid));
+            Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
+            if (log && log->GetMask().Test(GDBR_LOG_VERBOSE))
+                log->Printf ("ProcessGDBRemote::%s Adding new thread: %p for thread ID: 0x%" PRIx64 ".\n",
+                             __FUNCTION__,
+                             static_cast<void*>(thread_sp.get()),
+                             thread_sp->GetID());
+
+            m_thread_list_real.AddThread(thread_sp);
+        }
+    }
+    else
+    {
+        // If the response is old style 'S' packet which does not provide us with thread information
+        // then update the thread list and choose the first one.
+        UpdateThreadIDList ();
+
+        if (!m_thread_ids.empty ())
+        {
+            Mutex::Locker locker (m_thread_list_real.GetMutex ());
+            thread_sp = m_thread_list_real.FindThreadByProtocolID (m_thread_ids.front (), false);
+        }
+    }
+
+    if (thread_sp)
+    {
+        ThreadGDBRemote *gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get());
+
+        // Supply the expedited register values to our thread so it won't
+        // have to go and read them. This must be done before the stop
+        // reason is calculated below since that can read the PC.
+        for (auto &pair : expedited_register_map)
+        {
+            StringExtractor reg_value_extractor;
+            // Swap the value over into "reg_value_extractor"
+            reg_value_extractor.GetStringRef().swap(pair.second);
+            if (!gdb_thread->PrivateSetRegisterValue (pair.first, reg_value_extractor))
+            {
+                Host::SetCrashDescriptionWithFormat("Setting thread register %u (0x%x) with value '%s' for thread 0x%" PRIx64,
+                                                    pair.first,
+                                                    pair.first,
+                                                    reg_value_extractor.GetStringRef().c_str(),
+                                                    thread_sp->GetProtocolID());
+            }
+        }
+
+        // Clear the stop info just in case we don't set it to anything
+        thread_sp->SetStopInfo (StopInfoSP());
+
+        gdb_thread->SetThreadDispatchQAddr (thread_dispatch_qaddr);
+        gdb_thread->SetName (thread_name.empty() ? NULL : thread_name.c_str());
+        if (exc_type != 0)
+        {
+            const size_t exc_data_size = exc_data.size();
+
+            thread_sp->SetStopInfo (StopInfoMachException::CreateStopReasonWithMachException (*thread_sp,
+                                                                                              exc_type,
+                                                                                              exc_data_size,
+                                                                                              exc_data_size >= 1 ? exc_data[0] : 0,
+                                                                                              exc_data_size >= 2 ? exc_data[1] : 0,
+                                                                                              exc_data_size >= 3 ? exc_data[2] : 0));
+        }
+        else
+        {
+            bool handled = false;
+            bool did_exec = false;
+            if (!reason.empty())
+            {
+                if (reason.compare("trace") == 0)
+                {
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
+                    handled = true;
+                }
+                else if (reason.compare("breakpoint") == 0)
+                {
+                    addr_t pc = thread_sp->GetRegisterContext()->GetPC();
+                    lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+                    if (bp_site_sp)
+                    {
+                        // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
+                        // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
+                        // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
+                        handled = true;
+                        if (bp_site_sp->ValidForThisThread (thread_sp.get()))
+                        {
+                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
+                        }
+                        else
+                        {
+                            StopInfoSP invalid_stop_info_sp;
+                            thread_sp->SetStopInfo (invalid_stop_info_sp);
+                        }
+                    }
+                }
+                else if (reason.compare("trap") == 0)
+                {
+                    // Let the trap just use the standard signal stop reason below...
+                }
+                else if (reason.compare("watchpoint") == 0)
+                {
+                    StringExtractor desc_extractor(description.c_str());
+                    addr_t wp_addr = desc_extractor.GetU64(LLDB_INVALID_ADDRESS);
+                    uint32_t wp_index = desc_extractor.GetU32(LLDB_INVALID_INDEX32);
+                    watch_id_t watch_id = LLDB_INVALID_WATCH_ID;
+                    if (wp_addr != LLDB_INVALID_ADDRESS)
+                    {
+                        WatchpointSP wp_sp = GetTarget().GetWatchpointList().FindByAddress(wp_addr);
+                        if (wp_sp)
+                        {
+                            wp_sp->SetHardwareIndex(wp_index);
+                            watch_id = wp_sp->GetID();
+                        }
+                    }
+                    if (watch_id == LLDB_INVALID_WATCH_ID)
+                    {
+                        Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_WATCHPOINTS));
+                        if (log) log->Printf ("failed to find watchpoint");
+                    }
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithWatchpointID (*thread_sp, watch_id));
+                    handled = true;
+                }
+                else if (reason.compare("exception") == 0)
+                {
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException(*thread_sp, description.c_str()));
+                    handled = true;
+                }
+                else if (reason.compare("exec") == 0)
+                {
+                    did_exec = true;
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithExec(*thread_sp));
+                    handled = true;
+                }
+            }
+
+            if (!handled && signo && did_exec == false)
+            {
+                if (signo == SIGTRAP)
+                {
+                    // Currently we are going to assume SIGTRAP means we are either
+                    // hitting a breakpoint or hardware single stepping. 
+                    handled = true;
+                    addr_t pc = thread_sp->GetRegisterContext()->GetPC() + m_breakpoint_pc_offset;
+                    lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
+
+                    if (bp_site_sp)
+                    {
+                        // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
+                        // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
+                        // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
+                        if (bp_site_sp->ValidForThisThread (thread_sp.get()))
+                        {
+                            if(m_breakpoint_pc_offset != 0)
+                                thread_sp->GetRegisterContext()->SetPC(pc);
+                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
+                        }
+                        else
+                        {
+                            StopInfoSP invalid_stop_info_sp;
+                            thread_sp->SetStopInfo (invalid_stop_info_sp);
+                        }
+                    }
+                    else
+                    {
+                        // If we were stepping then assume the stop was the result of the trace.  If we were
+                        // not stepping then report the SIGTRAP.
+                        // FIXME: We are still missing the case where we single step over a trap instruction.
+                        if (thread_sp->GetTemporaryResumeState() == eStateStepping)
+                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
+                        else
+                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal(*thread_sp, signo));
+                    }
+                }
+                if (!handled)
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal (*thread_sp, signo));
+            }
+
+            if (!description.empty())
+            {
+                lldb::StopInfoSP stop_info_sp (thread_sp->GetStopInfo ());
+                if (stop_info_sp)
+                {
+                    stop_info_sp->SetDescription (description.c_str());
+                }
+                else
+                {
+                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException (*thread_sp, description.c_str()));
+                }
+            }
+        }
+    }
+    return thread_sp;
+}
+
+ThreadSP
+ProcessGDBRemote::SetThreadStopInfo (StructuredData::Dictionary *thread_dict)
+{
+    // Decode one thread dictionary from a "jThreadsInfo" reply:
+    //  {"tid":1234,"name":"a.out","signal":5,"reason":"breakpoint",
+    //   "registers":{"0":"0000000000000000",...},"metype":1,"medata":[1,2],
+    //   "qaddr":140735087127872}
+    lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+    if (!thread_dict->GetValueForKeyAsInteger ("tid", tid))
+        return ThreadSP();
+
+    uint32_t signo = 0;
+    thread_dict->GetValueForKeyAsInteger ("signal", signo);
+
+    std::string thread_name;
+    std::string reason;
+    std::string description;
+    thread_dict->GetValueForKeyAsString ("name", thread_name);
+    thread_dict->GetValueForKeyAsString ("reason", reason);
+    thread_dict->GetValueForKeyAsString ("description", description);
+
+    addr_t thread_dispatch_qaddr = LLDB_INVALID_ADDRESS;
+    thread_dict->GetValueForKeyAsInteger ("qaddr", thread_dispatch_qaddr);
+
+    uint32_t exc_type = 0;
+    std::vector<addr_t> exc_data;
+    thread_dict->GetValueForKeyAsInteger ("metype", exc_type);
+    StructuredData::Array *medata_array = nullptr;
+    if (thread_dict->GetValueForKeyAsArray ("medata", medata_array) && medata_array)
+    {
+        for (size_t i = 0; i < medata_array->GetSize(); ++i)
+        {
+            addr_t value = 0;
+            if (medata_array->GetItemAtIndexAsInteger (i, value))
+                exc_data.push_back (value);
+        }
+    }
+
+    ExpeditedRegisterMap expedited_register_map;
+    StructuredData::Dictionary *registers_dict = nullptr;
+    if (thread_dict->GetValueForKeyAsDictionary ("registers", registers_dict) && registers_dict)
+    {
+        StructuredData::ObjectSP keys_sp (registers_dict->GetKeys());
+        StructuredData::Array *keys = keys_sp->GetAsArray();
+        for (size_t i = 0; i < keys->GetSize(); ++i)
+        {
+            std::string key;
+            std::string value;
+            if (!keys->GetItemAtIndexAsString (i, key) || !registers_dict->GetValueForKeyAsString (key, value))
+                continue;
+            const uint32_t reg = StringConvert::ToUInt32 (key.c_str(), UINT32_MAX, 10);
+            if (reg != UINT32_MAX)
+                expedited_register_map[reg] = value;
+        }
+    }
+
+    return SetThreadStopInfo (tid,
+                              expedited_register_map,
+                              signo,
+                              thread_name,
+                              reason,
+                              description,
+                              exc_type,
+                              exc_data,
+                              thread_dispatch_qaddr);
+}
+
 StateType
 ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
 {
@@ -1681,8 +2059,8 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
             uint32_t exc_type = 0;
             std::vector<addr_t> exc_data;
             addr_t thread_dispatch_qaddr = LLDB_INVALID_ADDRESS;
-            ThreadSP thread_sp;
-            ThreadGDBRemote *gdb_thread = NULL;
+            lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+            ExpeditedRegisterMap expedited_register_map;
 
             while (stop_packet.GetNameColonValue(name, value))
             {
@@ -1699,28 +2077,7 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                 else if (name.compare("thread") == 0)
                 {
                     // thread in big endian hex
-                    lldb::tid_t tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
-                    // m_thread_list_real does have its own mutex, but we need to
-                    // hold onto the mutex between the call to m_thread_list_real.FindThreadByID(...)
-                    // and the m_thread_list_real.AddThread(...) so it doesn't change on us
-                    Mutex::Locker locker (m_thread_list_real.GetMutex ());
-                    thread_sp = m_thread_list_real.FindThreadByProtocolID(tid, false);
-
-                    if (!thread_sp)
-                    {
-                        // Create the thread if we need to
-                        thread_sp.reset (new ThreadGDBRemote (*this, tid));
-                        Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_THREAD));
-                        if (log && log->GetMask().Test(GDBR_LOG_VERBOSE))
-                            log->Printf ("ProcessGDBRemote::%s Adding new thread: %p for thread ID: 0x%" PRIx64 ".\n",
-                                         __FUNCTION__,
-                                         static_cast<void*>(thread_sp.get()),
-                                         thread_sp->GetID());
-
-                        m_thread_list_real.AddThread(thread_sp);
-                    }
-                    gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get());
-
+                    tid = StringConvert::ToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
                 }
                 else if (name.compare("threads") == 0)
                 {
@@ -1777,192 +2134,24 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                 else if (name.size() == 2 && ::isxdigit(name[0]) && ::isxdigit(name[1]))
                 {
                     // We have a register number that contains an expedited
-                    // register value. Lets supply this register to our thread
-                    // so it won't have to go and read it.
-                    if (gdb_thread)
-                    {
-                        uint32_t reg = StringConvert::ToUInt32 (name.c_str(), UINT32_MAX, 16);
-
-                        if (reg != UINT32_MAX)
-                        {
-                            StringExtractor reg_value_extractor;
-                            // Swap "value" over into "reg_value_extractor"
-                            reg_value_extractor.GetStringRef().swap(value);
-                            if (!gdb_thread->PrivateSetRegisterValue (reg, reg_value_extractor))
-                            {
-                                Host::SetCrashDescriptionWithFormat("Setting thread register '%s' (decoded to %u (0x%x)) with value '%s' for stop packet: '%s'", 
-                                                                    name.c_str(), 
-                                                                    reg, 
-                                                                    reg, 
-                                                                    reg_value_extractor.GetStringRef().c_str(), 
-                                                                    stop_packet.GetStringRef().c_str());
-                            }
-                        }
-                    }
+                    // register value. Save it so we can supply it to the
+                    // thread once we know which thread this packet is for.
+                    uint32_t reg = StringConvert::ToUInt32 (name.c_str(), UINT32_MAX, 16);
+                    if (reg != UINT32_MAX)
+                        expedited_register_map[reg] = value;
                 }
             }
 
-            // If the response is old style 'S' packet which does not provide us with thread information
-            // then update the thread list and choose the first one.
-            if (!thread_sp)
-            {
-                UpdateThreadIDList ();
+            SetThreadStopInfo (tid,
+                               expedited_register_map,
+                               signo,
+                               thread_name,
+                               reason,
+                               description,
+                               exc_type,
+                               exc_data,
+                               thread_dispatch_qaddr);
 
-                if (!m_thread_ids.empty ())
-                {
-                    Mutex::Locker locker (m_thread_list_real.GetMutex ());
-                    thread_sp = m_thread_list_real.FindThreadByProtocolID (m_thread_ids.front (), false);
-                    if (thread_sp)
-                        gdb_thread = static_cast<ThreadGDBRemote *> (thread_sp.get ());
-                }
-            }
-
-            if (thread_sp)
-            {
-                // Clear the stop info just in case we don't set it to anything
-                thread_sp->SetStopInfo (StopInfoSP());
-
-                gdb_thread->SetThreadDispatchQAddr (thread_dispatch_qaddr);
-                gdb_thread->SetName (thread_name.empty() ? NULL : thread_name.c_str());
-                if (exc_type != 0)
-                {
-                    const size_t exc_data_size = exc_data.size();
-
-                    thread_sp->SetStopInfo (StopInfoMachException::CreateStopReasonWithMachException (*thread_sp,
-                                                                                                      exc_type,
-                                                                                                      exc_data_size,
-                                                                                                      exc_data_size >= 1 ? exc_data[0] : 0,
-                                                                                                      exc_data_size >= 2 ? exc_data[1] : 0,
-                                                                                                      exc_data_size >= 3 ? exc_data[2] : 0));
-                }
-                else
-                {
-                    bool handled = false;
-                    bool did_exec = false;
-                    if (!reason.empty())
-                    {
-                        if (reason.compare("trace") == 0)
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
-                            handled = true;
-                        }
-                        else if (reason.compare("breakpoint") == 0)
-                        {
-                            addr_t pc = thread_sp->GetRegisterContext()->GetPC();
-                            lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
-                            if (bp_site_sp)
-                            {
-                                // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
-                                // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
-                                // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
-                                handled = true;
-                                if (bp_site_sp->ValidForThisThread (thread_sp.get()))
-                                {
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
-                                }
-                                else
-                                {
-                                    StopInfoSP invalid_stop_info_sp;
-                                    thread_sp->SetStopInfo (invalid_stop_info_sp);
-                                }
-                            }
-                        }
-                        else if (reason.compare("trap") == 0)
-                        {
-                            // Let the trap just use the standard signal stop reason below...
-                        }
-                        else if (reason.compare("watchpoint") == 0)
-                        {
-                            StringExtractor desc_extractor(description.c_str());
-                            addr_t wp_addr = desc_extractor.GetU64(LLDB_INVALID_ADDRESS);
-                            uint32_t wp_index = desc_extractor.GetU32(LLDB_INVALID_INDEX32);
-                            watch_id_t watch_id = LLDB_INVALID_WATCH_ID;
-                            if (wp_addr != LLDB_INVALID_ADDRESS)
-                            {
-                                WatchpointSP wp_sp = GetTarget().GetWatchpointList().FindByAddress(wp_addr);
-                                if (wp_sp)
-                                {
-                                    wp_sp->SetHardwareIndex(wp_index);
-                                    watch_id = wp_sp->GetID();
-                                }
-                            }
-                            if (watch_id == LLDB_INVALID_WATCH_ID)
-                            {
-                                Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_WATCHPOINTS));
-                                if (log) log->Printf ("failed to find watchpoint");
-                            }
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithWatchpointID (*thread_sp, watch_id));
-                            handled = true;
-                        }
-                        else if (reason.compare("exception") == 0)
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException(*thread_sp, description.c_str()));
-                            handled = true;
-                        }
-                        else if (reason.compare("exec") == 0)
-                        {
-                            did_exec = true;
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithExec(*thread_sp));
-                            handled = true;
-                        }
-                    }
-
-                    if (!handled && signo && did_exec == false)
-                    {
-                        if (signo == SIGTRAP)
-                        {
-                            // Currently we are going to assume SIGTRAP means we are either
-                            // hitting a breakpoint or hardware single stepping. 
-                            handled = true;
-                            addr_t pc = thread_sp->GetRegisterContext()->GetPC() + m_breakpoint_pc_offset;
-                            lldb::BreakpointSiteSP bp_site_sp = thread_sp->GetProcess()->GetBreakpointSiteList().FindByAddress(pc);
-
-                            if (bp_site_sp)
-                            {
-                                // If the breakpoint is for this thread, then we'll report the hit, but if it is for another thread,
-                                // we can just report no reason.  We don't need to worry about stepping over the breakpoint here, that
-                                // will be taken care of when the thread resumes and notices that there's a breakpoint under the pc.
-                                if (bp_site_sp->ValidForThisThread (thread_sp.get()))
-                                {
-                                    if(m_breakpoint_pc_offset != 0)
-                                        thread_sp->GetRegisterContext()->SetPC(pc);
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithBreakpointSiteID (*thread_sp, bp_site_sp->GetID()));
-                                }
-                                else
-                                {
-                                    StopInfoSP invalid_stop_info_sp;
-                                    thread_sp->SetStopInfo (invalid_stop_info_sp);
-                                }
-                            }
-                            else
-                            {
-                                // If we were stepping then assume the stop was the result of the trace.  If we were
-                                // not stepping then report the SIGTRAP.
-                                // FIXME: We are still missing the case where we single step over a trap instruction.
-                                if (thread_sp->GetTemporaryResumeState() == eStateStepping)
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonToTrace (*thread_sp));
-                                else
-                                    thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal(*thread_sp, signo));
-                            }
-                        }
-                        if (!handled)
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithSignal (*thread_sp, signo));
-                    }
-
-                    if (!description.empty())
-                    {
-                        lldb::StopInfoSP stop_info_sp (thread_sp->GetStopInfo ());
-                        if (stop_info_sp)
-                        {
-                            stop_info_sp->SetDescription (description.c_str());
-                        }
-                        else
-                        {
-                            thread_sp->SetStopInfo (StopInfo::CreateStopReasonWithException (*thread_sp, description.c_str()));
-                        }
-                    }
-                }
-            }
             return eStateStopped;
         }
         break;
@@ -1983,6 +2172,8 @@ ProcessGDBRemote::RefreshStateAfterStop ()
 {
     Mutex::Locker locker(m_thread_list_real.GetMutex());
     m_thread_ids.clear();
+    m_threads_info_sp.reset();
+    m_thread_id_to_thread_info.clear();
     // Set the thread stop info. It might have a "threads" key whose value is
     // a list of all thread IDs in the current process, so m_thread_ids might
     // get set.
@@ -2287,21 +2478,11 @@ ProcessGDBRemote::GetImageInfoAddress()
 //------------------------------------------------------------------
 // Process Memory
 //------------------------------------------------------------------
-size_t
-ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &error)
+static std::string
+MakeMemoryReadPacket (addr_t addr, size_t size, bool binary_memory_read)
 {
-    GetMaxMemorySize ();
-    if (size > m_max_memory_size)
-    {
-        // Keep memory read sizes down to a sane limit. This function will be
-        // called multiple times in order to complete the task by 
-        // lldb_private::Process so it is ok to do this.
-        size = m_max_memory_size;
-    }
-
     char packet[64];
     int packet_len;
-    bool binary_memory_read = m_gdb_comm.GetxPacketSupported();
     if (binary_memory_read)
     {
         packet_len = ::snprintf (packet, sizeof(packet), "x0x%" PRIx64 ",0x%" PRIx64, (uint64_t)addr, (uint64_t)size);
@@ -2311,46 +2492,133 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
         packet_len = ::snprintf (packet, sizeof(packet), "m%" PRIx64 ",%" PRIx64, (uint64_t)addr, (uint64_t)size);
     }
     assert (packet_len + 1 < (int)sizeof(packet));
-    StringExtractorGDBRemote response;
-    if (m_gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, true) == GDBRemoteCommunication::PacketResult::Success)
+    return std::string (packet, packet_len);
+}
+
+static size_t
+ParseMemoryReadResponse (StringExtractorGDBRemote &response,
+                         const std::string &packet,
+                         bool binary_memory_read,
+                         addr_t addr,
+                         void *buf,
+                         size_t size,
+                         Error &error)
+{
+    if (response.IsNormalResponse())
     {
-        if (response.IsNormalResponse())
+        error.Clear();
+        if (binary_memory_read)
         {
-            error.Clear();
-            if (binary_memory_read)
-            {
-                // The lower level GDBRemoteCommunication packet receive layer has already de-quoted any
-                // 0x7d character escaping that was present in the packet
+            // The lower level GDBRemoteCommunication packet receive layer has already de-quoted any
+            // 0x7d character escaping that was present in the packet, after inflating it if it was
+            // compressed
 
-                size_t data_received_size = response.GetBytesLeft();
-                if (data_received_size > size)
-                {
-                    // Don't write past the end of BUF if the remote debug server gave us too
-                    // much data for some reason.
-                    data_received_size = size;
-                }
-                memcpy (buf, response.GetStringRef().data(), data_received_size);
-                return data_received_size;
-            }
-            else
+            size_t data_received_size = response.GetBytesLeft();
+            if (data_received_size > size)
             {
-                return response.GetHexBytes(buf, size, '\xdd');
+                // Don't write past the end of BUF if the remote debug server gave us too
+                // much data for some reason.
+                data_received_size = size;
             }
+            memcpy (buf, response.GetStringRef().data(), data_received_size);
+            return data_received_size;
         }
-        else if (response.IsErrorResponse())
-            error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, addr);
-        else if (response.IsUnsupportedResponse())
-            error.SetErrorStringWithFormat("GDB server does not support reading memory");
         else
-            error.SetErrorStringWithFormat("unexpected response to GDB server memory read packet '%s': '%s'", packet, response.GetStringRef().c_str());
+        {
+            return response.GetHexBytes(buf, size, '\xdd');
+        }
+    }
+    else if (response.IsErrorResponse())
+        error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, addr);
+    else if (response.IsUnsupportedResponse())
+        error.SetErrorStringWithFormat("GDB server does not support reading memory");
+    else
+        error.SetErrorStringWithFormat("unexpected response to GDB server memory read packet '%s': '%s'", packet.c_str(), response.GetStringRef().c_str());
+    return 0;
+}
+
+size_t
+ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &error)
+{
+    GetMaxMemorySize ();
+    const bool binary_memory_read = m_gdb_comm.GetxPacketSupported();
+    if (size > m_max_memory_size)
+    {
+        // Large reads are split up into m_max_memory_size chunks that are
+        // all sent to the remote stub without waiting for each reply.
+        size_t bytes_read = 0;
+        if (ReadMemoryPipelined (addr, buf, size, binary_memory_read, bytes_read, error))
+            return bytes_read;
+
+        // Keep memory read sizes down to a sane limit. This function will be
+        // called multiple times in order to complete the task by 
+        // lldb_private::Process so it is ok to do this.
+        size = m_max_memory_size;
+    }
+
+    const std::string packet (MakeMemoryReadPacket (addr, size, binary_memory_read));
+    StringExtractorGDBRemote response;
+    if (m_gdb_comm.SendPacketAndWaitForResponse(packet.c_str(), packet.size(), response, true) == GDBRemoteCommunication::PacketResult::Success)
+    {
+        return ParseMemoryReadResponse (response, packet, binary_memory_read, addr, buf, size, error);
     }
     else
     {
-        error.SetErrorStringWithFormat("failed to send packet: '%s'", packet);
+        error.SetErrorStringWithFormat("failed to send packet: '%s'", packet.c_str());
     }
     return 0;
 }
 
+bool
+ProcessGDBRemote::ReadMemoryPipelined (addr_t addr,
+                                       void *buf,
+                                       size_t size,
+                                       bool binary_memory_read,
+                                       size_t &bytes_read,
+                                       Error &error)
+{
+    const uint64_t window_size = GetGlobalPluginProperties()->GetMemoryReadWindow();
+    if (window_size <= 1)
+        return false;
+
+    std::vector<std::string> packets;
+    for (size_t offset = 0; offset < size; offset += m_max_memory_size)
+        packets.push_back (MakeMemoryReadPacket (addr + offset, std::min<size_t> (m_max_memory_size, size - offset), binary_memory_read));
+
+    std::vector<StringExtractorGDBRemote> responses;
+    const GDBRemoteCommunication::PacketResult result = m_gdb_comm.SendPacketsAndWaitForResponses (packets,
+                                                                                                   responses,
+                                                                                                   (uint32_t)std::min<uint64_t> (window_size, UINT32_MAX));
+    // The sequence mutex is only unavailable while the process is running,
+    // let DoReadMemory() send a single packet with an async interrupt.
+    if (result == GDBRemoteCommunication::PacketResult::ErrorNoSequenceLock)
+        return false;
+
+    // Copy the data out of the replies in order and stop at the first chunk
+    // that comes back short, Process::ReadMemoryFromInferior() will call us
+    // again for whatever is left.
+    uint8_t *dst = (uint8_t *)buf;
+    bytes_read = 0;
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        const size_t chunk_size = std::min<size_t> (m_max_memory_size, size - bytes_read);
+        const size_t chunk_bytes_read = ParseMemoryReadResponse (responses[i],
+                                                                 packets[i],
+                                                                 binary_memory_read,
+                                                                 addr + bytes_read,
+                                                                 dst + bytes_read,
+                                                                 chunk_size,
+                                                                 error);
+        bytes_read += chunk_bytes_read;
+        if (chunk_bytes_read != chunk_size)
+            break;
+    }
+
+    if (responses.empty())
+        error.SetErrorStringWithFormat("failed to send packet: '%s'", packets.front().c_str());
+    return true;
+}
+
 size_t
 ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
 {
@@ -14,6 +14,7 @@
 
 // C++ Includes
 #include <list>
+#include <map>
 #include <vector>
 
 // Other libraries and framework includes
@@ -344,7 +345,11 @@ protected:
     typedef std::vector<lldb::tid_t> tid_collection;
     typedef std::vector< std::pair<lldb::tid_t,int> > tid_sig_collection;
     typedef std::map<lldb::addr_t, lldb::addr_t> MMapMap;
+    typedef std::map<uint32_t, std::string> ExpeditedRegisterMap;
+    typedef std::map<lldb::tid_t, StructuredData::Dictionary *> ThreadInfoMap;
     tid_collection m_thread_ids; // Thread IDs for all threads. This list gets updated after stopping
+    StructuredData::ObjectSP m_threads_info_sp; // The "jThreadsInfo" reply for the current stop, if we asked for it
+    ThreadInfoMap m_thread_id_to_thread_info; // Dictionaries in m_threads_info_sp indexed by thread ID
     tid_collection m_continue_c_tids;                  // 'c' for continue
     tid_sig_collection m_continue_C_tids; // 'C' for continue with signal
     tid_collection m_continue_s_tids;                  // 's' for step
@@ -377,6 +382,34 @@ protected:
     lldb::StateType
     SetThreadStopInfo (StringExtractor& stop_packet);
 
+    lldb::ThreadSP
+    SetThreadStopInfo (StructuredData::Dictionary *thread_dict);
+
+    lldb::ThreadSP
+    SetThreadStopInfo (lldb::tid_t tid,
+                       ExpeditedRegisterMap &expedited_register_map,
+                       uint8_t signo,
+                       const std::string &thread_name,
+                       const std::string &reason,
+                       const std::string &description,
+                       uint32_t exc_type,
+                       const std::vector<lldb::addr_t> &exc_data,
+                       lldb::addr_t thread_dispatch_qaddr);
+
+    bool
+    CalculateThreadStopInfo (ThreadGDBRemote *thread);
+
+    bool
+    UpdateThreadsInfo ();
+
+    bool
+    ReadMemoryPipelined (lldb::addr_t addr,
+                         void *buf,
+                         size_t size,
+                         bool binary_memory_read,
+                         size_t &bytes_read,
+                         Error &error);
+
     void
     ClearThreadIDList ();
 
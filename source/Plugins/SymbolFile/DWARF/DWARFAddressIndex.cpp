@@ -0,0 +1,151 @@
+//===-- DWARFAddressIndex.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFAddressIndex.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace {
+
+// The start or end of one of the appended ranges
+struct RangeEdge
+{
+    dw_addr_t address;
+    uint32_t range_idx;
+    bool is_start;
+
+    bool
+    operator < (const RangeEdge &rhs) const
+    {
+        return address < rhs.address;
+    }
+};
+
+}  // anonymous namespace
+
+DWARFAddressIndex::DWARFAddressIndex () :
+    m_ranges (),
+    m_segments ()
+{
+}
+
+void
+DWARFAddressIndex::Append (dw_addr_t lo_pc, dw_addr_t hi_pc, uint32_t depth, const Entry &entry)
+{
+    if (lo_pc < hi_pc)
+    {
+        Range range = { lo_pc, hi_pc, depth, entry };
+        m_ranges.push_back (range);
+    }
+}
+
+void
+DWARFAddressIndex::Append (const DWARFAddressIndex &index)
+{
+    m_ranges.insert (m_ranges.end(), index.m_ranges.begin(), index.m_ranges.end());
+}
+
+void
+DWARFAddressIndex::Finalize ()
+{
+    m_segments.clear();
+
+    std::vector<RangeEdge> edges;
+    edges.reserve (m_ranges.size() * 2);
+    for (uint32_t i = 0; i < m_ranges.size(); ++i)
+    {
+        RangeEdge start = { m_ranges[i].lo_pc, i, true };
+        RangeEdge end = { m_ranges[i].hi_pc, i, false };
+        edges.push_back (start);
+        edges.push_back (end);
+    }
+    std::sort (edges.begin(), edges.end());
+
+    // Sweep over the edges keeping the ranges that cover the current
+    // address ordered by depth, and then by the order they were
+    // appended in, so the last one is the one that wins
+    std::set<std::pair<uint32_t, uint32_t> > covering;
+    size_t edge_idx = 0;
+    while (edge_idx < edges.size())
+    {
+        const dw_addr_t address = edges[edge_idx].address;
+        for (; edge_idx < edges.size() && edges[edge_idx].address == address; ++edge_idx)
+        {
+            const RangeEdge &edge = edges[edge_idx];
+            const std::pair<uint32_t, uint32_t> key (m_ranges[edge.range_idx].depth, edge.range_idx);
+            if (edge.is_start)
+                covering.insert (key);
+            else
+                covering.erase (key);
+        }
+
+        if (covering.empty() || edge_idx == edges.size())
+            continue;
+
+        const Entry &entry = m_ranges[covering.rbegin()->second].entry;
+        const dw_addr_t end_address = edges[edge_idx].address;
+        if (!m_segments.empty() && m_segments.back().hi_pc == address && m_segments.back().entry == entry)
+        {
+            m_segments.back().hi_pc = end_address;
+        }
+        else
+        {
+            Segment segment = { address, end_address, entry };
+            m_segments.push_back (segment);
+        }
+    }
+
+    std::vector<Range>().swap (m_ranges);
+    std::vector<Segment>(m_segments).swap (m_segments);
+}
+
+std::vector<DWARFAddressIndex::Segment>::const_iterator
+DWARFAddressIndex::FindSegment (std::vector<Segment>::const_iterator first, dw_addr_t address) const
+{
+    // The segments don't overlap so their ends are sorted too
+    return std::upper_bound (first, m_segments.end(), address,
+                             [](dw_addr_t address, const Segment &segment) { return address < segment.hi_pc; });
+}
+
+const DWARFAddressIndex::Entry *
+DWARFAddressIndex::FindAddress (dw_addr_t address) const
+{
+    std::vector<Segment>::const_iterator pos = FindSegment (m_segments.begin(), address);
+    if (pos != m_segments.end() && pos->lo_pc <= address)
+        return &pos->entry;
+    return NULL;
+}
+
+size_t
+DWARFAddressIndex::FindAddresses (const std::vector<dw_addr_t> &addresses,
+                                  std::vector<const Entry *> &entries) const
+{
+    entries.assign (addresses.size(), NULL);
+
+    size_t num_found = 0;
+    std::vector<Segment>::const_iterator cursor = m_segments.begin();
+    for (size_t i = 0; i < addresses.size(); ++i)
+    {
+        // Only search the segments after the previous match unless the
+        // addresses aren't sorted
+        if (i > 0 && addresses[i] < addresses[i - 1])
+            cursor = m_segments.begin();
+        cursor = FindSegment (cursor, addresses[i]);
+        if (cursor == m_segments.end())
+            continue;
+        if (cursor->lo_pc <= addresses[i])
+        {
+            entries[i] = &cursor->entry;
+            ++num_found;
+        }
+    }
+    return num_found;
+}
@@ -0,0 +1,143 @@
+//===-- DWARFAddressIndex.h -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFAddressIndex_h_
+#define SymbolFileDWARF_DWARFAddressIndex_h_
+
+#include <vector>
+
+#include "lldb/Core/dwarf.h"
+
+//----------------------------------------------------------------------
+// Maps the addresses of a module to the compile unit, function and
+// innermost lexical block or inlined function DIEs that contain them.
+//
+// The address ranges of the DIEs nest, so they are appended with their
+// depth and Finalize() flattens them into sorted, non-overlapping
+// segments where the deepest range covering an address wins. Looking
+// up an address is then a binary search that needs no DIEs at all.
+//----------------------------------------------------------------------
+class DWARFAddressIndex
+{
+public:
+    struct Entry
+    {
+        Entry () :
+            cu_offset (DW_INVALID_OFFSET),
+            function_offset (DW_INVALID_OFFSET),
+            block_offset (DW_INVALID_OFFSET)
+        {
+        }
+
+        Entry (dw_offset_t cu, dw_offset_t function, dw_offset_t block) :
+            cu_offset (cu),
+            function_offset (function),
+            block_offset (block)
+        {
+        }
+
+        bool
+        operator == (const Entry &rhs) const
+        {
+            return cu_offset == rhs.cu_offset &&
+                   function_offset == rhs.function_offset &&
+                   block_offset == rhs.block_offset;
+        }
+
+        bool
+        operator != (const Entry &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        dw_offset_t cu_offset;
+        dw_offset_t function_offset;    // DW_INVALID_OFFSET if outside of any function
+        dw_offset_t block_offset;       // DW_INVALID_OFFSET if not in a block of the function
+    };
+
+    DWARFAddressIndex ();
+
+    //------------------------------------------------------------------
+    // Add the range [lo_pc, hi_pc) at "depth", which is 0 for compile
+    // units and one more than the range it is nested in otherwise.
+    // When ranges at the same depth overlap, the one appended last wins.
+    //------------------------------------------------------------------
+    void
+    Append (dw_addr_t lo_pc, dw_addr_t hi_pc, uint32_t depth, const Entry &entry);
+
+    // Append the ranges of "index", which must not be finalized yet
+    void
+    Append (const DWARFAddressIndex &index);
+
+    //------------------------------------------------------------------
+    // Flatten the appended ranges into the segments that are searched.
+    // Must be called once all ranges have been appended and before any
+    // lookups.
+    //------------------------------------------------------------------
+    void
+    Finalize ();
+
+    // Returns NULL if no range contains "address"
+    const Entry *
+    FindAddress (dw_addr_t address) const;
+
+    //------------------------------------------------------------------
+    // Look up each of "addresses" and set the matching element of
+    // "entries" to what FindAddress() would return for it. When the
+    // addresses are sorted this is a single pass over the segments.
+    // Returns the number of addresses that were found.
+    //------------------------------------------------------------------
+    size_t
+    FindAddresses (const std::vector<dw_addr_t> &addresses,
+                   std::vector<const Entry *> &entries) const;
+
+    bool
+    IsEmpty () const
+    {
+        return m_segments.empty();
+    }
+
+    size_t
+    GetNumSegments () const
+    {
+        return m_segments.size();
+    }
+
+    size_t
+    GetMemorySize () const
+    {
+        return m_ranges.capacity() * sizeof(Range) + m_segments.capacity() * sizeof(Segment);
+    }
+
+protected:
+    struct Range
+    {
+        dw_addr_t lo_pc;
+        dw_addr_t hi_pc;
+        uint32_t depth;
+        Entry entry;
+    };
+
+    struct Segment
+    {
+        dw_addr_t lo_pc;
+        dw_addr_t hi_pc;
+        Entry entry;
+    };
+
+    // Returns the first segment at or after "first" whose range ends
+    // after "address"
+    std::vector<Segment>::const_iterator
+    FindSegment (std::vector<Segment>::const_iterator first, dw_addr_t address) const;
+
+    std::vector<Range> m_ranges;        // Appended ranges, until finalized
+    std::vector<Segment> m_segments;    // Sorted by address, non-overlapping
+};
+
+#endif  // SymbolFileDWARF_DWARFAddressIndex_h_
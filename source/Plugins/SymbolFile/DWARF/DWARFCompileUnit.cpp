@@ -22,12 +22,14 @@
 #include "DWARFDebugAbbrev.h"
 #include "DWARFDebugAranges.h"
 #include "DWARFDebugInfo.h"
+#include "DWARFDebugLine.h"
 #include "DWARFDIECollection.h"
 #include "DWARFFormValue.h"
 #include "LogChannelDWARF.h"
 #include "NameToDIE.h"
 #include "SymbolFileDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -43,6 +45,9 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
     m_die_array     (),
     m_func_aranges_ap (),
     m_base_addr     (0),
+    m_addr_base     (0),
+    m_ranges_base   (0),
+    m_dwo_symfile_ap (),
     m_offset        (DW_INVALID_OFFSET),
     m_length        (0),
     m_version       (0),
@@ -52,7 +57,12 @@ DWARFCompileUnit::DWARFCompileUnit(SymbolFileDWARF* dwarf2Data) :
     m_producer_version_minor (0),
     m_producer_version_update (0),
     m_language_type (eLanguageTypeUnknown),
-    m_is_dwarf64    (false)
+    m_is_dwarf64    (false),
+    m_load_dwo_symfile_once ()
+{
+}
+
+DWARFCompileUnit::~DWARFCompileUnit()
 {
 }
 
@@ -65,6 +75,8 @@ DWARFCompileUnit::Clear()
     m_abbrevs       = NULL;
     m_addr_size     = DWARFCompileUnit::GetDefaultAddressSize();
     m_base_addr     = 0;
+    m_addr_base     = 0;
+    m_ranges_base   = 0;
     m_die_array.clear();
     m_func_aranges_ap.reset();
     m_user_data     = NULL;
@@ -157,6 +169,11 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         // Keep a flat array of the DIE for binary lookup by DIE offset
     if (!cu_die_only)
     {
+        // Size the array for all of the DIEs up front. Letting it grow
+        // would leave it with up to twice the memory it needs until it
+        // gets trimmed below.
+        m_die_array.reserve (m_dwarf2Data->EstimateDIECount (GetDebugInfoSize()));
+
         Log *log (LogChannelDWARF::GetLogIfAny(DWARF_LOG_DEBUG_INFO | DWARF_LOG_LOOKUPS));
         if (log)
         {
@@ -188,10 +205,19 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         const bool null_die = die.IsNULL();
         if (depth == 0)
         {
-            uint64_t base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
+            // A split DWARF skeleton compile unit can refer to its own
+            // addresses through the .debug_addr section
+            const dw_offset_t addr_base = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_addr_base, DW_INVALID_OFFSET);
+            if (addr_base != DW_INVALID_OFFSET)
+                SetAddrBase (addr_base);
+
+            // A compile unit in a split DWARF .dwo file has no address of
+            // its own, it keeps the one its skeleton gave it
+            uint64_t base_addr = die.GetAttributeValueAsAddress(m_dwarf2Data, this, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
             if (base_addr == LLDB_INVALID_ADDRESS)
-                base_addr = die.GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_entry_pc, 0);
-            SetBaseAddress (base_addr);
+                base_addr = die.GetAttributeValueAsAddress(m_dwarf2Data, this, DW_AT_entry_pc, LLDB_INVALID_ADDRESS);
+            if (base_addr != LLDB_INVALID_ADDRESS)
+                SetBaseAddress (base_addr);
             if (initial_die_array_size == 0)
                 AddDIE (die);
             if (cu_die_only)
@@ -261,12 +287,12 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
                                                                    offset);
     }
 
-    // Since std::vector objects will double their size, we really need to
-    // make a new array with the perfect size so we don't end up wasting
-    // space. So here we copy and swap to make sure we don't have any extra
-    // memory taken up.
-    
-    if (m_die_array.size () < m_die_array.capacity())
+    m_dwarf2Data->AddExtractedDIECount (GetDebugInfoSize(), m_die_array.size());
+
+    // If the estimate was off by more than a little, make a new array with
+    // the perfect size so we don't end up wasting space. So here we copy
+    // and swap to make sure we don't have any extra memory taken up.
+    if (m_die_array.capacity() - m_die_array.size() > m_die_array.capacity() / 8)
     {
         DWARFDebugInfoEntry::collection exact_size_die_array (m_die_array.begin(), m_die_array.end());
         exact_size_die_array.swap (m_die_array);
@@ -373,6 +399,48 @@ DWARFCompileUnit::SetDefaultAddressSize(uint8_t addr_size)
     g_default_addr_size = addr_size;
 }
 
+void
+DWARFCompileUnit::BuildAddressIndex (DWARFAddressIndex& address_index)
+{
+    const DWARFDebugInfoEntry* die = DIE();
+    if (die)
+        die->BuildAddressIndex (m_dwarf2Data, this, address_index, DW_INVALID_OFFSET, 1);
+}
+
+void
+DWARFCompileUnit::BuildFileIndex (uint32_t cu_idx, DWARFFileIndex& file_index)
+{
+    const DWARFDebugInfoEntry* die = GetCompileUnitDIEOnly();
+    if (die == NULL)
+        return;
+
+    // Only the base names are indexed, which the compile directory and
+    // the include directories of the line table don't change
+    const char *cu_name = die->GetName(m_dwarf2Data, this);
+    const dw_offset_t stmt_list = die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_stmt_list, DW_INVALID_OFFSET);
+    DWARFDebugLine::Prologue prologue;
+    lldb::offset_t offset = stmt_list;
+    if (cu_name == NULL ||
+        stmt_list == DW_INVALID_OFFSET ||
+        !DWARFDebugLine::ParsePrologue(m_dwarf2Data->get_debug_line_data(), &offset, &prologue))
+    {
+        // The name of a split DWARF compile unit can be in its .dwo file
+        // and the line table may be in a format we can't index, so look
+        // in the compile unit for every file rather than miss it
+        file_index.AppendUnindexed (cu_idx);
+        return;
+    }
+
+    file_index.Append (FileSpec(cu_name, false).GetFilename(), cu_idx, 0);
+    for (size_t i = 0; i < prologue.file_names.size(); ++i)
+    {
+        // The support files stop at the first unnamed file
+        if (prologue.file_names[i].name.empty())
+            break;
+        file_index.Append (FileSpec(prologue.file_names[i].name.c_str(), false).GetFilename(), cu_idx, i + 1);
+    }
+}
+
 void
 DWARFCompileUnit::BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
                                           DWARFDebugAranges* debug_aranges)
@@ -1088,3 +1156,54 @@ DWARFCompileUnit::IsDWARF64() const
     return m_is_dwarf64;
 }
 
+dw_addr_t
+DWARFCompileUnit::ReadAddressAtIndex (uint64_t addr_idx) const
+{
+    // Split DWARF refers to addresses by their index in the .debug_addr
+    // section of the executable, starting at the address base of the
+    // skeleton compile unit
+    const uint8_t addr_size = GetAddressByteSize();
+    lldb::offset_t offset = GetAddrBase() + addr_idx * addr_size;
+    const DWARFDataExtractor &addr_data = m_dwarf2Data->get_debug_addr_data();
+    if (!addr_data.ValidOffsetForDataOfSize(offset, addr_size))
+        return LLDB_INVALID_ADDRESS;
+    return addr_data.GetMaxU64(&offset, addr_size);
+}
+
+bool
+DWARFCompileUnit::IsSplitDWARFSkeleton ()
+{
+    const DWARFDebugInfoEntry *die = GetCompileUnitDIEOnly();
+    if (die == NULL || die->HasChildren())
+        return false;
+    if (die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_dwo_id, 0) == 0)
+        return false;
+    // Clang modules refer to their .pcm files the same way, but they
+    // don't have any code so they don't have an address base or a line
+    // table.
+    return die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_GNU_addr_base, DW_INVALID_OFFSET) != DW_INVALID_OFFSET ||
+           die->GetAttributeValueAsUnsigned(m_dwarf2Data, this, DW_AT_stmt_list, DW_INVALID_OFFSET) != DW_INVALID_OFFSET;
+}
+
+SymbolFileDWARFDwo *
+DWARFCompileUnit::GetDwoSymbolFile ()
+{
+    std::call_once (m_load_dwo_symfile_once, [this]() {
+        if (IsSplitDWARFSkeleton())
+            m_dwo_symfile_ap = m_dwarf2Data->LoadDwoSymbolFile (*this, *GetCompileUnitDIEOnly());
+    });
+    return m_dwo_symfile_ap.get();
+}
+
+DWARFCompileUnit *
+DWARFCompileUnit::GetNonSkeletonUnit ()
+{
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFile();
+    if (dwo_symfile)
+    {
+        DWARFCompileUnit *dwo_cu = dwo_symfile->GetCompileUnit();
+        if (dwo_cu)
+            return dwo_cu;
+    }
+    return this;
+}
@@ -10,11 +10,14 @@
 #ifndef SymbolFileDWARF_DWARFCompileUnit_h_
 #define SymbolFileDWARF_DWARFCompileUnit_h_
 
+#include <mutex>
+
 #include "lldb/lldb-enumerations.h"
 #include "DWARFDebugInfoEntry.h"
 #include "SymbolFileDWARF.h"
 
 class NameToDIE;
+class SymbolFileDWARFDwo;
 
 class DWARFCompileUnit
 {
@@ -29,6 +32,7 @@ public:
     };
 
     DWARFCompileUnit(SymbolFileDWARF* dwarf2Data);
+    ~DWARFCompileUnit();
 
     bool        Extract(const lldb_private::DWARFDataExtractor &debug_info, lldb::offset_t *offset_ptr);
     size_t      ExtractDIEsIfNeeded (bool cu_die_only);
@@ -56,6 +60,12 @@ public:
     void        ClearDIEs(bool keep_compile_unit_die);
     void        BuildAddressRangeTable (SymbolFileDWARF* dwarf2Data,
                                         DWARFDebugAranges* debug_aranges);
+    // Append the address ranges of the functions, lexical blocks and
+    // inlined functions of the compile unit. The DIEs must be extracted.
+    void        BuildAddressIndex (DWARFAddressIndex& address_index);
+    // Append the file names of the compile unit and of its line table
+    // as compile unit "cu_idx". Only the compile unit DIE is needed.
+    void        BuildFileIndex (uint32_t cu_idx, DWARFFileIndex& file_index);
 
     void
     SetBaseAddress(dw_addr_t base_addr)
@@ -63,6 +73,72 @@ public:
         m_base_addr = base_addr;
     }
 
+    // Where the entries of this compile unit start in the .debug_addr
+    // section, for split DWARF
+    dw_offset_t
+    GetAddrBase() const
+    {
+        return m_addr_base;
+    }
+
+    void
+    SetAddrBase(dw_offset_t addr_base)
+    {
+        m_addr_base = addr_base;
+    }
+
+    // Read the address at index "addr_idx" of the .debug_addr entries
+    // of this compile unit. Returns LLDB_INVALID_ADDRESS if it's out of
+    // range.
+    dw_addr_t
+    ReadAddressAtIndex (uint64_t addr_idx) const;
+
+    // What the DW_AT_ranges offsets of this compile unit are relative
+    // to. Only compile units in a split DWARF .dwo file have one.
+    dw_offset_t
+    GetRangesBase() const
+    {
+        return m_ranges_base;
+    }
+
+    void
+    SetRangesBase(dw_offset_t ranges_base)
+    {
+        m_ranges_base = ranges_base;
+    }
+
+    //------------------------------------------------------------------
+    // True if this is the skeleton of a compile unit whose DIEs are in
+    // a split DWARF .dwo file.
+    //------------------------------------------------------------------
+    bool
+    IsSplitDWARFSkeleton ();
+
+    //------------------------------------------------------------------
+    // Get the symbol file of the .dwo file, or of the unit in the .dwp
+    // package, of a split DWARF skeleton compile unit. The file is
+    // opened the first time this is called, which is safe to do from
+    // many threads at once. Returns NULL if this isn't a skeleton
+    // compile unit or its .dwo file can't be found.
+    //------------------------------------------------------------------
+    SymbolFileDWARFDwo *
+    GetDwoSymbolFile ();
+
+    // Like GetDwoSymbolFile() but doesn't open the .dwo file
+    SymbolFileDWARFDwo *
+    GetLoadedDwoSymbolFile () const
+    {
+        return m_dwo_symfile_ap.get();
+    }
+
+    //------------------------------------------------------------------
+    // Get the compile unit with the DIEs of this one: the one in the
+    // .dwo file if this is a split DWARF skeleton compile unit that
+    // could be loaded, otherwise this one.
+    //------------------------------------------------------------------
+    DWARFCompileUnit *
+    GetNonSkeletonUnit ();
+
     const DWARFDebugInfoEntry*
     GetCompileUnitDIEOnly()
     {
@@ -84,17 +160,6 @@ public:
     void
     AddDIE (DWARFDebugInfoEntry& die)
     {
-        // The average bytes per DIE entry has been seen to be
-        // around 14-20 so lets pre-reserve half of that since
-        // we are now stripping the NULL tags. 
-
-        // Only reserve the memory if we are adding children of
-        // the main compile unit DIE. The compile unit DIE is always
-        // the first entry, so if our size is 1, then we are adding
-        // the first compile unit child DIE and should reserve
-        // the memory.
-        if (m_die_array.empty())
-            m_die_array.reserve(GetDebugInfoSize() / 24);
         m_die_array.push_back(die);
     }
 
@@ -104,6 +169,13 @@ public:
         return m_die_array.size() > 1;
     }
 
+    // The number of bytes the extracted DIEs take up
+    size_t
+    GetDIEMemorySize () const
+    {
+        return m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+    }
+
     DWARFDebugInfoEntry*
     GetDIEAtIndexUnchecked (uint32_t idx)
     {
@@ -200,6 +272,9 @@ protected:
     DWARFDebugInfoEntry::collection m_die_array;    // The compile unit debug information entry item
     std::unique_ptr<DWARFDebugAranges> m_func_aranges_ap;   // A table similar to the .debug_aranges table, but this one points to the exact DW_TAG_subprogram DIEs
     dw_addr_t           m_base_addr;
+    dw_offset_t         m_addr_base;
+    dw_offset_t         m_ranges_base;
+    std::unique_ptr<SymbolFileDWARFDwo> m_dwo_symfile_ap;
     dw_offset_t         m_offset;
     dw_offset_t         m_length;
     uint16_t            m_version;
@@ -210,6 +285,7 @@ protected:
     uint32_t            m_producer_version_update;
     lldb::LanguageType  m_language_type;
     bool                m_is_dwarf64;
+    std::once_flag      m_load_dwo_symfile_once;
     
     void
     ParseProducerInfo ();
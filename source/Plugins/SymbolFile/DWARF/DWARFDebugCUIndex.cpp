@@ -0,0 +1,124 @@
+//===-- DWARFDebugCUIndex.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFDebugCUIndex.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// Size of the header: the version, number of columns, number of units
+// and number of hash table slots
+const lldb::offset_t kHeaderSize = 16;
+
+}  // anonymous namespace
+
+DWARFDebugCUIndex::DWARFDebugCUIndex () :
+    m_data (),
+    m_num_columns (0),
+    m_num_units (0),
+    m_num_slots (0),
+    m_column_kinds ()
+{
+}
+
+bool
+DWARFDebugCUIndex::Extract (const DWARFDataExtractor &data)
+{
+    m_num_slots = 0;
+    m_column_kinds.clear();
+
+    if (!data.ValidOffsetForDataOfSize (0, kHeaderSize))
+        return false;
+
+    lldb::offset_t offset = 0;
+    // Version 2 is what the GNU split DWARF extension to DWARF 4 uses
+    const uint32_t version = data.GetU32 (&offset);
+    const uint32_t num_columns = data.GetU32 (&offset);
+    const uint32_t num_units = data.GetU32 (&offset);
+    const uint32_t num_slots = data.GetU32 (&offset);
+    if (version != 2 || num_columns == 0 || num_slots == 0)
+        return false;
+
+    // The number of slots is a power of two so the hash can be masked
+    if ((num_slots & (num_slots - 1)) != 0)
+        return false;
+
+    // A hash table of signatures, followed by the row of each signature,
+    // the row of section identifiers, the table of offsets and the table
+    // of sizes
+    const uint64_t size = kHeaderSize +
+                          (uint64_t)num_slots * 12 +
+                          (uint64_t)num_columns * 4 +
+                          (uint64_t)num_units * num_columns * 8;
+    if (size > data.GetByteSize())
+        return false;
+
+    offset = kHeaderSize + (lldb::offset_t)num_slots * 12;
+    m_column_kinds.reserve (num_columns);
+    for (uint32_t i = 0; i < num_columns; ++i)
+        m_column_kinds.push_back (data.GetU32 (&offset));
+
+    m_data = data;
+    m_num_columns = num_columns;
+    m_num_units = num_units;
+    m_num_slots = num_slots;
+    return true;
+}
+
+bool
+DWARFDebugCUIndex::FindUnit (uint64_t dwo_id, Contributions &contributions) const
+{
+    if (!IsValid())
+        return false;
+
+    const uint32_t mask = m_num_slots - 1;
+    const lldb::offset_t signatures_offset = kHeaderSize;
+    const lldb::offset_t rows_offset = signatures_offset + (lldb::offset_t)m_num_slots * 8;
+    uint32_t slot = (uint32_t)dwo_id & mask;
+    const uint32_t step = ((uint32_t)(dwo_id >> 32) & mask) | 1;
+    for (uint32_t probes = 0; probes < m_num_slots; ++probes)
+    {
+        lldb::offset_t offset = rows_offset + (lldb::offset_t)slot * 4;
+        const uint32_t row = m_data.GetU32 (&offset);
+        if (row == 0)
+            return false;   // Empty slot, the unit isn't in the package
+
+        offset = signatures_offset + (lldb::offset_t)slot * 8;
+        if (m_data.GetU64 (&offset) == dwo_id)
+        {
+            if (row > m_num_units)
+                return false;
+
+            const lldb::offset_t row_size = (lldb::offset_t)m_num_columns * 4;
+            const lldb::offset_t offsets_offset = rows_offset + (lldb::offset_t)m_num_slots * 4 + row_size;
+            const lldb::offset_t sizes_offset = offsets_offset + (lldb::offset_t)m_num_units * row_size;
+            lldb::offset_t contribution_offset = offsets_offset + (row - 1) * row_size;
+            lldb::offset_t contribution_size_offset = sizes_offset + (row - 1) * row_size;
+
+            for (uint32_t i = 0; i < kNumSectionKinds; ++i)
+                contributions[i] = Contribution();
+            for (uint32_t column = 0; column < m_num_columns; ++column)
+            {
+                const uint32_t kind = m_column_kinds[column];
+                const uint32_t section_offset = m_data.GetU32 (&contribution_offset);
+                const uint32_t section_size = m_data.GetU32 (&contribution_size_offset);
+                if (kind < kNumSectionKinds)
+                {
+                    contributions[kind].offset = section_offset;
+                    contributions[kind].size = section_size;
+                }
+            }
+            return true;
+        }
+        slot = (slot + step) & mask;
+    }
+    return false;
+}
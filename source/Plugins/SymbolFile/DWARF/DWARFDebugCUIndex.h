@@ -0,0 +1,91 @@
+//===-- DWARFDebugCUIndex.h -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFDebugCUIndex_h_
+#define SymbolFileDWARF_DWARFDebugCUIndex_h_
+
+#include <vector>
+
+#include "lldb/lldb-private.h"
+
+#include "DWARFDataExtractor.h"
+
+//----------------------------------------------------------------------
+// Reads the .debug_cu_index section of a split DWARF package (.dwp).
+//
+// A package holds the .dwo sections of many compile units concatenated
+// together. The index maps the DW_AT_GNU_dwo_id of each compile unit to
+// the part of each section that belongs to it.
+//----------------------------------------------------------------------
+class DWARFDebugCUIndex
+{
+public:
+    // The section identifiers used by the index
+    enum SectionKind
+    {
+        eSectionInfo = 1,
+        eSectionTypes,
+        eSectionAbbrev,
+        eSectionLine,
+        eSectionLoc,
+        eSectionStrOffsets,
+        eSectionMacinfo,
+        eSectionMacro,
+        kNumSectionKinds
+    };
+
+    // The part of a section that belongs to one compile unit. Sections
+    // that the compile unit doesn't contribute to are empty.
+    struct Contribution
+    {
+        Contribution () :
+            offset (0),
+            size (0)
+        {
+        }
+
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    typedef Contribution Contributions[kNumSectionKinds];
+
+    DWARFDebugCUIndex ();
+
+    //------------------------------------------------------------------
+    // Parse "data" which must be the contents of a .debug_cu_index
+    // section. Returns false if the section is malformed or a version
+    // this doesn't know how to read.
+    //------------------------------------------------------------------
+    bool
+    Extract (const lldb_private::DWARFDataExtractor &data);
+
+    bool
+    IsValid () const
+    {
+        return m_num_slots != 0;
+    }
+
+    //------------------------------------------------------------------
+    // Fill in "contributions", indexed by SectionKind, for the compile
+    // unit whose DW_AT_GNU_dwo_id is "dwo_id". Returns false if the
+    // package doesn't have that compile unit.
+    //------------------------------------------------------------------
+    bool
+    FindUnit (uint64_t dwo_id, Contributions &contributions) const;
+
+private:
+    lldb_private::DWARFDataExtractor m_data;
+    uint32_t m_num_columns;
+    uint32_t m_num_units;
+    uint32_t m_num_slots;
+    std::vector<uint32_t> m_column_kinds;   // SectionKind of each column
+};
+
+#endif  // SymbolFileDWARF_DWARFDebugCUIndex_h_
@@ -158,7 +158,7 @@ DWARFDebugInfoEntry::FastExtract
         {
             form = abbrevDecl->GetFormByIndexUnchecked(i);
 
-            const uint8_t fixed_skip_size = fixed_form_sizes [form];
+            const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
             if (fixed_skip_size)
                 offset += fixed_skip_size;
             else
@@ -229,6 +229,8 @@ DWARFDebugInfoEntry::FastExtract
                     case DW_FORM_sdata       :
                     case DW_FORM_udata       :
                     case DW_FORM_ref_udata   :
+                    case DW_FORM_GNU_addr_index:
+                    case DW_FORM_GNU_str_index:
                         debug_info_data.Skip_LEB128 (&offset);
                         break;
 
@@ -305,8 +307,6 @@ DWARFDebugInfoEntry::Extract
                 m_has_children = abbrevDecl->HasChildren();
 
                 bool isCompileUnitTag = m_tag == DW_TAG_compile_unit;
-                if (cu && isCompileUnitTag)
-                    ((DWARFCompileUnit*)cu)->SetBaseAddress(0);
 
                 // Skip all data in the .debug_info for the attributes
                 const uint32_t numAttributes = abbrevDecl->NumAttributes();
@@ -323,7 +323,7 @@ DWARFDebugInfoEntry::Extract
                         if (form_value.ExtractValue(debug_info_data, &offset))
                         {
                             if (attr == DW_AT_low_pc || attr == DW_AT_entry_pc)
-                                ((DWARFCompileUnit*)cu)->SetBaseAddress(form_value.Unsigned());
+                                ((DWARFCompileUnit*)cu)->SetBaseAddress(form_value.Address());
                         }
                     }
                     else
@@ -392,6 +392,8 @@ DWARFDebugInfoEntry::Extract
                             case DW_FORM_sdata       :
                             case DW_FORM_udata       :
                             case DW_FORM_ref_udata   :
+                            case DW_FORM_GNU_addr_index:
+                            case DW_FORM_GNU_str_index:
                                 debug_info_data.Skip_LEB128(&offset);
                                 break;
 
@@ -784,7 +786,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
                 switch (attr)
                 {
                 case DW_AT_low_pc:
-                    lo_pc = form_value.Unsigned();
+                    lo_pc = form_value.Address();
 
                     if (do_offset)
                         hi_pc += lo_pc;
@@ -792,12 +794,12 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
                     break;
 
                 case DW_AT_entry_pc:
-                    lo_pc = form_value.Unsigned();
+                    lo_pc = form_value.Address();
                     break;
 
                 case DW_AT_high_pc:
-                    hi_pc = form_value.Unsigned();
-                    if (form_value.Form() != DW_FORM_addr)
+                    hi_pc = form_value.Address();
+                    if (form_value.Form() != DW_FORM_addr && form_value.Form() != DW_FORM_GNU_addr_index)
                     {
                         if (lo_pc == LLDB_INVALID_ADDRESS)
                             do_offset = hi_pc != LLDB_INVALID_ADDRESS;
@@ -809,7 +811,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
                 case DW_AT_ranges:
                     {
                         const DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
-                        debug_ranges->FindRanges(form_value.Unsigned(), ranges);
+                        debug_ranges->FindRanges(cu->GetRangesBase() + form_value.Unsigned(), ranges);
                         // All DW_AT_ranges are relative to the base address of the
                         // compile unit. We add the compile unit base address to make
                         // sure all the addresses are properly fixed up.
@@ -1277,7 +1279,7 @@ DWARFDebugInfoEntry::GetAttributes
             }
             else
             {
-                const uint8_t fixed_skip_size = fixed_form_sizes [form];
+                const uint8_t fixed_skip_size = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form);
                 if (fixed_skip_size)
                     offset += fixed_skip_size;
                 else
@@ -1424,6 +1426,27 @@ DWARFDebugInfoEntry::GetAttributeValueAsReference
     return fail_value;
 }
 
+//----------------------------------------------------------------------
+// GetAttributeValueAsAddress
+//
+// Get the value of an attribute as an address, looking up indexes into
+// the .debug_addr section that split DWARF uses.
+//----------------------------------------------------------------------
+dw_addr_t
+DWARFDebugInfoEntry::GetAttributeValueAsAddress
+(
+    SymbolFileDWARF* dwarf2Data,
+    const DWARFCompileUnit* cu,
+    const dw_attr_t attr,
+    dw_addr_t fail_value
+) const
+{
+    DWARFFormValue form_value;
+    if (GetAttributeValue(dwarf2Data, cu, attr, form_value))
+        return form_value.Address();
+    return fail_value;
+}
+
 //----------------------------------------------------------------------
 // GetAttributeHighPC
 //
@@ -1445,10 +1468,10 @@ DWARFDebugInfoEntry::GetAttributeHighPC
 
     if (GetAttributeValue(dwarf2Data, cu, DW_AT_high_pc, form_value))
     {
-        dw_addr_t hi_pc = form_value.Unsigned();
-        if (form_value.Form() != DW_FORM_addr)
-            hi_pc += lo_pc; // DWARF4 can specify the hi_pc as an <offset-from-lowpc>
-        return hi_pc; 
+        const dw_form_t form = form_value.Form();
+        if (form == DW_FORM_addr || form == DW_FORM_GNU_addr_index)
+            return form_value.Address();
+        return lo_pc + form_value.Unsigned(); // DWARF4 can specify the hi_pc as an <offset-from-lowpc>
     }
     return fail_value;
 }
@@ -1471,7 +1494,7 @@ DWARFDebugInfoEntry::GetAttributeAddressRange
     uint64_t fail_value
 ) const
 {
-    lo_pc = GetAttributeValueAsUnsigned(dwarf2Data, cu, DW_AT_low_pc, fail_value);
+    lo_pc = GetAttributeValueAsAddress(dwarf2Data, cu, DW_AT_low_pc, fail_value);
     if (lo_pc != fail_value)
     {
         hi_pc = GetAttributeHighPC(dwarf2Data, cu, lo_pc, fail_value);
@@ -1499,7 +1522,7 @@ DWARFDebugInfoEntry::GetAttributeAddressRanges(SymbolFileDWARF* dwarf2Data,
         {
             DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
             
-            debug_ranges->FindRanges(debug_ranges_offset, ranges);
+            debug_ranges->FindRanges(cu->GetRangesBase() + debug_ranges_offset, ranges);
             ranges.Slide (cu->GetBaseAddress());
         }
     }
@@ -1904,6 +1927,68 @@ DWARFDebugInfoEntry::BuildFunctionAddressRangeTable
     }
 }
 
+void
+DWARFDebugInfoEntry::BuildAddressIndex
+(
+    SymbolFileDWARF* dwarf2Data,
+    const DWARFCompileUnit* cu,
+    DWARFAddressIndex& address_index,
+    dw_offset_t function_offset,
+    uint32_t depth
+) const
+{
+    if (m_tag)
+    {
+        uint32_t child_depth = depth;
+        dw_offset_t block_offset = DW_INVALID_OFFSET;
+        switch (m_tag)
+        {
+        case DW_TAG_subprogram:         // Function
+            function_offset = GetOffset();
+            break;
+
+        case DW_TAG_inlined_subroutine: // Inlined Function
+        case DW_TAG_lexical_block:      // Block { } in code
+            // Blocks only mean anything inside of a function
+            if (function_offset != DW_INVALID_OFFSET)
+                block_offset = GetOffset();
+            break;
+
+        default:
+            break;
+        }
+
+        if (function_offset == GetOffset() || block_offset != DW_INVALID_OFFSET)
+        {
+            DWARFDebugRanges::RangeList ranges;
+            const size_t num_ranges = GetAttributeAddressRanges (dwarf2Data, cu, ranges, true);
+            if (num_ranges > 0)
+            {
+                const DWARFAddressIndex::Entry entry (cu->GetOffset(), function_offset, block_offset);
+                for (size_t i = 0; i < num_ranges; ++i)
+                {
+                    const DWARFDebugRanges::RangeList::Entry &range = ranges.GetEntryRef(i);
+                    address_index.Append (range.GetRangeBase(), range.GetRangeEnd(), depth, entry);
+                }
+                child_depth = depth + 1;
+            }
+            else if (m_tag == DW_TAG_subprogram)
+            {
+                // A declaration or the abstract instance of an inlined
+                // function, its blocks have no code of their own
+                function_offset = DW_INVALID_OFFSET;
+            }
+        }
+
+        const DWARFDebugInfoEntry* child = GetFirstChild();
+        while (child)
+        {
+            child->BuildAddressIndex (dwarf2Data, cu, address_index, function_offset, child_depth);
+            child = child->GetSibling();
+        }
+    }
+}
+
 void
 DWARFDebugInfoEntry::GetDeclContextDIEs (SymbolFileDWARF* dwarf2Data, 
                                          DWARFCompileUnit* cu,
@@ -2175,7 +2260,7 @@ DWARFDebugInfoEntry::LookupAddress
 
         if (match_addr_range)
         {
-            dw_addr_t lo_pc = GetAttributeValueAsUnsigned(dwarf2Data, cu, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
+            dw_addr_t lo_pc = GetAttributeValueAsAddress(dwarf2Data, cu, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
             if (lo_pc != LLDB_INVALID_ADDRESS)
             {
                 dw_addr_t hi_pc = GetAttributeHighPC(dwarf2Data, cu, lo_pc, LLDB_INVALID_ADDRESS);
@@ -2227,7 +2312,7 @@ DWARFDebugInfoEntry::LookupAddress
                 {
                     DWARFDebugRanges::RangeList ranges;
                     DWARFDebugRanges* debug_ranges = dwarf2Data->DebugRanges();
-                    debug_ranges->FindRanges(debug_ranges_offset, ranges);
+                    debug_ranges->FindRanges(cu->GetRangesBase() + debug_ranges_offset, ranges);
                     // All DW_AT_ranges are relative to the base address of the
                     // compile unit. We add the compile unit base address to make
                     // sure all the addresses are properly fixed up.
@@ -141,6 +141,13 @@ public:
                     const DWARFCompileUnit* cu,
                     DWARFDebugAranges* debug_aranges) const;
 
+    void        BuildAddressIndex(
+                    SymbolFileDWARF* dwarf2Data,
+                    const DWARFCompileUnit* cu,
+                    DWARFAddressIndex& address_index,
+                    dw_offset_t function_offset,
+                    uint32_t depth) const;
+
     bool        FastExtract(
                     const lldb_private::DWARFDataExtractor& debug_info_data,
                     const DWARFCompileUnit* cu,
@@ -197,6 +204,12 @@ public:
                     const dw_attr_t attr,
                     int64_t fail_value) const;
 
+    dw_addr_t   GetAttributeValueAsAddress(
+                    SymbolFileDWARF* dwarf2Data,
+                    const DWARFCompileUnit* cu,
+                    const dw_attr_t attr,
+                    dw_addr_t fail_value) const;
+
     dw_addr_t   GetAttributeHighPC(
                     SymbolFileDWARF* dwarf2Data,
                     const DWARFCompileUnit* cu,
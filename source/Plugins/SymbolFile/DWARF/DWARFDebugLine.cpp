@@ -618,7 +618,66 @@ DWARFDebugLine::ParseStatementTable
 
     const dw_offset_t end_offset = debug_line_offset + prologue->total_length + (debug_line_data.GetDWARFSizeofInitialLength());
 
-    State state(prologue, log, callback, userData);
+    State state(prologue, log, callback, userData, *offset_ptr);
+
+    ParseStatementOpcodes (debug_line_data, offset_ptr, end_offset, state, false);
+
+    state.Finalize( *offset_ptr );
+
+    return end_offset;
+}
+
+
+//----------------------------------------------------------------------
+// ParseStatementSequence
+//
+// Parse the rows of the sequence whose opcodes start at *offset_ptr in
+// the line table with "prologue" that ends at "end_offset", and call
+// the callback function once for the start of the sequence and each
+// time a row is to be added to the line table.
+//----------------------------------------------------------------------
+bool
+DWARFDebugLine::ParseStatementSequence
+(
+    const DWARFDataExtractor& debug_line_data,
+    lldb::offset_t* offset_ptr,
+    dw_offset_t end_offset,
+    Prologue::shared_ptr& prologue,
+    DWARFDebugLine::State::Callback callback,
+    void* userData
+)
+{
+    if (*offset_ptr >= end_offset)
+        return false;
+
+    Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_LINE));
+    State state(prologue, log, callback, userData, *offset_ptr);
+
+    ParseStatementOpcodes (debug_line_data, offset_ptr, end_offset, state, true);
+
+    state.Finalize( *offset_ptr );
+
+    return true;
+}
+
+//----------------------------------------------------------------------
+// ParseStatementOpcodes
+//
+// Run the state machine over the opcodes from *offset_ptr to the end of
+// the line table, or just to the end of the current sequence if
+// "single_sequence" is true.
+//----------------------------------------------------------------------
+void
+DWARFDebugLine::ParseStatementOpcodes
+(
+    const DWARFDataExtractor& debug_line_data,
+    lldb::offset_t* offset_ptr,
+    dw_offset_t end_offset,
+    State& state,
+    bool single_sequence
+)
+{
+    const Prologue::shared_ptr& prologue = state.prologue;
 
     while (*offset_ptr < end_offset)
     {
@@ -648,6 +707,8 @@ DWARFDebugLine::ParseStatementTable
                 state.end_sequence = true;
                 state.AppendRowToMatrix(*offset_ptr);
                 state.Reset();
+                if (single_sequence)
+                    return;
                 break;
 
             case DW_LNE_set_address:
@@ -683,13 +744,18 @@ DWARFDebugLine::ParseStatementTable
                 // appear; the names in the prologue come before names defined by
                 // the DW_LNE_define_file instruction. These numbers are used in the
                 // file register of the state machine.
+                //
+                // A sequence that is parsed on its own was parsed before
+                // with the rest of the line table, so the file has
+                // already been added then.
                 {
                     FileNameEntry fileEntry;
                     fileEntry.name      = debug_line_data.GetCStr(offset_ptr);
                     fileEntry.dir_idx   = debug_line_data.GetULEB128(offset_ptr);
                     fileEntry.mod_time  = debug_line_data.GetULEB128(offset_ptr);
                     fileEntry.length    = debug_line_data.GetULEB128(offset_ptr);
-                    state.prologue->file_names.push_back(fileEntry);
+                    if (!single_sequence)
+                        state.prologue->file_names.push_back(fileEntry);
                 }
                 break;
 
@@ -854,13 +920,8 @@ DWARFDebugLine::ParseStatementTable
             state.AppendRowToMatrix(*offset_ptr);
         }
     }
-
-    state.Finalize( *offset_ptr );
-
-    return end_offset;
 }
 
-
 //----------------------------------------------------------------------
 // ParseStatementTableCallback
 //----------------------------------------------------------------------
@@ -1216,7 +1277,7 @@ DWARFDebugLine::Row::Dump(Log *log, const Row::collection& state_coll)
 //----------------------------------------------------------------------
 // DWARFDebugLine::State::State
 //----------------------------------------------------------------------
-DWARFDebugLine::State::State(Prologue::shared_ptr& p, Log *l, DWARFDebugLine::State::Callback cb, void* userData) :
+DWARFDebugLine::State::State(Prologue::shared_ptr& p, Log *l, DWARFDebugLine::State::Callback cb, void* userData, dw_offset_t offset) :
     Row (p->default_is_stmt),
     prologue (p),
     log (l),
@@ -1225,8 +1286,9 @@ DWARFDebugLine::State::State(Prologue::shared_ptr& p, Log *l, DWARFDebugLine::St
     row (StartParsingLineTable)
 {
     // Call the callback with the initial row state of zero for the prologue
+    // and the offset of the first opcode
     if (callback)
-        callback(0, *this, callbackUserData);
+        callback(offset, *this, callbackUserData);
 }
 
 //----------------------------------------------------------------------
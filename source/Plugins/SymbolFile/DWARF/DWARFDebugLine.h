@@ -172,7 +172,8 @@ public:
         State (Prologue::shared_ptr& prologue_sp,
                lldb_private::Log *log,
                Callback callback,
-               void* userData);
+               void* userData,
+               dw_offset_t offset);
 
         void
         AppendRowToMatrix (dw_offset_t offset);
@@ -197,6 +198,7 @@ public:
     static bool ParseSupportFiles(const lldb::ModuleSP &module_sp, const lldb_private::DWARFDataExtractor& debug_line_data, const char *cu_comp_dir, dw_offset_t stmt_list, lldb_private::FileSpecList &support_files);
     static bool ParsePrologue(const lldb_private::DWARFDataExtractor& debug_line_data, lldb::offset_t* offset_ptr, Prologue* prologue);
     static bool ParseStatementTable(const lldb_private::DWARFDataExtractor& debug_line_data, lldb::offset_t* offset_ptr, State::Callback callback, void* userData);
+    static bool ParseStatementSequence(const lldb_private::DWARFDataExtractor& debug_line_data, lldb::offset_t* offset_ptr, dw_offset_t end_offset, Prologue::shared_ptr& prologue, State::Callback callback, void* userData);
     static dw_offset_t DumpStatementTable(lldb_private::Log *log, const lldb_private::DWARFDataExtractor& debug_line_data, const dw_offset_t line_offset);
     static dw_offset_t DumpStatementOpcodes(lldb_private::Log *log, const lldb_private::DWARFDataExtractor& debug_line_data, const dw_offset_t line_offset, uint32_t flags);
     static bool ParseStatementTable(const lldb_private::DWARFDataExtractor& debug_line_data, lldb::offset_t *offset_ptr, LineTable* line_table);
@@ -213,6 +215,8 @@ public:
     LineTable::shared_ptr GetLineTable(const dw_offset_t offset) const;
 
 protected:
+    static void ParseStatementOpcodes(const lldb_private::DWARFDataExtractor& debug_line_data, lldb::offset_t* offset_ptr, dw_offset_t end_offset, State& state, bool single_sequence);
+
     typedef std::map<dw_offset_t, LineTable::shared_ptr> LineTableMap;
     typedef LineTableMap::iterator LineTableIter;
     typedef LineTableMap::const_iterator LineTableConstIter;
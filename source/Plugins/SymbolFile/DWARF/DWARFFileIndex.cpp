@@ -0,0 +1,95 @@
+//===-- DWARFFileIndex.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFFileIndex.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+DWARFFileIndex::DWARFFileIndex () :
+    m_items (),
+    m_unindexed_cus ()
+{
+}
+
+void
+DWARFFileIndex::Append (const ConstString &file_name, uint32_t cu_idx, uint32_t file_idx)
+{
+    if (file_name)
+    {
+        Item item = { file_name.GetCString(), { cu_idx, file_idx } };
+        m_items.push_back (item);
+    }
+}
+
+void
+DWARFFileIndex::AppendUnindexed (uint32_t cu_idx)
+{
+    m_unindexed_cus.push_back (cu_idx);
+}
+
+void
+DWARFFileIndex::Append (const DWARFFileIndex &index)
+{
+    m_items.insert (m_items.end(), index.m_items.begin(), index.m_items.end());
+    m_unindexed_cus.insert (m_unindexed_cus.end(), index.m_unindexed_cus.begin(), index.m_unindexed_cus.end());
+}
+
+void
+DWARFFileIndex::Finalize ()
+{
+    std::sort (m_items.begin(), m_items.end(), [](const Item &lhs, const Item &rhs)
+    {
+        if (lhs.file_name != rhs.file_name)
+            return lhs.file_name < rhs.file_name;
+        if (lhs.entry.cu_idx != rhs.entry.cu_idx)
+            return lhs.entry.cu_idx < rhs.entry.cu_idx;
+        return lhs.entry.file_idx < rhs.entry.file_idx;
+    });
+
+    // A header is usually in the support files of a compile unit once,
+    // but the same base name can come from different directories. Only
+    // the first index is needed since lookups search forward from it.
+    m_items.erase (std::unique (m_items.begin(), m_items.end(), [](const Item &lhs, const Item &rhs)
+    {
+        return lhs.file_name == rhs.file_name && lhs.entry.cu_idx == rhs.entry.cu_idx;
+    }), m_items.end());
+    std::vector<Item>(m_items).swap (m_items);
+
+    std::sort (m_unindexed_cus.begin(), m_unindexed_cus.end());
+    m_unindexed_cus.erase (std::unique (m_unindexed_cus.begin(), m_unindexed_cus.end()), m_unindexed_cus.end());
+}
+
+size_t
+DWARFFileIndex::Find (const ConstString &file_name, std::vector<Entry> &entries) const
+{
+    const char *name = file_name.GetCString();
+    if (name == NULL)
+        return 0;
+
+    std::vector<Item>::const_iterator pos = std::lower_bound (m_items.begin(), m_items.end(), name,
+                                                              [](const Item &item, const char *name) { return item.file_name < name; });
+    const size_t prev_size = entries.size();
+    for (; pos != m_items.end() && pos->file_name == name; ++pos)
+        entries.push_back (pos->entry);
+
+    if (!m_unindexed_cus.empty())
+    {
+        const size_t num_indexed = entries.size();
+        for (uint32_t cu_idx : m_unindexed_cus)
+        {
+            Entry entry = { cu_idx, 0 };
+            entries.push_back (entry);
+        }
+        std::inplace_merge (entries.begin() + prev_size, entries.begin() + num_indexed, entries.end(),
+                            [](const Entry &lhs, const Entry &rhs) { return lhs.cu_idx < rhs.cu_idx; });
+    }
+    return entries.size() - prev_size;
+}
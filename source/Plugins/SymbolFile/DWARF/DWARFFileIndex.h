@@ -0,0 +1,98 @@
+//===-- DWARFFileIndex.h ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFFileIndex_h_
+#define SymbolFileDWARF_DWARFFileIndex_h_
+
+#include <vector>
+
+#include "lldb/lldb-types.h"
+#include "lldb/Core/ConstString.h"
+
+//----------------------------------------------------------------------
+// Maps the file names used by the compile units of a module to the
+// compile units that use them.
+//
+// Files are keyed by their base name, which is all a file and line
+// lookup has to match exactly, so the index finds every compile unit
+// that can have a match without parsing the support files of the rest.
+// Each compile unit is listed with the lowest index of the file in its
+// support files, where index zero is the compile unit's own file.
+// Compile units whose files can't be read without parsing more than
+// their line table header are returned for every file.
+//----------------------------------------------------------------------
+class DWARFFileIndex
+{
+public:
+    struct Entry
+    {
+        uint32_t cu_idx;
+        uint32_t file_idx;
+    };
+
+    DWARFFileIndex ();
+
+    void
+    Append (const lldb_private::ConstString &file_name, uint32_t cu_idx, uint32_t file_idx);
+
+    // Make "cu_idx" a match for every file name, for when the files of
+    // the compile unit aren't known
+    void
+    AppendUnindexed (uint32_t cu_idx);
+
+    // Append the files of "index", which must not be finalized yet
+    void
+    Append (const DWARFFileIndex &index);
+
+    //------------------------------------------------------------------
+    // Sort the appended files so they can be looked up. Must be called
+    // once all files have been appended and before any lookups.
+    //------------------------------------------------------------------
+    void
+    Finalize ();
+
+    //------------------------------------------------------------------
+    // Append an entry for each compile unit that uses a file named
+    // "file_name", or that is unindexed, to "entries" in compile unit
+    // order. The file index of unindexed compile units is zero.
+    // Returns the number of entries that were appended.
+    //------------------------------------------------------------------
+    size_t
+    Find (const lldb_private::ConstString &file_name, std::vector<Entry> &entries) const;
+
+    size_t
+    GetSize () const
+    {
+        return m_items.size();
+    }
+
+    size_t
+    GetNumUnindexed () const
+    {
+        return m_unindexed_cus.size();
+    }
+
+    size_t
+    GetMemorySize () const
+    {
+        return m_items.capacity() * sizeof(Item) + m_unindexed_cus.capacity() * sizeof(uint32_t);
+    }
+
+protected:
+    struct Item
+    {
+        const char *file_name;  // A ConstString so it can be compared by pointer
+        Entry entry;
+    };
+
+    std::vector<Item> m_items;              // Sorted by file name and then compile unit once finalized
+    std::vector<uint32_t> m_unindexed_cus;  // Compile units that match any file
+};
+
+#endif  // SymbolFileDWARF_DWARFFileIndex_h_
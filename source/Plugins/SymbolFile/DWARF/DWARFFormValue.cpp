@@ -153,6 +153,16 @@ DWARFFormValue::GetFixedFormSizesForAddressSize (uint8_t addr_size, bool is_dwar
     return NULL;
 }
 
+uint8_t
+DWARFFormValue::GetFixedFormSize (const uint8_t *fixed_form_sizes, dw_form_t form)
+{
+    // All of the tables have the same size, and the vendor forms past
+    // their end all have variable sizes.
+    if (form < sizeof(g_form_sizes_addr4))
+        return fixed_form_sizes[form];
+    return 0;
+}
+
 DWARFFormValue::DWARFFormValue() :
     m_cu (NULL),
     m_form(0),
@@ -223,6 +233,8 @@ DWARFFormValue::ExtractValue(const DWARFDataExtractor& data, lldb::offset_t* off
                                     m_value.value.uval = data.GetMaxU64(offset_ptr, DWARFCompileUnit::IsDWARF64(m_cu) ? 8 : 4);  break;
         case DW_FORM_flag_present:  m_value.value.uval = 1;                                             break;
         case DW_FORM_ref_sig8:      m_value.value.uval = data.GetU64(offset_ptr);                       break;
+        case DW_FORM_GNU_addr_index:
+        case DW_FORM_GNU_str_index: m_value.value.uval = data.GetULEB128(offset_ptr);                   break;
         default:
             return false;
             break;
@@ -322,6 +334,8 @@ DWARFFormValue::SkipValue(dw_form_t form, const DWARFDataExtractor& debug_info_d
     case DW_FORM_sdata:
     case DW_FORM_udata:
     case DW_FORM_ref_udata:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
         debug_info_data.Skip_LEB128(offset_ptr);
         return true;
 
@@ -394,6 +408,12 @@ DWARFFormValue::Dump(Stream &s, const DWARFDataExtractor* debug_str_data) const
 
     case DW_FORM_sdata:     s.PutSLEB128(uvalue); break;
     case DW_FORM_udata:     s.PutULEB128(uvalue); break;
+    case DW_FORM_GNU_addr_index:
+        if (verbose)
+            s.Printf(" .debug_addr[%" PRIu64 "] = ", uvalue);
+        s.Address(Address(), sizeof (uint64_t));
+        break;
+    case DW_FORM_GNU_str_index:
     case DW_FORM_strp:
         if (debug_str_data)
         {
@@ -449,10 +469,36 @@ DWARFFormValue::AsCString(const DWARFDataExtractor* debug_str_data_ptr) const
     if (IsInlinedCStr())
         return m_value.value.cstr;
     else if (debug_str_data_ptr)
+    {
+        if (m_form == DW_FORM_GNU_str_index)
+        {
+            // Split DWARF refers to strings by their index in the string
+            // offsets table of the .dwo file
+            if (m_cu == NULL)
+                return NULL;
+            const uint32_t index_size = m_cu->IsDWARF64() ? 8 : 4;
+            lldb::offset_t offset = m_value.value.uval * index_size;
+            const DWARFDataExtractor &str_offsets_data = m_cu->GetSymbolFileDWARF()->get_debug_str_offsets_data();
+            if (!str_offsets_data.ValidOffsetForDataOfSize(offset, index_size))
+                return NULL;
+            return debug_str_data_ptr->PeekCStr(str_offsets_data.GetMaxU64(&offset, index_size));
+        }
         return debug_str_data_ptr->PeekCStr(m_value.value.uval);
+    }
     return NULL;
 }
 
+dw_addr_t
+DWARFFormValue::Address () const
+{
+    if (m_form != DW_FORM_GNU_addr_index)
+        return Unsigned();
+
+    if (m_cu == NULL)
+        return LLDB_INVALID_ADDRESS;
+    return m_cu->ReadAddressAtIndex(m_value.value.uval);
+}
+
 uint64_t
 DWARFFormValue::Reference() const
 {
@@ -558,6 +604,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
     case DW_FORM_sec_offset:
     case DW_FORM_flag_present:
     case DW_FORM_ref_sig8:
+    case DW_FORM_GNU_addr_index:
         {
             uint64_t a = a_value.Unsigned();
             uint64_t b = b_value.Unsigned();
@@ -581,6 +628,7 @@ DWARFFormValue::Compare (const DWARFFormValue& a_value, const DWARFFormValue& b_
 
     case DW_FORM_string:
     case DW_FORM_strp:
+    case DW_FORM_GNU_str_index:
         {
             const char *a_string = a_value.AsCString(debug_str_data_ptr);
             const char *b_string = b_value.AsCString(debug_str_data_ptr);
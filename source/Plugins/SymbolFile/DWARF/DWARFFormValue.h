@@ -59,6 +59,7 @@ public:
     const uint8_t*      BlockData() const;
     uint64_t            Reference() const;
     uint64_t            Reference (dw_offset_t offset) const;
+    dw_addr_t           Address () const;
     bool                Boolean() const { return m_value.value.uval != 0; }
     uint64_t            Unsigned() const { return m_value.value.uval; }
     void                SetUnsigned(uint64_t uval) { m_value.value.uval = uval; }
@@ -70,6 +71,7 @@ public:
     static bool         IsBlockForm(const dw_form_t form);
     static bool         IsDataForm(const dw_form_t form);
     static const uint8_t * GetFixedFormSizesForAddressSize (uint8_t addr_size, bool is_dwarf64);
+    static uint8_t      GetFixedFormSize (const uint8_t *fixed_form_sizes, dw_form_t form);
     static int          Compare (const DWARFFormValue& a, const DWARFFormValue& b, const lldb_private::DWARFDataExtractor* debug_str_data_ptr);
 protected:
     const DWARFCompileUnit* m_cu; // Compile unit for this form
@@ -0,0 +1,187 @@
+//===-- DWARFGdbIndex.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFGdbIndex.h"
+
+#include <string.h>
+
+#include "lldb/Core/ConstString.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// Size of the header: the version followed by the offsets of the five
+// areas of the index
+const lldb::offset_t kHeaderSize = 24;
+
+// A compile unit vector entry keeps the index of the compile unit in
+// its low 24 bits, the upper bits describe the kind of symbol.
+const uint32_t kCUIndexMask = 0x00ffffff;
+
+}  // anonymous namespace
+
+DWARFGdbIndex::DWARFGdbIndex () :
+    m_data (),
+    m_version (0),
+    m_constant_pool_offset (0),
+    m_cu_offsets (),
+    m_name_to_cu_vector ()
+{
+}
+
+bool
+DWARFGdbIndex::Extract (const DWARFDataExtractor &data)
+{
+    m_version = 0;
+    m_cu_offsets.clear();
+    m_name_to_cu_vector.Clear();
+
+    if (!data.ValidOffsetForDataOfSize (0, kHeaderSize))
+        return false;
+
+    lldb::offset_t offset = 0;
+    const uint32_t version = data.GetU32 (&offset);
+    // Older versions used a hash function with known bugs and didn't
+    // describe the kind of each symbol. Version 7 is what gold and lld
+    // write, gdb itself writes version 8 which only changed the meaning
+    // of the contents of the symbol table for gdb.
+    if (version < 7 || version > 8)
+        return false;
+
+    const uint32_t cu_list_offset = data.GetU32 (&offset);
+    const uint32_t types_cu_list_offset = data.GetU32 (&offset);
+    const uint32_t address_area_offset = data.GetU32 (&offset);
+    const uint32_t symbol_table_offset = data.GetU32 (&offset);
+    const uint32_t constant_pool_offset = data.GetU32 (&offset);
+    if (cu_list_offset < kHeaderSize ||
+        types_cu_list_offset < cu_list_offset ||
+        address_area_offset < types_cu_list_offset ||
+        symbol_table_offset < address_area_offset ||
+        constant_pool_offset < symbol_table_offset ||
+        constant_pool_offset > data.GetByteSize())
+        return false;
+
+    // The compile unit list is made of 64 bit .debug_info offset and
+    // length pairs
+    const uint32_t num_cus = (types_cu_list_offset - cu_list_offset) / 16;
+    m_cu_offsets.reserve (num_cus);
+    offset = cu_list_offset;
+    for (uint32_t i = 0; i < num_cus; ++i)
+    {
+        m_cu_offsets.push_back ((dw_offset_t)data.GetU64 (&offset));
+        data.GetU64 (&offset);
+    }
+
+    // The symbol table is an open addressing hash table of name and
+    // compile unit vector offset pairs, both relative to the constant
+    // pool. Every name is needed to make them available by their base
+    // name too, so walk all of the slots rather than hashing.
+    const uint32_t num_slots = (constant_pool_offset - symbol_table_offset) / 8;
+    offset = symbol_table_offset;
+    for (uint32_t i = 0; i < num_slots; ++i)
+    {
+        const uint32_t name_offset = data.GetU32 (&offset);
+        const uint32_t cu_vector_offset = data.GetU32 (&offset);
+        if (name_offset == 0 && cu_vector_offset == 0)
+            continue;   // Empty slot
+
+        lldb::offset_t name_cstr_offset = (lldb::offset_t)constant_pool_offset + name_offset;
+        const char *name = data.GetCStr (&name_cstr_offset);
+        if (name == NULL || name[0] == '\0')
+            continue;
+
+        m_name_to_cu_vector.Append (ConstString (name).GetCString(), cu_vector_offset);
+        const char *base_name = GetBaseName (name);
+        if (base_name && base_name[0])
+            m_name_to_cu_vector.Append (ConstString (base_name).GetCString(), cu_vector_offset);
+    }
+    m_name_to_cu_vector.Sort();
+
+    m_data = data;
+    m_constant_pool_offset = constant_pool_offset;
+    m_version = version;
+    return true;
+}
+
+size_t
+DWARFGdbIndex::FindCompileUnits (const ConstString &name, std::vector<uint32_t> &cu_indexes) const
+{
+    const size_t initial_size = cu_indexes.size();
+    if (!IsValid() || !name)
+        return 0;
+
+    std::vector<uint32_t> cu_vector_offsets;
+    m_name_to_cu_vector.GetValues (name.GetCString(), cu_vector_offsets);
+    const uint32_t num_cus = m_cu_offsets.size();
+    for (uint32_t cu_vector_offset : cu_vector_offsets)
+    {
+        lldb::offset_t offset = m_constant_pool_offset + cu_vector_offset;
+        const uint32_t count = m_data.GetU32 (&offset);
+        if (!m_data.ValidOffsetForDataOfSize (offset, (lldb::offset_t)count * 4))
+            continue;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            // Indexes past the compile units refer to type units
+            const uint32_t cu_index = m_data.GetU32_unchecked (&offset) & kCUIndexMask;
+            if (cu_index < num_cus)
+                cu_indexes.push_back (cu_index);
+        }
+    }
+    return cu_indexes.size() - initial_size;
+}
+
+bool
+DWARFGdbIndex::CanLookupName (const ConstString &name)
+{
+    const char *cstr = name.GetCString();
+    if (cstr == NULL || cstr[0] == '\0')
+        return false;
+    // Mangled C++ names and Objective C method names
+    if (::strncmp (cstr, "_Z", 2) == 0 || cstr[0] == '-' || cstr[0] == '+')
+        return false;
+    // Demangled names with their argument lists
+    return ::strchr (cstr, '(') == NULL;
+}
+
+const char *
+DWARFGdbIndex::GetBaseName (const char *name)
+{
+    // Skip over template arguments, which can contain "::" themselves.
+    // Operator names can make the nesting unbalanced, but they are always
+    // the last component so that doesn't matter.
+    const char *base_name = NULL;
+    uint32_t depth = 0;
+    for (const char *p = name; *p; ++p)
+    {
+        switch (*p)
+        {
+        case '<':
+        case '(':
+        case '[':
+            ++depth;
+            break;
+        case '>':
+        case ')':
+        case ']':
+            if (depth > 0)
+                --depth;
+            break;
+        case ':':
+            if (depth == 0 && p[1] == ':')
+            {
+                base_name = p + 2;
+                ++p;
+            }
+            break;
+        }
+    }
+    return base_name;
+}
@@ -0,0 +1,105 @@
+//===-- DWARFGdbIndex.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFGdbIndex_h_
+#define SymbolFileDWARF_DWARFGdbIndex_h_
+
+#include <vector>
+
+#include "lldb/lldb-private.h"
+#include "lldb/Core/UniqueCStringMap.h"
+#include "lldb/Core/dwarf.h"
+
+#include "DWARFDataExtractor.h"
+
+//----------------------------------------------------------------------
+// Reads the .gdb_index section that gold and lld create with
+// --gdb-index.
+//
+// The index maps the names of functions, variables, types and
+// namespaces to the compile units that define them. It doesn't record
+// DIE offsets, so SymbolFileDWARF still indexes the DIEs of those
+// compile units, but only of those.
+//
+// The index records fully qualified names, e.g. "ns::foo", while the
+// DWARF name indexes use the DW_AT_name of each DIE, so every name is
+// also made available by its last component.
+//----------------------------------------------------------------------
+class DWARFGdbIndex
+{
+public:
+    DWARFGdbIndex ();
+
+    //------------------------------------------------------------------
+    // Parse "data" which must be the contents of a .gdb_index section.
+    // Returns false if the section is malformed or a version this
+    // doesn't know how to read.
+    //------------------------------------------------------------------
+    bool
+    Extract (const lldb_private::DWARFDataExtractor &data);
+
+    bool
+    IsValid () const
+    {
+        return m_version != 0;
+    }
+
+    uint32_t
+    GetVersion () const
+    {
+        return m_version;
+    }
+
+    size_t
+    GetNumCompileUnits () const
+    {
+        return m_cu_offsets.size();
+    }
+
+    dw_offset_t
+    GetCompileUnitOffset (uint32_t idx) const
+    {
+        return idx < m_cu_offsets.size() ? m_cu_offsets[idx] : DW_INVALID_OFFSET;
+    }
+
+    //------------------------------------------------------------------
+    // Append the indexes, into the compile unit list of the index, of
+    // the compile units that define something called "name". Type units
+    // are skipped. Returns the number of indexes that were appended,
+    // some of which might be duplicates.
+    //------------------------------------------------------------------
+    size_t
+    FindCompileUnits (const lldb_private::ConstString &name,
+                      std::vector<uint32_t> &cu_indexes) const;
+
+    //------------------------------------------------------------------
+    // Names can only be found if they are spelled like the index spells
+    // them. Mangled names and names with argument lists aren't in it.
+    //------------------------------------------------------------------
+    static bool
+    CanLookupName (const lldb_private::ConstString &name);
+
+    //------------------------------------------------------------------
+    // Get the last component of a qualified C++ name, e.g. "bar" for
+    // "ns::foo<int>::bar", or NULL if "name" isn't qualified.
+    //------------------------------------------------------------------
+    static const char *
+    GetBaseName (const char *name);
+
+private:
+    lldb_private::DWARFDataExtractor m_data;
+    uint32_t m_version;
+    lldb::offset_t m_constant_pool_offset;
+    std::vector<dw_offset_t> m_cu_offsets;
+    // Name, or last component of a name, to the offset of its compile
+    // unit vector in the constant pool
+    lldb_private::UniqueCStringMap<uint32_t> m_name_to_cu_vector;
+};
+
+#endif  // SymbolFileDWARF_DWARFGdbIndex_h_
@@ -0,0 +1,220 @@
+//===-- DWARFIndexCache.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFIndexCache.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/Host.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "NameToDIE.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// "LDWX" when read as a little endian 32 bit integer
+const uint32_t kCacheMagic = 0x5857444c;
+// Bump this whenever the layout of the cache file or the contents of
+// the NameToDIE tables change.
+const uint32_t kCacheVersion = 2;
+
+}  // anonymous namespace
+
+DWARFIndexCache::DWARFIndexCache (const FileSpec &cache_dir) :
+    m_cache_dir (cache_dir)
+{
+}
+
+FileSpec
+DWARFIndexCache::GetCacheFileSpec (const Key &key) const
+{
+    FileSpec cache_file (m_cache_dir);
+    std::string file_name (key.uuid.GetAsString());
+    if (key.file_offset != 0)
+    {
+        StreamString strm;
+        strm.Printf ("-%" PRIx64, key.file_offset);
+        file_name += strm.GetString();
+    }
+    file_name += ".dwarf-index";
+    cache_file.AppendPathComponent (file_name.c_str());
+    return cache_file;
+}
+
+bool
+DWARFIndexCache::Load (const Key &key, const std::vector<NameToDIE *> &tables) const
+{
+    if (!key.IsValid())
+        return false;
+
+    const FileSpec cache_file (GetCacheFileSpec (key));
+    if (!cache_file.Exists())
+        return false;
+
+    DataBufferSP data_sp (cache_file.MemoryMapFileContents());
+    if (!data_sp || data_sp->GetByteSize() == 0)
+        return false;
+
+    DataExtractor data (data_sp, eByteOrderLittle, 4);
+    lldb::offset_t offset = 0;
+    if (data.GetU32 (&offset) != kCacheMagic)
+        return false;
+    if (data.GetU32 (&offset) != kCacheVersion)
+        return false;
+
+    UUID uuid;
+    const uint8_t uuid_len = data.GetU8 (&offset);
+    const void *uuid_bytes = data.GetData (&offset, uuid_len);
+    if (uuid_bytes == NULL || !uuid.SetBytes (uuid_bytes, uuid_len) || uuid != key.uuid)
+        return false;
+    if (data.GetU64 (&offset) != key.mod_time)
+        return false;
+    if (data.GetU64 (&offset) != key.file_offset)
+        return false;
+    if (data.GetU64 (&offset) != key.debug_info_size)
+        return false;
+
+    const uint32_t num_strings = data.GetU32 (&offset);
+    std::vector<ConstString> strings;
+    strings.reserve (num_strings);
+    for (uint32_t i = 0; i < num_strings; ++i)
+    {
+        const char *cstr = data.GetCStr (&offset);
+        if (cstr == NULL)
+            return false;
+        strings.push_back (ConstString (cstr));
+    }
+
+    if (data.GetU32 (&offset) != tables.size())
+        return false;
+
+    // Decode everything into temporaries first so a truncated or corrupt
+    // cache file can't leave the caller with partially filled tables.
+    std::vector<NameToDIE> decoded_tables (tables.size());
+    for (auto &table : decoded_tables)
+    {
+        const uint32_t num_entries = data.GetU32 (&offset);
+        if (!data.ValidOffsetForDataOfSize (offset, (lldb::offset_t)num_entries * 8))
+            return false;
+        for (uint32_t i = 0; i < num_entries; ++i)
+        {
+            const uint32_t str_idx = data.GetU32_unchecked (&offset);
+            const uint32_t die_offset = data.GetU32_unchecked (&offset);
+            if (str_idx >= num_strings)
+                return false;
+            table.Insert (strings[str_idx], die_offset);
+        }
+    }
+
+    for (size_t i = 0; i < tables.size(); ++i)
+    {
+        tables[i]->Append (decoded_tables[i]);
+        tables[i]->Finalize();
+    }
+    return true;
+}
+
+Error
+DWARFIndexCache::Save (const Key &key, const std::vector<const NameToDIE *> &tables) const
+{
+    Error error;
+    if (!key.IsValid())
+    {
+        error.SetErrorString ("object file has no UUID");
+        return error;
+    }
+
+    if (!m_cache_dir.IsDirectory())
+    {
+        error = FileSystem::MakeDirectory (m_cache_dir.GetPath().c_str(), eFilePermissionsDirectoryDefault);
+        if (error.Fail())
+            return error;
+    }
+
+    // Give every unique name an index in the string table.
+    llvm::DenseMap<const char *, uint32_t> string_to_index;
+    std::vector<const char *> strings;
+    for (const NameToDIE *table : tables)
+    {
+        table->ForEach ([&string_to_index, &strings](const char *name, uint32_t die_offset) -> bool {
+            if (string_to_index.insert (std::make_pair (name, (uint32_t)strings.size())).second)
+                strings.push_back (name);
+            return true;
+        });
+    }
+
+    StreamString strm (Stream::eBinary, 4, eByteOrderLittle);
+    strm.PutHex32 (kCacheMagic);
+    strm.PutHex32 (kCacheVersion);
+    UUID uuid (key.uuid);
+    strm.PutHex8 ((uint8_t)uuid.GetByteSize());
+    strm.Write (uuid.GetBytes(), uuid.GetByteSize());
+    strm.PutHex64 (key.mod_time);
+    strm.PutHex64 (key.file_offset);
+    strm.PutHex64 (key.debug_info_size);
+
+    strm.PutHex32 ((uint32_t)strings.size());
+    for (const char *cstr : strings)
+        strm.Write (cstr, ::strlen (cstr) + 1);
+
+    strm.PutHex32 ((uint32_t)tables.size());
+    for (const NameToDIE *table : tables)
+    {
+        StreamString table_strm (Stream::eBinary, 4, eByteOrderLittle);
+        uint32_t num_entries = 0;
+        table->ForEach ([&string_to_index, &table_strm, &num_entries](const char *name, uint32_t die_offset) -> bool {
+            table_strm.PutHex32 (string_to_index[name]);
+            table_strm.PutHex32 (die_offset);
+            ++num_entries;
+            return true;
+        });
+        strm.PutHex32 (num_entries);
+        strm.Write (table_strm.GetData(), table_strm.GetSize());
+    }
+
+    // Write to a temporary file and rename it into place so that other
+    // debug sessions never see a partially written cache file.
+    const std::string cache_path (GetCacheFileSpec (key).GetPath());
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", cache_path.c_str(), (uint64_t)Host::GetCurrentProcessID());
+
+    File file;
+    error = file.Open (tmp_path.GetData(),
+                       File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate,
+                       lldb::eFilePermissionsFileDefault);
+    if (error.Fail())
+        return error;
+
+    size_t bytes_written = strm.GetSize();
+    error = file.Write (strm.GetData(), bytes_written);
+    file.Close();
+    if (error.Success() && bytes_written != strm.GetSize())
+        error.SetErrorString ("short write to DWARF index cache file");
+
+    if (error.Success())
+    {
+        std::error_code ec = llvm::sys::fs::rename (tmp_path.GetData(), cache_path.c_str());
+        if (ec)
+            error.SetErrorString (ec.message().c_str());
+    }
+
+    if (error.Fail())
+        FileSystem::Unlink (tmp_path.GetData());
+    return error;
+}
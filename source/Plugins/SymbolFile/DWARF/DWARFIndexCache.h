@@ -0,0 +1,79 @@
+//===-- DWARFIndexCache.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWARFIndexCache_h_
+#define SymbolFileDWARF_DWARFIndexCache_h_
+
+#include <vector>
+
+#include "lldb/lldb-private.h"
+#include "lldb/Core/UUID.h"
+#include "lldb/Host/FileSpec.h"
+
+class NameToDIE;
+
+//----------------------------------------------------------------------
+// Saves and restores the finalized NameToDIE tables that
+// SymbolFileDWARF::Index() builds so that unchanged modules don't need
+// to be indexed again in the next debug session.
+//
+// A cache file is named after the UUID of the object file it was built
+// for, and is only used if the modification time, file offset and
+// .debug_info size it recorded still match the object file.
+//----------------------------------------------------------------------
+class DWARFIndexCache
+{
+public:
+    struct Key
+    {
+        Key () :
+            uuid (),
+            mod_time (0),
+            file_offset (0),
+            debug_info_size (0)
+        {
+        }
+
+        lldb_private::UUID uuid;
+        uint64_t mod_time;          // Seconds since Jan 1 1970
+        uint64_t file_offset;       // Offset of the object file within its container
+        uint64_t debug_info_size;   // Byte size of .debug_info
+
+        bool
+        IsValid () const
+        {
+            return uuid.IsValid();
+        }
+    };
+
+    DWARFIndexCache (const lldb_private::FileSpec &cache_dir);
+
+    //------------------------------------------------------------------
+    // Fill in "tables" from the cache file for "key". The number and
+    // order of the tables must match what was passed to Save(). Returns
+    // false, leaving "tables" untouched, if there is no usable cache
+    // file.
+    //------------------------------------------------------------------
+    bool
+    Load (const Key &key, const std::vector<NameToDIE *> &tables) const;
+
+    //------------------------------------------------------------------
+    // Write the finalized "tables" to the cache file for "key".
+    //------------------------------------------------------------------
+    lldb_private::Error
+    Save (const Key &key, const std::vector<const NameToDIE *> &tables) const;
+
+    lldb_private::FileSpec
+    GetCacheFileSpec (const Key &key) const;
+
+private:
+    lldb_private::FileSpec m_cache_dir;
+};
+
+#endif  // SymbolFileDWARF_DWARFIndexCache_h_
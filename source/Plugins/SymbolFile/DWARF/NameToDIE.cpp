@@ -28,12 +28,26 @@ NameToDIE::Finalize()
     m_map.SizeToFit ();
 }
 
+void
+NameToDIE::Clear ()
+{
+    m_map.Clear ();
+}
+
 void
 NameToDIE::Insert (const ConstString& name, uint32_t die_offset)
 {
     m_map.Append(name.GetCString(), die_offset);
 }
 
+void
+NameToDIE::Append (const NameToDIE& other)
+{
+    const uint32_t size = other.m_map.GetSize();
+    for (uint32_t i = 0; i < size; ++i)
+        m_map.Append(other.m_map.GetCStringAtIndexUnchecked (i), other.m_map.GetValueAtIndexUnchecked (i));
+}
+
 size_t
 NameToDIE::Find (const ConstString &name, DIEArray &info_array) const
 {
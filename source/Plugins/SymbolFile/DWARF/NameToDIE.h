@@ -38,9 +38,15 @@ public:
     void
     Insert (const lldb_private::ConstString& name, uint32_t die_offset);
 
+    void
+    Append (const NameToDIE& other);
+
     void
     Finalize();
 
+    void
+    Clear ();
+
     size_t
     Find (const lldb_private::ConstString &name, 
           DIEArray &info_array) const;
@@ -24,6 +24,7 @@
 #include "clang/Basic/Specifiers.h"
 #include "clang/Sema/DeclSpec.h"
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/Casting.h"
 
 #include "lldb/Core/Module.h"
@@ -42,6 +43,9 @@
 
 #include "lldb/Host/Host.h"
 
+#include "lldb/Interpreter/OptionValueProperties.h"
+#include "lldb/Interpreter/Property.h"
+
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/ClangExternalASTSourceCallbacks.h"
 #include "lldb/Symbol/CompileUnit.h"
@@ -53,9 +57,12 @@
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
 
+#include "lldb/Utility/TaskPool.h"
+
 #include "DWARFCompileUnit.h"
 #include "DWARFDebugAbbrev.h"
 #include "DWARFDebugAranges.h"
+#include "DWARFDebugCUIndex.h"
 #include "DWARFDebugInfo.h"
 #include "DWARFDebugInfoEntry.h"
 #include "DWARFDebugLine.h"
@@ -64,10 +71,14 @@
 #include "DWARFDeclContext.h"
 #include "DWARFDIECollection.h"
 #include "DWARFFormValue.h"
+#include "DWARFIndexCache.h"
 #include "DWARFLocationList.h"
 #include "LogChannelDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
+#include "SymbolFileDWARFDwo.h"
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 
 #include <ctype.h>
@@ -145,6 +156,108 @@ removeHostnameFromPathname(const char* path_from_dwarf)
     return colon_pos + 1;
 }
 
+namespace {
+
+    PropertyDefinition
+    g_properties[] =
+    {
+        { "parallel-index"   , OptionValue::eTypeBoolean , true, true, nullptr, nullptr, "Index the DWARF compile units of a module on multiple threads. Faster, but keeps the DIEs of every compile unit in memory while the index is being built." },
+        { "index-cache-path" , OptionValue::eTypeFileSpec, true, 0   , nullptr, nullptr, "A directory in which to save the manually built DWARF name indexes of modules so later debug sessions can load them instead of indexing the DWARF again. Caching is disabled when this is empty." },
+        { "max-resident-die-memory", OptionValue::eTypeUInt64, true, 256 * 1024 * 1024, nullptr, nullptr, "The number of bytes of DIEs that indexing the DWARF of a module may leave in memory, so later lookups in those compile units don't need to extract the DIEs again. The DIEs of the compile units beyond this are freed once they have been indexed." },
+        { "use-gdb-index"    , OptionValue::eTypeBoolean , true, true, nullptr, nullptr, "Use the .gdb_index section of a module, when it has one, to index only the compile units that define a name being looked up instead of indexing all of the DWARF up front." },
+        { "use-address-index", OptionValue::eTypeBoolean , true, true, nullptr, nullptr, "Build a table of the address ranges of all of the functions and blocks of a module the first time many addresses are looked up in it at once, so looking up addresses doesn't need to search the DIEs of a compile unit." },
+        { "lazy-line-tables" , OptionValue::eTypeBoolean , true, true, nullptr, nullptr, "Only find where the sequences of a compile unit's line table start when it is parsed, and decode the rows of each sequence from the .debug_line data the first time they are needed." },
+        { "use-file-index"   , OptionValue::eTypeBoolean , true, true, nullptr, nullptr, "Build a table of the compile units that use each source file name of a module while indexing it, so setting a breakpoint by file and line only parses the line tables of those compile units." },
+        {  nullptr           , OptionValue::eTypeInvalid , false, 0  , nullptr, nullptr, nullptr }
+    };
+
+    enum
+    {
+        ePropertyParallelIndex,
+        ePropertyIndexCachePath,
+        ePropertyMaxResidentDIEMemory,
+        ePropertyUseGdbIndex,
+        ePropertyUseAddressIndex,
+        ePropertyLazyLineTables,
+        ePropertyUseFileIndex
+    };
+
+    class PluginProperties : public Properties
+    {
+    public:
+        static ConstString
+        GetSettingName ()
+        {
+            return SymbolFileDWARF::GetPluginNameStatic();
+        }
+
+        PluginProperties ()
+        {
+            m_collection_sp.reset (new OptionValueProperties(GetSettingName()));
+            m_collection_sp->Initialize(g_properties);
+        }
+
+        bool
+        GetParallelIndex () const
+        {
+            const uint32_t idx = ePropertyParallelIndex;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, g_properties[idx].default_uint_value != 0);
+        }
+
+        FileSpec
+        GetIndexCachePath () const
+        {
+            const uint32_t idx = ePropertyIndexCachePath;
+            return m_collection_sp->GetPropertyAtIndexAsFileSpec(nullptr, idx);
+        }
+
+        uint64_t
+        GetMaxResidentDIEMemory () const
+        {
+            const uint32_t idx = ePropertyMaxResidentDIEMemory;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64(nullptr, idx, g_properties[idx].default_uint_value);
+        }
+
+        bool
+        GetUseGdbIndex () const
+        {
+            const uint32_t idx = ePropertyUseGdbIndex;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, g_properties[idx].default_uint_value != 0);
+        }
+
+        bool
+        GetUseAddressIndex () const
+        {
+            const uint32_t idx = ePropertyUseAddressIndex;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, g_properties[idx].default_uint_value != 0);
+        }
+
+        bool
+        GetLazyLineTables () const
+        {
+            const uint32_t idx = ePropertyLazyLineTables;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, g_properties[idx].default_uint_value != 0);
+        }
+
+        bool
+        GetUseFileIndex () const
+        {
+            const uint32_t idx = ePropertyUseFileIndex;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, g_properties[idx].default_uint_value != 0);
+        }
+    };
+
+    typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
+
+    static const SymbolFileDWARFPropertiesSP&
+    GetGlobalPluginProperties()
+    {
+        static const auto g_settings_sp(std::make_shared<PluginProperties>());
+        return g_settings_sp;
+    }
+
+}  // anonymous namespace end
+
 #if defined(LLDB_CONFIGURATION_DEBUG) || defined(LLDB_CONFIGURATION_RELEASE)
 
 class DIEStack
@@ -231,7 +344,21 @@ SymbolFileDWARF::Initialize()
     LogChannelDWARF::Initialize();
     PluginManager::RegisterPlugin (GetPluginNameStatic(),
                                    GetPluginDescriptionStatic(),
-                                   CreateInstance);
+                                   CreateInstance,
+                                   DebuggerInitialize);
+}
+
+void
+SymbolFileDWARF::DebuggerInitialize(Debugger &debugger)
+{
+    if (!PluginManager::GetSettingForSymbolFilePlugin(debugger, PluginProperties::GetSettingName()))
+    {
+        const bool is_global_setting = true;
+        PluginManager::CreateSettingForSymbolFilePlugin(debugger,
+                                                        GetGlobalPluginProperties()->GetValueProperties(),
+                                                        ConstString ("Properties for the dwarf symbol-file plug-in."),
+                                                        is_global_setting);
+    }
 }
 
 void
@@ -352,12 +479,13 @@ SymbolFileDWARF::GetTypes (SymbolContextScope *sc_scope,
         dwarf_cu = GetDWARFCompileUnit(comp_unit);
         if (dwarf_cu == 0)
             return 0;
-        GetTypes (dwarf_cu,
-                  dwarf_cu->DIE(),
-                  dwarf_cu->GetOffset(),
-                  dwarf_cu->GetNextCompileUnitOffset(),
-                  type_mask,
-                  type_set);
+        dwarf_cu = dwarf_cu->GetNonSkeletonUnit();
+        dwarf_cu->GetSymbolFileDWARF()->GetTypes (dwarf_cu,
+                                                  dwarf_cu->DIE(),
+                                                  dwarf_cu->GetOffset(),
+                                                  dwarf_cu->GetNextCompileUnitOffset(),
+                                                  type_mask,
+                                                  type_set);
     }
     else
     {
@@ -370,12 +498,13 @@ SymbolFileDWARF::GetTypes (SymbolContextScope *sc_scope,
                 dwarf_cu = info->GetCompileUnitAtIndex(cu_idx);
                 if (dwarf_cu)
                 {
-                    GetTypes (dwarf_cu,
-                              dwarf_cu->DIE(),
-                              0,
-                              UINT32_MAX,
-                              type_mask,
-                              type_set);
+                    dwarf_cu = dwarf_cu->GetNonSkeletonUnit();
+                    dwarf_cu->GetSymbolFileDWARF()->GetTypes (dwarf_cu,
+                                                              dwarf_cu->DIE(),
+                                                              0,
+                                                              UINT32_MAX,
+                                                              type_mask,
+                                                              type_set);
                 }
             }
         }
@@ -508,6 +637,13 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_apple_types_ap (),
     m_apple_namespaces_ap (),
     m_apple_objc_ap (),
+    m_gdb_index_ap (),
+    m_address_index_ap (),
+    m_file_index_ap (),
+    m_dwp_obj_file_sp (),
+    m_dwp_cu_index_ap (),
+    m_skeleton_cu_indexes (),
+    m_cu_name_indexes (),
     m_function_basename_index(),
     m_function_fullname_index(),
     m_function_method_index(),
@@ -516,13 +652,21 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_global_index(),
     m_type_index(),
     m_namespace_index(),
+    m_dwo_name_index(),
     m_indexed (false),
+    m_parsed_gdb_index (false),
+    m_built_address_index (false),
+    m_built_file_index (false),
+    m_loaded_dwp (false),
+    m_found_skeleton_cus (false),
     m_is_external_ast_source (false),
     m_using_apple_tables (false),
     m_fetched_external_modules (false),
     m_supports_DW_AT_APPLE_objc_complete_type (eLazyBoolCalculate),
     m_ranges(),
-    m_unique_ast_type_map ()
+    m_unique_ast_type_map (),
+    m_extracted_debug_info_size (0),
+    m_extracted_die_count (0)
 {
 }
 
@@ -836,6 +980,24 @@ SymbolFileDWARF::get_apple_objc_data()
     return GetCachedSectionData (flagsGotAppleObjCData, eSectionTypeDWARFAppleObjC, m_data_apple_objc);
 }
 
+const DWARFDataExtractor&
+SymbolFileDWARF::get_gdb_index_data()
+{
+    return GetCachedSectionData (flagsGotGDBIndexData, eSectionTypeDWARFGDBIndex, m_data_gdb_index);
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_addr_data()
+{
+    return GetCachedSectionData (flagsGotDebugAddrData, eSectionTypeDWARFDebugAddr, m_data_debug_addr);
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARF::get_debug_str_offsets_data()
+{
+    return GetCachedSectionData (flagsGotDebugStrOffsetsData, eSectionTypeDWARFDebugStrOffsets, m_data_debug_str_offsets);
+}
+
 
 DWARFDebugAbbrev*
 SymbolFileDWARF::DebugAbbrev()
@@ -943,6 +1105,27 @@ SymbolFileDWARF::DebugRanges() const
     return m_ranges.get();
 }
 
+size_t
+SymbolFileDWARF::EstimateDIECount (size_t debug_info_size) const
+{
+    const uint64_t extracted_debug_info_size = m_extracted_debug_info_size;
+    const uint64_t extracted_die_count = m_extracted_die_count;
+    // The average bytes per DIE entry has been seen to be around 14-20,
+    // including the NULL DIEs which aren't stored.
+    if (extracted_die_count == 0 || extracted_debug_info_size == 0)
+        return debug_info_size / 24;
+    // Aim a little high as running out of space would double the array.
+    const double dies_per_byte = (double)extracted_die_count / extracted_debug_info_size;
+    return (size_t)(debug_info_size * dies_per_byte * 1.0625) + 1;
+}
+
+void
+SymbolFileDWARF::AddExtractedDIECount (size_t debug_info_size, size_t die_count)
+{
+    m_extracted_debug_info_size += debug_info_size;
+    m_extracted_die_count += die_count;
+}
+
 lldb::CompUnitSP
 SymbolFileDWARF::ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
 {
@@ -974,6 +1157,21 @@ SymbolFileDWARF::ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
                         const char * cu_die_name = cu_die->GetName(this, dwarf_cu);
                         const char * cu_comp_dir = cu_die->GetAttributeValueAsString(this, dwarf_cu, DW_AT_comp_dir, NULL);
                         LanguageType cu_language = (LanguageType)cu_die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_language, 0);
+                        if (cu_die_name == NULL || cu_language == eLanguageTypeUnknown)
+                        {
+                            // A split DWARF skeleton compile unit leaves the
+                            // name and language to the one in its .dwo file
+                            DWARFCompileUnit *dwo_cu = dwarf_cu->GetNonSkeletonUnit();
+                            const DWARFDebugInfoEntry *dwo_cu_die = dwo_cu != dwarf_cu ? dwo_cu->GetCompileUnitDIEOnly() : NULL;
+                            if (dwo_cu_die)
+                            {
+                                SymbolFileDWARF *dwo_dwarf = dwo_cu->GetSymbolFileDWARF();
+                                if (cu_die_name == NULL)
+                                    cu_die_name = dwo_cu_die->GetName(dwo_dwarf, dwo_cu);
+                                if (cu_language == eLanguageTypeUnknown)
+                                    cu_language = (LanguageType)dwo_cu_die->GetAttributeValueAsUnsigned(dwo_dwarf, dwo_cu, DW_AT_language, 0);
+                            }
+                        }
                         if (cu_die_name)
                         {
                             std::string ramapped_file;
@@ -1210,6 +1408,10 @@ SymbolFileDWARF::ParseCompileUnitLanguage (const SymbolContext& sc)
             if (language)
                 return (lldb::LanguageType)language;
         }
+
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile)
+            return dwo_symfile->ParseCompileUnitLanguage(sc);
     }
     return eLanguageTypeUnknown;
 }
@@ -1222,6 +1424,12 @@ SymbolFileDWARF::ParseCompileUnitFunctions(const SymbolContext &sc)
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
     {
+        // The DIEs of a split DWARF skeleton compile unit are in its .dwo
+        // file
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile)
+            return dwo_symfile->ParseCompileUnitFunctions(sc);
+
         DWARFDIECollection function_dies;
         const size_t num_functions = dwarf_cu->AppendDIEsWithTag (DW_TAG_subprogram, function_dies);
         size_t func_idx;
@@ -1339,6 +1547,140 @@ ParseDWARFLineTableCallback(dw_offset_t offset, const DWARFDebugLine::State& sta
     }
 }
 
+struct IndexDWARFLineSequencesCallbackInfo
+{
+    IndexDWARFLineSequencesCallbackInfo () :
+        line_table (NULL),
+        prologue (),
+        end_offset (DW_INVALID_OFFSET),
+        sequence_offset (DW_INVALID_OFFSET),
+        file_addr (LLDB_INVALID_ADDRESS),
+        prev_file_addr (LLDB_INVALID_ADDRESS),
+        num_entries (0),
+        file_mask (0)
+    {
+    }
+
+    LineTable* line_table;
+    DWARFDebugLine::Prologue::shared_ptr prologue;
+    dw_offset_t end_offset;         // The end of the line table
+    dw_offset_t sequence_offset;    // The first opcode of the current sequence
+    dw_addr_t file_addr;            // The address of the first row of the current sequence
+    dw_addr_t prev_file_addr;       // The address of the last row
+    uint32_t num_entries;           // The number of line entries the rows so far make
+    uint64_t file_mask;
+};
+
+//----------------------------------------------------------------------
+// IndexDWARFLineSequencesCallback
+//
+// Record where each sequence of a line table starts and how many line
+// entries it will have without keeping any of its rows.
+//----------------------------------------------------------------------
+static void
+IndexDWARFLineSequencesCallback(dw_offset_t offset, const DWARFDebugLine::State& state, void* userData)
+{
+    IndexDWARFLineSequencesCallbackInfo* info = (IndexDWARFLineSequencesCallbackInfo*)userData;
+    if (state.row == DWARFDebugLine::State::StartParsingLineTable)
+    {
+        info->prologue = state.prologue;
+        info->sequence_offset = offset;
+    }
+    else if (state.row == DWARFDebugLine::State::DoneParsingLineTable)
+    {
+        info->end_offset = offset;
+    }
+    else
+    {
+        // LineTable::AppendLineEntryToSequence() replaces the previous
+        // entry when a row has the same address, so count the same way
+        if (info->num_entries == 0)
+        {
+            info->file_addr = state.address;
+            info->num_entries = 1;
+        }
+        else if (state.address != info->prev_file_addr)
+        {
+            ++info->num_entries;
+        }
+        info->prev_file_addr = state.address;
+        info->file_mask |= LineTable::GetFileMask (state.file);
+
+        if (state.end_sequence)
+        {
+            info->line_table->InsertLazySequence (info->file_addr,
+                                                  state.address,
+                                                  info->num_entries,
+                                                  info->file_mask,
+                                                  info->sequence_offset);
+            info->sequence_offset = offset;
+            info->num_entries = 0;
+            info->file_mask = 0;
+        }
+    }
+}
+
+struct DecodeDWARFLineSequenceCallbackInfo
+{
+    LineTable* line_table;
+    LineSequence* sequence;
+};
+
+static void
+DecodeDWARFLineSequenceCallback(dw_offset_t offset, const DWARFDebugLine::State& state, void* userData)
+{
+    if (state.row != DWARFDebugLine::State::StartParsingLineTable &&
+        state.row != DWARFDebugLine::State::DoneParsingLineTable)
+    {
+        DecodeDWARFLineSequenceCallbackInfo* info = (DecodeDWARFLineSequenceCallbackInfo*)userData;
+        info->line_table->AppendLineEntryToSequence (info->sequence,
+                                                     state.address,
+                                                     state.line,
+                                                     state.column,
+                                                     state.file,
+                                                     state.is_stmt,
+                                                     state.basic_block,
+                                                     state.prologue_end,
+                                                     state.epilogue_begin,
+                                                     state.end_sequence);
+    }
+}
+
+//----------------------------------------------------------------------
+// Decodes the sequences of a lazily parsed line table straight from the
+// .debug_line data, which stays alive (and mapped when the DWARF is
+// memory mapped) as long as the decoder holds a reference to it.
+//----------------------------------------------------------------------
+class DWARFLineSequenceDecoder : public LineSequenceDecoder
+{
+public:
+    DWARFLineSequenceDecoder (const DWARFDataExtractor &debug_line_data,
+                              const DWARFDebugLine::Prologue::shared_ptr &prologue,
+                              dw_offset_t end_offset) :
+        LineSequenceDecoder (),
+        m_debug_line_data (debug_line_data),
+        m_prologue (prologue),
+        m_end_offset (end_offset)
+    {
+        // Decoding a sequence doesn't need the file names
+        m_prologue->include_directories.clear();
+        m_prologue->file_names.clear();
+    }
+
+    virtual bool
+    DecodeSequence (LineTable &line_table, lldb::offset_t decode_offset, LineSequence *sequence)
+    {
+        DecodeDWARFLineSequenceCallbackInfo info = { &line_table, sequence };
+        lldb::offset_t offset = decode_offset;
+        return DWARFDebugLine::ParseStatementSequence (m_debug_line_data, &offset, m_end_offset, m_prologue, DecodeDWARFLineSequenceCallback, &info);
+    }
+
+private:
+    DWARFDataExtractor m_debug_line_data;
+    DWARFDebugLine::Prologue::shared_ptr m_prologue;
+    dw_offset_t m_end_offset;
+};
+
 bool
 SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
 {
@@ -1356,7 +1698,19 @@ SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
             if (cu_line_offset != DW_INVALID_OFFSET)
             {
                 std::unique_ptr<LineTable> line_table_ap(new LineTable(sc.comp_unit));
-                if (line_table_ap.get())
+                if (line_table_ap.get() && m_debug_map_symfile == NULL && GetGlobalPluginProperties()->GetLazyLineTables())
+                {
+                    // Only find the sequences now and let the line table
+                    // decode them when they are first needed
+                    IndexDWARFLineSequencesCallbackInfo info;
+                    info.line_table = line_table_ap.get();
+                    lldb::offset_t offset = cu_line_offset;
+                    if (DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset, IndexDWARFLineSequencesCallback, &info))
+                        line_table_ap->SetSequenceDecoder (new DWARFLineSequenceDecoder (get_debug_line_data(), info.prologue, info.end_offset));
+                    sc.comp_unit->SetLineTable(line_table_ap.release());
+                    return true;
+                }
+                else if (line_table_ap.get())
                 {
                     ParseDWARFLineTableCallbackInfo info;
                     info.line_table = line_table_ap.get();
@@ -2379,6 +2733,10 @@ SymbolFileDWARF::ParseChildMembers
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 {
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->GetClangDeclContextContainingTypeUID (type_uid);
+
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info && UserIDMatches(type_uid))
     {
@@ -2393,6 +2751,10 @@ SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContext &sc, lldb::user_id_t type_uid)
 {
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->GetClangDeclContextForTypeUID (sc, type_uid);
+
     if (UserIDMatches(type_uid))
         return GetClangDeclContextForDIEOffset (sc, type_uid);
     return NULL;
@@ -2401,6 +2763,10 @@ SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContex
 Type*
 SymbolFileDWARF::ResolveTypeUID (lldb::user_id_t type_uid)
 {
+    SymbolFileDWARFDwo *dwo_symfile = GetDwoSymbolFileForUID (type_uid);
+    if (dwo_symfile)
+        return dwo_symfile->ResolveTypeUID (type_uid);
+
     if (UserIDMatches(type_uid))
     {
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -2494,6 +2860,13 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (ClangASTType &clang_type)
     const DWARFDebugInfoEntry* die = m_forward_decl_clang_type_to_die.lookup (clang_type_no_qualifiers.GetOpaqueQualType());
     if (die == NULL)
     {
+        // The types of split DWARF compile units are made by the symbol
+        // file of their .dwo file, in our clang AST context
+        for (SymbolFileDWARFDwo *dwo_symfile : GetLoadedDwoSymbolFiles())
+        {
+            if (dwo_symfile->HasForwardDeclForClangType (clang_type))
+                return dwo_symfile->ResolveClangOpaqueTypeDefinition (clang_type);
+        }
         // We have already resolved this type...
         return true;
     }
@@ -2606,10 +2979,7 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (ClangASTType &clang_type)
                             }
                             else
                             {
-                                if (!m_indexed)
-                                    Index ();
-
-                                m_objc_class_selectors_index.Find (class_name, method_die_offsets);
+                                FindInNameIndex (eNameIndexObjCClassSelectors, class_name, method_die_offsets);
                             }
 
                             if (!method_die_offsets.empty())
@@ -2883,6 +3253,11 @@ SymbolFileDWARF::UpdateExternalModuleListIfNeeded()
     for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
     {
         DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+
+        // Split DWARF skeleton compile units look like module references
+        // but their .dwo files are loaded by GetDwoSymbolFile()
+        if (dwarf_cu->IsSplitDWARFSkeleton())
+            continue;
         
         const DWARFDebugInfoEntry *die = dwarf_cu->GetCompileUnitDIEOnly();
         if (die && die->HasChildren() == false)
@@ -2982,142 +3357,234 @@ SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr, uint32_t resolve_
                        "SymbolFileDWARF::ResolveSymbolContext (so_addr = { section = %p, offset = 0x%" PRIx64 " }, resolve_scope = 0x%8.8x)",
                        static_cast<void*>(so_addr.GetSection().get()),
                        so_addr.GetOffset(), resolve_scope);
-    uint32_t resolved = 0;
     if (resolve_scope & (   eSymbolContextCompUnit  |
                             eSymbolContextFunction  |
                             eSymbolContextBlock     |
                             eSymbolContextLineEntry |
                             eSymbolContextVariable  ))
     {
-        lldb::addr_t file_vm_addr = so_addr.GetFileAddress();
+        // Building the address index parses the DIEs of every compile unit,
+        // which only pays off when many addresses are looked up at once, so
+        // only use it here if ResolveSymbolContexts() already built it.
+        const DWARFAddressIndex::Entry *entry = NULL;
+        DWARFAddressIndex *address_index = m_address_index_ap.get();
+        if (address_index)
+        {
+            static const DWARFAddressIndex::Entry g_no_entry;
+            entry = address_index->FindAddress (so_addr.GetFileAddress());
+            if (entry == NULL)
+                entry = &g_no_entry;
+        }
+        return ResolveSymbolContext (so_addr, entry, resolve_scope, sc);
+    }
+    return 0;
+}
 
-        DWARFDebugInfo* debug_info = DebugInfo();
-        if (debug_info)
+size_t
+SymbolFileDWARF::ResolveSymbolContexts (const std::vector<Address>& so_addrs,
+                                        uint32_t resolve_scope,
+                                        std::vector<SymbolContext>& sc_list,
+                                        std::vector<uint32_t>& resolved_list)
+{
+    DWARFAddressIndex *address_index = NULL;
+    if (resolve_scope & (   eSymbolContextCompUnit  |
+                            eSymbolContextFunction  |
+                            eSymbolContextBlock     |
+                            eSymbolContextLineEntry |
+                            eSymbolContextVariable  ))
+        address_index = AddressIndex();
+    if (address_index == NULL)
+        return SymbolFile::ResolveSymbolContexts (so_addrs, resolve_scope, sc_list, resolved_list);
+
+    Timer scoped_timer(__PRETTY_FUNCTION__,
+                       "SymbolFileDWARF::ResolveSymbolContexts (%" PRIu64 " addresses, resolve_scope = 0x%8.8x)",
+                       (uint64_t)so_addrs.size(), resolve_scope);
+
+    // Look all of the addresses up in one pass over the index
+    std::vector<dw_addr_t> file_addrs;
+    file_addrs.reserve (so_addrs.size());
+    for (const Address &so_addr : so_addrs)
+        file_addrs.push_back (so_addr.GetFileAddress());
+    std::vector<const DWARFAddressIndex::Entry *> entries;
+    address_index->FindAddresses (file_addrs, entries);
+
+    static const DWARFAddressIndex::Entry g_no_entry;
+    resolved_list.assign (so_addrs.size(), 0);
+    size_t num_resolved = 0;
+    for (size_t i = 0; i < so_addrs.size(); ++i)
+    {
+        resolved_list[i] = ResolveSymbolContext (so_addrs[i],
+                                                 entries[i] ? entries[i] : &g_no_entry,
+                                                 resolve_scope,
+                                                 sc_list[i]);
+        if (resolved_list[i])
+            ++num_resolved;
+    }
+    return num_resolved;
+}
+
+uint32_t
+SymbolFileDWARF::ResolveSymbolContext (const Address& so_addr,
+                                       const DWARFAddressIndex::Entry *entry,
+                                       uint32_t resolve_scope,
+                                       SymbolContext& sc)
+{
+    uint32_t resolved = 0;
+    lldb::addr_t file_vm_addr = so_addr.GetFileAddress();
+
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info)
+    {
+        const dw_offset_t cu_offset = entry ? entry->cu_offset : debug_info->GetCompileUnitAranges().FindAddress(file_vm_addr);
+        if (cu_offset == DW_INVALID_OFFSET)
         {
-            const dw_offset_t cu_offset = debug_info->GetCompileUnitAranges().FindAddress(file_vm_addr);
-            if (cu_offset == DW_INVALID_OFFSET)
+            // Global variables are not in the compile unit address ranges. The only way to
+            // currently find global variables is to iterate over the .debug_pubnames or the
+            // __apple_names table and find all items in there that point to DW_TAG_variable
+            // DIEs and then find the address that matches.
+            if (resolve_scope & eSymbolContextVariable)
             {
-                // Global variables are not in the compile unit address ranges. The only way to
-                // currently find global variables is to iterate over the .debug_pubnames or the
-                // __apple_names table and find all items in there that point to DW_TAG_variable
-                // DIEs and then find the address that matches.
-                if (resolve_scope & eSymbolContextVariable)
+                GlobalVariableMap &map = GetGlobalAranges();
+                const GlobalVariableMap::Entry *variable_entry = map.FindEntryThatContains(file_vm_addr);
+                if (variable_entry && variable_entry->data)
                 {
-                    GlobalVariableMap &map = GetGlobalAranges();
-                    const GlobalVariableMap::Entry *entry = map.FindEntryThatContains(file_vm_addr);
-                    if (entry && entry->data)
+                    Variable *variable = variable_entry->data;
+                    SymbolContextScope *scc = variable->GetSymbolContextScope();
+                    if (scc)
                     {
-                        Variable *variable = entry->data;
-                        SymbolContextScope *scc = variable->GetSymbolContextScope();
-                        if (scc)
-                        {
-                            scc->CalculateSymbolContext(&sc);
-                            sc.variable = variable;
-                        }
-                        return sc.GetResolvedMask();
+                        scc->CalculateSymbolContext(&sc);
+                        sc.variable = variable;
                     }
+                    return sc.GetResolvedMask();
                 }
             }
-            else
+        }
+        else
+        {
+            uint32_t cu_idx = DW_INVALID_INDEX;
+            DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnit(cu_offset, &cu_idx).get();
+            if (dwarf_cu)
             {
-                uint32_t cu_idx = DW_INVALID_INDEX;
-                DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnit(cu_offset, &cu_idx).get();
-                if (dwarf_cu)
+                sc.comp_unit = GetCompUnitForDWARFCompUnit(dwarf_cu, cu_idx);
+                if (sc.comp_unit)
                 {
-                    sc.comp_unit = GetCompUnitForDWARFCompUnit(dwarf_cu, cu_idx);
-                    if (sc.comp_unit)
-                    {
-                        resolved |= eSymbolContextCompUnit;
+                    resolved |= eSymbolContextCompUnit;
 
-                        bool force_check_line_table = false;
-                        if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
+                    bool force_check_line_table = false;
+                    if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
+                    {
+                        // The functions of a split DWARF compile unit are in its
+                        // .dwo file, which the address index doesn't cover
+                        DWARFCompileUnit *die_cu = dwarf_cu->GetNonSkeletonUnit();
+                        SymbolFileDWARF *die_dwarf = die_cu->GetSymbolFileDWARF();
+                        dw_offset_t function_offset = DW_INVALID_OFFSET;
+                        dw_offset_t block_offset = DW_INVALID_OFFSET;
+                        const DWARFDebugInfoEntry *function_die = NULL;
+                        if (entry && die_cu == dwarf_cu)
+                        {
+                            function_offset = entry->function_offset;
+                            block_offset = entry->block_offset;
+                        }
+                        else
                         {
-                            DWARFDebugInfoEntry *function_die = NULL;
                             DWARFDebugInfoEntry *block_die = NULL;
+                            DWARFDebugInfoEntry *found_function_die = NULL;
                             if (resolve_scope & eSymbolContextBlock)
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, &block_die);
+                                die_cu->LookupAddress(file_vm_addr, &found_function_die, &block_die);
                             }
                             else
                             {
-                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, NULL);
+                                die_cu->LookupAddress(file_vm_addr, &found_function_die, NULL);
                             }
+                            function_die = found_function_die;
+                            if (function_die)
+                                function_offset = function_die->GetOffset();
+                            if (block_die)
+                                block_offset = block_die->GetOffset();
+                        }
 
-                            if (function_die != NULL)
-                            {
-                                sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
-                                if (sc.function == NULL)
-                                    sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
-                            }
-                            else
+                        if (function_offset != DW_INVALID_OFFSET)
+                        {
+                            // Only extract the DIEs if the function hasn't
+                            // been parsed yet
+                            sc.function = sc.comp_unit->FindFunctionByUID (die_dwarf->MakeUserID(function_offset)).get();
+                            if (sc.function == NULL)
                             {
-                                // We might have had a compile unit that had discontiguous
-                                // address ranges where the gaps are symbols that don't have
-                                // any debug info. Discontiguous compile unit address ranges
-                                // should only happen when there aren't other functions from
-                                // other compile units in these gaps. This helps keep the size
-                                // of the aranges down.
-                                force_check_line_table = true;
+                                if (function_die == NULL)
+                                    function_die = die_cu->GetDIEPtr(function_offset);
+                                if (function_die)
+                                    sc.function = die_dwarf->ParseCompileUnitFunction(sc, die_cu, function_die);
                             }
+                        }
+                        else
+                        {
+                            // We might have had a compile unit that had discontiguous
+                            // address ranges where the gaps are symbols that don't have
+                            // any debug info. Discontiguous compile unit address ranges
+                            // should only happen when there aren't other functions from
+                            // other compile units in these gaps. This helps keep the size
+                            // of the aranges down.
+                            force_check_line_table = true;
+                        }
 
-                            if (sc.function != NULL)
-                            {
-                                resolved |= eSymbolContextFunction;
+                        if (sc.function != NULL)
+                        {
+                            resolved |= eSymbolContextFunction;
 
-                                if (resolve_scope & eSymbolContextBlock)
-                                {
-                                    Block& block = sc.function->GetBlock (true);
+                            if (resolve_scope & eSymbolContextBlock)
+                            {
+                                Block& block = sc.function->GetBlock (true);
 
-                                    if (block_die != NULL)
-                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
-                                    else
-                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
-                                    if (sc.block)
-                                        resolved |= eSymbolContextBlock;
-                                }
+                                if (block_offset != DW_INVALID_OFFSET)
+                                    sc.block = block.FindBlockByID (die_dwarf->MakeUserID(block_offset));
+                                else
+                                    sc.block = block.FindBlockByID (die_dwarf->MakeUserID(function_offset));
+                                if (sc.block)
+                                    resolved |= eSymbolContextBlock;
                             }
                         }
-                        
-                        if ((resolve_scope & eSymbolContextLineEntry) || force_check_line_table)
+                    }
+                    
+                    if ((resolve_scope & eSymbolContextLineEntry) || force_check_line_table)
+                    {
+                        LineTable *line_table = sc.comp_unit->GetLineTable();
+                        if (line_table != NULL)
                         {
-                            LineTable *line_table = sc.comp_unit->GetLineTable();
-                            if (line_table != NULL)
+                            // And address that makes it into this function should be in terms
+                            // of this debug file if there is no debug map, or it will be an
+                            // address in the .o file which needs to be fixed up to be in terms
+                            // of the debug map executable. Either way, calling FixupAddress()
+                            // will work for us.
+                            Address exe_so_addr (so_addr);
+                            if (FixupAddress(exe_so_addr))
                             {
-                                // And address that makes it into this function should be in terms
-                                // of this debug file if there is no debug map, or it will be an
-                                // address in the .o file which needs to be fixed up to be in terms
-                                // of the debug map executable. Either way, calling FixupAddress()
-                                // will work for us.
-                                Address exe_so_addr (so_addr);
-                                if (FixupAddress(exe_so_addr))
+                                if (line_table->FindLineEntryByAddress (exe_so_addr, sc.line_entry))
                                 {
-                                    if (line_table->FindLineEntryByAddress (exe_so_addr, sc.line_entry))
-                                    {
-                                        resolved |= eSymbolContextLineEntry;
-                                    }
+                                    resolved |= eSymbolContextLineEntry;
                                 }
                             }
                         }
-                        
-                        if (force_check_line_table && !(resolved & eSymbolContextLineEntry))
-                        {
-                            // We might have had a compile unit that had discontiguous
-                            // address ranges where the gaps are symbols that don't have
-                            // any debug info. Discontiguous compile unit address ranges
-                            // should only happen when there aren't other functions from
-                            // other compile units in these gaps. This helps keep the size
-                            // of the aranges down.
-                            sc.comp_unit = NULL;
-                            resolved &= ~eSymbolContextCompUnit;
-                        }
                     }
-                    else
+                    
+                    if (force_check_line_table && !(resolved & eSymbolContextLineEntry))
                     {
-                        GetObjectFile()->GetModule()->ReportWarning ("0x%8.8x: compile unit %u failed to create a valid lldb_private::CompileUnit class.",
-                                                                     cu_offset,
-                                                                     cu_idx);
+                        // We might have had a compile unit that had discontiguous
+                        // address ranges where the gaps are symbols that don't have
+                        // any debug info. Discontiguous compile unit address ranges
+                        // should only happen when there aren't other functions from
+                        // other compile units in these gaps. This helps keep the size
+                        // of the aranges down.
+                        sc.comp_unit = NULL;
+                        resolved &= ~eSymbolContextCompUnit;
                     }
                 }
+                else
+                {
+                    GetObjectFile()->GetModule()->ReportWarning ("0x%8.8x: compile unit %u failed to create a valid lldb_private::CompileUnit class.",
+                                                                 cu_offset,
+                                                                 cu_idx);
+                }
             }
         }
     }
@@ -3135,11 +3602,26 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
         DWARFDebugInfo* debug_info = DebugInfo();
         if (debug_info)
         {
-            uint32_t cu_idx;
-            DWARFCompileUnit* dwarf_cu = NULL;
-
-            for (cu_idx = 0; (dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx)) != NULL; ++cu_idx)
+            // Only the compile units that use a file with the same name
+            // can match, so when the file index has them skip the rest
+            // without parsing their support files
+            std::vector<DWARFFileIndex::Entry> candidates;
+            DWARFFileIndex *file_index = file_spec.GetFilename() ? FileIndex() : NULL;
+            if (file_index)
+                file_index->Find (file_spec.GetFilename(), candidates);
+            const size_t num_candidates = file_index ? candidates.size() : GetNumCompileUnits();
+
+            for (size_t candidate_idx = 0; candidate_idx < num_candidates; ++candidate_idx)
             {
+                const uint32_t cu_idx = file_index ? candidates[candidate_idx].cu_idx : candidate_idx;
+                DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+                if (dwarf_cu == NULL)
+                    break;
+
+                // Support files before the first one with the right name
+                // can't match
+                const uint32_t first_file_idx = file_index ? std::max<uint32_t>(1, candidates[candidate_idx].file_idx) : 1;
+
                 CompileUnit *dc_cu = GetCompUnitForDWARFCompUnit(dwarf_cu, cu_idx);
                 const bool full_match = (bool)file_spec.GetDirectory();
                 bool file_spec_matches_cu_file_spec = dc_cu != NULL && FileSpec::Equal(file_spec, *dc_cu, full_match);
@@ -3155,7 +3637,7 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                         // find it in the support files, we are done.
                         if (check_inlines)
                         {
-                            file_idx = sc.comp_unit->GetSupportFiles().FindFileIndex (1, file_spec, true);
+                            file_idx = sc.comp_unit->GetSupportFiles().FindFileIndex (first_file_idx, file_spec, true);
                             if (file_idx == UINT32_MAX)
                                 continue;
                         }
@@ -3164,140 +3646,817 @@ SymbolFileDWARF::ResolveSymbolContext(const FileSpec& file_spec, uint32_t line,
                         {
                             LineTable *line_table = sc.comp_unit->GetLineTable();
 
-                            if (line_table != NULL && line != 0)
-                            {
-                                // We will have already looked up the file index if
-                                // we are searching for inline entries.
-                                if (!check_inlines)
-                                    file_idx = sc.comp_unit->GetSupportFiles().FindFileIndex (1, file_spec, true);
+                            if (line_table != NULL && line != 0)
+                            {
+                                // We will have already looked up the file index if
+                                // we are searching for inline entries.
+                                if (!check_inlines)
+                                    file_idx = sc.comp_unit->GetSupportFiles().FindFileIndex (first_file_idx, file_spec, true);
+
+                                if (file_idx != UINT32_MAX)
+                                {
+                                    uint32_t found_line;
+                                    uint32_t line_idx = line_table->FindLineEntryIndexByFileIndex (0, file_idx, line, false, &sc.line_entry);
+                                    found_line = sc.line_entry.line;
+
+                                    while (line_idx != UINT32_MAX)
+                                    {
+                                        sc.function = NULL;
+                                        sc.block = NULL;
+                                        if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
+                                        {
+                                            const lldb::addr_t file_vm_addr = sc.line_entry.range.GetBaseAddress().GetFileAddress();
+                                            if (file_vm_addr != LLDB_INVALID_ADDRESS)
+                                            {
+                                                DWARFCompileUnit *die_cu = dwarf_cu->GetNonSkeletonUnit();
+                                                SymbolFileDWARF *die_dwarf = die_cu->GetSymbolFileDWARF();
+                                                DWARFDebugInfoEntry *function_die = NULL;
+                                                DWARFDebugInfoEntry *block_die = NULL;
+                                                die_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
+
+                                                if (function_die != NULL)
+                                                {
+                                                    sc.function = sc.comp_unit->FindFunctionByUID (die_dwarf->MakeUserID(function_die->GetOffset())).get();
+                                                    if (sc.function == NULL)
+                                                        sc.function = die_dwarf->ParseCompileUnitFunction(sc, die_cu, function_die);
+                                                }
+
+                                                if (sc.function != NULL)
+                                                {
+                                                    Block& block = sc.function->GetBlock (true);
+
+                                                    if (block_die != NULL)
+                                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(block_die->GetOffset()));
+                                                    else if (function_die != NULL)
+                                                        sc.block = block.FindBlockByID (die_dwarf->MakeUserID(function_die->GetOffset()));
+                                                }
+                                            }
+                                        }
+
+                                        sc_list.Append(sc);
+                                        line_idx = line_table->FindLineEntryIndexByFileIndex (line_idx + 1, file_idx, found_line, true, &sc.line_entry);
+                                    }
+                                }
+                            }
+                            else if (file_spec_matches_cu_file_spec && !check_inlines)
+                            {
+                                // only append the context if we aren't looking for inline call sites
+                                // by file and line and if the file spec matches that of the compile unit
+                                sc_list.Append(sc);
+                            }
+                        }
+                        else if (file_spec_matches_cu_file_spec && !check_inlines)
+                        {
+                            // only append the context if we aren't looking for inline call sites
+                            // by file and line and if the file spec matches that of the compile unit
+                            sc_list.Append(sc);
+                        }
+
+                        if (!check_inlines)
+                            break;
+                    }
+                }
+            }
+        }
+    }
+    return sc_list.GetSize() - prev_size;
+}
+
+void
+SymbolFileDWARF::Index ()
+{
+    if (m_indexed)
+        return;
+    m_indexed = true;
+    // The full indexes make the per compile unit ones redundant
+    m_cu_name_indexes.clear();
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "SymbolFileDWARF::Index (%s)",
+                        GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
+
+    DWARFDebugInfo* debug_info = DebugInfo();
+    if (debug_info)
+    {
+        // Only the compile unit DIEs and line table headers are needed
+        // for this, so it isn't part of what the index cache saves
+        FileIndex();
+
+        // Try the on disk index cache before doing any work
+        const FileSpec index_cache_dir (GetGlobalPluginProperties()->GetIndexCachePath());
+        DWARFIndexCache::Key index_cache_key;
+        if (index_cache_dir)
+        {
+            GetIndexCacheKey (index_cache_key);
+            if (DWARFIndexCache(index_cache_dir).Load(index_cache_key, GetIndexTables()))
+                return;
+        }
+
+        const uint32_t num_compile_units = GetNumCompileUnits();
+        if (num_compile_units > 1 && GetGlobalPluginProperties()->GetParallelIndex())
+            ParallelIndex (debug_info, num_compile_units);
+        else
+        {
+            const uint64_t max_resident_die_memory = GetGlobalPluginProperties()->GetMaxResidentDIEMemory();
+            uint64_t resident_die_memory = 0;
+            for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+            {
+                DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+
+                bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
+
+                dwarf_cu->Index (cu_idx,
+                                 m_function_basename_index,
+                                 m_function_fullname_index,
+                                 m_function_method_index,
+                                 m_function_selector_index,
+                                 m_objc_class_selectors_index,
+                                 m_global_index,
+                                 m_type_index,
+                                 m_namespace_index);
+
+                // Keep memory down by clearing DIEs if this generate function
+                // caused them to be parsed and they don't fit in the
+                // resident DIE budget
+                if (clear_dies)
+                {
+                    const size_t die_memory = dwarf_cu->GetDIEMemorySize();
+                    if (resident_die_memory + die_memory <= max_resident_die_memory)
+                        resident_die_memory += die_memory;
+                    else
+                        dwarf_cu->ClearDIEs (true);
+                }
+            }
+        }
+
+        IndexDwoSymbolFiles ();
+
+        m_function_basename_index.Finalize();
+        m_function_fullname_index.Finalize();
+        m_function_method_index.Finalize();
+        m_function_selector_index.Finalize();
+        m_objc_class_selectors_index.Finalize();
+        m_global_index.Finalize(); 
+        m_type_index.Finalize();
+        m_namespace_index.Finalize();
+        m_dwo_name_index.Finalize();
+
+        if (index_cache_dir && index_cache_key.IsValid())
+        {
+            std::vector<NameToDIE *> tables (GetIndexTables());
+            Error error (DWARFIndexCache(index_cache_dir).Save(index_cache_key,
+                                                                std::vector<const NameToDIE *>(tables.begin(), tables.end())));
+            Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+            if (log && error.Fail())
+                GetObjectFile()->GetModule()->LogMessage (log,
+                                                          "SymbolFileDWARF::Index failed to save the index cache: %s",
+                                                          error.AsCString());
+        }
+
+#if defined (ENABLE_DEBUG_PRINTF)
+        StreamFile s(stdout, false);
+        s.Printf ("DWARF index for '%s':",
+                  GetObjectFile()->GetFileSpec().GetPath().c_str());
+        s.Printf("\nFunction basenames:\n");    m_function_basename_index.Dump (&s);
+        s.Printf("\nFunction fullnames:\n");    m_function_fullname_index.Dump (&s);
+        s.Printf("\nFunction methods:\n");      m_function_method_index.Dump (&s);
+        s.Printf("\nFunction selectors:\n");    m_function_selector_index.Dump (&s);
+        s.Printf("\nObjective C class selectors:\n");    m_objc_class_selectors_index.Dump (&s);
+        s.Printf("\nGlobals and statics:\n");   m_global_index.Dump (&s); 
+        s.Printf("\nTypes:\n");                 m_type_index.Dump (&s);
+        s.Printf("\nNamepaces:\n");             m_namespace_index.Dump (&s);
+#endif
+    }
+}
+
+std::vector<NameToDIE *>
+SymbolFileDWARF::GetIndexTables ()
+{
+    // The order of these tables is part of the index cache file format
+    std::vector<NameToDIE *> tables;
+    tables.push_back (&m_function_basename_index);
+    tables.push_back (&m_function_fullname_index);
+    tables.push_back (&m_function_method_index);
+    tables.push_back (&m_function_selector_index);
+    tables.push_back (&m_objc_class_selectors_index);
+    tables.push_back (&m_global_index);
+    tables.push_back (&m_type_index);
+    tables.push_back (&m_namespace_index);
+    tables.push_back (&m_dwo_name_index);
+    return tables;
+}
+
+void
+SymbolFileDWARF::IndexDwoSymbolFiles ()
+{
+    // Remember which .dwo files define each name so that lookups only
+    // need to look in the .dwo files that can have a match. The .dwo files
+    // are indexed in parallel, and not at all when the index comes from
+    // the index cache.
+    const std::vector<uint32_t> &skeleton_cu_indexes = GetSkeletonCompileUnitIndexes();
+    if (skeleton_cu_indexes.empty())
+        return;
+
+    // Find the .dwp package, if any, before the threads need it
+    GetDwpIndex ();
+
+    DWARFDebugInfo *debug_info = DebugInfo();
+    std::vector<std::vector<const char *>> dwo_names (skeleton_cu_indexes.size());
+    TaskMapOverInt(0, skeleton_cu_indexes.size(), [debug_info, &skeleton_cu_indexes, &dwo_names](size_t i)
+    {
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(skeleton_cu_indexes[i]);
+        if (dwarf_cu == NULL)
+            return;
+        const bool was_loaded = dwarf_cu->GetLoadedDwoSymbolFile() != NULL;
+        SymbolFileDWARF *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile == NULL)
+            return;
+
+        dwo_symfile->Index ();
+        llvm::DenseSet<const char *> names;
+        for (const NameToDIE *table : dwo_symfile->GetIndexTables())
+        {
+            table->ForEach ([&names, &dwo_names, i](const char *name, uint32_t die_offset) -> bool {
+                if (names.insert (name).second)
+                    dwo_names[i].push_back (name);
+                return true;
+            });
+        }
+
+        // Only keep what was in use before. A lookup that needs this .dwo
+        // file indexes it again, or loads its index from the index cache.
+        if (!was_loaded)
+        {
+            dwo_symfile->ClearIndex ();
+            DWARFCompileUnit *dwo_cu = static_cast<SymbolFileDWARFDwo *>(dwo_symfile)->GetCompileUnit();
+            if (dwo_cu)
+                dwo_cu->ClearDIEs (true);
+        }
+    });
+
+    // Insert the names in compile unit order so the index comes out the
+    // same every time
+    for (size_t i = 0; i < skeleton_cu_indexes.size(); ++i)
+    {
+        for (const char *name : dwo_names[i])
+            m_dwo_name_index.Insert (ConstString (name), skeleton_cu_indexes[i]);
+    }
+}
+
+void
+SymbolFileDWARF::ClearIndex ()
+{
+    for (NameToDIE *table : GetIndexTables())
+        table->Clear ();
+    m_indexed = false;
+}
+
+DWARFGdbIndex *
+SymbolFileDWARF::GdbIndex ()
+{
+    if (!m_parsed_gdb_index)
+    {
+        m_parsed_gdb_index = true;
+        if (!GetGlobalPluginProperties()->GetUseGdbIndex())
+            return NULL;
+
+        const DWARFDataExtractor &gdb_index_data = get_gdb_index_data();
+        if (gdb_index_data.GetByteSize() == 0)
+            return NULL;
+
+        m_gdb_index_ap.reset (new DWARFGdbIndex ());
+        // The index is only any use if it covers every compile unit,
+        // otherwise names in the ones it doesn't know about would be
+        // missed.
+        if (!m_gdb_index_ap->Extract (gdb_index_data) ||
+            m_gdb_index_ap->GetNumCompileUnits() != GetNumCompileUnits())
+        {
+            Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+            if (log)
+                GetObjectFile()->GetModule()->LogMessage (log, "ignoring invalid or incomplete .gdb_index");
+            m_gdb_index_ap.reset();
+        }
+    }
+    return m_gdb_index_ap.get();
+}
+
+DWARFAddressIndex *
+SymbolFileDWARF::AddressIndex ()
+{
+    if (!m_built_address_index)
+    {
+        m_built_address_index = true;
+        if (!GetGlobalPluginProperties()->GetUseAddressIndex())
+            return NULL;
+
+        DWARFDebugInfo *debug_info = DebugInfo();
+        if (debug_info == NULL)
+            return NULL;
+
+        Timer scoped_timer (__PRETTY_FUNCTION__,
+                            "SymbolFileDWARF::AddressIndex (%s)",
+                            GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
+
+        m_address_index_ap.reset (new DWARFAddressIndex ());
+
+        // The compile units cover the addresses in between their functions
+        const DWARFDebugAranges &cu_aranges = debug_info->GetCompileUnitAranges();
+        const size_t num_cu_ranges = cu_aranges.GetNumRanges();
+        for (size_t i = 0; i < num_cu_ranges; ++i)
+        {
+            const DWARFDebugAranges::Range *range = cu_aranges.RangeAtIndex(i);
+            m_address_index_ap->Append (range->GetRangeBase(),
+                                        range->GetRangeEnd(),
+                                        0,
+                                        DWARFAddressIndex::Entry (range->data, DW_INVALID_OFFSET, DW_INVALID_OFFSET));
+        }
+
+        // Make sure everything the compile units lazily pull in is loaded
+        // up front in case they are walked on multiple threads
+        get_debug_info_data();
+        get_debug_addr_data();
+        DebugAbbrev();
+        DebugRanges();
+
+        // The ranges of a function only refer to its own compile unit so
+        // each one can be done on its own, and its DIEs freed right after
+        const uint32_t num_compile_units = GetNumCompileUnits();
+        std::vector<DWARFAddressIndex> cu_address_indexes (num_compile_units);
+        auto build_cu_address_index = [debug_info, &cu_address_indexes](size_t cu_idx)
+        {
+            DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+            if (dwarf_cu == NULL)
+                return;
+            bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
+            // The functions of a split DWARF compile unit are in its .dwo
+            // file, which is only loaded if something is looked up in it
+            if (!dwarf_cu->IsSplitDWARFSkeleton())
+                dwarf_cu->BuildAddressIndex (cu_address_indexes[cu_idx]);
+            if (clear_dies)
+                dwarf_cu->ClearDIEs (true);
+        };
+        if (num_compile_units > 1 && GetGlobalPluginProperties()->GetParallelIndex())
+            TaskMapOverInt(0, num_compile_units, build_cu_address_index);
+        else
+        {
+            for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+                build_cu_address_index (cu_idx);
+        }
+
+        for (const DWARFAddressIndex &cu_address_index : cu_address_indexes)
+            m_address_index_ap->Append (cu_address_index);
+        m_address_index_ap->Finalize();
+
+        Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+        if (log)
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "built address index with %" PRIu64 " ranges using %" PRIu64 " bytes",
+                                                      (uint64_t)m_address_index_ap->GetNumSegments(),
+                                                      (uint64_t)m_address_index_ap->GetMemorySize());
+    }
+    return m_address_index_ap.get();
+}
+
+DWARFFileIndex *
+SymbolFileDWARF::FileIndex ()
+{
+    if (!m_built_file_index)
+    {
+        m_built_file_index = true;
+        if (!GetGlobalPluginProperties()->GetUseFileIndex())
+            return NULL;
+
+        DWARFDebugInfo *debug_info = DebugInfo();
+        if (debug_info == NULL)
+            return NULL;
+
+        Timer scoped_timer (__PRETTY_FUNCTION__,
+                            "SymbolFileDWARF::FileIndex (%s)",
+                            GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
+
+        m_file_index_ap.reset (new DWARFFileIndex ());
+
+        // Make sure everything the compile units lazily pull in is loaded
+        // up front in case they are read on multiple threads
+        get_debug_info_data();
+        get_debug_str_data();
+        get_debug_str_offsets_data();
+        get_debug_line_data();
+        DebugAbbrev();
+
+        const uint32_t num_compile_units = GetNumCompileUnits();
+        std::vector<DWARFFileIndex> cu_file_indexes (num_compile_units);
+        auto build_cu_file_index = [debug_info, &cu_file_indexes](size_t cu_idx)
+        {
+            DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+            if (dwarf_cu)
+                dwarf_cu->BuildFileIndex (cu_idx, cu_file_indexes[cu_idx]);
+        };
+        if (num_compile_units > 1 && GetGlobalPluginProperties()->GetParallelIndex())
+            TaskMapOverInt(0, num_compile_units, build_cu_file_index);
+        else
+        {
+            for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+                build_cu_file_index (cu_idx);
+        }
+
+        for (const DWARFFileIndex &cu_file_index : cu_file_indexes)
+            m_file_index_ap->Append (cu_file_index);
+        m_file_index_ap->Finalize();
+
+        Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+        if (log)
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "built file index with %" PRIu64 " files and %" PRIu64 " unindexed compile units using %" PRIu64 " bytes",
+                                                      (uint64_t)m_file_index_ap->GetSize(),
+                                                      (uint64_t)m_file_index_ap->GetNumUnindexed(),
+                                                      (uint64_t)m_file_index_ap->GetMemorySize());
+    }
+    return m_file_index_ap.get();
+}
+
+bool
+SymbolFileDWARF::FindCompileUnitsInGdbIndex (const ConstString &name, std::vector<uint32_t> &cu_indexes)
+{
+    DWARFGdbIndex *gdb_index = GdbIndex();
+    DWARFDebugInfo *debug_info = DebugInfo();
+    if (gdb_index == NULL || debug_info == NULL || !DWARFGdbIndex::CanLookupName (name))
+        return false;
+
+    std::vector<uint32_t> gdb_cu_indexes;
+    gdb_index->FindCompileUnits (name, gdb_cu_indexes);
+
+    // Map the compile units of the index to ours, keeping them in
+    // compile unit order so matches come out in the same order as
+    // they would from the full indexes.
+    for (uint32_t gdb_cu_idx : gdb_cu_indexes)
+    {
+        uint32_t cu_idx = UINT32_MAX;
+        if (debug_info->GetCompileUnit (gdb_index->GetCompileUnitOffset (gdb_cu_idx), &cu_idx) && cu_idx != UINT32_MAX)
+            cu_indexes.push_back (cu_idx);
+    }
+    std::sort (cu_indexes.begin(), cu_indexes.end());
+    cu_indexes.erase (std::unique (cu_indexes.begin(), cu_indexes.end()), cu_indexes.end());
+    return true;
+}
+
+size_t
+SymbolFileDWARF::FindInNameIndex (NameIndexType index_type,
+                                  const ConstString &name,
+                                  DIEArray &die_offsets)
+{
+    if (!m_indexed)
+    {
+        // Objective C selectors aren't in the .gdb_index
+        const bool gdb_index_has_names = index_type != eNameIndexFunctionSelectors &&
+                                         index_type != eNameIndexObjCClassSelectors;
+        DWARFDebugInfo *debug_info = DebugInfo();
+        std::vector<uint32_t> cu_indexes;
+        if (gdb_index_has_names && FindCompileUnitsInGdbIndex (name, cu_indexes))
+        {
+            if (m_cu_name_indexes.empty())
+                m_cu_name_indexes.resize (GetNumCompileUnits());
+
+            const size_t initial_size = die_offsets.size();
+            for (uint32_t cu_idx : cu_indexes)
+            {
+                if (cu_idx >= m_cu_name_indexes.size())
+                    continue;
+                std::unique_ptr<CompileUnitNameIndex> &cu_name_index = m_cu_name_indexes[cu_idx];
+                if (!cu_name_index)
+                {
+                    DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex (cu_idx);
+                    if (dwarf_cu == NULL)
+                        continue;
+                    // The DIEs are left in memory since the caller is about
+                    // to look at the ones we find.
+                    dwarf_cu->ExtractDIEsIfNeeded (false);
+                    cu_name_index.reset (new CompileUnitNameIndex ());
+                    NameToDIE *tables = cu_name_index->tables;
+                    dwarf_cu->Index (cu_idx,
+                                     tables[eNameIndexFunctionBasenames],
+                                     tables[eNameIndexFunctionFullnames],
+                                     tables[eNameIndexFunctionMethods],
+                                     tables[eNameIndexFunctionSelectors],
+                                     tables[eNameIndexObjCClassSelectors],
+                                     tables[eNameIndexGlobals],
+                                     tables[eNameIndexTypes],
+                                     tables[eNameIndexNamespaces]);
+                    for (NameToDIE &table : cu_name_index->tables)
+                        table.Finalize();
+                }
+                cu_name_index->tables[index_type].Find (name, die_offsets);
+            }
+            return die_offsets.size() - initial_size;
+        }
+
+        Index ();
+    }
+
+    return GetIndexTables()[index_type]->Find (name, die_offsets);
+}
+
+DWARFDebugCUIndex *
+SymbolFileDWARF::GetDwpIndex ()
+{
+    if (!m_loaded_dwp)
+    {
+        m_loaded_dwp = true;
+        // A split DWARF package is named after the module, e.g. "a.out.dwp"
+        ModuleSP module_sp (m_obj_file->GetModule());
+        const std::string dwp_path (m_obj_file->GetFileSpec().GetPath() + ".dwp");
+        FileSpec dwp_file (dwp_path.c_str(), false);
+        if (!module_sp || !dwp_file.Exists())
+            return NULL;
+
+        DataBufferSP dwp_file_data_sp;
+        lldb::offset_t dwp_file_data_offset = 0;
+        ObjectFileSP dwp_obj_file_sp (ObjectFile::FindPlugin (module_sp, &dwp_file, 0, dwp_file.GetByteSize(), dwp_file_data_sp, dwp_file_data_offset));
+        SectionList *section_list = dwp_obj_file_sp ? dwp_obj_file_sp->GetSectionList (false) : NULL;
+        SectionSP section_sp (section_list ? section_list->FindSectionByType (eSectionTypeDWARFDebugCUIndex, true) : SectionSP());
+        DWARFDataExtractor cu_index_data;
+        if (section_sp && dwp_obj_file_sp->ReadSectionData (section_sp.get(), cu_index_data) > 0)
+        {
+            m_dwp_cu_index_ap.reset (new DWARFDebugCUIndex ());
+            if (m_dwp_cu_index_ap->Extract (cu_index_data))
+                m_dwp_obj_file_sp = dwp_obj_file_sp;
+            else
+                m_dwp_cu_index_ap.reset();
+        }
 
-                                if (file_idx != UINT32_MAX)
-                                {
-                                    uint32_t found_line;
-                                    uint32_t line_idx = line_table->FindLineEntryIndexByFileIndex (0, file_idx, line, false, &sc.line_entry);
-                                    found_line = sc.line_entry.line;
+        if (!m_dwp_cu_index_ap)
+        {
+            Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+            if (log)
+                GetObjectFile()->GetModule()->LogMessage (log, "ignoring '%s' which has no valid .debug_cu_index", dwp_file.GetPath().c_str());
+        }
+    }
+    return m_dwp_cu_index_ap.get();
+}
 
-                                    while (line_idx != UINT32_MAX)
-                                    {
-                                        sc.function = NULL;
-                                        sc.block = NULL;
-                                        if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock))
-                                        {
-                                            const lldb::addr_t file_vm_addr = sc.line_entry.range.GetBaseAddress().GetFileAddress();
-                                            if (file_vm_addr != LLDB_INVALID_ADDRESS)
-                                            {
-                                                DWARFDebugInfoEntry *function_die = NULL;
-                                                DWARFDebugInfoEntry *block_die = NULL;
-                                                dwarf_cu->LookupAddress(file_vm_addr, &function_die, resolve_scope & eSymbolContextBlock ? &block_die : NULL);
+std::unique_ptr<SymbolFileDWARFDwo>
+SymbolFileDWARF::LoadDwoSymbolFile (DWARFCompileUnit &dwarf_cu, const DWARFDebugInfoEntry &cu_die)
+{
+    const char *dwo_name = cu_die.GetAttributeValueAsString (this, &dwarf_cu, DW_AT_GNU_dwo_name, NULL);
+    const uint64_t dwo_id = cu_die.GetAttributeValueAsUnsigned (this, &dwarf_cu, DW_AT_GNU_dwo_id, 0);
+    if (dwo_name == NULL || dwo_id == 0)
+        return std::unique_ptr<SymbolFileDWARFDwo>();
 
-                                                if (function_die != NULL)
-                                                {
-                                                    sc.function = sc.comp_unit->FindFunctionByUID (MakeUserID(function_die->GetOffset())).get();
-                                                    if (sc.function == NULL)
-                                                        sc.function = ParseCompileUnitFunction(sc, dwarf_cu, function_die);
-                                                }
+    // The units of a package are found by their id, the package is
+    // always used if there is one so a stale .dwo file isn't picked up
+    DWARFDebugCUIndex *dwp_index = GetDwpIndex ();
+    if (dwp_index)
+    {
+        DWARFDebugCUIndex::Contributions contributions;
+        if (dwp_index->FindUnit (dwo_id, contributions))
+            return std::unique_ptr<SymbolFileDWARFDwo>(new SymbolFileDWARFDwo (m_dwp_obj_file_sp, *this, dwarf_cu, &contributions));
+    }
 
-                                                if (sc.function != NULL)
-                                                {
-                                                    Block& block = sc.function->GetBlock (true);
+    FileSpec dwo_file (dwo_name, false);
+    if (dwo_file.IsRelativeToCurrentWorkingDirectory())
+    {
+        const char *comp_dir = cu_die.GetAttributeValueAsString (this, &dwarf_cu, DW_AT_comp_dir, NULL);
+        if (comp_dir)
+        {
+            dwo_file.SetFile (comp_dir, true);
+            dwo_file.AppendPathComponent (dwo_name);
+        }
+    }
 
-                                                    if (block_die != NULL)
-                                                        sc.block = block.FindBlockByID (MakeUserID(block_die->GetOffset()));
-                                                    else if (function_die != NULL)
-                                                        sc.block = block.FindBlockByID (MakeUserID(function_die->GetOffset()));
-                                                }
-                                            }
-                                        }
+    ObjectFileSP dwo_obj_file_sp;
+    ModuleSP module_sp (m_obj_file->GetModule());
+    if (module_sp && dwo_file.Exists())
+    {
+        DataBufferSP dwo_file_data_sp;
+        lldb::offset_t dwo_file_data_offset = 0;
+        dwo_obj_file_sp = ObjectFile::FindPlugin (module_sp, &dwo_file, 0, dwo_file.GetByteSize(), dwo_file_data_sp, dwo_file_data_offset);
+    }
 
-                                        sc_list.Append(sc);
-                                        line_idx = line_table->FindLineEntryIndexByFileIndex (line_idx + 1, file_idx, found_line, true, &sc.line_entry);
-                                    }
-                                }
-                            }
-                            else if (file_spec_matches_cu_file_spec && !check_inlines)
-                            {
-                                // only append the context if we aren't looking for inline call sites
-                                // by file and line and if the file spec matches that of the compile unit
-                                sc_list.Append(sc);
-                            }
-                        }
-                        else if (file_spec_matches_cu_file_spec && !check_inlines)
-                        {
-                            // only append the context if we aren't looking for inline call sites
-                            // by file and line and if the file spec matches that of the compile unit
-                            sc_list.Append(sc);
-                        }
+    if (!dwo_obj_file_sp)
+    {
+        Log *log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+        if (log)
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "0x%8.8x: unable to load split DWARF file '%s'",
+                                                      dwarf_cu.GetOffset(),
+                                                      dwo_file.GetPath().c_str());
+        return std::unique_ptr<SymbolFileDWARFDwo>();
+    }
+    return std::unique_ptr<SymbolFileDWARFDwo>(new SymbolFileDWARFDwo (dwo_obj_file_sp, *this, dwarf_cu, NULL));
+}
 
-                        if (!check_inlines)
-                            break;
-                    }
-                }
+const std::vector<uint32_t> &
+SymbolFileDWARF::GetSkeletonCompileUnitIndexes ()
+{
+    if (!m_found_skeleton_cus)
+    {
+        m_found_skeleton_cus = true;
+        DWARFDebugInfo *debug_info = DebugInfo();
+        // Skeleton compile units need .debug_addr for their addresses,
+        // or at least a line table, and a .dwo file never has any
+        if (debug_info && GetDebugMapSymfile () == NULL)
+        {
+            const uint32_t num_compile_units = GetNumCompileUnits();
+            for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+            {
+                DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+                if (dwarf_cu && dwarf_cu->IsSplitDWARFSkeleton())
+                    m_skeleton_cu_indexes.push_back (cu_idx);
             }
         }
     }
-    return sc_list.GetSize() - prev_size;
+    return m_skeleton_cu_indexes;
 }
 
 void
-SymbolFileDWARF::Index ()
+SymbolFileDWARF::GetDwoSymbolFiles (const ConstString &name, std::vector<SymbolFileDWARFDwo *> &dwo_symfiles)
 {
-    if (m_indexed)
+    const std::vector<uint32_t> &skeleton_cu_indexes = GetSkeletonCompileUnitIndexes();
+    if (skeleton_cu_indexes.empty())
         return;
-    m_indexed = true;
-    Timer scoped_timer (__PRETTY_FUNCTION__,
-                        "SymbolFileDWARF::Index (%s)",
-                        GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
 
-    DWARFDebugInfo* debug_info = DebugInfo();
+    DIEArray cu_indexes;
+    if (FindCompileUnitsInGdbIndex (name, cu_indexes))
+    {
+        // Both lists are sorted
+        DIEArray skeleton_cu_matches;
+        std::set_intersection (cu_indexes.begin(), cu_indexes.end(),
+                               skeleton_cu_indexes.begin(), skeleton_cu_indexes.end(),
+                               std::back_inserter (skeleton_cu_matches));
+        cu_indexes.swap (skeleton_cu_matches);
+    }
+    else
+    {
+        if (!m_indexed)
+            Index ();
+        m_dwo_name_index.Find (name, cu_indexes);
+    }
+    GetDwoSymbolFiles (cu_indexes, dwo_symfiles);
+}
+
+void
+SymbolFileDWARF::GetDwoSymbolFiles (const RegularExpression &regex, std::vector<SymbolFileDWARFDwo *> &dwo_symfiles)
+{
+    if (GetSkeletonCompileUnitIndexes().empty())
+        return;
+
+    // The .gdb_index can't be searched with a regular expression
+    if (!m_indexed)
+        Index ();
+    DIEArray cu_indexes;
+    m_dwo_name_index.Find (regex, cu_indexes);
+    GetDwoSymbolFiles (cu_indexes, dwo_symfiles);
+}
+
+void
+SymbolFileDWARF::GetDwoSymbolFiles (const DIEArray &cu_indexes, std::vector<SymbolFileDWARFDwo *> &dwo_symfiles)
+{
+    // Keep the .dwo files in compile unit order, each one only once
+    DIEArray sorted_cu_indexes (cu_indexes);
+    std::sort (sorted_cu_indexes.begin(), sorted_cu_indexes.end());
+    sorted_cu_indexes.erase (std::unique (sorted_cu_indexes.begin(), sorted_cu_indexes.end()), sorted_cu_indexes.end());
+
+    DWARFDebugInfo *debug_info = DebugInfo();
+    for (uint32_t cu_idx : sorted_cu_indexes)
+    {
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu ? dwarf_cu->GetDwoSymbolFile() : NULL;
+        if (dwo_symfile)
+            dwo_symfiles.push_back (dwo_symfile);
+    }
+}
+
+std::vector<SymbolFileDWARFDwo *>
+SymbolFileDWARF::GetLoadedDwoSymbolFiles ()
+{
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    DWARFDebugInfo *debug_info = DebugInfo();
     if (debug_info)
     {
-        uint32_t cu_idx = 0;
-        const uint32_t num_compile_units = GetNumCompileUnits();
-        for (cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+        for (uint32_t cu_idx : GetSkeletonCompileUnitIndexes())
         {
             DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+            SymbolFileDWARFDwo *dwo_symfile = dwarf_cu ? dwarf_cu->GetLoadedDwoSymbolFile() : NULL;
+            if (dwo_symfile)
+                dwo_symfiles.push_back (dwo_symfile);
+        }
+    }
+    return dwo_symfiles;
+}
 
-            bool clear_dies = dwarf_cu->ExtractDIEsIfNeeded (false) > 1;
+SymbolFileDWARFDwo *
+SymbolFileDWARF::GetDwoSymbolFileForUID (lldb::user_id_t uid)
+{
+    // The IDs of a .dwo symbol file have the index, plus one, of its
+    // skeleton compile unit in the high 32 bits. A debug map uses them
+    // for the index of the .o file instead.
+    const uint64_t cu_idx_plus_one = uid >> 32;
+    if (cu_idx_plus_one == 0 || GetID() != 0 || GetDebugMapSymfile () != NULL)
+        return NULL;
+    DWARFDebugInfo *debug_info = DebugInfo();
+    DWARFCompileUnit* dwarf_cu = debug_info ? debug_info->GetCompileUnitAtIndex(cu_idx_plus_one - 1) : NULL;
+    return dwarf_cu ? dwarf_cu->GetDwoSymbolFile() : NULL;
+}
+
+void
+SymbolFileDWARF::GetIndexCacheKey (DWARFIndexCache::Key &key)
+{
+    m_obj_file->GetUUID (&key.uuid);
+    key.mod_time = m_obj_file->GetFileSpec().GetModificationTime().GetAsSecondsSinceJan1_1970();
+    key.file_offset = m_obj_file->GetFileOffset();
+    key.debug_info_size = get_debug_info_data().GetByteSize();
+}
 
+void
+SymbolFileDWARF::ParallelIndex (DWARFDebugInfo *debug_info, uint32_t num_compile_units)
+{
+    // Make sure everything the compile units lazily pull in is loaded up
+    // front so the worker threads below only ever read shared state.
+    get_debug_info_data();
+    get_debug_str_data();
+    DebugAbbrev();
+
+    // A DIE can refer to DIEs in other compile units through
+    // DW_AT_specification and DW_AT_abstract_origin, so all of the DIEs
+    // need to be extracted before any compile unit can be indexed.
+    std::vector<uint8_t> clear_cu_dies (num_compile_units, false);
+    TaskMapOverInt(0, num_compile_units, [debug_info, &clear_cu_dies](size_t cu_idx)
+    {
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        if (dwarf_cu && dwarf_cu->ExtractDIEsIfNeeded (false) > 1)
+            clear_cu_dies[cu_idx] = true;
+    });
+
+    // Index each compile unit into its own set of maps so the workers
+    // don't contend on the final ones...
+    struct IndexSet
+    {
+        NameToDIE function_basename_index;
+        NameToDIE function_fullname_index;
+        NameToDIE function_method_index;
+        NameToDIE function_selector_index;
+        NameToDIE objc_class_selectors_index;
+        NameToDIE global_index;
+        NameToDIE type_index;
+        NameToDIE namespace_index;
+    };
+    std::vector<IndexSet> cu_index_sets (num_compile_units);
+    TaskMapOverInt(0, num_compile_units, [debug_info, &cu_index_sets](size_t cu_idx)
+    {
+        DWARFCompileUnit* dwarf_cu = debug_info->GetCompileUnitAtIndex(cu_idx);
+        if (dwarf_cu)
+        {
+            IndexSet &set = cu_index_sets[cu_idx];
             dwarf_cu->Index (cu_idx,
-                             m_function_basename_index,
-                             m_function_fullname_index,
-                             m_function_method_index,
-                             m_function_selector_index,
-                             m_objc_class_selectors_index,
-                             m_global_index, 
-                             m_type_index,
-                             m_namespace_index);
-            
-            // Keep memory down by clearing DIEs if this generate function
-            // caused them to be parsed
-            if (clear_dies)
-                dwarf_cu->ClearDIEs (true);
+                             set.function_basename_index,
+                             set.function_fullname_index,
+                             set.function_method_index,
+                             set.function_selector_index,
+                             set.objc_class_selectors_index,
+                             set.global_index,
+                             set.type_index,
+                             set.namespace_index);
         }
-        
-        m_function_basename_index.Finalize();
-        m_function_fullname_index.Finalize();
-        m_function_method_index.Finalize();
-        m_function_selector_index.Finalize();
-        m_objc_class_selectors_index.Finalize();
-        m_global_index.Finalize(); 
-        m_type_index.Finalize();
-        m_namespace_index.Finalize();
+    });
 
-#if defined (ENABLE_DEBUG_PRINTF)
-        StreamFile s(stdout, false);
-        s.Printf ("DWARF index for '%s':",
-                  GetObjectFile()->GetFileSpec().GetPath().c_str());
-        s.Printf("\nFunction basenames:\n");    m_function_basename_index.Dump (&s);
-        s.Printf("\nFunction fullnames:\n");    m_function_fullname_index.Dump (&s);
-        s.Printf("\nFunction methods:\n");      m_function_method_index.Dump (&s);
-        s.Printf("\nFunction selectors:\n");    m_function_selector_index.Dump (&s);
-        s.Printf("\nObjective C class selectors:\n");    m_objc_class_selectors_index.Dump (&s);
-        s.Printf("\nGlobals and statics:\n");   m_global_index.Dump (&s); 
-        s.Printf("\nTypes:\n");                 m_type_index.Dump (&s);
-        s.Printf("\nNamepaces:\n");             m_namespace_index.Dump (&s);
-#endif
+    // ...and merge them in compile unit order, one map per task, so the
+    // final maps end up with the same contents as the serial path.
+    auto merge = [&cu_index_sets](NameToDIE &index, NameToDIE IndexSet::*member)
+    {
+        for (auto &set : cu_index_sets)
+            index.Append (set.*member);
+    };
+    TaskPool::RunTasks([&]() { merge (m_function_basename_index, &IndexSet::function_basename_index); },
+                       [&]() { merge (m_function_fullname_index, &IndexSet::function_fullname_index); },
+                       [&]() { merge (m_function_method_index, &IndexSet::function_method_index); },
+                       [&]() { merge (m_function_selector_index, &IndexSet::function_selector_index); },
+                       [&]() { merge (m_objc_class_selectors_index, &IndexSet::objc_class_selectors_index); },
+                       [&]() { merge (m_global_index, &IndexSet::global_index); },
+                       [&]() { merge (m_type_index, &IndexSet::type_index); },
+                       [&]() { merge (m_namespace_index, &IndexSet::namespace_index); });
+
+    // Keep memory down by clearing DIEs for any compile units whose DIEs
+    // were only parsed so we could index them, once they no longer fit in
+    // the resident DIE budget. Decide in compile unit order so the same
+    // ones are kept as in the serial path.
+    const uint64_t max_resident_die_memory = GetGlobalPluginProperties()->GetMaxResidentDIEMemory();
+    uint64_t resident_die_memory = 0;
+    for (uint32_t cu_idx = 0; cu_idx < num_compile_units; ++cu_idx)
+    {
+        if (clear_cu_dies[cu_idx])
+        {
+            const size_t die_memory = debug_info->GetCompileUnitAtIndex(cu_idx)->GetDIEMemorySize();
+            if (resident_die_memory + die_memory <= max_resident_die_memory)
+            {
+                resident_die_memory += die_memory;
+                clear_cu_dies[cu_idx] = false;
+            }
+        }
     }
+    TaskMapOverInt(0, num_compile_units, [debug_info, &clear_cu_dies](size_t cu_idx)
+    {
+        if (clear_cu_dies[cu_idx])
+            debug_info->GetCompileUnitAtIndex(cu_idx)->ClearDIEs (true);
+    });
 }
 
 bool
@@ -3421,11 +4580,7 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
     }
     else
     {
-        // Index the DWARF if we haven't already
-        if (!m_indexed)
-            Index ();
-
-        m_global_index.Find (name, die_offsets);
+        FindInNameIndex (eNameIndexGlobals, name, die_offsets);
     }
 
     const size_t num_die_matches = die_offsets.size();
@@ -3481,6 +4636,20 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
         }
     }
 
+    // The variables of split DWARF compile units are in their .dwo files
+    if (variables.GetSize() - original_size < max_matches)
+    {
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (name, dwo_symfiles);
+        for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+        {
+            const uint32_t num_found = variables.GetSize() - original_size;
+            if (num_found >= max_matches)
+                break;
+            dwo_symfile->FindGlobalVariables (name, namespace_decl, true, max_matches - num_found, variables);
+        }
+    }
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = variables.GetSize() - original_size;
     if (log && num_matches > 0)
@@ -3575,6 +4744,19 @@ SymbolFileDWARF::FindGlobalVariables(const RegularExpression& regex, bool append
         }
     }
 
+    if (variables.GetSize() - original_size < max_matches)
+    {
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (regex, dwo_symfiles);
+        for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+        {
+            const uint32_t num_found = variables.GetSize() - original_size;
+            if (num_found >= max_matches)
+                break;
+            dwo_symfile->FindGlobalVariables (regex, true, max_matches - num_found, variables);
+        }
+    }
+
     // Return the number of variable that were appended to the list
     return variables.GetSize() - original_size;
 }
@@ -3649,12 +4831,12 @@ SymbolFileDWARF::ResolveFunction (DWARFCompileUnit *cu,
 
 void
 SymbolFileDWARF::FindFunctions (const ConstString &name, 
-                                const NameToDIE &name_to_die,
+                                NameIndexType index_type,
                                 bool include_inlines,
                                 SymbolContextList& sc_list)
 {
     DIEArray die_offsets;
-    if (name_to_die.Find (name, die_offsets))
+    if (FindInNameIndex (index_type, name, die_offsets))
     {
         ParseFunctions (die_offsets, include_inlines, sc_list);
     }
@@ -4023,14 +5205,9 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
     }
     else
     {
-
-        // Index the DWARF if we haven't already
-        if (!m_indexed)
-            Index ();
-
         if (name_type_mask & eFunctionNameTypeFull)
         {
-            FindFunctions (name, m_function_fullname_index, include_inlines, sc_list);
+            FindFunctions (name, eNameIndexFunctionFullnames, include_inlines, sc_list);
 
             // FIXME Temporary workaround for global/anonymous namespace
             // functions on FreeBSD and Linux
@@ -4042,7 +5219,7 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
             if (sc_list.GetSize() == 0)
             {
                 SymbolContextList temp_sc_list;
-                FindFunctions (name, m_function_basename_index, include_inlines, temp_sc_list);
+                FindFunctions (name, eNameIndexFunctionBasenames, include_inlines, temp_sc_list);
                 if (!namespace_decl)
                 {
                     SymbolContext sc;
@@ -4068,7 +5245,7 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
         
         if (name_type_mask & eFunctionNameTypeBase)
         {
-            uint32_t num_base = m_function_basename_index.Find(name, die_offsets);
+            uint32_t num_base = FindInNameIndex (eNameIndexFunctionBasenames, name, die_offsets);
             for (uint32_t i = 0; i < num_base; i++)
             {
                 const DWARFDebugInfoEntry* die = info->GetDIEPtrWithCompileUnitHint (die_offsets[i], &dwarf_cu);
@@ -4093,7 +5270,7 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
             if (namespace_decl && *namespace_decl)
                 return 0; // no methods in namespaces
 
-            uint32_t num_base = m_function_method_index.Find(name, die_offsets);
+            uint32_t num_base = FindInNameIndex (eNameIndexFunctionMethods, name, die_offsets);
             {
                 for (uint32_t i = 0; i < num_base; i++)
                 {
@@ -4114,11 +5291,17 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
 
         if ((name_type_mask & eFunctionNameTypeSelector) && (!namespace_decl || !*namespace_decl))
         {
-            FindFunctions (name, m_function_selector_index, include_inlines, sc_list);
+            FindFunctions (name, eNameIndexFunctionSelectors, include_inlines, sc_list);
         }
         
     }
 
+    // The functions of split DWARF compile units are in their .dwo files
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (name, dwo_symfiles);
+    for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+        dwo_symfile->FindFunctions (name, namespace_decl, name_type_mask, include_inlines, true, sc_list);
+
     // Return the number of variable that were appended to the list
     const uint32_t num_matches = sc_list.GetSize() - original_size;
     
@@ -4177,6 +5360,11 @@ SymbolFileDWARF::FindFunctions(const RegularExpression& regex, bool include_inli
         FindFunctions (regex, m_function_fullname_index, include_inlines, sc_list);
     }
 
+    std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+    GetDwoSymbolFiles (regex, dwo_symfiles);
+    for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+        dwo_symfile->FindFunctions (regex, include_inlines, true, sc_list);
+
     // Return the number of variable that were appended to the list
     return sc_list.GetSize() - original_size;
 }
@@ -4230,17 +5418,14 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
     }
     else
     {
-        if (!m_indexed)
-            Index ();
-
-        m_type_index.Find (name, die_offsets);
+        FindInNameIndex (eNameIndexTypes, name, die_offsets);
     }
 
+    const uint32_t initial_types_size = types.GetSize();
     const size_t num_die_matches = die_offsets.size();
 
     if (num_die_matches)
     {
-        const uint32_t initial_types_size = types.GetSize();
         DWARFCompileUnit* dwarf_cu = NULL;
         const DWARFDebugInfoEntry* die = NULL;
         DWARFDebugInfo* debug_info = DebugInfo();
@@ -4273,31 +5458,44 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
             }            
 
         }
-        const uint32_t num_matches = types.GetSize() - initial_types_size;
-        if (log && num_matches)
+    }
+
+    // The types of split DWARF compile units are in their .dwo files
+    if (types.GetSize() < max_matches)
+    {
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (name, dwo_symfiles);
+        for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
         {
-            if (namespace_decl)
-            {
-                GetObjectFile()->GetModule()->LogMessage (log,
-                                                          "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(%p) \"%s\", append=%u, max_matches=%u, type_list) => %u", 
-                                                          name.GetCString(),
-                                                          static_cast<void*>(namespace_decl->GetNamespaceDecl()),
-                                                          namespace_decl->GetQualifiedName().c_str(),
-                                                          append, max_matches,
-                                                          num_matches);
-            }
-            else
-            {
-                GetObjectFile()->GetModule()->LogMessage (log,
-                                                          "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(NULL), append=%u, max_matches=%u, type_list) => %u",
-                                                          name.GetCString(), 
-                                                          append, max_matches,
-                                                          num_matches);
-            }
+            dwo_symfile->FindTypes (sc, name, namespace_decl, true, max_matches, types);
+            if (types.GetSize() >= max_matches)
+                break;
         }
-        return num_matches;
     }
-    return 0;
+
+    const uint32_t num_matches = types.GetSize() - initial_types_size;
+    if (log && num_matches)
+    {
+        if (namespace_decl)
+        {
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(%p) \"%s\", append=%u, max_matches=%u, type_list) => %u", 
+                                                      name.GetCString(),
+                                                      static_cast<void*>(namespace_decl->GetNamespaceDecl()),
+                                                      namespace_decl->GetQualifiedName().c_str(),
+                                                      append, max_matches,
+                                                      num_matches);
+        }
+        else
+        {
+            GetObjectFile()->GetModule()->LogMessage (log,
+                                                      "SymbolFileDWARF::FindTypes (sc, name=\"%s\", clang::NamespaceDecl(NULL), append=%u, max_matches=%u, type_list) => %u",
+                                                      name.GetCString(), 
+                                                      append, max_matches,
+                                                      num_matches);
+        }
+    }
+    return num_matches;
 }
 
 
@@ -4336,10 +5534,7 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
         }
         else
         {
-            if (!m_indexed)
-                Index ();
-
-            m_namespace_index.Find (name, die_offsets);
+            FindInNameIndex (eNameIndexNamespaces, name, die_offsets);
         }
         
         DWARFCompileUnit* dwarf_cu = NULL;
@@ -4378,6 +5573,19 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
             }
         }
     }
+    if (!namespace_decl.GetNamespaceDecl())
+    {
+        // The namespaces of split DWARF compile units are in their .dwo
+        // files
+        std::vector<SymbolFileDWARFDwo *> dwo_symfiles;
+        GetDwoSymbolFiles (name, dwo_symfiles);
+        for (SymbolFileDWARFDwo *dwo_symfile : dwo_symfiles)
+        {
+            namespace_decl = dwo_symfile->FindNamespace (sc, name, parent_namespace_decl);
+            if (namespace_decl.GetNamespaceDecl())
+                break;
+        }
+    }
     if (log && namespace_decl.GetNamespaceDecl())
     {
         GetObjectFile()->GetModule()->LogMessage (log,
@@ -5085,10 +6293,7 @@ SymbolFileDWARF::FindCompleteObjCDefinitionTypeForDIE (const DWARFDebugInfoEntry
     }
     else
     {
-        if (!m_indexed)
-            Index ();
-        
-        m_type_index.Find (type_name, die_offsets);
+        FindInNameIndex (eNameIndexTypes, type_name, die_offsets);
     }
     
     const size_t num_matches = die_offsets.size();
@@ -5317,10 +6522,7 @@ SymbolFileDWARF::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &
             }
             else
             {
-                if (!m_indexed)
-                    Index ();
-                
-                m_type_index.Find (type_name, die_offsets);
+                FindInNameIndex (eNameIndexTypes, type_name, die_offsets);
             }
             
             const size_t num_matches = die_offsets.size();
@@ -7218,6 +8420,10 @@ SymbolFileDWARF::ParseFunctionBlocks (const SymbolContext &sc)
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
     {
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile)
+            return dwo_symfile->ParseFunctionBlocks(sc);
+
         dw_offset_t function_die_offset = sc.function->GetID();
         const DWARFDebugInfoEntry *function_die = dwarf_cu->GetDIEPtr(function_die_offset);
         if (function_die)
@@ -7239,6 +8445,10 @@ SymbolFileDWARF::ParseTypes (const SymbolContext &sc)
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
     if (dwarf_cu)
     {
+        SymbolFileDWARFDwo *dwo_symfile = dwarf_cu->GetDwoSymbolFile();
+        if (dwo_symfile)
+            return dwo_symfile->ParseTypes(sc);
+
         if (sc.function)
         {
             dw_offset_t function_die_offset = sc.function->GetID();
@@ -7269,6 +8479,11 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
         DWARFDebugInfo* info = DebugInfo();
         if (info == NULL)
             return 0;
+
+        DWARFCompileUnit* comp_unit_dwarf_cu = GetDWARFCompileUnit(sc.comp_unit);
+        SymbolFileDWARFDwo *dwo_symfile = comp_unit_dwarf_cu ? comp_unit_dwarf_cu->GetDwoSymbolFile() : NULL;
+        if (dwo_symfile)
+            return dwo_symfile->ParseVariablesForContext(sc);
         
         if (sc.function)
         {
@@ -7279,7 +8494,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
             
             const DWARFDebugInfoEntry *function_die = dwarf_cu->GetDIEPtr(sc.function->GetID());
             
-            dw_addr_t func_lo_pc = function_die->GetAttributeValueAsUnsigned (this, dwarf_cu, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
+            dw_addr_t func_lo_pc = function_die->GetAttributeValueAsAddress (this, dwarf_cu, DW_AT_low_pc, LLDB_INVALID_ADDRESS);
             if (func_lo_pc != LLDB_INVALID_ADDRESS)
             {
                 const size_t num_variables = ParseVariables(sc, dwarf_cu, func_lo_pc, function_die->GetFirstChild(), true, true);
@@ -7291,7 +8506,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
         }
         else if (sc.comp_unit)
         {
-            DWARFCompileUnit* dwarf_cu = info->GetCompileUnit(sc.comp_unit->GetID()).get();
+            DWARFCompileUnit* dwarf_cu = comp_unit_dwarf_cu;
 
             if (dwarf_cu == NULL)
                 return 0;
@@ -7440,7 +8655,7 @@ SymbolFileDWARF::ParseVariableDIE
                                 // Retrieve the value as a data expression.
                                 const uint8_t *fixed_form_sizes = DWARFFormValue::GetFixedFormSizesForAddressSize (attributes.CompileUnitAtIndex(i)->GetAddressByteSize(), attributes.CompileUnitAtIndex(i)->IsDWARF64());
                                 uint32_t data_offset = attributes.DIEOffsetAtIndex(i);
-                                uint32_t data_length = fixed_form_sizes[form_value.Form()];
+                                uint32_t data_length = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form_value.Form());
                                 if (data_length == 0)
                                 {
                                     const uint8_t *data_pointer = form_value.BlockData();
@@ -7464,7 +8679,7 @@ SymbolFileDWARF::ParseVariableDIE
                                 {
                                     const uint8_t *fixed_form_sizes = DWARFFormValue::GetFixedFormSizesForAddressSize (attributes.CompileUnitAtIndex(i)->GetAddressByteSize(), attributes.CompileUnitAtIndex(i)->IsDWARF64());
                                     uint32_t data_offset = attributes.DIEOffsetAtIndex(i);
-                                    uint32_t data_length = fixed_form_sizes[form_value.Form()];
+                                    uint32_t data_length = DWARFFormValue::GetFixedFormSize (fixed_form_sizes, form_value.Form());
                                     location.CopyOpcodeData(module, debug_info_data, data_offset, data_length);
                                 }
                                 else
@@ -7487,7 +8702,30 @@ SymbolFileDWARF::ParseVariableDIE
 
                                 uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
                                 uint32_t block_length = form_value.Unsigned();
-                                location.CopyOpcodeData(module, get_debug_info_data(), block_offset, block_length);
+
+                                // Split DWARF gives the address of a global as an index
+                                // into .debug_addr, which the expression evaluator can't
+                                // read, so turn the lone DW_OP_GNU_addr_index of a global
+                                // into a DW_OP_addr
+                                lldb::offset_t op_offset = block_offset;
+                                dw_addr_t op_addr = LLDB_INVALID_ADDRESS;
+                                if (block_length > 1 && debug_info_data.GetU8(&op_offset) == DW_OP_GNU_addr_index)
+                                {
+                                    const uint64_t addr_idx = debug_info_data.GetULEB128(&op_offset);
+                                    if (op_offset == block_offset + block_length)
+                                        op_addr = dwarf_cu->ReadAddressAtIndex(addr_idx);
+                                }
+
+                                if (op_addr != LLDB_INVALID_ADDRESS)
+                                {
+                                    const uint8_t addr_size = dwarf_cu->GetAddressByteSize();
+                                    StreamString strm (Stream::eBinary, addr_size, debug_info_data.GetByteOrder());
+                                    strm.PutHex8 (DW_OP_addr);
+                                    strm.PutMaxHex64 (op_addr, addr_size);
+                                    location.CopyOpcodeData (strm.GetData(), strm.GetSize(), debug_info_data.GetByteOrder(), addr_size);
+                                }
+                                else
+                                    location.CopyOpcodeData(module, get_debug_info_data(), block_offset, block_length);
                             }
                             else
                             {
@@ -8004,10 +9242,7 @@ SymbolFileDWARF::SearchDeclContext (const clang::DeclContext *decl_context,
         }
         else
         {
-            if (!m_indexed)
-                Index ();
-            
-            m_type_index.Find (ConstString(name), die_offsets);
+            FindInNameIndex (eNameIndexTypes, ConstString(name), die_offsets);
         }
         
         const size_t num_matches = die_offsets.size();
@@ -8054,7 +9289,10 @@ SymbolFileDWARF::FindExternalVisibleDeclsByName (void *baton,
     case clang::Decl::TranslationUnit:
         {
             SymbolFileDWARF *symbol_file_dwarf = (SymbolFileDWARF *)baton;
-            symbol_file_dwarf->SearchDeclContext (decl_context, decl_name.getAsString().c_str(), results);
+            const std::string name (decl_name.getAsString());
+            symbol_file_dwarf->SearchDeclContext (decl_context, name.c_str(), results);
+            for (SymbolFileDWARFDwo *dwo_symfile : symbol_file_dwarf->GetLoadedDwoSymbolFiles())
+                dwo_symfile->SearchDeclContext (decl_context, name.c_str(), results);
         }
         break;
     default:
@@ -8070,6 +9308,13 @@ SymbolFileDWARF::LayoutRecordType(void *baton, const clang::RecordDecl *record_d
                                   llvm::DenseMap<const clang::CXXRecordDecl *, clang::CharUnits> &vbase_offsets)
 {
     SymbolFileDWARF *symbol_file_dwarf = (SymbolFileDWARF *)baton;
+    for (SymbolFileDWARFDwo *dwo_symfile : symbol_file_dwarf->GetLoadedDwoSymbolFiles())
+    {
+        // The layout is recorded by the symbol file that made the type
+        SymbolFileDWARF *dwo_dwarf = dwo_symfile;
+        if (dwo_dwarf->m_record_decl_to_layout_map.count (record_decl))
+            return dwo_dwarf->LayoutRecordType (record_decl, size, alignment, field_offsets, base_offsets, vbase_offsets);
+    }
     return symbol_file_dwarf->LayoutRecordType (record_decl, size, alignment, field_offsets, base_offsets, vbase_offsets);
 }
 
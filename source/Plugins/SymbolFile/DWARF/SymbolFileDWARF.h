@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
@@ -37,7 +38,11 @@
 
 // Project includes
 #include "DWARFDefines.h"
+#include "DWARFAddressIndex.h"
+#include "DWARFFileIndex.h"
 #include "DWARFDataExtractor.h"
+#include "DWARFGdbIndex.h"
+#include "DWARFIndexCache.h"
 #include "HashedNameToDIE.h"
 #include "NameToDIE.h"
 #include "UniqueDWARFASTType.h"
@@ -51,6 +56,7 @@ class DWARFAbbreviationDeclarationSet;
 class DWARFileUnit;
 class DWARFDebugAbbrev;
 class DWARFDebugAranges;
+class DWARFDebugCUIndex;
 class DWARFDebugInfo;
 class DWARFDebugInfoEntry;
 class DWARFDebugLine;
@@ -60,6 +66,7 @@ class DWARFDeclContext;
 class DWARFDIECollection;
 class DWARFFormValue;
 class SymbolFileDWARFDebugMap;
+class SymbolFileDWARFDwo;
 
 class SymbolFileDWARF : public lldb_private::SymbolFile, public lldb_private::UserID
 {
@@ -67,6 +74,7 @@ public:
     friend class SymbolFileDWARFDebugMap;
     friend class DebugMapModule;
     friend class DWARFCompileUnit;
+    friend class SymbolFileDWARFDwo;
     //------------------------------------------------------------------
     // Static Functions
     //------------------------------------------------------------------
@@ -76,6 +84,9 @@ public:
     static void
     Terminate();
 
+    static void
+    DebuggerInitialize(lldb_private::Debugger &debugger);
+
     static lldb_private::ConstString
     GetPluginNameStatic();
 
@@ -117,6 +128,7 @@ public:
 
     virtual uint32_t        ResolveSymbolContext (const lldb_private::Address& so_addr, uint32_t resolve_scope, lldb_private::SymbolContext& sc);
     virtual uint32_t        ResolveSymbolContext (const lldb_private::FileSpec& file_spec, uint32_t line, bool check_inlines, uint32_t resolve_scope, lldb_private::SymbolContextList& sc_list);
+    virtual size_t          ResolveSymbolContexts (const std::vector<lldb_private::Address>& so_addrs, uint32_t resolve_scope, std::vector<lldb_private::SymbolContext>& sc_list, std::vector<uint32_t>& resolved_list);
     virtual uint32_t        FindGlobalVariables(const lldb_private::ConstString &name, const lldb_private::ClangNamespaceDecl *namespace_decl, bool append, uint32_t max_matches, lldb_private::VariableList& variables);
     virtual uint32_t        FindGlobalVariables(const lldb_private::RegularExpression& regex, bool append, uint32_t max_matches, lldb_private::VariableList& variables);
     virtual uint32_t        FindFunctions(const lldb_private::ConstString &name, const lldb_private::ClangNamespaceDecl *namespace_decl, uint32_t name_type_mask, bool include_inlines, bool append, lldb_private::SymbolContextList& sc_list);
@@ -206,6 +218,9 @@ public:
     const lldb_private::DWARFDataExtractor&     get_apple_types_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_namespaces_data ();
     const lldb_private::DWARFDataExtractor&     get_apple_objc_data ();
+    const lldb_private::DWARFDataExtractor&     get_gdb_index_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_addr_data ();
+    const lldb_private::DWARFDataExtractor&     get_debug_str_offsets_data ();
 
 
     DWARFDebugAbbrev*       DebugAbbrev();
@@ -217,7 +232,13 @@ public:
     DWARFDebugRanges*       DebugRanges();
     const DWARFDebugRanges* DebugRanges() const;
 
-    const lldb_private::DWARFDataExtractor&
+    // The number of DIEs a compile unit with "debug_info_size" bytes of
+    // .debug_info is expected to hold, based on the compile units whose
+    // DIEs were extracted so far.
+    size_t                  EstimateDIECount (size_t debug_info_size) const;
+    void                    AddExtractedDIECount (size_t debug_info_size, size_t die_count);
+
+    virtual const lldb_private::DWARFDataExtractor&
     GetCachedSectionData (uint32_t got_flag, 
                           lldb::SectionType sect_type, 
                           lldb_private::DWARFDataExtractor &data);
@@ -290,7 +311,31 @@ protected:
         flagsGotAppleNamesData      = (1 << 11),
         flagsGotAppleTypesData      = (1 << 12),
         flagsGotAppleNamespacesData = (1 << 13),
-        flagsGotAppleObjCData       = (1 << 14)
+        flagsGotAppleObjCData       = (1 << 14),
+        flagsGotGDBIndexData        = (1 << 15),
+        flagsGotDebugAddrData       = (1 << 16),
+        flagsGotDebugStrOffsetsData = (1 << 17)
+    };
+
+    // The name indexes, in the order GetIndexTables() returns them
+    enum NameIndexType
+    {
+        eNameIndexFunctionBasenames,
+        eNameIndexFunctionFullnames,
+        eNameIndexFunctionMethods,
+        eNameIndexFunctionSelectors,
+        eNameIndexObjCClassSelectors,
+        eNameIndexGlobals,
+        eNameIndexTypes,
+        eNameIndexNamespaces,
+        kNumNameIndexTypes
+    };
+
+    // The name indexes of a single compile unit, built on demand when a
+    // .gdb_index says the compile unit has a name we're looking for
+    struct CompileUnitNameIndex
+    {
+        NameToDIE tables[kNumNameIndexTypes];
     };
     
     bool                    NamespaceDeclMatchesThisSymbolFile (const lldb_private::ClangNamespaceDecl *namespace_decl);
@@ -301,9 +346,9 @@ protected:
 
     DISALLOW_COPY_AND_ASSIGN (SymbolFileDWARF);
     lldb::CompUnitSP        ParseCompileUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx);
-    DWARFCompileUnit*       GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
+    virtual DWARFCompileUnit*       GetDWARFCompileUnit(lldb_private::CompileUnit *comp_unit);
     DWARFCompileUnit*       GetNextUnparsedDWARFCompileUnit(DWARFCompileUnit* prev_cu);
-    lldb_private::CompileUnit*      GetCompUnitForDWARFCompUnit(DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
+    virtual lldb_private::CompileUnit*      GetCompUnitForDWARFCompUnit(DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
     bool                    GetFunction (DWARFCompileUnit* dwarf_cu, const DWARFDebugInfoEntry* func_die, lldb_private::SymbolContext& sc);
     lldb_private::Function *        ParseCompileUnitFunction (const lldb_private::SymbolContext& sc, DWARFCompileUnit* dwarf_cu, const DWARFDebugInfoEntry *die);
     size_t                  ParseFunctionBlocks (const lldb_private::SymbolContext& sc,
@@ -404,7 +449,7 @@ protected:
 
     void                    FindFunctions(
                                 const lldb_private::ConstString &name, 
-                                const NameToDIE &name_to_die,
+                                NameIndexType index_type,
                                 bool include_inlines,
                                 lldb_private::SymbolContextList& sc_list);
 
@@ -444,6 +489,49 @@ protected:
     uint32_t                FindTypes(std::vector<dw_offset_t> die_offsets, uint32_t max_matches, lldb_private::TypeList& types);
 
     void                    Index();
+
+    void                    ParallelIndex (DWARFDebugInfo *debug_info, uint32_t num_compile_units);
+
+    // Fill m_dwo_name_index from the indexes of the .dwo files
+    void                    IndexDwoSymbolFiles ();
+
+    // Drop the name indexes, the next lookup builds or loads them again
+    void                    ClearIndex ();
+
+    std::vector<NameToDIE *> GetIndexTables ();
+
+    // Find "name" in one of the name indexes. Uses the .gdb_index, when
+    // there is one, to index only the compile units that can contain
+    // "name" instead of the whole module.
+    size_t                  FindInNameIndex (NameIndexType index_type,
+                                             const lldb_private::ConstString &name,
+                                             DIEArray &die_offsets);
+
+    DWARFGdbIndex *         GdbIndex ();
+
+    // The address ranges of every function and block of the module, built
+    // the first time ResolveSymbolContexts() needs it. NULL if it is disabled.
+    DWARFAddressIndex *     AddressIndex ();
+
+    // The compile units that use each file name of the module, built
+    // while indexing. NULL if it is disabled.
+    DWARFFileIndex *        FileIndex ();
+
+    // Resolve "so_addr" given what the address index has for it, or the
+    // old way, through the compile unit aranges and a search of the DIEs
+    // of the compile unit, if "entry" is NULL
+    uint32_t                ResolveSymbolContext (const lldb_private::Address& so_addr,
+                                                  const DWARFAddressIndex::Entry *entry,
+                                                  uint32_t resolve_scope,
+                                                  lldb_private::SymbolContext& sc);
+
+    // Append the indexes of the compile units that the .gdb_index says
+    // define "name", sorted. Returns false if there is no usable
+    // .gdb_index or "name" can't be looked up in it.
+    bool                    FindCompileUnitsInGdbIndex (const lldb_private::ConstString &name,
+                                                        std::vector<uint32_t> &cu_indexes);
+
+    virtual void            GetIndexCacheKey (DWARFIndexCache::Key &key);
     
     void                    DumpIndexes();
 
@@ -455,6 +543,38 @@ protected:
     SymbolFileDWARFDebugMap *
                             GetDebugMapSymfile ();
 
+    // Open the .dwo file, or find the unit in the .dwp package, of a
+    // split DWARF skeleton compile unit
+    std::unique_ptr<SymbolFileDWARFDwo>
+                            LoadDwoSymbolFile (DWARFCompileUnit &dwarf_cu,
+                                               const DWARFDebugInfoEntry &cu_die);
+
+    DWARFDebugCUIndex *     GetDwpIndex ();
+
+    const std::vector<uint32_t> &
+                            GetSkeletonCompileUnitIndexes ();
+
+    // Append the symbol files of the .dwo files that can define "name",
+    // or a name matching "regex", loading them as needed. The .gdb_index,
+    // or else the name index of the .dwo files built by Index(), tells
+    // which ones to load.
+    void                    GetDwoSymbolFiles (const lldb_private::ConstString &name,
+                                               std::vector<SymbolFileDWARFDwo *> &dwo_symfiles);
+
+    void                    GetDwoSymbolFiles (const lldb_private::RegularExpression &regex,
+                                               std::vector<SymbolFileDWARFDwo *> &dwo_symfiles);
+
+    void                    GetDwoSymbolFiles (const DIEArray &cu_indexes,
+                                               std::vector<SymbolFileDWARFDwo *> &dwo_symfiles);
+
+    // Get the split DWARF symbol file that made "uid", or NULL if it was
+    // made by this symbol file
+    SymbolFileDWARFDwo *    GetDwoSymbolFileForUID (lldb::user_id_t uid);
+
+    // The .dwo symbol files that have been loaded so far
+    std::vector<SymbolFileDWARFDwo *>
+                            GetLoadedDwoSymbolFiles ();
+
     const DWARFDebugInfoEntry *
                             FindBlockContainingSpecification (dw_offset_t func_die_offset, 
                                                               dw_offset_t spec_block_die_offset,
@@ -469,7 +589,7 @@ protected:
     clang::NamespaceDecl *
     ResolveNamespaceDIE (DWARFCompileUnit *curr_cu, const DWARFDebugInfoEntry *die);
     
-    UniqueDWARFASTTypeMap &
+    virtual UniqueDWARFASTTypeMap &
     GetUniqueDWARFASTTypeMap ();
 
     void                    LinkDeclContextToDIE (clang::DeclContext *decl_ctx,
@@ -589,6 +709,9 @@ protected:
     lldb_private::DWARFDataExtractor      m_data_apple_types;
     lldb_private::DWARFDataExtractor      m_data_apple_namespaces;
     lldb_private::DWARFDataExtractor      m_data_apple_objc;
+    lldb_private::DWARFDataExtractor      m_data_gdb_index;
+    lldb_private::DWARFDataExtractor      m_data_debug_addr;
+    lldb_private::DWARFDataExtractor      m_data_debug_str_offsets;
 
     // The unique pointer items below are generated on demand if and when someone accesses
     // them through a non const version of this class.
@@ -599,6 +722,13 @@ protected:
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_types_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_namespaces_ap;
     std::unique_ptr<DWARFMappedHash::MemoryTable> m_apple_objc_ap;
+    std::unique_ptr<DWARFGdbIndex>      m_gdb_index_ap;
+    std::unique_ptr<DWARFAddressIndex>  m_address_index_ap;
+    std::unique_ptr<DWARFFileIndex>     m_file_index_ap;
+    lldb::ObjectFileSP                  m_dwp_obj_file_sp;      // The split DWARF package (.dwp) next to the module
+    std::unique_ptr<DWARFDebugCUIndex>  m_dwp_cu_index_ap;
+    std::vector<uint32_t>               m_skeleton_cu_indexes;  // Split DWARF skeleton compile units
+    std::vector<std::unique_ptr<CompileUnitNameIndex>> m_cu_name_indexes; // Indexed by compile unit index
     std::unique_ptr<GlobalVariableMap>  m_global_aranges_ap;
     ExternalTypeModuleMap               m_external_type_modules;
     NameToDIE                           m_function_basename_index;  // All concrete functions
@@ -609,7 +739,13 @@ protected:
     NameToDIE                           m_global_index;             // Global and static variables
     NameToDIE                           m_type_index;               // All type DIE offsets
     NameToDIE                           m_namespace_index;          // All type DIE offsets
+    NameToDIE                           m_dwo_name_index;           // Names defined in .dwo files to the index of their skeleton compile unit
     bool                                m_indexed:1,
+                                        m_parsed_gdb_index:1,
+                                        m_built_address_index:1,
+                                        m_built_file_index:1,
+                                        m_loaded_dwp:1,
+                                        m_found_skeleton_cus:1,
                                         m_is_external_ast_source:1,
                                         m_using_apple_tables:1,
                                         m_fetched_external_modules:1;
@@ -617,6 +753,8 @@ protected:
 
     std::unique_ptr<DWARFDebugRanges>     m_ranges;
     UniqueDWARFASTTypeMap m_unique_ast_type_map;
+    std::atomic<uint64_t> m_extracted_debug_info_size;
+    std::atomic<uint64_t> m_extracted_die_count;
     typedef llvm::SmallPtrSet<const DWARFDebugInfoEntry *, 4> DIEPointerSet;
     typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::DeclContext *> DIEToDeclContextMap;
     typedef llvm::DenseMap<const clang::DeclContext *, DIEPointerSet> DeclContextToDIEMap;
@@ -0,0 +1,167 @@
+//===-- SymbolFileDWARFDwo.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymbolFileDWARFDwo.h"
+
+#include <algorithm>
+
+#include "lldb/Core/Section.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+#include "DWARFCompileUnit.h"
+#include "DWARFDebugInfo.h"
+#include "DWARFDebugInfoEntry.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+SymbolFileDWARFDwo::SymbolFileDWARFDwo (const ObjectFileSP &objfile,
+                                        SymbolFileDWARF &base_symfile,
+                                        DWARFCompileUnit &skeleton_cu,
+                                        const DWARFDebugCUIndex::Contributions *contributions) :
+    SymbolFileDWARF (objfile.get()),
+    m_objfile_sp (objfile),
+    m_base_symfile (base_symfile),
+    m_skeleton_cu (skeleton_cu),
+    m_contributions (),
+    m_is_package (contributions != NULL)
+{
+    if (contributions)
+        std::copy (*contributions, *contributions + DWARFDebugCUIndex::kNumSectionKinds, m_contributions);
+
+    // Everything this symbol file makes has the index of the skeleton
+    // compile unit, plus one, in the high 32 bits of its ID so the base
+    // symbol file can tell which .dwo file an ID belongs to
+    uint32_t skeleton_cu_idx = UINT32_MAX;
+    base_symfile.DebugInfo()->GetCompileUnit (skeleton_cu.GetOffset(), &skeleton_cu_idx);
+    SetID (((lldb::user_id_t)skeleton_cu_idx + 1) << 32);
+
+    // The compile unit refers to addresses and ranges in the module
+    // through the bases of its skeleton
+    DWARFCompileUnit *dwarf_cu = GetCompileUnit();
+    if (dwarf_cu)
+    {
+        dwarf_cu->SetBaseAddress (skeleton_cu.GetBaseAddress());
+        dwarf_cu->SetAddrBase (skeleton_cu.GetAddrBase());
+        const DWARFDebugInfoEntry *skeleton_die = skeleton_cu.GetCompileUnitDIEOnly();
+        if (skeleton_die)
+            dwarf_cu->SetRangesBase (skeleton_die->GetAttributeValueAsUnsigned (&base_symfile, &skeleton_cu, DW_AT_GNU_ranges_base, 0));
+    }
+}
+
+SymbolFileDWARFDwo::~SymbolFileDWARFDwo ()
+{
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetCompileUnit ()
+{
+    DWARFDebugInfo *debug_info = DebugInfo();
+    if (debug_info == NULL)
+        return NULL;
+    return debug_info->GetCompileUnitAtIndex (0);
+}
+
+ClangASTContext &
+SymbolFileDWARFDwo::GetClangASTContext ()
+{
+    return m_base_symfile.GetClangASTContext();
+}
+
+const DWARFDataExtractor&
+SymbolFileDWARFDwo::GetCachedSectionData (uint32_t got_flag, SectionType sect_type, DWARFDataExtractor &data)
+{
+    // Only the DIEs and what they need to be read are in the .dwo file
+    switch (sect_type)
+    {
+        case eSectionTypeDWARFDebugAddr:    return m_base_symfile.get_debug_addr_data();
+        case eSectionTypeDWARFDebugAranges: return m_base_symfile.get_debug_aranges_data();
+        case eSectionTypeDWARFDebugFrame:   return m_base_symfile.get_debug_frame_data();
+        case eSectionTypeDWARFDebugLine:    return m_base_symfile.get_debug_line_data();
+        case eSectionTypeDWARFDebugRanges:  return m_base_symfile.get_debug_ranges_data();
+        default:
+            break;
+    }
+
+    if (m_flags.IsClear (got_flag))
+    {
+        m_flags.Set (got_flag);
+        // The location lists in .debug_loc.dwo have a format of their own
+        // that isn't supported, so variables that need one have no location
+        if (sect_type == eSectionTypeDWARFDebugLoc)
+            return data;
+
+        const SectionList *section_list = m_obj_file->GetSectionList (false);
+        SectionSP section_sp (section_list ? section_list->FindSectionByType (sect_type, true) : SectionSP());
+        if (!section_sp || m_obj_file->ReadSectionData (section_sp.get(), data) == 0)
+        {
+            data.Clear();
+            return data;
+        }
+
+        // A package has the sections of many units, only part of some of
+        // them is ours
+        if (m_is_package)
+        {
+            DWARFDebugCUIndex::SectionKind section_kind = DWARFDebugCUIndex::kNumSectionKinds;
+            switch (sect_type)
+            {
+                case eSectionTypeDWARFDebugInfo:       section_kind = DWARFDebugCUIndex::eSectionInfo; break;
+                case eSectionTypeDWARFDebugAbbrev:     section_kind = DWARFDebugCUIndex::eSectionAbbrev; break;
+                case eSectionTypeDWARFDebugMacInfo:    section_kind = DWARFDebugCUIndex::eSectionMacinfo; break;
+                case eSectionTypeDWARFDebugStrOffsets: section_kind = DWARFDebugCUIndex::eSectionStrOffsets; break;
+                default:
+                    break;
+            }
+            if (section_kind != DWARFDebugCUIndex::kNumSectionKinds)
+            {
+                const DWARFDebugCUIndex::Contribution &contribution = m_contributions[section_kind];
+                DWARFDataExtractor section_data (data);
+                data.Clear();
+                if (section_data.ValidOffsetForDataOfSize (contribution.offset, contribution.size))
+                    data.SetData (section_data, contribution.offset, contribution.size);
+            }
+        }
+    }
+    return data;
+}
+
+DWARFCompileUnit *
+SymbolFileDWARFDwo::GetDWARFCompileUnit (CompileUnit *comp_unit)
+{
+    // The compile unit was made by the base symbol file for the skeleton
+    DWARFCompileUnit *dwarf_cu = GetCompileUnit();
+    if (dwarf_cu && dwarf_cu->GetUserData() == NULL)
+        dwarf_cu->SetUserData (comp_unit);
+    return dwarf_cu;
+}
+
+CompileUnit *
+SymbolFileDWARFDwo::GetCompUnitForDWARFCompUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx)
+{
+    CompileUnit *comp_unit = m_base_symfile.GetCompUnitForDWARFCompUnit (&m_skeleton_cu);
+    if (comp_unit && dwarf_cu && dwarf_cu->GetUserData() == NULL)
+        dwarf_cu->SetUserData (comp_unit);
+    return comp_unit;
+}
+
+UniqueDWARFASTTypeMap &
+SymbolFileDWARFDwo::GetUniqueDWARFASTTypeMap ()
+{
+    // Types are made in the clang AST of the module, so they are uniqued
+    // across all of its .dwo files
+    return m_base_symfile.GetUniqueDWARFASTTypeMap();
+}
+
+void
+SymbolFileDWARFDwo::GetIndexCacheKey (DWARFIndexCache::Key &key)
+{
+    // A .dwo file has a single compile unit, which is quick to index, so
+    // leave the key invalid and don't cache its index
+}
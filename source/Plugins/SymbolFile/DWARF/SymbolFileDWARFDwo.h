@@ -0,0 +1,73 @@
+//===-- SymbolFileDWARFDwo.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_SymbolFileDWARFDwo_h_
+#define SymbolFileDWARF_SymbolFileDWARFDwo_h_
+
+#include "DWARFDebugCUIndex.h"
+#include "SymbolFileDWARF.h"
+
+//----------------------------------------------------------------------
+// The symbol file of the .dwo file of a split DWARF skeleton compile
+// unit, or of its unit in a .dwp package.
+//
+// A .dwo file has the DIEs of a single compile unit. The addresses,
+// ranges and line table it refers to stay in the module, so those are
+// read through the symbol file of the module, which also owns the
+// lldb_private::CompileUnit and the clang AST of the module.
+//----------------------------------------------------------------------
+class SymbolFileDWARFDwo : public SymbolFileDWARF
+{
+public:
+    // "contributions" is the part of each section of a .dwp package that
+    // belongs to the unit, or NULL if "objfile" is a .dwo file
+    SymbolFileDWARFDwo (const lldb::ObjectFileSP &objfile,
+                        SymbolFileDWARF &base_symfile,
+                        DWARFCompileUnit &skeleton_cu,
+                        const DWARFDebugCUIndex::Contributions *contributions);
+
+    virtual
+    ~SymbolFileDWARFDwo ();
+
+    // The compile unit of the .dwo file
+    DWARFCompileUnit *
+    GetCompileUnit ();
+
+    virtual lldb_private::ClangASTContext &
+    GetClangASTContext ();
+
+protected:
+    virtual const lldb_private::DWARFDataExtractor&
+    GetCachedSectionData (uint32_t got_flag,
+                          lldb::SectionType sect_type,
+                          lldb_private::DWARFDataExtractor &data);
+
+    virtual DWARFCompileUnit *
+    GetDWARFCompileUnit (lldb_private::CompileUnit *comp_unit);
+
+    virtual lldb_private::CompileUnit *
+    GetCompUnitForDWARFCompUnit (DWARFCompileUnit* dwarf_cu, uint32_t cu_idx = UINT32_MAX);
+
+    virtual UniqueDWARFASTTypeMap &
+    GetUniqueDWARFASTTypeMap ();
+
+    virtual void
+    GetIndexCacheKey (DWARFIndexCache::Key &key);
+
+    lldb::ObjectFileSP m_objfile_sp;    // Keeps m_obj_file alive
+    SymbolFileDWARF &m_base_symfile;
+    DWARFCompileUnit &m_skeleton_cu;
+    DWARFDebugCUIndex::Contributions m_contributions;
+    bool m_is_package;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (SymbolFileDWARFDwo);
+};
+
+#endif  // SymbolFileDWARF_SymbolFileDWARFDwo_h_
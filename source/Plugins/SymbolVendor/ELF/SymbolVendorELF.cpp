@@ -153,6 +153,8 @@ SymbolVendorELF::CreateInstance (const lldb::ModuleSP &module_sp, lldb_private::
                         eSectionTypeDWARFDebugPubNames,
                         eSectionTypeDWARFDebugPubTypes,
                         eSectionTypeDWARFDebugRanges,
+                        eSectionTypeDWARFGDBIndex,
+                        eSectionTypeDWARFDebugAddr,
                         eSectionTypeELFSymbolTable,
                     };
                     for (size_t idx = 0; idx < sizeof(g_sections) / sizeof(g_sections[0]); ++idx)
@@ -10,6 +10,7 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 #include <list>
 
 #include "lldb/Core/Log.h"
@@ -24,6 +25,7 @@
 #include "lldb/Symbol/UnwindPlan.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Utility/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -33,11 +35,15 @@ DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile& objfile, SectionSP& section_s
     m_section_sp (section_sp),
     m_reg_kind (reg_kind),  // The flavor of registers that the CFI data uses (enum RegisterKind)
     m_flags (),
-    m_cie_map (),
+    m_cies (),
+    m_cies_mutex (),
     m_cfi_data (),
     m_cfi_data_initialized (false),
     m_fde_index (),
     m_fde_index_initialized (false),
+    m_hdr_table (),
+    m_hdr_table_initialized (false),
+    m_hdr_table_valid (false),
     m_is_eh_frame (is_eh_frame)
 {
 }
@@ -73,14 +79,11 @@ DWARFCallFrameInfo::GetAddressRange (Address addr, AddressRange &range)
     if (module_sp.get() == nullptr || module_sp->GetObjectFile() == nullptr || module_sp->GetObjectFile() != &m_objfile)
         return false;
 
-    if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
-        return false;
-    GetFDEIndex();
-    FDEEntryMap::Entry *fde_entry = m_fde_index.FindEntryThatContains (addr.GetFileAddress());
-    if (!fde_entry)
+    FDEEntryMap::Entry fde_entry;
+    if (!GetFDEEntryByFileAddress (addr.GetFileAddress(), fde_entry))
         return false;
 
-    range = AddressRange(fde_entry->base, fde_entry->size, m_objfile.GetSectionList());
+    range = AddressRange(fde_entry.base, fde_entry.size, m_objfile.GetSectionList());
     return true;
 }
 
@@ -90,6 +93,10 @@ DWARFCallFrameInfo::GetFDEEntryByFileAddress (addr_t file_addr, FDEEntryMap::Ent
     if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
         return false;
 
+    // The linker's table covers every FDE, so there is no need to scan for them
+    if (GetEHFrameHdrTable())
+        return FindFDEInEHFrameHdrTable (file_addr, fde_entry);
+
     GetFDEIndex();
 
     if (m_fde_index.IsEmpty())
@@ -123,26 +130,39 @@ DWARFCallFrameInfo::GetFunctionAddressAndSizeVector (FunctionAddressAndSizeVecto
     }
 }
 
-const DWARFCallFrameInfo::CIE*
-DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset)
+const DWARFCallFrameInfo::CIE *
+DWARFCallFrameInfo::FindCIE (const cie_collection &cies, dw_offset_t cie_offset)
 {
-    cie_map_t::iterator pos = m_cie_map.find(cie_offset);
+    cie_collection::const_iterator pos = std::lower_bound (cies.begin(), cies.end(), cie_offset,
+                                                           [](const CIE &cie, dw_offset_t offset) { return cie.cie_offset < offset; });
+    if (pos != cies.end() && pos->cie_offset == cie_offset)
+        return &*pos;
+    return nullptr;
+}
 
-    if (pos != m_cie_map.end())
-    {
-        // Parse and cache the CIE
-        if (pos->second.get() == nullptr)
-            pos->second = ParseCIE (cie_offset);
+bool
+DWARFCallFrameInfo::GetCIE (dw_offset_t cie_offset, CIE &cie)
+{
+    Mutex::Locker locker(m_cies_mutex);
 
-        return pos->second.get();
+    const CIE *found_cie = FindCIE (m_cies, cie_offset);
+    if (found_cie == nullptr)
+    {
+        // The section hasn't been scanned, or there is no CIE here
+        CIE new_cie (cie_offset);
+        if (!ParseCIE (cie_offset, new_cie))
+            return false;
+        cie_collection::iterator pos = std::lower_bound (m_cies.begin(), m_cies.end(), cie_offset,
+                                                         [](const CIE &cie, dw_offset_t offset) { return cie.cie_offset < offset; });
+        found_cie = &*m_cies.insert (pos, new_cie);
     }
-    return nullptr;
+    cie = *found_cie;
+    return true;
 }
 
-DWARFCallFrameInfo::CIESP
-DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
+bool
+DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset, CIE &cie)
 {
-    CIESP cie_sp(new CIE(cie_offset));
     lldb::offset_t offset = cie_offset;
     if (m_cfi_data_initialized == false)
         GetCFIData();
@@ -163,49 +183,49 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
         //    cie.offset = cie_offset;
         //    cie.length = length;
         //    cie.cieID = cieID;
-        cie_sp->ptr_encoding = DW_EH_PE_absptr; // default
-        cie_sp->version = m_cfi_data.GetU8(&offset);
+        cie.ptr_encoding = DW_EH_PE_absptr; // default
+        cie.version = m_cfi_data.GetU8(&offset);
 
         for (i=0; i<CFI_AUG_MAX_SIZE; ++i)
         {
-            cie_sp->augmentation[i] = m_cfi_data.GetU8(&offset);
-            if (cie_sp->augmentation[i] == '\0')
+            cie.augmentation[i] = m_cfi_data.GetU8(&offset);
+            if (cie.augmentation[i] == '\0')
             {
                 // Zero out remaining bytes in augmentation string
                 for (size_t j = i+1; j<CFI_AUG_MAX_SIZE; ++j)
-                    cie_sp->augmentation[j] = '\0';
+                    cie.augmentation[j] = '\0';
 
                 break;
             }
         }
 
-        if (i == CFI_AUG_MAX_SIZE && cie_sp->augmentation[CFI_AUG_MAX_SIZE-1] != '\0')
+        if (i == CFI_AUG_MAX_SIZE && cie.augmentation[CFI_AUG_MAX_SIZE-1] != '\0')
         {
             Host::SystemLog (Host::eSystemLogError, "CIE parse error: CIE augmentation string was too large for the fixed sized buffer of %d bytes.\n", CFI_AUG_MAX_SIZE);
-            return cie_sp;
+            return true;
         }
-        cie_sp->code_align = (uint32_t)m_cfi_data.GetULEB128(&offset);
-        cie_sp->data_align = (int32_t)m_cfi_data.GetSLEB128(&offset);
-        cie_sp->return_addr_reg_num = m_cfi_data.GetU8(&offset);
+        cie.code_align = (uint32_t)m_cfi_data.GetULEB128(&offset);
+        cie.data_align = (int32_t)m_cfi_data.GetSLEB128(&offset);
+        cie.return_addr_reg_num = m_cfi_data.GetU8(&offset);
 
-        if (cie_sp->augmentation[0])
+        if (cie.augmentation[0])
         {
             // Get the length of the eh_frame augmentation data
             // which starts with a ULEB128 length in bytes
             const size_t aug_data_len = (size_t)m_cfi_data.GetULEB128(&offset);
             const size_t aug_data_end = offset + aug_data_len;
-            const size_t aug_str_len = strlen(cie_sp->augmentation);
+            const size_t aug_str_len = strlen(cie.augmentation);
             // A 'z' may be present as the first character of the string.
             // If present, the Augmentation Data field shall be present.
             // The contents of the Augmentation Data shall be intepreted
             // according to other characters in the Augmentation String.
-            if (cie_sp->augmentation[0] == 'z')
+            if (cie.augmentation[0] == 'z')
             {
                 // Extract the Augmentation Data
                 size_t aug_str_idx = 0;
                 for (aug_str_idx = 1; aug_str_idx < aug_str_len; aug_str_idx++)
                 {
-                    char aug = cie_sp->augmentation[aug_str_idx];
+                    char aug = cie.augmentation[aug_str_idx];
                     switch (aug)
                     {
                         case 'L':
@@ -218,7 +238,7 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
                             // FDE, which is the address of a language-specific
                             // data area (LSDA). The size of the LSDA pointer is
                             // specified by the pointer encoding used.
-                            cie_sp->lsda_addr_encoding = m_cfi_data.GetU8(&offset);
+                            cie.lsda_addr_encoding = m_cfi_data.GetU8(&offset);
                             break;
 
                         case 'P':
@@ -238,7 +258,7 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
                         {
                             uint8_t arg_ptr_encoding = m_cfi_data.GetU8(&offset);
                             const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
-                            cie_sp->personality_loc = m_cfi_data.GetGNUEHPointer(&offset, arg_ptr_encoding, pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+                            cie.personality_loc = m_cfi_data.GetGNUEHPointer(&offset, arg_ptr_encoding, pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
                         }
                             break;
 
@@ -249,12 +269,12 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
                             // represents the pointer encoding for the address
                             // pointers used in the FDE.
                             // Example: 0x1B == DW_EH_PE_pcrel | DW_EH_PE_sdata4 
-                            cie_sp->ptr_encoding = m_cfi_data.GetU8(&offset);
+                            cie.ptr_encoding = m_cfi_data.GetU8(&offset);
                             break;
                     }
                 }
             }
-            else if (strcmp(cie_sp->augmentation, "eh") == 0)
+            else if (strcmp(cie.augmentation, "eh") == 0)
             {
                 // If the Augmentation string has the value "eh", then
                 // the EH Data field shall be present
@@ -267,8 +287,8 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
 
         if (end_offset > offset)
         {
-            cie_sp->inst_offset = offset;
-            cie_sp->inst_length = end_offset - offset;
+            cie.inst_offset = offset;
+            cie.inst_length = end_offset - offset;
         }
         while (offset < end_offset)
         {
@@ -284,7 +304,7 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
                 // register and offset.
                 uint32_t reg_num = (uint32_t)m_cfi_data.GetULEB128(&offset);
                 int op_offset = (int32_t)m_cfi_data.GetULEB128(&offset);
-                cie_sp->initial_row.GetCFAValue().SetIsRegisterPlusOffset (reg_num, op_offset);
+                cie.initial_row.GetCFAValue().SetIsRegisterPlusOffset (reg_num, op_offset);
                 continue;
             }
             if (primary_opcode == DW_CFA_offset)
@@ -296,10 +316,10 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
                 // to be an offset(N) rule with a value of
                 // (N = factored offset * data_align).
                 uint32_t reg_num = extended_opcode;
-                int op_offset = (int32_t)m_cfi_data.GetULEB128(&offset) * cie_sp->data_align;
+                int op_offset = (int32_t)m_cfi_data.GetULEB128(&offset) * cie.data_align;
                 UnwindPlan::Row::RegisterLocation reg_location;
                 reg_location.SetAtCFAPlusOffset(op_offset);
-                cie_sp->initial_row.SetRegisterInfo (reg_num, reg_location);
+                cie.initial_row.SetRegisterInfo (reg_num, reg_location);
                 continue;
             }
             if (extended_opcode == DW_CFA_nop)
@@ -308,9 +328,10 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
             }
             break;  // Stop if we hit an unrecognized opcode
         }
+        return true;
     }
 
-    return cie_sp;
+    return false;
 }
 
 void
@@ -325,9 +346,152 @@ DWARFCallFrameInfo::GetCFIData()
         m_cfi_data_initialized = true;
     }
 }
+// The size of a pointer in the encoding "ptr_enc", or 0 if it isn't a fixed size
+
+static uint32_t
+GetFixedPointerSize (uint8_t ptr_enc, uint32_t addr_size)
+{
+    if ((ptr_enc & DW_EH_PE_indirect) || (ptr_enc & 0x70) == DW_EH_PE_aligned)
+        return 0;
+    switch (ptr_enc & DW_EH_PE_MASK_ENCODING)
+    {
+        case DW_EH_PE_absptr: return addr_size;
+        case DW_EH_PE_udata2:
+        case DW_EH_PE_sdata2: return 2;
+        case DW_EH_PE_udata4:
+        case DW_EH_PE_sdata4: return 4;
+        case DW_EH_PE_udata8:
+        case DW_EH_PE_sdata8: return 8;
+        default:              return 0;
+    }
+}
+
+bool
+DWARFCallFrameInfo::GetEHFrameHdrTable ()
+{
+    if (m_hdr_table_initialized)
+        return m_hdr_table_valid;
+
+    Mutex::Locker locker(m_fde_index_mutex);
+
+    if (m_hdr_table_initialized) // if two threads hit the locker
+        return m_hdr_table_valid;
+
+    // Only ELF files have a .eh_frame_hdr, and only for their .eh_frame
+    SectionList *section_list = m_objfile.GetSectionList();
+    SectionSP hdr_section_sp;
+    if (m_is_eh_frame && section_list)
+        hdr_section_sp = section_list->FindSectionByName (ConstString (".eh_frame_hdr"));
+
+    if (hdr_section_sp && !hdr_section_sp->IsEncrypted())
+    {
+        EHFrameHdrTable &table = m_hdr_table;
+        m_objfile.ReadSectionData (hdr_section_sp.get(), table.data);
+        table.data_addr = hdr_section_sp->GetFileAddress();
+
+        lldb::offset_t offset = 0;
+        const uint8_t version = table.data.GetU8 (&offset);
+        const uint8_t eh_frame_ptr_enc = table.data.GetU8 (&offset);
+        const uint8_t fde_count_enc = table.data.GetU8 (&offset);
+        table.table_enc = table.data.GetU8 (&offset);
+        const lldb::addr_t eh_frame_addr = table.data.GetGNUEHPointer (&offset, eh_frame_ptr_enc, table.data_addr, LLDB_INVALID_ADDRESS, table.data_addr);
+        const uint64_t fde_count = table.data.GetGNUEHPointer (&offset, fde_count_enc, table.data_addr, LLDB_INVALID_ADDRESS, table.data_addr);
+        table.table_offset = offset;
+        table.entry_size = 2 * GetFixedPointerSize (table.table_enc, table.data.GetAddressByteSize());
+
+        // The entries have to be a fixed size to binary search them, and
+        // the table must be for this section
+        if (version == 1 &&
+            eh_frame_addr == m_section_sp->GetFileAddress() &&
+            table.entry_size > 0 &&
+            fde_count > 0 && fde_count < UINT32_MAX &&
+            table.data.ValidOffsetForDataOfSize (table.table_offset, fde_count * table.entry_size))
+        {
+            table.fde_count = fde_count;
+            m_hdr_table_valid = true;
+
+            Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+            if (log)
+                m_objfile.GetModule()->LogMessage(log, "Using the .eh_frame_hdr table of %u FDEs", table.fde_count);
+        }
+        else
+        {
+            table.data.Clear();
+        }
+    }
+
+    m_hdr_table_initialized = true;
+    return m_hdr_table_valid;
+}
+
+bool
+DWARFCallFrameInfo::FindFDEInEHFrameHdrTable (lldb::addr_t file_addr, FDEEntryMap::Entry &fde_entry)
+{
+    const EHFrameHdrTable &table = m_hdr_table;
+
+    // Find the last entry for a function that starts at or before file_addr
+    uint32_t lo = 0;
+    uint32_t hi = table.fde_count;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        lldb::offset_t offset = table.table_offset + (lldb::offset_t)mid * table.entry_size;
+        const lldb::addr_t start_addr = table.data.GetGNUEHPointer (&offset, table.table_enc, table.data_addr, LLDB_INVALID_ADDRESS, table.data_addr);
+        if (start_addr <= file_addr)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return false;
+
+    lldb::offset_t offset = table.table_offset + (lldb::offset_t)(lo - 1) * table.entry_size + table.entry_size / 2;
+    const lldb::addr_t fde_addr = table.data.GetGNUEHPointer (&offset, table.table_enc, table.data_addr, LLDB_INVALID_ADDRESS, table.data_addr);
+
+    if (m_cfi_data_initialized == false)
+        GetCFIData();
+
+    const lldb::addr_t eh_frame_addr = m_section_sp->GetFileAddress();
+    if (fde_addr < eh_frame_addr || !m_cfi_data.ValidOffsetForDataOfSize (fde_addr - eh_frame_addr, CFI_HEADER_SIZE))
+        return false;
+    const dw_offset_t fde_offset = fde_addr - eh_frame_addr;
+
+    // The table only has the start of the function, its size is in the FDE
+    offset = fde_offset;
+    dw_offset_t cie_id, cie_offset;
+    uint32_t length = m_cfi_data.GetU32 (&offset);
+    if (length == UINT32_MAX)
+    {
+        m_cfi_data.GetU64 (&offset);
+        cie_id = m_cfi_data.GetU64 (&offset);
+        cie_offset = fde_offset + 12 - cie_id;
+    }
+    else
+    {
+        cie_id = m_cfi_data.GetU32 (&offset);
+        cie_offset = fde_offset + 4 - cie_id;
+    }
+
+    CIE cie (cie_offset);
+    if (cie_id == 0 || length == 0 || !GetCIE (cie_offset, cie))
+        return false;
+
+    const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
+    const lldb::addr_t range_base = m_cfi_data.GetGNUEHPointer (&offset, cie.ptr_encoding, pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+    const lldb::addr_t range_len = m_cfi_data.GetGNUEHPointer (&offset, cie.ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+    if (file_addr < range_base || file_addr - range_base >= range_len)
+        return false;
+
+    fde_entry = FDEEntryMap::Entry (range_base, range_len, fde_offset);
+    return true;
+}
+
 // Scan through the eh_frame or debug_frame section looking for FDEs and noting the start/end addresses
 // of the functions and a pointer back to the function's FDE for later expansion.
 // Internalize CIEs as we come across them.
+//
+// Entries only say how long they are, so finding them is a walk from one to the next, but that
+// only reads their headers. The CIEs and FDEs are then decoded in parallel.
 
 void
 DWARFCallFrameInfo::GetFDEIndex ()
@@ -345,6 +509,16 @@ DWARFCallFrameInfo::GetFDEIndex ()
 
     Timer scoped_timer (__PRETTY_FUNCTION__, "%s - %s", __PRETTY_FUNCTION__, m_objfile.GetFileSpec().GetFilename().AsCString(""));
 
+    struct FDELocation
+    {
+        dw_offset_t fde_offset;
+        dw_offset_t cie_offset;
+        dw_offset_t addr_offset;    // offset of the FDE's initial location
+        dw_offset_t cie_id;
+    };
+    std::vector<dw_offset_t> cie_offsets;
+    std::vector<FDELocation> fde_locations;
+
     lldb::offset_t offset = 0;
     if (m_cfi_data_initialized == false)
         GetCFIData();
@@ -392,34 +566,71 @@ DWARFCallFrameInfo::GetFDEIndex ()
 
         if (cie_id == 0 || cie_id == UINT32_MAX || len == 0)
         {
-            m_cie_map[current_entry] = ParseCIE (current_entry);
+            cie_offsets.push_back (current_entry);
             offset = next_entry;
             continue;
         }
 
-        const CIE *cie = GetCIE (cie_offset);
-        if (cie)
+        FDELocation fde_location = { current_entry, cie_offset, (dw_offset_t)offset, cie_id };
+        fde_locations.push_back (fde_location);
+        offset = next_entry;
+    }
+
+    // The walk was in section order so the CIEs are sorted by offset
+    cie_collection cies;
+    cies.reserve (cie_offsets.size());
+    for (size_t i = 0; i < cie_offsets.size(); ++i)
+        cies.push_back (CIE (cie_offsets[i]));
+    TaskMapOverInt (0, cies.size(), [this, &cies](size_t cie_idx)
+    {
+        ParseCIE (cies[cie_idx].cie_offset, cies[cie_idx]);
+    });
+
+    // Decode the FDEs in batches so each task does a worthwhile amount of work
+    const size_t num_fdes = fde_locations.size();
+    const size_t fdes_per_batch = 1024;
+    std::vector<FDEEntryMap::Entry> fdes (num_fdes);
+    std::vector<uint8_t> fde_is_valid (num_fdes, 0);
+    TaskMapOverInt (0, (num_fdes + fdes_per_batch - 1) / fdes_per_batch, [&](size_t batch_idx)
+    {
+        const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
+        const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
+        const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
+        const size_t end_idx = std::min (num_fdes, (batch_idx + 1) * fdes_per_batch);
+        for (size_t fde_idx = batch_idx * fdes_per_batch; fde_idx < end_idx; ++fde_idx)
         {
-            const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
-            const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
-            const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
+            const FDELocation &fde_location = fde_locations[fde_idx];
+            const CIE *cie = FindCIE (cies, fde_location.cie_offset);
+            if (cie == nullptr)
+            {
+                Host::SystemLog (Host::eSystemLogError, 
+                                 "error: unable to find CIE at 0x%8.8x for cie_id = 0x%8.8x for entry at 0x%8.8x.\n", 
+                                 fde_location.cie_offset,
+                                 fde_location.cie_id,
+                                 fde_location.fde_offset);
+                continue;
+            }
 
+            lldb::offset_t offset = fde_location.addr_offset;
             lldb::addr_t addr = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding, pc_rel_addr, text_addr, data_addr);
             lldb::addr_t length = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, text_addr, data_addr);
-            FDEEntryMap::Entry fde (addr, length, current_entry);
-            m_fde_index.Append(fde);
-        }
-        else
-        {
-            Host::SystemLog (Host::eSystemLogError, 
-                             "error: unable to find CIE at 0x%8.8x for cie_id = 0x%8.8x for entry at 0x%8.8x.\n", 
-                             cie_offset,
-                             cie_id,
-                             current_entry);
+            fdes[fde_idx] = FDEEntryMap::Entry (addr, length, fde_location.fde_offset);
+            fde_is_valid[fde_idx] = 1;
         }
-        offset = next_entry;
+    });
+
+    for (size_t fde_idx = 0; fde_idx < num_fdes; ++fde_idx)
+    {
+        if (fde_is_valid[fde_idx])
+            m_fde_index.Append (fdes[fde_idx]);
     }
     m_fde_index.Sort();
+
+    // Every CIE has been parsed now, keep them for making UnwindPlans
+    {
+        Mutex::Locker cies_locker(m_cies_mutex);
+        m_cies.swap (cies);
+    }
     m_fde_index_initialized = true;
 }
 
@@ -467,8 +678,10 @@ DWARFCallFrameInfo::FDEToUnwindPlan (dw_offset_t dwarf_offset, Address startaddr
     }
     unwind_plan.SetSourcedFromCompiler (eLazyBoolYes);
 
-    const CIE *cie = GetCIE (cie_offset);
-    assert (cie != nullptr);
+    CIE fde_cie (cie_offset);
+    if (!GetCIE (cie_offset, fde_cie))
+        return false;
+    const CIE *cie = &fde_cie;
 
     const dw_offset_t end_offset = current_entry + length + (is_64bit ? 12 : 4);
 
@@ -18,12 +18,93 @@
 using namespace lldb;
 using namespace lldb_private;
 
+
+namespace {
+
+// The flags byte that starts every encoded line table entry
+enum
+{
+    eEntryFlagStartOfStatement  = (1u << 0),
+    eEntryFlagStartOfBasicBlock = (1u << 1),
+    eEntryFlagPrologueEnd       = (1u << 2),
+    eEntryFlagEpilogueBegin     = (1u << 3),
+    eEntryFlagTerminalEntry     = (1u << 4),
+    eEntryFlagHasColumn         = (1u << 5),    // The column differs from the previous entry
+    eEntryFlagHasFileIndex      = (1u << 6)     // The file index differs from the previous entry
+};
+
+void
+AppendULEB128 (std::vector<uint8_t> &data, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        data.push_back (byte);
+    } while (value != 0);
+}
+
+void
+AppendSLEB128 (std::vector<uint8_t> &data, int64_t value)
+{
+    bool more = true;
+    while (more)
+    {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0))
+            more = false;
+        else
+            byte |= 0x80;
+        data.push_back (byte);
+    }
+}
+
+uint64_t
+ReadULEB128 (const uint8_t *&p)
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = *p++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+int64_t
+ReadSLEB128 (const uint8_t *&p)
+{
+    int64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = *p++;
+        value |= (int64_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    if (shift < 64 && (byte & 0x40))
+        value |= -((int64_t)1 << shift);
+    return value;
+}
+
+}  // anonymous namespace
+
 //----------------------------------------------------------------------
 // LineTable constructor
 //----------------------------------------------------------------------
 LineTable::LineTable(CompileUnit* comp_unit) :
     m_comp_unit(comp_unit),
-    m_entries()
+    m_sequences(),
+    m_num_entries(0),
+    m_decoder_ap(),
+    m_mutex()
 {
 }
 
@@ -48,19 +129,10 @@ LineTable::InsertLineEntry
     bool is_terminal_entry
 )
 {
-    Entry entry(file_addr, line, column, file_idx, is_start_of_statement, is_start_of_basic_block, is_prologue_end, is_epilogue_begin, is_terminal_entry);
-
-    entry_collection::iterator begin_pos = m_entries.begin();
-    entry_collection::iterator end_pos = m_entries.end();
-    LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
-    entry_collection::iterator pos = upper_bound(begin_pos, end_pos, entry, less_than_bp);
-
-//  Stream s(stdout);
-//  s << "\n\nBefore:\n";
-//  Dump (&s, Address::DumpStyleFileAddress);
-    m_entries.insert(pos, entry);
-//  s << "After:\n";
-//  Dump (&s, Address::DumpStyleFileAddress);
+    // An entry that isn't part of a sequence is a sequence of its own
+    LineSequenceImpl sequence;
+    AppendLineEntryToSequence (&sequence, file_addr, line, column, file_idx, is_start_of_statement, is_start_of_basic_block, is_prologue_end, is_epilogue_begin, is_terminal_entry);
+    InsertSequence (&sequence);
 }
 
 LineSequence::LineSequence()
@@ -98,7 +170,7 @@ LineTable::AppendLineEntryToSequence
     Entry entry(file_addr, line, column, file_idx, is_start_of_statement, is_start_of_basic_block, is_prologue_end, is_epilogue_begin, is_terminal_entry);
     entry_collection &entries = seq->m_entries;
     // Replace the last entry if the address is the same, otherwise append it. If we have multiple
-    // line entries at the same address, this indicates illegal DWARF so this "fixes" the line table
+    // line entries at the same address, this indicates illegal DWARF so this "fixes" the line table
     // to be correct. If not fixed this can cause a line entry's address that when resolved back to
     // a symbol context, could resolve to a different line entry. We really want a 1 to 1 mapping
     // here to avoid these kinds of inconsistencies. We will need tor revisit this if the DWARF line
@@ -114,35 +186,232 @@ LineTable::InsertSequence (LineSequence* sequence)
 {
     assert(sequence != nullptr);
     LineSequenceImpl* seq = reinterpret_cast<LineSequenceImpl*>(sequence);
-    if (seq->m_entries.empty())
+    const entry_collection &entries = seq->m_entries;
+    if (entries.empty())
         return;
-    Entry& entry = seq->m_entries.front();
-    
-    // If the first entry address in this sequence is greater than or equal to
-    // the address of the last item in our entry collection, just append.
-    if (m_entries.empty() || !Entry::EntryAddressLessThan(entry, m_entries.back()))
+
+    Sequence new_sequence;
+    new_sequence.file_addr = entries.front().file_addr;
+    // A sequence that doesn't end with a terminal entry runs into the
+    // next one
+    if (entries.back().is_terminal_entry)
+        new_sequence.end_file_addr = entries.back().file_addr;
+    new_sequence.num_entries = entries.size();
+    for (const Entry &entry : entries)
+        new_sequence.file_mask |= GetFileMask (entry.file_idx);
+    EncodeEntries (entries, new_sequence);
+    InsertSequence (new_sequence);
+}
+
+void
+LineTable::InsertLazySequence (lldb::addr_t file_addr,
+                               lldb::addr_t end_file_addr,
+                               uint32_t num_entries,
+                               uint64_t file_mask,
+                               lldb::offset_t decode_offset)
+{
+    if (num_entries == 0)
+        return;
+
+    Sequence new_sequence;
+    new_sequence.file_addr = file_addr;
+    new_sequence.end_file_addr = end_file_addr;
+    new_sequence.num_entries = num_entries;
+    new_sequence.file_mask = file_mask;
+    new_sequence.decode_offset = decode_offset;
+    InsertSequence (new_sequence);
+}
+
+void
+LineTable::InsertSequence (Sequence &sequence)
+{
+    // Sequences are usually inserted in address order, in which case
+    // this appends and only the new sequence gets numbered
+    sequence_collection::iterator pos = std::upper_bound (m_sequences.begin(),
+                                                          m_sequences.end(),
+                                                          sequence.file_addr,
+                                                          Sequence::StartAddressLessThan);
+    uint32_t entry_idx = 0;
+    if (pos != m_sequences.begin())
+    {
+        sequence_collection::const_iterator prev_pos = pos - 1;
+        entry_idx = prev_pos->entry_idx + prev_pos->num_entries;
+    }
+    for (pos = m_sequences.insert (pos, std::move (sequence)); pos != m_sequences.end(); ++pos)
+    {
+        pos->entry_idx = entry_idx;
+        entry_idx += pos->num_entries;
+    }
+    m_num_entries = entry_idx;
+}
+
+void
+LineTable::SetSequenceDecoder (LineSequenceDecoder *decoder)
+{
+    m_decoder_ap.reset (decoder);
+}
+
+void
+LineTable::EncodeEntries (const entry_collection &entries, Sequence &sequence)
+{
+    std::vector<uint8_t> &data = sequence.data;
+    data.clear();
+    sequence.blocks.clear();
+    sequence.blocks.reserve ((entries.size() + kEntriesPerBlock - 1) / kEntriesPerBlock);
+
+    Entry prev_entry;
+    for (size_t idx = 0; idx < entries.size(); ++idx)
     {
-        m_entries.insert(m_entries.end(),
-                         seq->m_entries.begin(),
-                         seq->m_entries.end());
+        const Entry &entry = entries[idx];
+        if (idx % kEntriesPerBlock == 0)
+        {
+            Block block = { entry.file_addr, (uint32_t)data.size() };
+            sequence.blocks.push_back (block);
+            prev_entry.Clear();
+            prev_entry.file_addr = entry.file_addr;
+        }
+
+        uint8_t flags = 0;
+        if (entry.is_start_of_statement)
+            flags |= eEntryFlagStartOfStatement;
+        if (entry.is_start_of_basic_block)
+            flags |= eEntryFlagStartOfBasicBlock;
+        if (entry.is_prologue_end)
+            flags |= eEntryFlagPrologueEnd;
+        if (entry.is_epilogue_begin)
+            flags |= eEntryFlagEpilogueBegin;
+        if (entry.is_terminal_entry)
+            flags |= eEntryFlagTerminalEntry;
+        if (entry.column != prev_entry.column)
+            flags |= eEntryFlagHasColumn;
+        if (entry.file_idx != prev_entry.file_idx)
+            flags |= eEntryFlagHasFileIndex;
+
+        data.push_back (flags);
+        // Addresses only go up in a valid sequence, but let them wrap
+        // around so an invalid one is still kept as is
+        AppendULEB128 (data, entry.file_addr - prev_entry.file_addr);
+        AppendSLEB128 (data, (int64_t)entry.line - (int64_t)prev_entry.line);
+        if (flags & eEntryFlagHasColumn)
+            AppendULEB128 (data, entry.column);
+        if (flags & eEntryFlagHasFileIndex)
+            AppendULEB128 (data, entry.file_idx);
+        prev_entry = entry;
+    }
+    std::vector<uint8_t>(data).swap (data);
+    sequence.is_decoded = true;
+}
+
+void
+LineTable::DecodeEntries (const Sequence &sequence, uint32_t first, uint32_t count, entry_collection &entries)
+{
+    if (first >= sequence.num_entries || !sequence.is_decoded)
         return;
+    const uint32_t end = first + std::min<uint32_t> (count, sequence.num_entries - first);
+
+    // Start at the block with the first entry and skip the entries
+    // before it
+    uint32_t idx = first - first % kEntriesPerBlock;
+    const uint8_t *p = sequence.data.data() + sequence.blocks[idx / kEntriesPerBlock].data_offset;
+    Entry entry;
+    for (; idx < end; ++idx)
+    {
+        if (idx % kEntriesPerBlock == 0)
+        {
+            entry.Clear();
+            entry.file_addr = sequence.blocks[idx / kEntriesPerBlock].file_addr;
+        }
+
+        const uint8_t flags = *p++;
+        entry.file_addr += ReadULEB128 (p);
+        entry.line += ReadSLEB128 (p);
+        if (flags & eEntryFlagHasColumn)
+            entry.column = ReadULEB128 (p);
+        if (flags & eEntryFlagHasFileIndex)
+            entry.file_idx = ReadULEB128 (p);
+        entry.is_start_of_statement = (flags & eEntryFlagStartOfStatement) != 0;
+        entry.is_start_of_basic_block = (flags & eEntryFlagStartOfBasicBlock) != 0;
+        entry.is_prologue_end = (flags & eEntryFlagPrologueEnd) != 0;
+        entry.is_epilogue_begin = (flags & eEntryFlagEpilogueBegin) != 0;
+        entry.is_terminal_entry = (flags & eEntryFlagTerminalEntry) != 0;
+        if (idx >= first)
+            entries.push_back (entry);
+    }
+}
+
+const LineTable::Sequence *
+LineTable::GetDecodedSequence (uint32_t sequence_idx)
+{
+    if (sequence_idx >= m_sequences.size())
+        return nullptr;
+
+    Sequence &sequence = m_sequences[sequence_idx];
+    Mutex::Locker locker (m_mutex);
+    if (!sequence.is_decoded)
+    {
+        if (!m_decoder_ap)
+            return nullptr;
+        LineSequenceImpl decoded_sequence;
+        if (!m_decoder_ap->DecodeSequence (*this, sequence.decode_offset, &decoded_sequence))
+            return nullptr;
+        // The entries are numbered from the count given when the
+        // sequence was inserted, so it has to match
+        if (decoded_sequence.m_entries.size() != sequence.num_entries)
+            return nullptr;
+        EncodeEntries (decoded_sequence.m_entries, sequence);
     }
+    return &sequence;
+}
 
-    // Otherwise, find where this belongs in the collection
-    entry_collection::iterator begin_pos = m_entries.begin();
-    entry_collection::iterator end_pos = m_entries.end();
-    LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
-    entry_collection::iterator pos = upper_bound(begin_pos, end_pos, entry, less_than_bp);
-#ifdef LLDB_CONFIGURATION_DEBUG
-    // If we aren't inserting at the beginning, the previous entry should
-    // terminate a sequence.
-    if (pos != begin_pos)
+uint32_t
+LineTable::FindSequenceIndexForEntry (uint32_t idx) const
+{
+    sequence_collection::const_iterator pos = std::upper_bound (m_sequences.begin(),
+                                                                m_sequences.end(),
+                                                                idx,
+                                                                Sequence::EntryIndexLessThan);
+    if (pos == m_sequences.begin())
+        return UINT32_MAX;
+    return std::distance (m_sequences.begin(), pos) - 1;
+}
+
+lldb::addr_t
+LineTable::GetNextEntryFileAddress (uint32_t sequence_idx, const entry_collection &entries, size_t idx) const
+{
+    if (idx + 1 < entries.size())
+        return entries[idx + 1].file_addr;
+    if (sequence_idx + 1 < m_sequences.size())
+        return m_sequences[sequence_idx + 1].file_addr;
+    return LLDB_INVALID_ADDRESS;
+}
+
+uint32_t
+LineTable::GetNumSequences () const
+{
+    return m_sequences.size();
+}
+
+uint32_t
+LineTable::GetNumDecodedSequences () const
+{
+    Mutex::Locker locker (m_mutex);
+    uint32_t num_decoded = 0;
+    for (const Sequence &sequence : m_sequences)
     {
-        entry_collection::iterator prev_pos = pos - 1;
-        assert(prev_pos->is_terminal_entry);
+        if (sequence.is_decoded)
+            ++num_decoded;
     }
-#endif
-    m_entries.insert(pos, seq->m_entries.begin(), seq->m_entries.end());
+    return num_decoded;
+}
+
+size_t
+LineTable::GetMemorySize () const
+{
+    Mutex::Locker locker (m_mutex);
+    size_t size = m_sequences.capacity() * sizeof(Sequence);
+    for (const Sequence &sequence : m_sequences)
+        size += sequence.data.capacity() + sequence.blocks.capacity() * sizeof(Block);
+    return size;
 }
 
 //----------------------------------------------------------------------
@@ -175,17 +444,14 @@ LineTable::Entry::LessThanBinaryPredicate::operator() (const LineTable::Entry& a
 uint32_t
 LineTable::GetSize() const
 {
-    return m_entries.size();
+    return m_num_entries;
 }
 
 bool
 LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry& line_entry)
 {
-    if (idx < m_entries.size())
-    {
-        ConvertEntryAtIndexToLineEntry (idx, line_entry);
+    if (idx < m_num_entries && ConvertEntryAtIndexToLineEntry (idx, line_entry))
         return true;
-    }
     line_entry.Clear();
     return false;
 }
@@ -196,101 +462,109 @@ LineTable::FindLineEntryByAddress (const Address &so_addr, LineEntry& line_entry
     if (index_ptr != nullptr )
         *index_ptr = UINT32_MAX;
 
-    bool success = false;
-
-    if (so_addr.GetModule().get() == m_comp_unit->GetModule().get())
+    if (so_addr.GetModule().get() != m_comp_unit->GetModule().get())
+        return false;
+
+    const lldb::addr_t file_addr = so_addr.GetFileAddress();
+    if (file_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    // Find the last sequence that starts at or before the address. When
+    // several sequences start at the same address, use the last one that
+    // contains it so only that one gets decoded.
+    const sequence_collection &sequences = m_sequences;
+    sequence_collection::const_iterator begin_pos = sequences.begin();
+    sequence_collection::const_iterator pos = std::upper_bound (begin_pos,
+                                                                sequences.end(),
+                                                                file_addr,
+                                                                Sequence::StartAddressLessThan);
+    if (pos == begin_pos)
+        return false;
+    --pos;
+    const lldb::addr_t sequence_file_addr = pos->file_addr;
+    while (file_addr >= pos->end_file_addr)
     {
-        Entry search_entry;
-        search_entry.file_addr = so_addr.GetFileAddress();
-        if (search_entry.file_addr != LLDB_INVALID_ADDRESS)
-        {
-            entry_collection::const_iterator begin_pos = m_entries.begin();
-            entry_collection::const_iterator end_pos = m_entries.end();
-            entry_collection::const_iterator pos = lower_bound(begin_pos, end_pos, search_entry, Entry::EntryAddressLessThan);
-            if (pos != end_pos)
-            {
-                if (pos != begin_pos)
-                {
-                    if (pos->file_addr != search_entry.file_addr)
-                        --pos;
-                    else if (pos->file_addr == search_entry.file_addr)
-                    {
-                        // If this is a termination entry, it should't match since
-                        // entries with the "is_terminal_entry" member set to true 
-                        // are termination entries that define the range for the 
-                        // previous entry.
-                        if (pos->is_terminal_entry)
-                        {
-                            // The matching entry is a terminal entry, so we skip
-                            // ahead to the next entry to see if there is another
-                            // entry following this one whose section/offset matches.
-                            ++pos;
-                            if (pos != end_pos)
-                            {
-                                if (pos->file_addr != search_entry.file_addr)
-                                    pos = end_pos;
-                            }
-                        }
-                        
-                        if (pos != end_pos)
-                        {
-                            // While in the same section/offset backup to find the first
-                            // line entry that matches the address in case there are 
-                            // multiple
-                            while (pos != begin_pos)
-                            {
-                                entry_collection::const_iterator prev_pos = pos - 1;
-                                if (prev_pos->file_addr == search_entry.file_addr &&
-                                    prev_pos->is_terminal_entry == false)
-                                    --pos;
-                                else
-                                    break;
-                            }
-                        }
-                    }
+        // Terminal entries don't match, they only end the range of the
+        // entry before them
+        if (pos == begin_pos || (pos - 1)->file_addr != sequence_file_addr)
+            return false;
+        --pos;
+    }
 
-                }
-                
-                // Make sure we have a valid match and that the match isn't a terminating
-                // entry for a previous line...
-                if (pos != end_pos && pos->is_terminal_entry == false)
-                {
-                    uint32_t match_idx = std::distance (begin_pos, pos);
-                    success = ConvertEntryAtIndexToLineEntry(match_idx, line_entry);
-                    if (index_ptr != nullptr && success)
-                        *index_ptr = match_idx;
-                }
-            }
-        }
+    const uint32_t sequence_idx = std::distance (begin_pos, pos);
+    const Sequence *sequence = GetDecodedSequence (sequence_idx);
+    if (sequence == nullptr)
+        return false;
+
+    // Only decode the block of entries with the address
+    std::vector<Block>::const_iterator block_pos = std::upper_bound (sequence->blocks.begin(),
+                                                                     sequence->blocks.end(),
+                                                                     file_addr,
+                                                                     [](lldb::addr_t file_addr, const Block &block) { return file_addr < block.file_addr; });
+    if (block_pos != sequence->blocks.begin())
+        --block_pos;
+    const uint32_t first = std::distance (sequence->blocks.begin(), block_pos) * kEntriesPerBlock;
+    entry_collection entries;
+    DecodeEntries (*sequence, first, kEntriesPerBlock + 1, entries);
+
+    // Find the last entry at or before the address, or the first one of
+    // several at that address
+    size_t match_idx = UINT32_MAX;
+    for (size_t idx = 0; idx < entries.size() && entries[idx].file_addr <= file_addr; ++idx)
+    {
+        if (match_idx == UINT32_MAX || entries[idx].file_addr != entries[match_idx].file_addr)
+            match_idx = idx;
     }
-    return success;
+
+    // Make sure we have a valid match and that the match isn't a terminating
+    // entry for a previous line...
+    if (match_idx == UINT32_MAX || entries[match_idx].is_terminal_entry)
+        return false;
+
+    if (!ConvertEntryToLineEntry (entries[match_idx], GetNextEntryFileAddress (sequence_idx, entries, match_idx), line_entry))
+        return false;
+    if (index_ptr != nullptr)
+        *index_ptr = sequence->entry_idx + first + match_idx;
+    return true;
 }
 
 
 bool
 LineTable::ConvertEntryAtIndexToLineEntry (uint32_t idx, LineEntry &line_entry)
 {
-    if (idx < m_entries.size())
+    const uint32_t sequence_idx = FindSequenceIndexForEntry (idx);
+    const Sequence *sequence = GetDecodedSequence (sequence_idx);
+    if (sequence == nullptr)
+        return false;
+
+    // Decode the entry after it as well for the size of its range
+    entry_collection entries;
+    DecodeEntries (*sequence, idx - sequence->entry_idx, 2, entries);
+    if (entries.empty())
+        return false;
+    return ConvertEntryToLineEntry (entries.front(), GetNextEntryFileAddress (sequence_idx, entries, 0), line_entry);
+}
+
+bool
+LineTable::ConvertEntryToLineEntry (const Entry &entry, lldb::addr_t next_file_addr, LineEntry &line_entry)
+{
+    ModuleSP module_sp (m_comp_unit->GetModule());
+    if (module_sp && module_sp->ResolveFileAddress(entry.file_addr, line_entry.range.GetBaseAddress()))
     {
-        const Entry& entry = m_entries[idx];
-        ModuleSP module_sp (m_comp_unit->GetModule());
-        if (module_sp && module_sp->ResolveFileAddress(entry.file_addr, line_entry.range.GetBaseAddress()))
-        {
-            if (!entry.is_terminal_entry && idx + 1 < m_entries.size())
-                line_entry.range.SetByteSize(m_entries[idx+1].file_addr - entry.file_addr);
-            else
-                line_entry.range.SetByteSize(0);
-
-            line_entry.file = m_comp_unit->GetSupportFiles().GetFileSpecAtIndex (entry.file_idx);
-            line_entry.line = entry.line;
-            line_entry.column = entry.column;
-            line_entry.is_start_of_statement = entry.is_start_of_statement;
-            line_entry.is_start_of_basic_block = entry.is_start_of_basic_block;
-            line_entry.is_prologue_end = entry.is_prologue_end;
-            line_entry.is_epilogue_begin = entry.is_epilogue_begin;
-            line_entry.is_terminal_entry = entry.is_terminal_entry;
-            return true;
-        }
+        if (!entry.is_terminal_entry && next_file_addr != LLDB_INVALID_ADDRESS)
+            line_entry.range.SetByteSize(next_file_addr - entry.file_addr);
+        else
+            line_entry.range.SetByteSize(0);
+
+        line_entry.file = m_comp_unit->GetSupportFiles().GetFileSpecAtIndex (entry.file_idx);
+        line_entry.line = entry.line;
+        line_entry.column = entry.column;
+        line_entry.is_start_of_statement = entry.is_start_of_statement;
+        line_entry.is_start_of_basic_block = entry.is_start_of_basic_block;
+        line_entry.is_prologue_end = entry.is_prologue_end;
+        line_entry.is_epilogue_begin = entry.is_epilogue_begin;
+        line_entry.is_terminal_entry = entry.is_terminal_entry;
+        return true;
     }
     return false;
 }
@@ -305,42 +579,66 @@ LineTable::FindLineEntryIndexByFileIndex
     LineEntry* line_entry_ptr
 )
 {
+    if (start_idx >= m_num_entries)
+        return UINT32_MAX;
 
-    const size_t count = m_entries.size();
     std::vector<uint32_t>::const_iterator begin_pos = file_indexes.begin();
     std::vector<uint32_t>::const_iterator end_pos = file_indexes.end();
-    size_t best_match = UINT32_MAX;
-
-    for (size_t idx = start_idx; idx < count; ++idx)
+    uint64_t file_mask = 0;
+    for (std::vector<uint32_t>::const_iterator pos = begin_pos; pos != end_pos; ++pos)
+        file_mask |= GetFileMask (*pos);
+
+    uint32_t best_match = UINT32_MAX;
+    uint32_t best_line = UINT32_MAX;
+    entry_collection entries;
+    for (uint32_t sequence_idx = FindSequenceIndexForEntry (start_idx); sequence_idx < m_sequences.size(); ++sequence_idx)
     {
-        // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-        if (m_entries[idx].is_terminal_entry)
+        // Don't decode sequences that can't have any of the files
+        if ((m_sequences[sequence_idx].file_mask & file_mask) == 0)
             continue;
 
-        if (find (begin_pos, end_pos, m_entries[idx].file_idx) == end_pos)
+        const Sequence *sequence = GetDecodedSequence (sequence_idx);
+        if (sequence == nullptr)
             continue;
 
-        // Exact match always wins.  Otherwise try to find the closest line > the desired
-        // line.
-        // FIXME: Maybe want to find the line closest before and the line closest after and
-        // if they're not in the same function, don't return a match.
-
-        if (m_entries[idx].line < line)
-        {
-            continue;
-        }
-        else if (m_entries[idx].line == line)
-        {
-            if (line_entry_ptr)
-                ConvertEntryAtIndexToLineEntry (idx, *line_entry_ptr);
-            return idx;
-        }
-        else if (!exact)
+        const uint32_t first = start_idx > sequence->entry_idx ? start_idx - sequence->entry_idx : 0;
+        entries.clear();
+        DecodeEntries (*sequence, first, sequence->num_entries, entries);
+        for (size_t i = 0; i < entries.size(); ++i)
         {
-            if (best_match == UINT32_MAX)
-                best_match = idx;
-            else if (m_entries[idx].line < m_entries[best_match].line)
-                best_match = idx;
+            const Entry &entry = entries[i];
+
+            // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
+            if (entry.is_terminal_entry)
+                continue;
+
+            if (find (begin_pos, end_pos, entry.file_idx) == end_pos)
+                continue;
+
+            // Exact match always wins.  Otherwise try to find the closest line > the desired
+            // line.
+            // FIXME: Maybe want to find the line closest before and the line closest after and
+            // if they're not in the same function, don't return a match.
+
+            const uint32_t idx = sequence->entry_idx + first + i;
+            if (entry.line < line)
+            {
+                continue;
+            }
+            else if (entry.line == line)
+            {
+                if (line_entry_ptr)
+                    ConvertEntryToLineEntry (entry, GetNextEntryFileAddress (sequence_idx, entries, i), *line_entry_ptr);
+                return idx;
+            }
+            else if (!exact)
+            {
+                if (best_match == UINT32_MAX || entry.line < best_line)
+                {
+                    best_match = idx;
+                    best_line = entry.line;
+                }
+            }
         }
     }
 
@@ -356,49 +654,8 @@ LineTable::FindLineEntryIndexByFileIndex
 uint32_t
 LineTable::FindLineEntryIndexByFileIndex (uint32_t start_idx, uint32_t file_idx, uint32_t line, bool exact, LineEntry* line_entry_ptr)
 {
-    const size_t count = m_entries.size();
-    size_t best_match = UINT32_MAX;
-
-    for (size_t idx = start_idx; idx < count; ++idx)
-    {
-        // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-        if (m_entries[idx].is_terminal_entry)
-            continue;
-
-        if (m_entries[idx].file_idx != file_idx)
-            continue;
-
-        // Exact match always wins.  Otherwise try to find the closest line > the desired
-        // line.
-        // FIXME: Maybe want to find the line closest before and the line closest after and
-        // if they're not in the same function, don't return a match.
-
-        if (m_entries[idx].line < line)
-        {
-            continue;
-        }
-        else if (m_entries[idx].line == line)
-        {
-            if (line_entry_ptr)
-                ConvertEntryAtIndexToLineEntry (idx, *line_entry_ptr);
-            return idx;
-        }
-        else if (!exact)
-        {
-            if (best_match == UINT32_MAX)
-                best_match = idx;
-            else if (m_entries[idx].line < m_entries[best_match].line)
-                best_match = idx;
-        }
-    }
-
-    if (best_match != UINT32_MAX)
-    {
-        if (line_entry_ptr)
-            ConvertEntryAtIndexToLineEntry (best_match, *line_entry_ptr);
-        return best_match;
-    }
-    return UINT32_MAX;
+    const std::vector<uint32_t> file_indexes (1, file_idx);
+    return FindLineEntryIndexByFileIndex (start_idx, file_indexes, line, exact, line_entry_ptr);
 }
 
 size_t
@@ -411,23 +668,36 @@ LineTable::FineLineEntriesForFileIndex (uint32_t file_idx,
         sc_list.Clear();
 
     size_t num_added = 0;
-    const size_t count = m_entries.size();
-    if (count > 0)
+    if (m_num_entries > 0)
     {
         SymbolContext sc (m_comp_unit);
+        entry_collection entries;
 
-        for (size_t idx = 0; idx < count; ++idx)
+        for (uint32_t sequence_idx = 0; sequence_idx < m_sequences.size(); ++sequence_idx)
         {
-            // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
-            if (m_entries[idx].is_terminal_entry)
+            // Don't decode sequences that can't have the file
+            if ((m_sequences[sequence_idx].file_mask & GetFileMask (file_idx)) == 0)
+                continue;
+
+            const Sequence *sequence = GetDecodedSequence (sequence_idx);
+            if (sequence == nullptr)
                 continue;
-            
-            if (m_entries[idx].file_idx == file_idx)
+
+            entries.clear();
+            DecodeEntries (*sequence, 0, sequence->num_entries, entries);
+            for (size_t idx = 0; idx < entries.size(); ++idx)
             {
-                if (ConvertEntryAtIndexToLineEntry (idx, sc.line_entry))
+                // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
+                if (entries[idx].is_terminal_entry)
+                    continue;
+
+                if (entries[idx].file_idx == file_idx)
                 {
-                    ++num_added;
-                    sc_list.Append(sc);
+                    if (ConvertEntryToLineEntry (entries[idx], GetNextEntryFileAddress (sequence_idx, entries, idx), sc.line_entry))
+                    {
+                        ++num_added;
+                        sc_list.Append(sc);
+                    }
                 }
             }
         }
@@ -439,7 +709,7 @@ LineTable::FineLineEntriesForFileIndex (uint32_t file_idx,
 void
 LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::DumpStyle fallback_style, bool show_line_ranges)
 {
-    const size_t count = m_entries.size();
+    const size_t count = m_num_entries;
     LineEntry line_entry;
     FileSpec prev_file;
     for (size_t idx = 0; idx < count; ++idx)
@@ -455,7 +725,7 @@ LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::D
 void
 LineTable::GetDescription (Stream *s, Target *target, DescriptionLevel level)
 {
-    const size_t count = m_entries.size();
+    const size_t count = m_num_entries;
     LineEntry line_entry;
     for (size_t idx = 0; idx < count; ++idx)
     {
@@ -471,26 +741,22 @@ LineTable::GetContiguousFileAddressRanges (FileAddressRanges &file_ranges, bool
     if (!append)
         file_ranges.Clear();
     const size_t initial_count = file_ranges.GetSize();
-    
-    const size_t count = m_entries.size();
-    LineEntry line_entry;
+
+    // The ranges only depend on where the sequences start and end, so
+    // none of them need to be decoded
     FileAddressRanges::Entry range (LLDB_INVALID_ADDRESS, 0);
-    for (size_t idx = 0; idx < count; ++idx)
+    for (const Sequence &sequence : m_sequences)
     {
-        const Entry& entry = m_entries[idx];
+        const bool is_terminated = sequence.end_file_addr != LLDB_INVALID_ADDRESS;
+        // A sequence with only a terminal entry doesn't start a range
+        if (range.GetRangeBase() == LLDB_INVALID_ADDRESS && !(is_terminated && sequence.num_entries == 1))
+            range.SetRangeBase(sequence.file_addr);
 
-        if (entry.is_terminal_entry)
+        if (is_terminated && range.GetRangeBase() != LLDB_INVALID_ADDRESS)
         {
-            if (range.GetRangeBase() != LLDB_INVALID_ADDRESS)
-            {
-                range.SetRangeEnd(entry.file_addr);
-                file_ranges.Append(range);
-                range.Clear(LLDB_INVALID_ADDRESS);
-            }
-        }
-        else if (range.GetRangeBase() == LLDB_INVALID_ADDRESS)
-        {
-            range.SetRangeBase(entry.file_addr);
+            range.SetRangeEnd(sequence.end_file_addr);
+            file_ranges.Append(range);
+            range.Clear(LLDB_INVALID_ADDRESS);
         }
     }
     return file_ranges.GetSize() - initial_count;
@@ -501,16 +767,22 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
 {
     std::unique_ptr<LineTable> line_table_ap (new LineTable (m_comp_unit));
     LineSequenceImpl sequence;
-    const size_t count = m_entries.size();
-    LineEntry line_entry;
+    entry_collection entries;
     const FileRangeMap::Entry *file_range_entry = nullptr;
     const FileRangeMap::Entry *prev_file_range_entry = nullptr;
     lldb::addr_t prev_file_addr = LLDB_INVALID_ADDRESS;
     bool prev_entry_was_linked = false;
     bool range_changed = false;
+    for (uint32_t sequence_idx = 0; sequence_idx < m_sequences.size(); ++sequence_idx)
+    {
+        const Sequence *decoded_sequence = GetDecodedSequence (sequence_idx);
+        if (decoded_sequence != nullptr)
+            DecodeEntries (*decoded_sequence, 0, decoded_sequence->num_entries, entries);
+    }
+    const size_t count = entries.size();
     for (size_t idx = 0; idx < count; ++idx)
     {
-        const Entry& entry = m_entries[idx];
+        const Entry& entry = entries[idx];
         
         const bool end_sequence = entry.is_terminal_entry;
         const lldb::addr_t lookup_file_addr = entry.file_addr - (end_sequence ? 1 : 0);
@@ -586,7 +858,7 @@ LineTable::LinkLineTable (const FileRangeMap &file_range_map)
         prev_file_addr = entry.file_addr;
         range_changed = false;
     }
-    if (line_table_ap->m_entries.empty())
+    if (line_table_ap->m_sequences.empty())
         return nullptr;
     return line_table_ap.release();
 }
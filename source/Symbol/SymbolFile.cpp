@@ -15,6 +15,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolContext.h"
 
 using namespace lldb_private;
 
@@ -74,6 +75,23 @@ SymbolFile::FindPlugin (ObjectFile* obj_file)
     return best_symfile_ap.release();
 }
 
+size_t
+SymbolFile::ResolveSymbolContexts (const std::vector<Address>& so_addrs,
+                                   uint32_t resolve_scope,
+                                   std::vector<SymbolContext>& sc_list,
+                                   std::vector<uint32_t>& resolved_list)
+{
+    resolved_list.assign (so_addrs.size(), 0);
+    size_t num_resolved = 0;
+    for (size_t i = 0; i < so_addrs.size(); ++i)
+    {
+        resolved_list[i] = ResolveSymbolContext (so_addrs[i], resolve_scope, sc_list[i]);
+        if (resolved_list[i])
+            ++num_resolved;
+    }
+    return num_resolved;
+}
+
 TypeList *
 SymbolFile::GetTypeList ()
 {
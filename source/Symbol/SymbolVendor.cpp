@@ -292,6 +292,20 @@ SymbolVendor::ResolveSymbolContext (const FileSpec& file_spec, uint32_t line, bo
     return 0;
 }
 
+size_t
+SymbolVendor::ResolveSymbolContexts (const std::vector<Address>& so_addrs, uint32_t resolve_scope, std::vector<SymbolContext>& sc_list, std::vector<uint32_t>& resolved_list)
+{
+    ModuleSP module_sp(GetModule());
+    if (module_sp)
+    {
+        lldb_private::Mutex::Locker locker(module_sp->GetMutex());
+        if (m_sym_file_ap.get())
+            return m_sym_file_ap->ResolveSymbolContexts(so_addrs, resolve_scope, sc_list, resolved_list);
+    }
+    resolved_list.assign (so_addrs.size(), 0);
+    return 0;
+}
+
 size_t
 SymbolVendor::FindGlobalVariables (const ConstString &name, const ClangNamespaceDecl *namespace_decl, bool append, size_t max_matches, VariableList& variables)
 {
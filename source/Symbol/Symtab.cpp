@@ -19,6 +19,7 @@
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
+#include "lldb/Utility/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -289,129 +290,161 @@ Symtab::InitNameIndexes()
         m_name_to_index.Reserve (actual_count);
 #endif
 
-        NameToIndexMap::Entry entry;
-
-        // The "const char *" in "class_contexts" must come from a ConstString::GetCString()
-        std::set<const char *> class_contexts;
-        UniqueCStringMap<uint32_t> mangled_name_to_index;
+        // The symbols are split into chunks that are indexed in parallel,
+        // each into its own set of maps so the workers don't contend on
+        // the final ones. Demangling the names is what takes most of the
+        // time here.
+        struct NameIndexes
+        {
+            UniqueCStringMap<uint32_t> name_to_index;
+            UniqueCStringMap<uint32_t> basename_to_index;
+            UniqueCStringMap<uint32_t> method_to_index;
+            UniqueCStringMap<uint32_t> selector_to_index;
+            // Functions with a context that we don't know to be a class
+            // yet, they get sorted out once all chunks are done
+            UniqueCStringMap<uint32_t> mangled_name_to_index;
+            // The "const char *" in "class_contexts" must come from a ConstString::GetCString()
+            std::set<const char *> class_contexts;
+        };
+
+        const size_t symbols_per_chunk = 8192;
+        const size_t num_chunks = (num_symbols + symbols_per_chunk - 1) / symbols_per_chunk;
+        std::vector<NameIndexes> chunk_indexes (num_chunks);
         std::vector<const char *> symbol_contexts(num_symbols, nullptr);
 
-        for (entry.value = 0; entry.value<num_symbols; ++entry.value)
+        TaskMapOverInt(0, num_chunks, [this, num_symbols, symbols_per_chunk, &chunk_indexes, &symbol_contexts](size_t chunk_idx)
         {
-            const Symbol *symbol = &m_symbols[entry.value];
-
-            // Don't let trampolines get into the lookup by name map
-            // If we ever need the trampoline symbols to be searchable by name
-            // we can remove this and then possibly add a new bool to any of the
-            // Symtab functions that lookup symbols by name to indicate if they
-            // want trampolines.
-            if (symbol->IsTrampoline())
-                continue;
-
-            const Mangled &mangled = symbol->GetMangled();
-            entry.cstring = mangled.GetMangledName().GetCString();
-            if (entry.cstring && entry.cstring[0])
+            NameIndexes &indexes = chunk_indexes[chunk_idx];
+            NameToIndexMap::Entry entry;
+            const uint32_t end_idx = std::min<size_t> ((chunk_idx + 1) * symbols_per_chunk, num_symbols);
+            for (entry.value = chunk_idx * symbols_per_chunk; entry.value < end_idx; ++entry.value)
             {
-                m_name_to_index.Append (entry);
+                const Symbol *symbol = &m_symbols[entry.value];
 
-                if (symbol->ContainsLinkerAnnotations()) {
-                    // If the symbol has linker annotations, also add the version without the
-                    // annotations.
-                    entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(entry.cstring)).GetCString();
-                    m_name_to_index.Append (entry);
-                }
-                
-                const SymbolType symbol_type = symbol->GetType();
-                if (symbol_type == eSymbolTypeCode || symbol_type == eSymbolTypeResolver)
+                // Don't let trampolines get into the lookup by name map
+                // If we ever need the trampoline symbols to be searchable by name
+                // we can remove this and then possibly add a new bool to any of the
+                // Symtab functions that lookup symbols by name to indicate if they
+                // want trampolines.
+                if (symbol->IsTrampoline())
+                    continue;
+
+                const Mangled &mangled = symbol->GetMangled();
+                entry.cstring = mangled.GetMangledName().GetCString();
+                if (entry.cstring && entry.cstring[0])
                 {
-                    if (entry.cstring[0] == '_' && entry.cstring[1] == 'Z' &&
-                        (entry.cstring[2] != 'T' && // avoid virtual table, VTT structure, typeinfo structure, and typeinfo name
-                         entry.cstring[2] != 'G' && // avoid guard variables
-                         entry.cstring[2] != 'Z'))  // named local entities (if we eventually handle eSymbolTypeData, we will want this back)
+                    indexes.name_to_index.Append (entry);
+
+                    if (symbol->ContainsLinkerAnnotations()) {
+                        // If the symbol has linker annotations, also add the version without the
+                        // annotations.
+                        entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(entry.cstring)).GetCString();
+                        indexes.name_to_index.Append (entry);
+                    }
+
+                    const SymbolType symbol_type = symbol->GetType();
+                    if (symbol_type == eSymbolTypeCode || symbol_type == eSymbolTypeResolver)
                     {
-                        CPPLanguageRuntime::MethodName cxx_method (mangled.GetDemangledName());
-                        entry.cstring = ConstString(cxx_method.GetBasename()).GetCString();
-                        if (entry.cstring && entry.cstring[0])
+                        if (entry.cstring[0] == '_' && entry.cstring[1] == 'Z' &&
+                            (entry.cstring[2] != 'T' && // avoid virtual table, VTT structure, typeinfo structure, and typeinfo name
+                             entry.cstring[2] != 'G' && // avoid guard variables
+                             entry.cstring[2] != 'Z'))  // named local entities (if we eventually handle eSymbolTypeData, we will want this back)
                         {
-                            // ConstString objects permanently store the string in the pool so calling
-                            // GetCString() on the value gets us a const char * that will never go away
-                            const char *const_context = ConstString(cxx_method.GetContext()).GetCString();
-
-                            if (entry.cstring[0] == '~' || !cxx_method.GetQualifiers().empty())
+                            CPPLanguageRuntime::MethodName cxx_method (mangled.GetDemangledName());
+                            entry.cstring = ConstString(cxx_method.GetBasename()).GetCString();
+                            if (entry.cstring && entry.cstring[0])
                             {
-                                // The first character of the demangled basename is '~' which
-                                // means we have a class destructor. We can use this information
-                                // to help us know what is a class and what isn't.
-                                if (class_contexts.find(const_context) == class_contexts.end())
-                                    class_contexts.insert(const_context);
-                                m_method_to_index.Append (entry);
-                            }
-                            else
-                            {
-                                if (const_context && const_context[0])
+                                // ConstString objects permanently store the string in the pool so calling
+                                // GetCString() on the value gets us a const char * that will never go away
+                                const char *const_context = ConstString(cxx_method.GetContext()).GetCString();
+
+                                if (entry.cstring[0] == '~' || !cxx_method.GetQualifiers().empty())
+                                {
+                                    // The first character of the demangled basename is '~' which
+                                    // means we have a class destructor. We can use this information
+                                    // to help us know what is a class and what isn't.
+                                    indexes.class_contexts.insert(const_context);
+                                    indexes.method_to_index.Append (entry);
+                                }
+                                else
                                 {
-                                    if (class_contexts.find(const_context) != class_contexts.end())
+                                    if (const_context && const_context[0])
                                     {
-                                        // The current decl context is in our "class_contexts" which means
-                                        // this is a method on a class
-                                        m_method_to_index.Append (entry);
+                                        if (indexes.class_contexts.find(const_context) != indexes.class_contexts.end())
+                                        {
+                                            // The current decl context is in our "class_contexts" which means
+                                            // this is a method on a class
+                                            indexes.method_to_index.Append (entry);
+                                        }
+                                        else
+                                        {
+                                            // We don't know if this is a function basename or a method,
+                                            // so put it into a temporary collection so once we are done
+                                            // we can look in class_contexts to see if each entry is a class
+                                            // or just a function and will put any remaining items into
+                                            // m_method_to_index or m_basename_to_index as needed
+                                            indexes.mangled_name_to_index.Append (entry);
+                                            symbol_contexts[entry.value] = const_context;
+                                        }
                                     }
                                     else
                                     {
-                                        // We don't know if this is a function basename or a method,
-                                        // so put it into a temporary collection so once we are done
-                                        // we can look in class_contexts to see if each entry is a class
-                                        // or just a function and will put any remaining items into
-                                        // m_method_to_index or m_basename_to_index as needed
-                                        mangled_name_to_index.Append (entry);
-                                        symbol_contexts[entry.value] = const_context;
+                                        // No context for this function so this has to be a basename
+                                        indexes.basename_to_index.Append(entry);
                                     }
                                 }
-                                else
-                                {
-                                    // No context for this function so this has to be a basename
-                                    m_basename_to_index.Append(entry);
-                                }
                             }
                         }
                     }
                 }
-            }
-            
-            entry.cstring = mangled.GetDemangledName().GetCString();
-            if (entry.cstring && entry.cstring[0]) {
-                m_name_to_index.Append (entry);
-
-                if (symbol->ContainsLinkerAnnotations()) {
-                    // If the symbol has linker annotations, also add the version without the
-                    // annotations.
-                    entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(entry.cstring)).GetCString();
-                    m_name_to_index.Append (entry);
+
+                entry.cstring = mangled.GetDemangledName().GetCString();
+                if (entry.cstring && entry.cstring[0]) {
+                    indexes.name_to_index.Append (entry);
+
+                    if (symbol->ContainsLinkerAnnotations()) {
+                        // If the symbol has linker annotations, also add the version without the
+                        // annotations.
+                        entry.cstring = ConstString(m_objfile->StripLinkerSymbolAnnotations(entry.cstring)).GetCString();
+                        indexes.name_to_index.Append (entry);
+                    }
                 }
-            }
-                
-            // If the demangled name turns out to be an ObjC name, and
-            // is a category name, add the version without categories to the index too.
-            ObjCLanguageRuntime::MethodName objc_method (entry.cstring, true);
-            if (objc_method.IsValid(true))
-            {
-                entry.cstring = objc_method.GetSelector().GetCString();
-                m_selector_to_index.Append (entry);
-                
-                ConstString objc_method_no_category (objc_method.GetFullNameWithoutCategory(true));
-                if (objc_method_no_category)
+
+                // If the demangled name turns out to be an ObjC name, and
+                // is a category name, add the version without categories to the index too.
+                ObjCLanguageRuntime::MethodName objc_method (entry.cstring, true);
+                if (objc_method.IsValid(true))
                 {
-                    entry.cstring = objc_method_no_category.GetCString();
-                    m_name_to_index.Append (entry);
+                    entry.cstring = objc_method.GetSelector().GetCString();
+                    indexes.selector_to_index.Append (entry);
+
+                    ConstString objc_method_no_category (objc_method.GetFullNameWithoutCategory(true));
+                    if (objc_method_no_category)
+                    {
+                        entry.cstring = objc_method_no_category.GetCString();
+                        indexes.name_to_index.Append (entry);
+                    }
                 }
             }
-                                                        
+        });
+
+        // Merge the chunks in symbol order. A class context found in any
+        // chunk applies to the functions of all chunks.
+        std::set<const char *> class_contexts;
+        for (const NameIndexes &indexes : chunk_indexes)
+        {
+            m_name_to_index.Append (indexes.name_to_index);
+            m_basename_to_index.Append (indexes.basename_to_index);
+            m_method_to_index.Append (indexes.method_to_index);
+            m_selector_to_index.Append (indexes.selector_to_index);
+            class_contexts.insert (indexes.class_contexts.begin(), indexes.class_contexts.end());
         }
-        
-        size_t count;
-        if (!mangled_name_to_index.IsEmpty())
+
+        NameToIndexMap::Entry entry;
+        for (const NameIndexes &indexes : chunk_indexes)
         {
-            count = mangled_name_to_index.GetSize();
+            const UniqueCStringMap<uint32_t> &mangled_name_to_index = indexes.mangled_name_to_index;
+            const size_t count = mangled_name_to_index.GetSize();
             for (size_t i=0; i<count; ++i)
             {
                 if (mangled_name_to_index.GetValueAtIndex(i, entry.value))
@@ -431,14 +464,11 @@ Symtab::InitNameIndexes()
                 }
             }
         }
-        m_name_to_index.Sort();
-        m_name_to_index.SizeToFit();
-        m_selector_to_index.Sort();
-        m_selector_to_index.SizeToFit();
-        m_basename_to_index.Sort();
-        m_basename_to_index.SizeToFit();
-        m_method_to_index.Sort();
-        m_method_to_index.SizeToFit();
+
+        TaskPool::RunTasks([this]() { m_name_to_index.Sort(); m_name_to_index.SizeToFit(); },
+                           [this]() { m_selector_to_index.Sort(); m_selector_to_index.SizeToFit(); },
+                           [this]() { m_basename_to_index.Sort(); m_basename_to_index.SizeToFit(); },
+                           [this]() { m_method_to_index.Sort(); m_method_to_index.SizeToFit(); });
     
 //        static StreamFile a ("/tmp/a.txt");
 //
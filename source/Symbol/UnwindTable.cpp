@@ -31,6 +31,10 @@ UnwindTable::UnwindTable (ObjectFile& objfile) :
     m_unwinds (),
     m_initialized (false),
     m_mutex (),
+    m_resolved_frames_mutex (),
+    m_resolved_call_frames (),
+    m_resolved_interrupted_frames (),
+    m_raw_unwind_rows (),
     m_eh_frame (nullptr),
     m_compact_unwind (nullptr)
 {
@@ -173,3 +177,64 @@ UnwindTable::GetArchitecture (lldb_private::ArchSpec &arch)
 {
     return m_object_file.GetArchitecture (arch);
 }
+
+UnwindTable::ResolvedFrameSP
+UnwindTable::FindResolvedFrame (lldb::addr_t file_addr, bool behaves_like_zeroth_frame, uint32_t process_unique_id)
+{
+    Mutex::Locker locker(m_resolved_frames_mutex);
+    const ResolvedFrameMap &resolved_frames = behaves_like_zeroth_frame ? m_resolved_interrupted_frames : m_resolved_call_frames;
+    ResolvedFrameMap::const_iterator pos = resolved_frames.find (file_addr);
+    if (pos != resolved_frames.end() && pos->second->process_unique_id == process_unique_id)
+        return pos->second;
+    return ResolvedFrameSP();
+}
+
+void
+UnwindTable::AddResolvedFrame (lldb::addr_t file_addr, bool behaves_like_zeroth_frame, const ResolvedFrameSP &resolved_frame_sp)
+{
+    Mutex::Locker locker(m_resolved_frames_mutex);
+    ResolvedFrameMap &resolved_frames = behaves_like_zeroth_frame ? m_resolved_interrupted_frames : m_resolved_call_frames;
+    resolved_frames[file_addr] = resolved_frame_sp;
+}
+
+UnwindPlan::RowSP
+UnwindTable::GetRawUnwindRow (const Address &addr, Target &target, lldb::RegisterKind &register_kind)
+{
+    const addr_t file_addr = addr.GetFileAddress();
+    {
+        Mutex::Locker locker(m_resolved_frames_mutex);
+        RawUnwindRowMap::const_iterator pos = m_raw_unwind_rows.find (file_addr);
+        if (pos != m_raw_unwind_rows.end())
+        {
+            register_kind = pos->second.register_kind;
+            return pos->second.row_sp;
+        }
+    }
+
+    Initialize();
+
+    // Parse the UnwindPlan without holding the lock; another thread
+    // looking up the same address just saves the same row
+    RawUnwindRow raw_row;
+    raw_row.register_kind = eRegisterKindGeneric;
+    UnwindPlan unwind_plan (eRegisterKindGeneric);
+    bool found = false;
+    if (m_compact_unwind)
+        found = m_compact_unwind->GetUnwindPlan (target, addr, unwind_plan);
+    if (!found && m_eh_frame)
+        found = m_eh_frame->GetUnwindPlan (addr, unwind_plan);
+    if (found)
+    {
+        const Address &start_addr = unwind_plan.GetAddressRange().GetBaseAddress();
+        if (start_addr.IsValid() && start_addr.GetFileAddress() <= file_addr)
+            raw_row.row_sp = unwind_plan.GetRowForFunctionOffset (file_addr - start_addr.GetFileAddress());
+        else
+            raw_row.row_sp = unwind_plan.GetRowForFunctionOffset (-1);
+        raw_row.register_kind = unwind_plan.GetRegisterKind();
+    }
+
+    Mutex::Locker locker(m_resolved_frames_mutex);
+    m_raw_unwind_rows[file_addr] = raw_row;
+    register_kind = raw_row.register_kind;
+    return raw_row.row_sp;
+}
@@ -11,9 +11,9 @@
 // C Includes
 #include <inttypes.h>
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
-#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Target/Process.h"
@@ -26,11 +26,21 @@ using namespace lldb_private;
 //----------------------------------------------------------------------
 MemoryCache::MemoryCache(Process &process) :
     m_process (process),
-    m_cache_line_byte_size (process.GetMemoryCacheLineSize()),
+    m_cache_line_byte_size (0),
+    m_num_sets (0),
+    m_max_prefetch_lines (0),
     m_mutex (Mutex::eMutexTypeRecursive),
-    m_cache (),
+    m_lines (),
+    m_line_bytes (),
+    m_read_buffer (),
+    m_clock (0),
+    m_next_sequential_addr (LLDB_INVALID_ADDRESS),
+    m_prev_sequential_addr (LLDB_INVALID_ADDRESS),
+    m_num_prefetch_lines (1),
+    m_stats (),
     m_invalid_ranges ()
 {
+    UpdateGeometry();
 }
 
 //----------------------------------------------------------------------
@@ -40,14 +50,50 @@ MemoryCache::~MemoryCache()
 {
 }
 
+void
+MemoryCache::UpdateGeometry ()
+{
+    // Lines are a power of two in size so they never straddle a page,
+    // where one half of a line could be readable and the other not
+    uint64_t line_byte_size = m_process.GetMemoryCacheLineSize();
+    if (line_byte_size < 16)
+        line_byte_size = 16;
+    else if (line_byte_size > 64 * 1024)
+        line_byte_size = 64 * 1024;
+    while (line_byte_size & (line_byte_size - 1))
+        line_byte_size &= line_byte_size - 1;
+
+    uint64_t num_sets = m_process.GetMemoryCacheSize() / (line_byte_size * kNumWays);
+    if (num_sets == 0)
+        num_sets = 1;
+    else if (num_sets > UINT32_MAX / kNumWays)
+        num_sets = UINT32_MAX / kNumWays;
+
+    if (line_byte_size != m_cache_line_byte_size || num_sets != m_num_sets)
+    {
+        m_cache_line_byte_size = line_byte_size;
+        m_num_sets = num_sets;
+        std::vector<Line>().swap (m_lines);
+        std::vector<uint8_t>().swap (m_line_bytes);
+    }
+
+    // Consecutive lines are in different sets, so lines that are read
+    // together can't replace each other
+    m_max_prefetch_lines = std::min<uint64_t> (m_process.GetMemoryCachePrefetchLines(), m_num_sets);
+}
+
 void
 MemoryCache::Clear(bool clear_invalid_ranges)
 {
     Mutex::Locker locker (m_mutex);
-    m_cache.clear();
+    for (Line &line : m_lines)
+        line.addr = LLDB_INVALID_ADDRESS;
+    m_next_sequential_addr = LLDB_INVALID_ADDRESS;
+    m_prev_sequential_addr = LLDB_INVALID_ADDRESS;
+    m_num_prefetch_lines = 1;
     if (clear_invalid_ranges)
         m_invalid_ranges.Clear();
-    m_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+    UpdateGeometry();
 }
 
 void
@@ -57,29 +103,36 @@ MemoryCache::Flush (addr_t addr, size_t size)
         return;
 
     Mutex::Locker locker (m_mutex);
-    if (m_cache.empty())
+    if (m_lines.empty())
         return;
 
     const uint32_t cache_line_byte_size = m_cache_line_byte_size;
-    const addr_t end_addr = (addr + size - 1);
-    const addr_t first_cache_line_addr = addr - (addr % cache_line_byte_size);
-    const addr_t last_cache_line_addr = end_addr - (end_addr % cache_line_byte_size);
     // Watch for overflow where size will cause us to go off the end of the
     // 64 bit address space
-    uint32_t num_cache_lines;
-    if (last_cache_line_addr >= first_cache_line_addr)
-        num_cache_lines = ((last_cache_line_addr - first_cache_line_addr)/cache_line_byte_size) + 1;
-    else
-        num_cache_lines = (UINT64_MAX - first_cache_line_addr + 1)/cache_line_byte_size;
+    addr_t end_addr = (addr + size - 1);
+    if (end_addr < addr)
+        end_addr = UINT64_MAX;
+    const addr_t first_cache_line_addr = GetLineAddress (addr);
+    const addr_t last_cache_line_addr = GetLineAddress (end_addr);
+    const uint64_t num_cache_lines = ((last_cache_line_addr - first_cache_line_addr)/cache_line_byte_size) + 1;
+
+    if (num_cache_lines > m_lines.size())
+    {
+        // Cheaper to look at every line than at every address
+        for (Line &line : m_lines)
+        {
+            if (line.addr != LLDB_INVALID_ADDRESS && line.addr >= first_cache_line_addr && line.addr <= last_cache_line_addr)
+                line.addr = LLDB_INVALID_ADDRESS;
+        }
+        return;
+    }
 
-    uint32_t cache_idx = 0;
-    for (addr_t curr_addr = first_cache_line_addr;
-         cache_idx < num_cache_lines;
-         curr_addr += cache_line_byte_size, ++cache_idx)
+    addr_t curr_addr = first_cache_line_addr;
+    for (uint64_t cache_idx = 0; cache_idx < num_cache_lines; ++cache_idx, curr_addr += cache_line_byte_size)
     {
-        BlockMap::iterator pos = m_cache.find (curr_addr);
-        if (pos != m_cache.end())
-            m_cache.erase(pos);
+        Line *line = FindLine (curr_addr);
+        if (line)
+            line->addr = LLDB_INVALID_ADDRESS;
     }
 }
 
@@ -112,7 +165,171 @@ MemoryCache::RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size)
     return false;
 }
 
+uint32_t
+MemoryCache::GetNumCachedLines () const
+{
+    Mutex::Locker locker (m_mutex);
+    uint32_t num_lines = 0;
+    for (const Line &line : m_lines)
+    {
+        if (line.addr != LLDB_INVALID_ADDRESS)
+            ++num_lines;
+    }
+    return num_lines;
+}
+
+MemoryCache::Statistics
+MemoryCache::GetStatistics () const
+{
+    Mutex::Locker locker (m_mutex);
+    return m_stats;
+}
+
+void
+MemoryCache::ResetStatistics ()
+{
+    Mutex::Locker locker (m_mutex);
+    m_stats = Statistics();
+}
+
+MemoryCache::Line *
+MemoryCache::FindLine (addr_t line_addr)
+{
+    if (m_lines.empty())
+        return NULL;
+
+    const uint32_t set_idx = (line_addr / m_cache_line_byte_size) % m_num_sets;
+    Line *set = &m_lines[set_idx * kNumWays];
+    for (uint32_t way = 0; way < kNumWays; ++way)
+    {
+        if (set[way].addr == line_addr)
+            return &set[way];
+    }
+    return NULL;
+}
+
+MemoryCache::Line &
+MemoryCache::AllocateLine (addr_t line_addr)
+{
+    if (m_lines.empty())
+    {
+        // The pool is only allocated once something is read so processes
+        // that never read memory through the cache don't pay for it
+        const Line unused_line = { LLDB_INVALID_ADDRESS, 0, false, 0 };
+        m_lines.assign ((size_t)m_num_sets * kNumWays, unused_line);
+        m_line_bytes.resize (m_lines.size() * m_cache_line_byte_size);
+    }
+
+    const uint32_t set_idx = (line_addr / m_cache_line_byte_size) % m_num_sets;
+    Line *set = &m_lines[set_idx * kNumWays];
+    Line *lru_line = &set[0];
+    for (uint32_t way = 0; way < kNumWays; ++way)
+    {
+        if (set[way].addr == line_addr || set[way].addr == LLDB_INVALID_ADDRESS)
+            return set[way];
+        if (set[way].last_used < lru_line->last_used)
+            lru_line = &set[way];
+    }
+    ++m_stats.evictions;
+    return *lru_line;
+}
+
+MemoryCache::Line &
+MemoryCache::StoreLine (addr_t line_addr, const uint8_t *bytes, uint32_t byte_size, bool prefetched)
+{
+    Line &line = AllocateLine (line_addr);
+    line.addr = line_addr;
+    line.byte_size = byte_size;
+    line.prefetched = prefetched;
+    line.last_used = ++m_clock;
+    memcpy (GetLineBytes (line), bytes, byte_size);
+    if (prefetched)
+        ++m_stats.prefetched_lines;
+    return line;
+}
+
+MemoryCache::Line *
+MemoryCache::FillLine (addr_t line_addr, Error &error)
+{
+    const addr_t cache_line_byte_size = m_cache_line_byte_size;
+
+    // A miss on the line right after, or right before, the last lines
+    // that were filled is taken to be part of a sequential scan, so read
+    // the lines that would be missed next along with this one
+    addr_t first_line_addr = line_addr;
+    uint32_t num_lines = 1;
+    const bool ascending = line_addr == m_next_sequential_addr;
+    if (m_max_prefetch_lines > 1 && (ascending || line_addr == m_prev_sequential_addr))
+    {
+        while (num_lines < m_num_prefetch_lines)
+        {
+            addr_t next_line_addr;
+            if (ascending)
+            {
+                next_line_addr = line_addr + num_lines * cache_line_byte_size;
+                if (next_line_addr < line_addr)
+                    break;
+            }
+            else
+            {
+                if (first_line_addr < cache_line_byte_size)
+                    break;
+                next_line_addr = first_line_addr - cache_line_byte_size;
+            }
+            if (FindLine (next_line_addr) || m_invalid_ranges.FindEntryThatContains (next_line_addr))
+                break;
+            if (!ascending)
+                first_line_addr = next_line_addr;
+            ++num_lines;
+        }
+        m_num_prefetch_lines = std::min<uint32_t> (m_num_prefetch_lines * 2, m_max_prefetch_lines);
+    }
+    else
+        m_num_prefetch_lines = 2;
+
+    const size_t read_size = num_lines * cache_line_byte_size;
+    if (m_read_buffer.size() < read_size)
+        m_read_buffer.resize (read_size);
+
+    Line *line = NULL;
+    if (num_lines > 1)
+    {
+        Error prefetch_error;
+        const size_t bytes_read = m_process.ReadMemoryFromInferior (first_line_addr, &m_read_buffer[0], read_size, prefetch_error);
+        ++m_stats.reads;
+        m_stats.bytes_read += bytes_read;
+
+        // Some processes fail the whole read if any of it can't be read,
+        // in which case the line that is needed is read on its own below
+        if (bytes_read > line_addr - first_line_addr)
+        {
+            for (uint32_t i = 0; i < num_lines && i * cache_line_byte_size < bytes_read; ++i)
+            {
+                const addr_t curr_line_addr = first_line_addr + i * cache_line_byte_size;
+                const size_t line_bytes_read = std::min<size_t> (cache_line_byte_size, bytes_read - i * cache_line_byte_size);
+                Line &curr_line = StoreLine (curr_line_addr, &m_read_buffer[i * cache_line_byte_size], line_bytes_read, curr_line_addr != line_addr);
+                if (curr_line_addr == line_addr)
+                    line = &curr_line;
+            }
+        }
+    }
+
+    if (line == NULL)
+    {
+        first_line_addr = line_addr;
+        num_lines = 1;
+        const size_t bytes_read = m_process.ReadMemoryFromInferior (line_addr, &m_read_buffer[0], cache_line_byte_size, error);
+        ++m_stats.reads;
+        m_stats.bytes_read += bytes_read;
+        if (bytes_read == 0)
+            return NULL;
+        line = &StoreLine (line_addr, &m_read_buffer[0], bytes_read, false);
+    }
 
+    m_next_sequential_addr = first_line_addr + num_lines * cache_line_byte_size;
+    m_prev_sequential_addr = first_line_addr >= cache_line_byte_size ? first_line_addr - cache_line_byte_size : LLDB_INVALID_ADDRESS;
+    return line;
+}
 
 size_t
 MemoryCache::Read (addr_t addr,  
@@ -131,93 +348,109 @@ MemoryCache::Read (addr_t addr,
     // it in the cache.
     if (dst && dst_len > m_cache_line_byte_size)
     {
+        {
+            Mutex::Locker locker (m_mutex);
+            ++m_stats.uncached_reads;
+        }
         return m_process.ReadMemoryFromInferior (addr, dst, dst_len, error);
     }
 
     if (dst && bytes_left > 0)
     {
-        const uint32_t cache_line_byte_size = m_cache_line_byte_size;
         uint8_t *dst_buf = (uint8_t *)dst;
-        addr_t curr_addr = addr - (addr % cache_line_byte_size);
-        addr_t cache_offset = addr - curr_addr;
+        addr_t curr_addr = addr;
         Mutex::Locker locker (m_mutex);
         
         while (bytes_left > 0)
         {
-            if (m_invalid_ranges.FindEntryThatContains(curr_addr))
+            const addr_t line_addr = GetLineAddress (curr_addr);
+            if (m_invalid_ranges.FindEntryThatContains(line_addr))
             {
-                error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, curr_addr);
+                error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, line_addr);
                 return dst_len - bytes_left;
             }
 
-            BlockMap::const_iterator pos = m_cache.find (curr_addr);
-            BlockMap::const_iterator end = m_cache.end ();
-            
-            if (pos != end)
+            Line *line = FindLine (line_addr);
+            if (line)
             {
-                size_t curr_read_size = cache_line_byte_size - cache_offset;
-                if (curr_read_size > bytes_left)
-                    curr_read_size = bytes_left;
-                
-                memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes() + cache_offset, curr_read_size);
-                
-                bytes_left -= curr_read_size;
-                curr_addr += curr_read_size + cache_offset;
-                cache_offset = 0;
-                
-                if (bytes_left > 0)
+                ++m_stats.hits;
+                if (line->prefetched)
                 {
-                    // Get sequential cache page hits
-                    for (++pos; (pos != end) && (bytes_left > 0); ++pos)
-                    {
-                        assert ((curr_addr % cache_line_byte_size) == 0);
-                        
-                        if (pos->first != curr_addr)
-                            break;
-                        
-                        curr_read_size = pos->second->GetByteSize();
-                        if (curr_read_size > bytes_left)
-                            curr_read_size = bytes_left;
-                        
-                        memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes(), curr_read_size);
-                        
-                        bytes_left -= curr_read_size;
-                        curr_addr += curr_read_size;
-                        
-                        // We have a cache page that succeeded to read some bytes
-                        // but not an entire page. If this happens, we must cap
-                        // off how much data we are able to read...
-                        if (pos->second->GetByteSize() != cache_line_byte_size)
-                            return dst_len - bytes_left;
-                    }
+                    ++m_stats.prefetch_hits;
+                    line->prefetched = false;
                 }
+                line->last_used = ++m_clock;
             }
-            
-            // We need to read from the process
-            
-            if (bytes_left > 0)
+            else
             {
-                assert ((curr_addr % cache_line_byte_size) == 0);
-                std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(new DataBufferHeap (cache_line_byte_size, 0));
-                size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
-                                                                              data_buffer_heap_ap->GetBytes(), 
-                                                                              data_buffer_heap_ap->GetByteSize(), 
-                                                                              error);
-                if (process_bytes_read == 0)
+                // We need to read from the process
+                ++m_stats.misses;
+                line = FillLine (line_addr, error);
+                if (line == NULL)
                     return dst_len - bytes_left;
-                
-                if (process_bytes_read != cache_line_byte_size)
-                    data_buffer_heap_ap->SetByteSize (process_bytes_read);
-                m_cache[curr_addr] = DataBufferSP (data_buffer_heap_ap.release());
-                // We have read data and put it into the cache, continue through the
-                // loop again to get the data out of the cache...
             }
+
+            const size_t line_offset = curr_addr - line_addr;
+            if (line_offset >= line->byte_size)
+                return dst_len - bytes_left;
+
+            const size_t curr_read_size = std::min<size_t> (bytes_left, line->byte_size - line_offset);
+            memcpy (dst_buf + dst_len - bytes_left, GetLineBytes (*line) + line_offset, curr_read_size);
+            bytes_left -= curr_read_size;
+            curr_addr += curr_read_size;
+
+            // We have a cache line that succeeded to read some bytes
+            // but not an entire line. If this happens, we must cap
+            // off how much data we are able to read...
+            if (line->byte_size != m_cache_line_byte_size)
+                break;
         }
     }
     
     return dst_len - bytes_left;
 }
 
+size_t
+MemoryCache::Prefetch (addr_t addr, size_t size)
+{
+    if (size == 0)
+        return 0;
+
+    Mutex::Locker locker (m_mutex);
+    const addr_t cache_line_byte_size = m_cache_line_byte_size;
+    addr_t end_addr = addr + size - 1;
+    if (end_addr < addr)
+        end_addr = UINT64_MAX;
+    const addr_t first_line_addr = GetLineAddress (addr);
+    uint64_t num_lines = (GetLineAddress (end_addr) - first_line_addr) / cache_line_byte_size + 1;
+    // Leave room for everything else that is being read
+    if (num_lines > GetCapacity() / 2)
+        num_lines = GetCapacity() / 2;
+    if (num_lines == 0)
+        return 0;
+
+    const size_t read_size = num_lines * cache_line_byte_size;
+    if (m_read_buffer.size() < read_size)
+        m_read_buffer.resize (read_size);
+
+    Error error;
+    const size_t bytes_read = m_process.ReadMemoryFromInferior (first_line_addr, &m_read_buffer[0], read_size, error);
+    ++m_stats.reads;
+    m_stats.bytes_read += bytes_read;
+
+    for (uint64_t i = 0; i < num_lines && i * cache_line_byte_size < bytes_read; ++i)
+    {
+        // The cache is flushed whenever the process runs so the lines that
+        // are already cached are up to date
+        const addr_t curr_line_addr = first_line_addr + i * cache_line_byte_size;
+        if (FindLine (curr_line_addr) || m_invalid_ranges.FindEntryThatContains (curr_line_addr))
+            continue;
+        const size_t line_bytes_read = std::min<size_t> (cache_line_byte_size, bytes_read - i * cache_line_byte_size);
+        StoreLine (curr_line_addr, &m_read_buffer[i * cache_line_byte_size], line_bytes_read, true);
+    }
+    return bytes_read;
+}
+
 
 
 AllocatedBlock::AllocatedBlock (lldb::addr_t addr, 
@@ -116,7 +116,10 @@ g_properties[] =
     { "python-os-plugin-path", OptionValue::eTypeFileSpec, false, true, NULL, NULL, "A path to a python OS plug-in module file that contains a OperatingSystemPlugIn class." },
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
-    { "memory-cache-line-size" , OptionValue::eTypeUInt64, false, 512, NULL, NULL, "The memory cache line size" },
+    { "memory-cache-line-size" , OptionValue::eTypeUInt64, false, 512, NULL, NULL, "The memory cache line size, rounded down to a power of two." },
+    { "memory-cache-size" , OptionValue::eTypeUInt64, false, 4 * 1024 * 1024, NULL, NULL, "The number of bytes of memory the memory cache holds before it replaces the least recently used lines." },
+    { "memory-cache-prefetch-lines" , OptionValue::eTypeUInt64, false, 16, NULL, NULL, "The most lines the memory cache reads ahead when memory is being read sequentially. 0 or 1 disables reading ahead." },
+    { "stack-prefetch-size" , OptionValue::eTypeUInt64, false, 8 * 1024, NULL, NULL, "The number of bytes above the stack pointer of a thread to read into the memory cache in one request when the thread is first unwound after a stop. 0 disables prefetching stack memory." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
@@ -128,7 +131,10 @@ enum {
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
     ePropertyDetachKeepsStopped,
-    ePropertyMemCacheLineSize
+    ePropertyMemCacheLineSize,
+    ePropertyMemCacheSize,
+    ePropertyMemCachePrefetchLines,
+    ePropertyStackPrefetchSize
 };
 
 ProcessProperties::ProcessProperties (lldb_private::Process *process) :
@@ -178,6 +184,27 @@ ProcessProperties::GetMemoryCacheLineSize() const
     return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
 }
 
+uint64_t
+ProcessProperties::GetMemoryCacheSize() const
+{
+    const uint32_t idx = ePropertyMemCacheSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+uint64_t
+ProcessProperties::GetMemoryCachePrefetchLines() const
+{
+    const uint32_t idx = ePropertyMemCachePrefetchLines;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+uint64_t
+ProcessProperties::GetStackPrefetchSize() const
+{
+    const uint32_t idx = ePropertyStackPrefetchSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
 Args
 ProcessProperties::GetExtraStartupCommands () const
 {
@@ -2556,6 +2583,29 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
         return ReadMemoryFromInferior (addr, buf, size, error);
     }
 }
+
+void
+Process::PrefetchStackMemory (lldb::addr_t sp)
+{
+    const uint64_t prefetch_size = GetStackPrefetchSize();
+    if (prefetch_size == 0 || sp == 0 || sp == LLDB_INVALID_ADDRESS || GetDisableMemoryCache())
+        return;
+
+    // The frames are above the stack pointer
+    if (m_memory_cache.Prefetch (sp, prefetch_size) > 0)
+        return;
+
+    // Some processes fail the whole read if the stack ends within it,
+    // as it does when the thread is only a few frames deep, so read up
+    // to the end of the stack instead
+    MemoryRegionInfo region_info;
+    if (GetMemoryRegionInfo (sp, region_info).Success() &&
+        region_info.GetRange().Contains (sp) &&
+        region_info.GetRange().GetRangeEnd() - sp < prefetch_size)
+    {
+        m_memory_cache.Prefetch (sp, region_info.GetRange().GetRangeEnd() - sp);
+    }
+}
     
 size_t
 Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, Error &error)
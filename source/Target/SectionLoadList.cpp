@@ -274,6 +274,49 @@ SectionLoadList::ResolveLoadAddress (addr_t load_addr, Address &so_addr) const
     return false;
 }
 
+size_t
+SectionLoadList::ResolveLoadAddresses (const std::vector<addr_t> &load_addrs, std::vector<Address> &so_addrs) const
+{
+    Mutex::Locker locker(m_mutex);
+    so_addrs.resize (load_addrs.size());
+
+    size_t num_resolved = 0;
+    const addr_to_sect_collection::const_iterator end = m_addr_to_sect.end();
+    addr_to_sect_collection::const_iterator pos = end;
+    for (size_t i = 0; i < load_addrs.size(); ++i)
+    {
+        const addr_t load_addr = load_addrs[i];
+        Address &so_addr = so_addrs[i];
+        so_addr.Clear();
+
+        // Only search for the top level section if the address isn't in
+        // the same one as the last address
+        if (pos == end || load_addr < pos->first || load_addr - pos->first >= pos->second->GetByteSize())
+        {
+            pos = m_addr_to_sect.upper_bound (load_addr);
+            if (pos == m_addr_to_sect.begin())
+            {
+                pos = end;
+                continue;
+            }
+            --pos;
+            if (load_addr - pos->first >= pos->second->GetByteSize())
+            {
+                pos = end;
+                continue;
+            }
+        }
+
+        // We have found the top level section, now we need to find the
+        // deepest child section.
+        if (pos->second->ResolveContainedAddress (load_addr - pos->first, so_addr))
+            ++num_resolved;
+        else
+            so_addr.Clear();
+    }
+    return num_resolved;
+}
+
 void
 SectionLoadList::Dump (Stream &s, Target *target)
 {
@@ -22,6 +22,7 @@
 #include "lldb/Breakpoint/BreakpointResolverName.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/DemangledNameCache.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
@@ -104,6 +105,15 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
 
     CheckInWithManager();
 
+    // The dummy target is created before the init files have been read,
+    // so set up the demangled name cache with the first real target.
+    if (!is_dummy_target)
+    {
+        TargetPropertiesSP global_properties_sp (Target::GetGlobalProperties());
+        DemangledNameCache::Initialize (global_properties_sp->GetDemangleCachePath(),
+                                        global_properties_sp->GetDemangleCacheMaxSize());
+    }
+
     Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_OBJECT));
     if (log)
         log->Printf ("%p Target::Target()", static_cast<void*>(this));
@@ -2965,6 +2975,8 @@ g_properties[] =
     { "display-expression-in-crashlogs"    , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Expressions that crash will show up in crash logs if the host system supports executable specific crash log strings and this setting is set to true." },
     { "trap-handler-names"                 , OptionValue::eTypeArray     , true,  OptionValue::eTypeString,   NULL, NULL, "A list of trap handler function names, e.g. a common Unix user process one is _sigtramp." },
     { "display-runtime-support-values"     , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "If true, LLDB will show variables that are meant to support the operation of a language's runtime support." },
+    { "demangle-cache-path"                , OptionValue::eTypeFileSpec  , true , 0,                          NULL, NULL, "A directory in which to keep a cache of demangled names that is shared between debug sessions. Caching is disabled when this is empty. This is only read when the first target is created." },
+    { "demangle-cache-max-size"            , OptionValue::eTypeUInt64    , true , 64 * 1024 * 1024,           NULL, NULL, "The maximum size in bytes of the demangled name cache file. The least recently added names are dropped when it grows beyond this." },
     { NULL                                 , OptionValue::eTypeInvalid   , false, 0                         , NULL, NULL, NULL }
 };
 
@@ -3003,7 +3015,9 @@ enum
     ePropertyMemoryModuleLoadLevel,
     ePropertyDisplayExpressionsInCrashlogs,
     ePropertyTrapHandlerNames,
-    ePropertyDisplayRuntimeSupportValues
+    ePropertyDisplayRuntimeSupportValues,
+    ePropertyDemangleCachePath,
+    ePropertyDemangleCacheMaxSize
 };
 
 
@@ -3502,6 +3516,20 @@ TargetProperties::SetDisplayRuntimeSupportValues (bool b)
     m_collection_sp->SetPropertyAtIndexAsBoolean (NULL, idx, b);
 }
 
+FileSpec
+TargetProperties::GetDemangleCachePath () const
+{
+    const uint32_t idx = ePropertyDemangleCachePath;
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+}
+
+uint64_t
+TargetProperties::GetDemangleCacheMaxSize () const
+{
+    const uint32_t idx = ePropertyDemangleCacheMaxSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
 const ProcessLaunchInfo &
 TargetProperties::GetProcessLaunchInfo ()
 {
@@ -2306,6 +2306,25 @@ Thread::GetStackFrameStatus (Stream& strm,
                                            num_frames_with_source);
 }
 
+uint32_t
+Thread::GetRawBacktrace (std::vector<addr_t> &pcs, uint32_t max_frames)
+{
+    Unwind *unwinder = GetUnwinder ();
+    if (unwinder)
+        return unwinder->GetRawBacktrace (pcs, max_frames);
+
+    pcs.clear();
+    TargetSP target_sp (CalculateTarget());
+    for (uint32_t idx = 0; idx < max_frames; ++idx)
+    {
+        StackFrameSP frame_sp (GetStackFrameAtIndex (idx));
+        if (!frame_sp)
+            break;
+        pcs.push_back (frame_sp->GetFrameCodeAddress().GetLoadAddress (target_sp.get()));
+    }
+    return pcs.size();
+}
+
 Unwind *
 Thread::GetUnwinder ()
 {
@@ -103,6 +103,14 @@ lldb_private::GetSectionTypeAsCString(lldb::SectionType sect_type)
             return "eh-frame";
         case eSectionTypeCompactUnwind:
             return "compact-unwind";
+        case eSectionTypeDWARFGDBIndex:
+            return "dwarf-gdb-index";
+        case eSectionTypeDWARFDebugAddr:
+            return "dwarf-addr";
+        case eSectionTypeDWARFDebugStrOffsets:
+            return "dwarf-str-offsets";
+        case eSectionTypeDWARFDebugCUIndex:
+            return "dwarf-cu-index";
         case eSectionTypeOther:
             return "regular";
     }
@@ -84,6 +84,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         switch (packet_cstr[1])
         {
         case 'E':
+            if (PACKET_STARTS_WITH ("QEnableCompression:"))     return eServerPacketType_QEnableCompression;
             if (PACKET_STARTS_WITH ("QEnvironment:"))           return eServerPacketType_QEnvironment;
             if (PACKET_STARTS_WITH ("QEnvironmentHexEncoded:")) return eServerPacketType_QEnvironmentHexEncoded;
             break;
@@ -207,6 +208,11 @@ StringExtractorGDBRemote::GetServerPacketType () const
             break;
         }
         break;
+
+    case 'j':
+        if (PACKET_MATCHES("jThreadsInfo"))                     return eServerPacketType_jThreadsInfo;
+        break;
+
     case 'v':
             if (PACKET_STARTS_WITH("vFile:"))
             {
@@ -257,7 +263,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         break;
 
       case 'g':
-        if (packet_size == 1) return eServerPacketType_g;
+        if (packet_size == 1 || packet_cstr[1] == ';') return eServerPacketType_g;
         break;
 
       case 'G':
@@ -295,6 +301,9 @@ StringExtractorGDBRemote::GetServerPacketType () const
       case 'T':
         return eServerPacketType_T;
 
+      case 'x':
+        return eServerPacketType_x;
+
       case 'z':
         if (packet_cstr[1] >= '0' && packet_cstr[1] <= '4')
           return eServerPacketType_z;
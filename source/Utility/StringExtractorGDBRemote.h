@@ -84,6 +84,7 @@ public:
         eServerPacketType_vFile_symlink,
         eServerPacketType_vFile_unlink,
       // debug server packages
+        eServerPacketType_QEnableCompression,
         eServerPacketType_QEnvironmentHexEncoded,
         eServerPacketType_QListThreadsInStopReply,
         eServerPacketType_QRestoreRegisterState,
@@ -116,6 +117,8 @@ public:
         eServerPacketType_qWatchpointSupportInfoSupported,
         eServerPacketType_qXfer_auxv_read,
 
+        eServerPacketType_jThreadsInfo,
+
         eServerPacketType_vAttach,
         eServerPacketType_vAttachWait,
         eServerPacketType_vAttachOrWait,
@@ -140,6 +143,7 @@ public:
         eServerPacketType_s,
         eServerPacketType_S,
         eServerPacketType_T,
+        eServerPacketType_x,
         eServerPacketType_Z,
         eServerPacketType_z,
 
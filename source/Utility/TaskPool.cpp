@@ -0,0 +1,188 @@
+//===--------------------- TaskPool.cpp -------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/TaskPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    class TaskPoolImpl
+    {
+    public:
+        static TaskPoolImpl &
+        GetInstance ();
+
+        void
+        AddTask (std::function<void()>&& task_fn);
+
+        uint32_t
+        GetMaxThreads () const
+        {
+            return m_max_threads;
+        }
+
+    private:
+        TaskPoolImpl ();
+
+        static void
+        Worker (TaskPoolImpl *pool);
+
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex m_tasks_mutex;
+        uint32_t m_thread_count;
+        const uint32_t m_max_threads;
+    };
+}
+
+TaskPoolImpl &
+TaskPoolImpl::GetInstance ()
+{
+    // Leaked on purpose so the worker threads never touch a destroyed
+    // pool while the process is exiting.
+    static TaskPoolImpl *g_task_pool_impl = new TaskPoolImpl();
+    return *g_task_pool_impl;
+}
+
+TaskPoolImpl::TaskPoolImpl () :
+    m_tasks (),
+    m_tasks_mutex (),
+    m_thread_count (0),
+    m_max_threads (std::max<uint32_t>(std::thread::hardware_concurrency(), 1))
+{
+}
+
+void
+TaskPoolImpl::AddTask (std::function<void()>&& task_fn)
+{
+    std::unique_lock<std::mutex> lock(m_tasks_mutex);
+    m_tasks.emplace(std::move(task_fn));
+    if (m_thread_count < m_max_threads)
+    {
+        m_thread_count++;
+        // Spawn the thread with m_tasks_mutex held so the new worker can't
+        // observe an empty queue and exit before the count is updated.
+        std::thread(Worker, this).detach();
+    }
+}
+
+void
+TaskPoolImpl::Worker (TaskPoolImpl *pool)
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(pool->m_tasks_mutex);
+        if (pool->m_tasks.empty())
+        {
+            // Let the thread exit when there is nothing left to do; a new
+            // one is spawned the next time a task is added.
+            pool->m_thread_count--;
+            break;
+        }
+
+        std::function<void()> f = std::move(pool->m_tasks.front());
+        pool->m_tasks.pop();
+        lock.unlock();
+
+        f();
+    }
+}
+
+void
+TaskPool::AddTaskImpl (std::function<void()>&& task_fn)
+{
+    TaskPoolImpl::GetInstance().AddTask(std::move(task_fn));
+}
+
+void
+TaskPool::RunTasksImpl (const std::vector<std::function<void()>> &tasks)
+{
+    // TaskMapOverInt has the calling thread run whatever the worker
+    // threads didn't get to, so this never waits on a queued task.
+    TaskMapOverInt(0, tasks.size(), [&tasks](size_t idx) { tasks[idx](); });
+}
+
+uint32_t
+TaskPool::GetMaxConcurrency ()
+{
+    return TaskPoolImpl::GetInstance().GetMaxThreads();
+}
+
+void
+lldb_private::TaskMapOverInt (size_t begin,
+                              size_t end,
+                              const std::function<void(size_t)> &func)
+{
+    if (begin >= end)
+        return;
+
+    // Shared with the helper tasks, some of which might only get scheduled
+    // after this function has returned.
+    struct MapState
+    {
+        std::atomic<size_t> next_idx;
+        std::mutex mutex;
+        std::condition_variable cond;
+        uint32_t num_running;
+        bool closed;
+    };
+    std::shared_ptr<MapState> state_sp(new MapState());
+    state_sp->next_idx = begin;
+    state_sp->num_running = 0;
+    state_sp->closed = false;
+
+    const std::function<void(MapState &)> process_items = [end, &func](MapState &state)
+    {
+        while (true)
+        {
+            const size_t i = state.next_idx.fetch_add(1);
+            if (i >= end)
+                break;
+            func(i);
+        }
+    };
+
+    // Helper tasks check in before touching "func" and bail out if the
+    // calling thread already finished the whole range. This lets
+    // TaskMapOverInt be called from within a task pool thread without
+    // dead locking when every worker thread is busy.
+    const std::function<void(MapState &)> *process_items_ptr = &process_items;
+    const size_t num_helpers = std::min<size_t>(TaskPool::GetMaxConcurrency(), end - begin) - 1;
+    for (size_t i = 0; i < num_helpers; ++i)
+    {
+        TaskPool::AddTask([state_sp, process_items_ptr]()
+        {
+            {
+                std::lock_guard<std::mutex> guard(state_sp->mutex);
+                if (state_sp->closed)
+                    return;
+                ++state_sp->num_running;
+            }
+            (*process_items_ptr)(*state_sp);
+            std::lock_guard<std::mutex> guard(state_sp->mutex);
+            --state_sp->num_running;
+            state_sp->cond.notify_all();
+        });
+    }
+
+    // The calling thread does its share of the work too.
+    process_items(*state_sp);
+
+    std::unique_lock<std::mutex> lock(state_sp->mutex);
+    state_sp->closed = true;
+    state_sp->cond.wait(lock, [&state_sp]() { return state_sp->num_running == 0; });
+}
@@ -0,0 +1,68 @@
+"""Benchmark how many frames per second the raw backtrace mode unwinds."""
+
+import os, time
+import unittest2
+import lldb
+from lldbbench import *
+import lldbutil
+
+class RawBacktraceBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        # Create self.stopwatch2 for measuring "thread backtrace all --raw".
+        # The default self.stopwatch is for SBThread.GetRawBacktrace().
+        self.stopwatch2 = Stopwatch()
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    @dwarf_test
+    def test_raw_backtrace_bench_with_dwarf(self):
+        """Benchmark sampling the stacks of many threads with raw backtraces."""
+        self.buildDwarf()
+        self.run_raw_backtrace_bench()
+
+    def run_raw_backtrace_bench(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_source_regexp (self, "// break here")
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+
+        # main() plus 32 threads, each 256 calls deep.
+        threads = [process.GetThreadAtIndex(i) for i in range(process.GetNumThreads())]
+        self.assertTrue(len(threads) == 33, "All of the threads should be running")
+
+        num_frames = 0
+        self.stopwatch.reset()
+        for i in range(self.count):
+            with self.stopwatch:
+                for thread in threads:
+                    num_frames += len(thread.GetRawBacktrace(1024))
+        self.assertTrue(num_frames >= self.count * 32 * 256, "Every thread should be unwound to the bottom of its stack")
+
+        self.stopwatch2.reset()
+        for i in range(self.count):
+            with self.stopwatch2:
+                self.runCmd("thread backtrace all --raw")
+
+        # Both sample the same stacks, so they unwind the same number of frames.
+        frames_per_sample = float(num_frames) / self.count
+        print
+        print "SBThread.GetRawBacktrace() of all threads:", self.stopwatch
+        print "SBThread.GetRawBacktrace() frames per second: %.0f" % (frames_per_sample / self.stopwatch.avg())
+        print "'thread backtrace all --raw':", self.stopwatch2
+        print "'thread backtrace all --raw' frames per second: %.0f" % (frames_per_sample / self.stopwatch2.avg())
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
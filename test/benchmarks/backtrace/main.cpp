@@ -0,0 +1,58 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Parks a number of threads at the bottom of a deep call stack so that
+// their backtraces can be sampled.
+
+#include <pthread.h>
+#include <atomic>
+
+#define NUM_THREADS 32
+#define STACK_DEPTH 256
+
+std::atomic_int g_threads_ready;
+std::atomic_bool g_done;
+
+int
+recurse (int depth)
+{
+    if (depth == 0)
+    {
+        ++g_threads_ready;
+        while (!g_done)
+            ;
+        return 0;
+    }
+    // Not a tail call, so every level keeps its frame.
+    return recurse (depth - 1) + 1;
+}
+
+void *
+thread_func (void *input)
+{
+    recurse (STACK_DEPTH);
+    return NULL;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; ++i)
+        pthread_create (&threads[i], NULL, thread_func, NULL);
+
+    while (g_threads_ready < NUM_THREADS)
+        ;
+
+    g_done = true; // break here
+
+    for (int i = 0; i < NUM_THREADS; ++i)
+        pthread_join (threads[i], NULL);
+    return 0;
+}
@@ -0,0 +1,88 @@
+"""
+Test the memory cache and the 'process cache' commands.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipUnlessDarwin
+    @dsym_test
+    def test_memory_cache_with_dsym(self):
+        """Test that sequential reads through the memory cache are read ahead."""
+        self.buildDsym()
+        self.memory_cache_commands()
+
+    @dwarf_test
+    def test_memory_cache_with_dwarf(self):
+        """Test that sequential reads through the memory cache are read ahead."""
+        self.buildDwarf()
+        self.memory_cache_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def get_stat(self, name):
+        self.runCmd("process cache stats")
+        match = re.search(name + r": (\d+)", self.res.GetOutput())
+        self.assertTrue(match, "'%s' is in the cache statistics" % name)
+        return int(match.group(1))
+
+    def memory_cache_commands(self):
+        """Read a buffer a few bytes at a time and check the cache statistics."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line (self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint'])
+
+        # Unwinding the thread for the stop read its stack all at once
+        self.assertTrue(self.get_stat("Prefetched lines") > 0)
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        buffer_addr = self.frame().FindValue("g_buffer", lldb.eValueTypeVariableGlobal).GetLoadAddress()
+        self.assertTrue(buffer_addr != lldb.LLDB_INVALID_ADDRESS)
+
+        self.runCmd("process cache clear")
+        self.assertTrue(self.get_stat("Hits") == 0)
+
+        # Read the first 16KB of the buffer 8 bytes at a time, which
+        # should be read ahead once the reads are seen to be sequential
+        error = lldb.SBError()
+        for offset in range(0, 16 * 1024, 8):
+            data = process.ReadMemory(buffer_addr + offset, 8, error)
+            self.assertTrue(error.Success(), "read at offset %u succeeded" % offset)
+            for i in range(8):
+                self.assertTrue(ord(data[i]) == ((offset + i) * 7) & 0xff, "byte %u is right" % (offset + i))
+
+        self.assertTrue(self.get_stat("Hits") > 0)
+        self.assertTrue(self.get_stat("Prefetched lines") > 0)
+        self.runCmd("process cache stats")
+        line_size = int(re.search(r"\((\d+) bytes each\)", self.res.GetOutput()).group(1))
+        self.assertTrue(self.get_stat("Reads from the process") < 16 * 1024 / line_size)
+
+        self.runCmd("process cache clear")
+        self.expect("process cache stats",
+            substrs = ['Cached lines: 0 of', 'Hits: 0, misses: 0'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,62 @@
+"""
+Test that breakpoints and variables in split DWARF .dwo files are found.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SplitDWARFTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # -gsplit-dwarf makes .dwo files for ELF only.
+    @skipIfWindows
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test breaking on functions that are defined in a .dwo file."""
+        self.buildDwarf()
+        self.split_dwarf()
+
+    def split_dwarf(self):
+        """Test breaking on functions that are defined in a .dwo file."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.assertTrue(os.path.isfile(os.path.join(os.getcwd(), "foo.dwo")), "foo.dwo was built")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # Break by name, then by regular expression, on functions that only
+        # the .dwo file describes.
+        lldbutil.run_break_set_by_symbol (self, "foo_split", num_expected_locations=1, module_name="a.out")
+        lldbutil.run_break_set_by_regexp (self, "^foo_split_re", num_expected_locations=1)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint (breakpoint #2).
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'a.out`foo_split_regex',
+                       'stop reason = breakpoint'])
+
+        self.runCmd("continue")
+
+        # The stop reason of the thread should be breakpoint (breakpoint #1).
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'a.out`foo_split',
+                       'stop reason = breakpoint'])
+
+        # The line table, the parameters and the globals come from foo.dwo.
+        self.expect("frame select", substrs = ['foo.c'])
+        self.expect("frame variable value", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) value = 21'])
+        self.expect("target variable g_foo_calls", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) g_foo_calls = 1'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
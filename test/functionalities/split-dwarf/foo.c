@@ -0,0 +1,24 @@
+//===-- foo.c ---------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Only the foo.dwo file has the debug information for this file.
+int g_foo_calls = 0;
+
+int
+foo_split (int value)
+{
+    ++g_foo_calls;
+    return value * 2; // Set break point at this line.
+}
+
+int
+foo_split_regex (int value)
+{
+    return foo_split (value) + 1;
+}
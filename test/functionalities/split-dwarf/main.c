@@ -0,0 +1,20 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int foo_split (int value);
+int foo_split_regex (int value);
+
+int
+main (int argc, char const *argv[])
+{
+    int result = foo_split_regex (argc + 20);
+    printf ("result = %d\n", result);
+    return 0;
+}
@@ -476,6 +476,18 @@ class TargetAPITestCase(TestBase):
         self.assertTrue(desc1 and desc2 and desc1 == desc2,
                         "The two addresses should resolve to the same symbol")
 
+        # Resolve both addresses, and one that isn't in any module, at once.
+        load_addrs = [address2.GetLoadAddress(target),
+                      lldb.LLDB_INVALID_ADDRESS,
+                      address1.GetLoadAddress(target)]
+        contexts = target.ResolveSymbolContextsForLoadAddresses(load_addrs, lldb.eSymbolContextEverything)
+        self.assertTrue(contexts.GetSize() == 3)
+        self.assertTrue(get_description(contexts.GetContextAtIndex(0).GetSymbol()) == desc2)
+        self.assertTrue(contexts.GetContextAtIndex(0).GetLineEntry().GetLine() == self.line2)
+        self.assertFalse(contexts.GetContextAtIndex(1).GetModule().IsValid())
+        self.assertTrue(contexts.GetContextAtIndex(2).GetLineEntry().GetLine() == self.line1)
+        self.assertTrue(contexts.GetContextAtIndex(2).GetFunction().GetName() == 'a')
+
         
 if __name__ == '__main__':
     import atexit
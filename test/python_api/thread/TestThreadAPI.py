@@ -42,6 +42,21 @@ class ThreadAPITestCase(TestBase):
         self.buildDwarf()
         self.get_stop_description()
 
+    @skipUnlessDarwin
+    @python_api_test
+    @dsym_test
+    def test_get_raw_backtrace_with_dsym(self):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        self.buildDsym()
+        self.get_raw_backtrace()
+
+    @python_api_test
+    @dwarf_test
+    def test_get_raw_backtrace_with_dwarf(self):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        self.buildDwarf()
+        self.get_raw_backtrace()
+
     @skipUnlessDarwin
     @python_api_test
     @dsym_test
@@ -166,6 +181,36 @@ class ThreadAPITestCase(TestBase):
         self.expect(stop_description, exe=False,
             startstr = 'breakpoint')
 
+    def get_raw_backtrace(self):
+        """Test Python SBThread.GetRawBacktrace() API."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation("main.cpp", self.break_line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        # Launch the process, and do not stop at the entry point.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+
+        # Due to the typemap magic (see lldb.swig), we pass in the most frames
+        # we want and get a Python list of pcs back.
+        pcs = thread.GetRawBacktrace(100)
+        self.assertTrue(len(pcs) >= 2, "There should be main() and its caller")
+        self.assertTrue(len(thread.GetRawBacktrace(1)) == 1)
+
+        # The pcs are those of the frames, main() and where it was called from.
+        self.assertTrue(pcs[0] == thread.GetFrameAtIndex(0).GetPC())
+        self.assertTrue(pcs[1] == thread.GetFrameAtIndex(1).GetPC())
+
+        self.expect("thread backtrace --raw",
+            substrs = ["frame #0: 0x%16.16x" % pcs[0],
+                       "frame #1: 0x%16.16x" % pcs[1]])
+
     def step_out_of_malloc_into_function_b(self, exe_name):
         """Test Python SBThread.StepOut() API to step out of a malloc call where the call site is at function b()."""
         exe = os.path.join(os.getcwd(), exe_name)
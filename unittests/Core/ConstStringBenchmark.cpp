@@ -0,0 +1,81 @@
+//===-- ConstStringBenchmark.cpp --------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ConstString.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    // Interns all of the strings using num_threads threads, each taking an
+    // equal slice, and returns the number of strings interned per second.
+    double
+    InternStrings (const std::vector<std::string> &strings, size_t num_threads)
+    {
+        const size_t slice_size = (strings.size() + num_threads - 1) / num_threads;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back ([t, slice_size, &strings]() {
+                const size_t begin = std::min (t * slice_size, strings.size());
+                const size_t end = std::min (begin + slice_size, strings.size());
+                for (size_t i = begin; i < end; ++i)
+                    ConstString (strings[i].c_str());
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return strings.size() / elapsed.count();
+    }
+}
+
+// Reports how many strings per second ConstString interns for a range of
+// thread counts, both for strings that are new to the pool and for strings
+// that are already in it. The total amount of work is the same for every
+// thread count. This is a benchmark rather than a test, so it is disabled by
+// default; run it with:
+//
+//   CoreTests --gtest_filter=ConstStringBenchmark.* --gtest_also_run_disabled_tests
+TEST (ConstStringBenchmark, DISABLED_InternThroughput)
+{
+    const size_t num_strings = 1000000;
+    const size_t max_threads = std::max<size_t> (std::thread::hardware_concurrency(), 8);
+
+    printf ("%8s %20s %20s\n", "threads", "new strings/s", "pooled strings/s");
+    for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+    {
+        // The pool never lets go of a string, so every round needs its own
+        // set of strings to measure insertion.
+        std::vector<std::string> strings;
+        strings.reserve (num_strings);
+        for (size_t i = 0; i < num_strings; ++i)
+            strings.push_back ("ConstStringBenchmark::" + std::to_string (num_threads) + "::" + std::to_string (i));
+        // Numbered strings that are interned in order have neighbouring hash
+        // values, which flatters a single hash table. Real symbol names don't.
+        std::shuffle (strings.begin(), strings.end(), std::mt19937 (num_threads));
+
+        const double new_rate = InternStrings (strings, num_threads);
+        const double pooled_rate = InternStrings (strings, num_threads);
+        printf ("%8zu %20.0f %20.0f\n", num_threads, new_rate, pooled_rate);
+    }
+}
@@ -0,0 +1,98 @@
+//===-- ConstStringTest.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ConstString.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+TEST (ConstStringTest, Uniquing)
+{
+    std::string foo ("foo");
+    ConstString foo1 ("foo");
+    ConstString foo2 (foo.c_str());
+    ConstString foobar ("foobar", 3);
+
+    ASSERT_EQ (foo1.GetCString(), foo2.GetCString());
+    ASSERT_EQ (foo1.GetCString(), foobar.GetCString());
+    ASSERT_EQ (3u, foo1.GetLength());
+    ASSERT_NE (foo1.GetCString(), ConstString ("bar").GetCString());
+}
+
+TEST (ConstStringTest, MangledCounterpart)
+{
+    ConstString mangled ("_ZN3foo3barEv");
+    ConstString demangled;
+    demangled.SetCStringWithMangledCounterpart ("foo::bar()", mangled);
+    ASSERT_STREQ ("foo::bar()", demangled.GetCString());
+
+    ConstString counterpart;
+    ASSERT_TRUE (mangled.GetMangledCounterpart (counterpart));
+    ASSERT_EQ (demangled.GetCString(), counterpart.GetCString());
+
+    ASSERT_TRUE (demangled.GetMangledCounterpart (counterpart));
+    ASSERT_EQ (mangled.GetCString(), counterpart.GetCString());
+}
+
+// Interns the same set of strings from several threads at once and checks
+// that every thread got the same unique pointers.
+TEST (ConstStringTest, ParallelIntern)
+{
+    const size_t num_strings = 50000;
+    const size_t num_threads = std::max<size_t> (std::thread::hardware_concurrency(), 2);
+
+    std::vector<std::string> strings;
+    strings.reserve (num_strings);
+    for (size_t i = 0; i < num_strings; ++i)
+        strings.push_back ("ConstStringTest::ParallelIntern::" + std::to_string (i));
+
+    std::vector<std::vector<const char *>> results (num_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back ([t, &strings, &results]() {
+            std::vector<const char *> &result = results[t];
+            result.reserve (strings.size());
+            // Walk the strings from a different starting point in every
+            // thread so that new strings get added concurrently too.
+            for (size_t i = 0; i < strings.size(); ++i)
+                result.push_back (ConstString (strings[(i + t * 997) % strings.size()].c_str()).GetCString());
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+        for (size_t i = 0; i < num_strings; ++i)
+        {
+            const size_t string_idx = (i + t * 997) % num_strings;
+            ASSERT_STREQ (strings[string_idx].c_str(), results[t][i]);
+        }
+    }
+
+    // Every thread must have ended up with the same pointer for a string.
+    std::vector<const char *> unique_ptrs (num_strings, nullptr);
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+        for (size_t i = 0; i < num_strings; ++i)
+        {
+            const size_t string_idx = (i + t * 997) % num_strings;
+            if (unique_ptrs[string_idx] == nullptr)
+                unique_ptrs[string_idx] = results[t][i];
+            ASSERT_EQ (unique_ptrs[string_idx], results[t][i]);
+        }
+    }
+}
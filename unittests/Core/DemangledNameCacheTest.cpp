@@ -0,0 +1,139 @@
+//===-- DemangledNameCacheTest.cpp ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/DemangledNameCache.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Host/FileSpec.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    class DemangledNameCacheTest : public ::testing::Test
+    {
+    protected:
+        void
+        SetUp () override
+        {
+            llvm::SmallString<128> path;
+            ASSERT_FALSE (llvm::sys::fs::createUniqueDirectory ("DemangledNameCacheTest", path));
+            m_cache_dir = path.str().str();
+        }
+
+        void
+        TearDown () override
+        {
+            FileSpec cache_file (DemangledNameCache (GetCacheDir(), 0).GetCacheFileSpec());
+            llvm::sys::fs::remove (cache_file.GetPath());
+            llvm::sys::fs::remove (m_cache_dir);
+        }
+
+        FileSpec
+        GetCacheDir () const
+        {
+            return FileSpec (m_cache_dir.c_str(), false);
+        }
+
+        std::string m_cache_dir;
+    };
+}
+
+TEST_F (DemangledNameCacheTest, SharedBetweenSessions)
+{
+    ConstString mangled ("_ZN3foo3barEv");
+    ConstString not_demangled ("_Zfoo");
+    {
+        DemangledNameCache cache (GetCacheDir(), 1024 * 1024);
+        ASSERT_EQ (nullptr, cache.Lookup (mangled));
+        cache.Insert (mangled, ConstString ("foo::bar()"));
+        cache.Insert (not_demangled, ConstString ());
+        ASSERT_TRUE (cache.Flush().Success());
+    }
+
+    DemangledNameCache cache (GetCacheDir(), 1024 * 1024);
+    ASSERT_STREQ ("foo::bar()", cache.Lookup (mangled));
+    ASSERT_STREQ ("", cache.Lookup (not_demangled));
+    ASSERT_EQ (nullptr, cache.Lookup (ConstString ("_ZN3foo3bazEv")));
+}
+
+TEST_F (DemangledNameCacheTest, SizeLimit)
+{
+    const uint64_t max_byte_size = 4096;
+    for (int session = 0; session < 10; ++session)
+    {
+        DemangledNameCache cache (GetCacheDir(), max_byte_size);
+        for (int i = 0; i < 20; ++i)
+        {
+            char mangled[64];
+            char demangled[64];
+            ::snprintf (mangled, sizeof (mangled), "_ZN3foo5bar%02d%02dEv", session, i);
+            ::snprintf (demangled, sizeof (demangled), "foo::bar%02d%02d()", session, i);
+            cache.Insert (ConstString (mangled), ConstString (demangled));
+        }
+        ASSERT_TRUE (cache.Flush().Success());
+        ASSERT_LE (cache.GetCacheFileSpec().GetByteSize(), max_byte_size);
+    }
+
+    // The names added last must have survived.
+    DemangledNameCache cache (GetCacheDir(), max_byte_size);
+    ASSERT_STREQ ("foo::bar0919()", cache.Lookup (ConstString ("_ZN3foo5bar0919Ev")));
+    ASSERT_EQ (nullptr, cache.Lookup (ConstString ("_ZN3foo5bar0000Ev")));
+}
+
+TEST_F (DemangledNameCacheTest, ParallelInsert)
+{
+    // Enough names that every thread triggers writes of its own while the
+    // others keep inserting.
+    const int num_threads = 4;
+    const int num_names = 5000;
+    {
+        DemangledNameCache cache (GetCacheDir(), 64 * 1024 * 1024);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back ([t, &cache]() {
+                for (int i = 0; i < num_names; ++i)
+                {
+                    char mangled[64];
+                    char demangled[64];
+                    ::snprintf (mangled, sizeof (mangled), "_ZN3foo12parallel%d%04dEv", t, i);
+                    ::snprintf (demangled, sizeof (demangled), "foo::parallel%d%04d()", t, i);
+                    cache.Insert (ConstString (mangled), ConstString (demangled));
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+        ASSERT_TRUE (cache.Flush().Success());
+    }
+
+    DemangledNameCache cache (GetCacheDir(), 64 * 1024 * 1024);
+    for (int t = 0; t < num_threads; ++t)
+    {
+        for (int i = 0; i < num_names; ++i)
+        {
+            char mangled[64];
+            char demangled[64];
+            ::snprintf (mangled, sizeof (mangled), "_ZN3foo12parallel%d%04dEv", t, i);
+            ::snprintf (demangled, sizeof (demangled), "foo::parallel%d%04d()", t, i);
+            ASSERT_STREQ (demangled, cache.Lookup (ConstString (mangled)));
+        }
+    }
+}
@@ -0,0 +1,252 @@
+//===-- GDBRemoteCommunicationClientTest.cpp --------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/StreamGDBRemote.h"
+#include "lldb/Host/ConnectionFileDescriptor.h"
+#include "lldb/Host/Predicate.h"
+#include "lldb/Host/Socket.h"
+
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationClient.h"
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationServer.h"
+#include "Utility/StringExtractorGDBRemote.h"
+
+using namespace lldb_private;
+using namespace lldb_private::process_gdb_remote;
+
+namespace
+{
+    const uint32_t g_timeout_usec = 5 * 1000 * 1000;
+
+    // A client that is already in no ACK mode, so packets can be pipelined.
+    class TestClient : public GDBRemoteCommunicationClient
+    {
+    public:
+        TestClient ()
+        {
+            m_send_acks = false;
+        }
+
+        void
+        EnableCompression ()
+        {
+            m_recv_compression_type = CompressionType::Zlib;
+        }
+    };
+
+    // A stub that sends whatever replies the test tells it to.
+    class MockServer : public GDBRemoteCommunicationServer
+    {
+    public:
+        MockServer () :
+            GDBRemoteCommunicationServer ("mock-server", "mock-server.listener")
+        {
+            m_send_acks = false;
+        }
+
+        bool
+        GetThreadSuffixSupported () override
+        {
+            return false;
+        }
+
+        PacketResult
+        SendPacket (const char *payload)
+        {
+            return SendPacketNoLock (payload, ::strlen (payload));
+        }
+
+        PacketResult
+        SendPacket (const char *payload, size_t payload_length)
+        {
+            return SendPacketNoLock (payload, payload_length);
+        }
+
+        void
+        EnableCompression ()
+        {
+            m_send_compression_type = CompressionType::Zlib;
+        }
+
+        uint64_t
+        GetCompressedBytesOut () const
+        {
+            return m_compression_bytes_out;
+        }
+
+        PacketResult
+        GetPacket (StringExtractorGDBRemote &packet)
+        {
+            return WaitForPacketWithTimeoutMicroSecondsNoLock (packet, g_timeout_usec);
+        }
+    };
+
+    void
+    AcceptThread (Socket *listen_socket, const char *listen_remote_address, Socket **accept_socket, Error *error)
+    {
+        *error = listen_socket->BlockingAccept (listen_remote_address, false, *accept_socket);
+    }
+
+    class GDBRemoteCommunicationClientTest : public ::testing::Test
+    {
+    protected:
+        void
+        SetUp () override
+        {
+            Predicate<uint16_t> port_predicate;
+            port_predicate.SetValue (0, eBroadcastNever);
+
+            const char *listen_remote_address = "localhost:0";
+            Socket *socket = nullptr;
+            Error error = Socket::TcpListen (listen_remote_address, false, socket, &port_predicate);
+            std::unique_ptr<Socket> listen_socket_up (socket);
+            ASSERT_TRUE (error.Success ());
+
+            Error accept_error;
+            Socket *accept_socket = nullptr;
+            std::thread accept_thread (AcceptThread, listen_socket_up.get (), listen_remote_address, &accept_socket, &accept_error);
+
+            char connect_remote_address[64];
+            snprintf (connect_remote_address, sizeof(connect_remote_address), "localhost:%u", port_predicate.GetValue ());
+            socket = nullptr;
+            error = Socket::TcpConnect (connect_remote_address, false, socket);
+            accept_thread.join ();
+            ASSERT_TRUE (error.Success ());
+            ASSERT_TRUE (accept_error.Success ());
+
+            m_client.SetConnection (new ConnectionFileDescriptor (socket));
+            m_server.SetConnection (new ConnectionFileDescriptor (accept_socket));
+            m_client.SetPacketTimeout (1);
+        }
+
+        void
+        TearDown () override
+        {
+            m_client.Disconnect ();
+            m_server.Disconnect ();
+        }
+
+        // Read the packets of one window on the server side and answer
+        // only the first one.
+        void
+        ReceiveWindowAndAnswerFirst (const std::vector<std::string> &payloads)
+        {
+            for (const std::string &payload : payloads)
+            {
+                StringExtractorGDBRemote packet;
+                ASSERT_EQ (GDBRemoteCommunication::PacketResult::Success, m_server.GetPacket (packet));
+                ASSERT_EQ (payload, packet.GetStringRef ());
+            }
+            ASSERT_EQ (GDBRemoteCommunication::PacketResult::Success, m_server.SendPacket ("00112233"));
+        }
+
+        TestClient m_client;
+        MockServer m_server;
+    };
+}
+
+TEST_F (GDBRemoteCommunicationClientTest, LateRepliesInWindowAreDropped)
+{
+    const std::vector<std::string> payloads = { "m1000,4", "m1004,4", "m1008,4" };
+
+    // The replies to the second and third packet show up after the client
+    // gave up waiting for them.
+    std::thread server_thread ([this, &payloads]() {
+        ReceiveWindowAndAnswerFirst (payloads);
+        std::this_thread::sleep_for (std::chrono::milliseconds (1500));
+        m_server.SendPacket ("44556677");
+        m_server.SendPacket ("8899aabb");
+
+        StringExtractorGDBRemote packet;
+        ASSERT_EQ (GDBRemoteCommunication::PacketResult::Success, m_server.GetPacket (packet));
+        ASSERT_EQ ("qC", packet.GetStringRef ());
+        m_server.SendPacket ("QC1234");
+    });
+
+    std::vector<StringExtractorGDBRemote> responses;
+    EXPECT_EQ (GDBRemoteCommunication::PacketResult::ErrorReplyTimeout,
+               m_client.SendPacketsAndWaitForResponses (payloads, responses, 3));
+
+    // The next packet must get its own reply, not a late one.
+    StringExtractorGDBRemote response;
+    EXPECT_EQ (GDBRemoteCommunication::PacketResult::Success,
+               m_client.SendPacketAndWaitForResponse ("qC", response, false));
+    server_thread.join ();
+
+    ASSERT_EQ (1u, responses.size ());
+    ASSERT_EQ ("00112233", responses[0].GetStringRef ());
+    ASSERT_EQ ("QC1234", response.GetStringRef ());
+    ASSERT_TRUE (m_client.IsConnected ());
+}
+
+TEST_F (GDBRemoteCommunicationClientTest, MissingRepliesInWindowDisconnect)
+{
+    const std::vector<std::string> payloads = { "m1000,4", "m1004,4", "m1008,4" };
+
+    // The replies to the second and third packet never show up.
+    std::thread server_thread ([this, &payloads]() {
+        ReceiveWindowAndAnswerFirst (payloads);
+        // Returns once the client closes the connection.
+        StringExtractorGDBRemote packet;
+        m_server.GetPacket (packet);
+    });
+
+    std::vector<StringExtractorGDBRemote> responses;
+    EXPECT_EQ (GDBRemoteCommunication::PacketResult::ErrorReplyTimeout,
+               m_client.SendPacketsAndWaitForResponses (payloads, responses, 3));
+    server_thread.join ();
+    ASSERT_EQ (1u, responses.size ());
+    ASSERT_FALSE (m_client.IsConnected ());
+}
+
+TEST_F (GDBRemoteCommunicationClientTest, CompressedBinaryMemoryRead)
+{
+    // Memory with every byte that the binary "x" reply has to escape
+    std::string memory;
+    for (int i = 0; i < 64; ++i)
+    {
+        memory.push_back ('\x23');
+        memory.push_back ('\x24');
+        memory.push_back ('\x2a');
+        memory.push_back ('\x7d');
+        memory.push_back ((char)i);
+    }
+
+    m_client.EnableCompression ();
+    m_server.EnableCompression ();
+
+    std::thread server_thread ([this, &memory]() {
+        StringExtractorGDBRemote packet;
+        ASSERT_EQ (GDBRemoteCommunication::PacketResult::Success, m_server.GetPacket (packet));
+        ASSERT_EQ ("x1000,140", packet.GetStringRef ());
+
+        StreamGDBRemote reply;
+        reply.PutEscapedBytes (memory.data (), memory.size ());
+        ASSERT_EQ (GDBRemoteCommunication::PacketResult::Success,
+                   m_server.SendPacket (reply.GetData (), reply.GetSize ()));
+    });
+
+    StringExtractorGDBRemote response;
+    EXPECT_EQ (GDBRemoteCommunication::PacketResult::Success,
+               m_client.SendPacketAndWaitForResponse ("x1000,140", response, false));
+    server_thread.join ();
+
+    // The reply was big enough to be compressed, and reads back as the
+    // memory it was made from.
+    ASSERT_LT (0u, m_server.GetCompressedBytesOut ());
+    ASSERT_EQ (memory, response.GetStringRef ());
+}
@@ -0,0 +1,133 @@
+//===-- DWARFAddressIndexTest.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DWARFAddressIndex.h"
+
+#include <vector>
+
+namespace
+{
+    // A compile unit at 0x10 with ranges [0x1000, 0x1100) and
+    // [0x2000, 0x2100), and a function at 0x40 covering [0x1000, 0x1080)
+    // with a lexical block at 0x60 covering [0x1010, 0x1040) and an
+    // inlined function at 0x80 inside the block covering [0x1020, 0x1030)
+    const dw_offset_t kCU = 0x10;
+    const dw_offset_t kFunction = 0x40;
+    const dw_offset_t kBlock = 0x60;
+    const dw_offset_t kInlined = 0x80;
+
+    void
+    MakeIndex (DWARFAddressIndex &index)
+    {
+        // Deliberately not appended in address or depth order
+        index.Append (0x1020, 0x1030, 3, DWARFAddressIndex::Entry (kCU, kFunction, kInlined));
+        index.Append (0x1000, 0x1080, 1, DWARFAddressIndex::Entry (kCU, kFunction, DW_INVALID_OFFSET));
+        index.Append (0x2000, 0x2100, 0, DWARFAddressIndex::Entry (kCU, DW_INVALID_OFFSET, DW_INVALID_OFFSET));
+        index.Append (0x1010, 0x1040, 2, DWARFAddressIndex::Entry (kCU, kFunction, kBlock));
+        index.Append (0x1000, 0x1100, 0, DWARFAddressIndex::Entry (kCU, DW_INVALID_OFFSET, DW_INVALID_OFFSET));
+        index.Finalize();
+    }
+
+    dw_offset_t
+    FunctionAt (const DWARFAddressIndex &index, dw_addr_t address)
+    {
+        const DWARFAddressIndex::Entry *entry = index.FindAddress (address);
+        return entry ? entry->function_offset : DW_INVALID_OFFSET;
+    }
+
+    dw_offset_t
+    BlockAt (const DWARFAddressIndex &index, dw_addr_t address)
+    {
+        const DWARFAddressIndex::Entry *entry = index.FindAddress (address);
+        return entry ? entry->block_offset : DW_INVALID_OFFSET;
+    }
+}
+
+TEST (DWARFAddressIndexTest, FindAddress)
+{
+    DWARFAddressIndex index;
+    MakeIndex (index);
+
+    ASSERT_EQ (nullptr, index.FindAddress (0xfff));
+    ASSERT_EQ (nullptr, index.FindAddress (0x1100));
+    ASSERT_EQ (nullptr, index.FindAddress (0x1fff));
+    ASSERT_EQ (nullptr, index.FindAddress (0x2100));
+
+    ASSERT_EQ (kFunction, FunctionAt (index, 0x1000));
+    ASSERT_EQ (DW_INVALID_OFFSET, BlockAt (index, 0x1000));
+    ASSERT_EQ (kBlock, BlockAt (index, 0x1010));
+    ASSERT_EQ (kInlined, BlockAt (index, 0x1020));
+    ASSERT_EQ (kInlined, BlockAt (index, 0x102f));
+    ASSERT_EQ (kBlock, BlockAt (index, 0x1030));
+    ASSERT_EQ (DW_INVALID_OFFSET, BlockAt (index, 0x1040));
+    ASSERT_EQ (kFunction, FunctionAt (index, 0x107f));
+
+    // Inside the compile unit but not in any function
+    ASSERT_EQ (DW_INVALID_OFFSET, FunctionAt (index, 0x1080));
+    ASSERT_EQ (kCU, index.FindAddress (0x1080)->cu_offset);
+    ASSERT_EQ (kCU, index.FindAddress (0x20ff)->cu_offset);
+
+    // [0x1000-0x1010) [0x1010-0x1020) [0x1020-0x1030) [0x1030-0x1040)
+    // [0x1040-0x1080) [0x1080-0x1100) [0x2000-0x2100)
+    ASSERT_EQ (7u, index.GetNumSegments());
+}
+
+TEST (DWARFAddressIndexTest, Coalesce)
+{
+    // Adjacent ranges of the same function are merged, as are ones
+    // separated by a range that doesn't change what is found
+    DWARFAddressIndex index;
+    const DWARFAddressIndex::Entry function (kCU, kFunction, DW_INVALID_OFFSET);
+    index.Append (0x1000, 0x1010, 1, function);
+    index.Append (0x1010, 0x1020, 1, function);
+    index.Append (0x1000, 0x1020, 0, DWARFAddressIndex::Entry (kCU, DW_INVALID_OFFSET, DW_INVALID_OFFSET));
+    index.Finalize();
+    ASSERT_EQ (1u, index.GetNumSegments());
+    ASSERT_EQ (kFunction, FunctionAt (index, 0x101f));
+}
+
+TEST (DWARFAddressIndexTest, FindAddresses)
+{
+    DWARFAddressIndex index;
+    MakeIndex (index);
+
+    std::vector<dw_addr_t> addresses;
+    addresses.push_back (0x10);
+    addresses.push_back (0x1000);
+    addresses.push_back (0x1025);
+    addresses.push_back (0x1025);
+    addresses.push_back (0x1090);
+    addresses.push_back (0x1800);
+    addresses.push_back (0x2000);
+    addresses.push_back (0x3000);
+    // Out of order addresses are still found
+    addresses.push_back (0x1035);
+
+    std::vector<const DWARFAddressIndex::Entry *> entries;
+    ASSERT_EQ (6u, index.FindAddresses (addresses, entries));
+    ASSERT_EQ (addresses.size(), entries.size());
+    for (size_t i = 0; i < addresses.size(); ++i)
+        ASSERT_EQ (index.FindAddress (addresses[i]), entries[i]);
+}
+
+TEST (DWARFAddressIndexTest, Empty)
+{
+    DWARFAddressIndex index;
+    index.Append (0x1000, 0x1000, 0, DWARFAddressIndex::Entry (kCU, DW_INVALID_OFFSET, DW_INVALID_OFFSET));
+    index.Finalize();
+    ASSERT_TRUE (index.IsEmpty());
+    ASSERT_EQ (nullptr, index.FindAddress (0x1000));
+
+    std::vector<dw_addr_t> addresses (1, 0x1000);
+    std::vector<const DWARFAddressIndex::Entry *> entries;
+    ASSERT_EQ (0u, index.FindAddresses (addresses, entries));
+    ASSERT_EQ (nullptr, entries[0]);
+}
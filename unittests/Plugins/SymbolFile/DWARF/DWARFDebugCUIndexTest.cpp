@@ -0,0 +1,127 @@
+//===-- DWARFDebugCUIndexTest.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DWARFDebugCUIndex.h"
+
+#include <vector>
+
+namespace
+{
+    void
+    PutU32 (std::vector<uint8_t> &bytes, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            bytes.push_back ((uint8_t)(value >> (i * 8)));
+    }
+
+    void
+    PutU64 (std::vector<uint8_t> &bytes, uint64_t value)
+    {
+        PutU32 (bytes, (uint32_t)value);
+        PutU32 (bytes, (uint32_t)(value >> 32));
+    }
+
+    // A package of two compile units with .debug_info, .debug_abbrev
+    // and .debug_str_offsets contributions, in a four slot hash table.
+    // Both dwo ids hash to slot 1 so the second one is probed for, and
+    // found, in slot 0.
+    const uint64_t kFirstDwoId = 0x0000000100000001ull;
+    const uint64_t kSecondDwoId = 0x0000000200000005ull;
+
+    std::vector<uint8_t>
+    MakeIndex (uint32_t version)
+    {
+        std::vector<uint8_t> bytes;
+        PutU32 (bytes, version);
+        PutU32 (bytes, 3);      // Columns
+        PutU32 (bytes, 2);      // Units
+        PutU32 (bytes, 4);      // Slots
+
+        PutU64 (bytes, kSecondDwoId);
+        PutU64 (bytes, kFirstDwoId);
+        PutU64 (bytes, 0);
+        PutU64 (bytes, 0);
+        PutU32 (bytes, 2);
+        PutU32 (bytes, 1);
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 0);
+
+        PutU32 (bytes, DWARFDebugCUIndex::eSectionInfo);
+        PutU32 (bytes, DWARFDebugCUIndex::eSectionAbbrev);
+        PutU32 (bytes, DWARFDebugCUIndex::eSectionStrOffsets);
+
+        // Offsets
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 0x40);
+        PutU32 (bytes, 0x20);
+        PutU32 (bytes, 0x10);
+
+        // Sizes
+        PutU32 (bytes, 0x40);
+        PutU32 (bytes, 0x20);
+        PutU32 (bytes, 0x10);
+        PutU32 (bytes, 0x80);
+        PutU32 (bytes, 0x30);
+        PutU32 (bytes, 0x18);
+        return bytes;
+    }
+
+    bool
+    ExtractIndex (DWARFDebugCUIndex &index, const std::vector<uint8_t> &bytes)
+    {
+        lldb_private::DWARFDataExtractor data;
+        data.SetData (bytes.data(), bytes.size(), lldb::eByteOrderLittle);
+        data.SetAddressByteSize (8);
+        return index.Extract (data);
+    }
+}
+
+TEST (DWARFDebugCUIndexTest, FindUnit)
+{
+    const std::vector<uint8_t> bytes (MakeIndex (2));
+    DWARFDebugCUIndex index;
+    ASSERT_TRUE (ExtractIndex (index, bytes));
+
+    DWARFDebugCUIndex::Contributions contributions;
+    ASSERT_TRUE (index.FindUnit (kFirstDwoId, contributions));
+    ASSERT_EQ (0u, contributions[DWARFDebugCUIndex::eSectionInfo].offset);
+    ASSERT_EQ (0x40u, contributions[DWARFDebugCUIndex::eSectionInfo].size);
+
+    ASSERT_TRUE (index.FindUnit (kSecondDwoId, contributions));
+    ASSERT_EQ (0x40u, contributions[DWARFDebugCUIndex::eSectionInfo].offset);
+    ASSERT_EQ (0x80u, contributions[DWARFDebugCUIndex::eSectionInfo].size);
+    ASSERT_EQ (0x20u, contributions[DWARFDebugCUIndex::eSectionAbbrev].offset);
+    ASSERT_EQ (0x30u, contributions[DWARFDebugCUIndex::eSectionAbbrev].size);
+    ASSERT_EQ (0x10u, contributions[DWARFDebugCUIndex::eSectionStrOffsets].offset);
+    ASSERT_EQ (0x18u, contributions[DWARFDebugCUIndex::eSectionStrOffsets].size);
+
+    // Sections the unit doesn't contribute to are empty
+    ASSERT_EQ (0u, contributions[DWARFDebugCUIndex::eSectionLine].size);
+
+    ASSERT_FALSE (index.FindUnit (0x0000000300000001ull, contributions));
+    ASSERT_FALSE (index.FindUnit (2, contributions));
+}
+
+TEST (DWARFDebugCUIndexTest, Malformed)
+{
+    DWARFDebugCUIndex index;
+    ASSERT_FALSE (ExtractIndex (index, MakeIndex (1)));
+    ASSERT_FALSE (index.IsValid());
+
+    std::vector<uint8_t> truncated (MakeIndex (2));
+    truncated.resize (truncated.size() - 4);
+    ASSERT_FALSE (ExtractIndex (index, truncated));
+
+    DWARFDebugCUIndex::Contributions contributions;
+    ASSERT_FALSE (index.FindUnit (kFirstDwoId, contributions));
+}
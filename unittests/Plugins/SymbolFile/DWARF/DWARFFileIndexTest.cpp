@@ -0,0 +1,82 @@
+//===-- DWARFFileIndexTest.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DWARFFileIndex.h"
+
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    // Compile unit 0 is main.c and includes util.h twice, compile unit
+    // 1 is util.c and includes util.h, and compile unit 2 is other.c
+    void
+    MakeIndex (DWARFFileIndex &index)
+    {
+        DWARFFileIndex cu_index;
+        cu_index.Append (ConstString("util.c"), 1, 0);
+        cu_index.Append (ConstString("util.h"), 1, 1);
+        index.Append (cu_index);
+
+        index.Append (ConstString("main.c"), 0, 0);
+        index.Append (ConstString("main.c"), 0, 1);
+        index.Append (ConstString("util.h"), 0, 4);
+        index.Append (ConstString("util.h"), 0, 2);
+        index.Append (ConstString("other.c"), 2, 0);
+        index.Append (ConstString(), 2, 1);
+        index.Finalize();
+    }
+}
+
+TEST (DWARFFileIndexTest, Find)
+{
+    DWARFFileIndex index;
+    MakeIndex (index);
+    ASSERT_EQ (5u, index.GetSize());
+
+    std::vector<DWARFFileIndex::Entry> entries;
+    ASSERT_EQ (0u, index.Find (ConstString("missing.c"), entries));
+    ASSERT_EQ (0u, index.Find (ConstString(), entries));
+
+    // The lowest file index of each compile unit is kept
+    ASSERT_EQ (2u, index.Find (ConstString("util.h"), entries));
+    ASSERT_EQ (0u, entries[0].cu_idx);
+    ASSERT_EQ (2u, entries[0].file_idx);
+    ASSERT_EQ (1u, entries[1].cu_idx);
+    ASSERT_EQ (1u, entries[1].file_idx);
+
+    // Found entries are appended
+    ASSERT_EQ (1u, index.Find (ConstString("main.c"), entries));
+    ASSERT_EQ (3u, entries.size());
+    ASSERT_EQ (0u, entries[2].cu_idx);
+    ASSERT_EQ (0u, entries[2].file_idx);
+}
+
+TEST (DWARFFileIndexTest, Unindexed)
+{
+    DWARFFileIndex index;
+    index.AppendUnindexed (1);
+    MakeIndex (index);
+    ASSERT_EQ (1u, index.GetNumUnindexed());
+
+    // Unindexed compile units match every name in compile unit order
+    std::vector<DWARFFileIndex::Entry> entries;
+    ASSERT_EQ (1u, index.Find (ConstString("missing.c"), entries));
+    ASSERT_EQ (1u, entries[0].cu_idx);
+    ASSERT_EQ (0u, entries[0].file_idx);
+
+    entries.clear();
+    ASSERT_EQ (2u, index.Find (ConstString("other.c"), entries));
+    ASSERT_EQ (1u, entries[0].cu_idx);
+    ASSERT_EQ (0u, entries[0].file_idx);
+    ASSERT_EQ (2u, entries[1].cu_idx);
+}
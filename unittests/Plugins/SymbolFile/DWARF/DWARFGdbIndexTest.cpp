@@ -0,0 +1,135 @@
+//===-- DWARFGdbIndexTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ConstString.h"
+#include "Plugins/SymbolFile/DWARF/DWARFGdbIndex.h"
+
+#include <string.h>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    void
+    PutU32 (std::vector<uint8_t> &bytes, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            bytes.push_back ((uint8_t)(value >> (i * 8)));
+    }
+
+    void
+    PutU64 (std::vector<uint8_t> &bytes, uint64_t value)
+    {
+        PutU32 (bytes, (uint32_t)value);
+        PutU32 (bytes, (uint32_t)(value >> 32));
+    }
+
+    // A version 7 index of two compile units, at .debug_info offsets 0
+    // and 0x100, with a four slot symbol table. "ns::foo" is defined in
+    // the second compile unit and "main" in the first one and in a type
+    // unit.
+    std::vector<uint8_t>
+    MakeIndex (uint32_t version)
+    {
+        std::vector<uint8_t> bytes;
+        PutU32 (bytes, version);
+        PutU32 (bytes, 24);     // Compile unit list
+        PutU32 (bytes, 56);     // Type unit list
+        PutU32 (bytes, 56);     // Address area
+        PutU32 (bytes, 56);     // Symbol table
+        PutU32 (bytes, 88);     // Constant pool
+
+        PutU64 (bytes, 0);
+        PutU64 (bytes, 0x100);
+        PutU64 (bytes, 0x100);
+        PutU64 (bytes, 0x80);
+
+        PutU32 (bytes, 20);     // "ns::foo"
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 0);      // Empty
+        PutU32 (bytes, 0);
+        PutU32 (bytes, 28);     // "main"
+        PutU32 (bytes, 8);
+        PutU32 (bytes, 0);      // Empty
+        PutU32 (bytes, 0);
+
+        PutU32 (bytes, 1);
+        PutU32 (bytes, 0x30000001);
+        PutU32 (bytes, 2);
+        PutU32 (bytes, 0x30000000);
+        PutU32 (bytes, 0x90000005);
+        const char names[] = "ns::foo\0main";
+        bytes.insert (bytes.end(), names, names + sizeof (names));
+        return bytes;
+    }
+
+    bool
+    ExtractIndex (DWARFGdbIndex &index, const std::vector<uint8_t> &bytes)
+    {
+        DWARFDataExtractor data;
+        data.SetData (bytes.data(), bytes.size(), lldb::eByteOrderLittle);
+        data.SetAddressByteSize (8);
+        return index.Extract (data);
+    }
+}
+
+TEST (DWARFGdbIndexTest, FindCompileUnits)
+{
+    const std::vector<uint8_t> bytes (MakeIndex (7));
+    DWARFGdbIndex index;
+    ASSERT_TRUE (ExtractIndex (index, bytes));
+    ASSERT_EQ (7u, index.GetVersion());
+    ASSERT_EQ (2u, index.GetNumCompileUnits());
+    ASSERT_EQ (0u, index.GetCompileUnitOffset (0));
+    ASSERT_EQ (0x100u, index.GetCompileUnitOffset (1));
+
+    std::vector<uint32_t> cu_indexes;
+    ASSERT_EQ (1u, index.FindCompileUnits (ConstString ("ns::foo"), cu_indexes));
+    ASSERT_EQ (1u, cu_indexes[0]);
+
+    // Qualified names can be found by their last component too
+    cu_indexes.clear();
+    ASSERT_EQ (1u, index.FindCompileUnits (ConstString ("foo"), cu_indexes));
+    ASSERT_EQ (1u, cu_indexes[0]);
+
+    // Type units are skipped
+    cu_indexes.clear();
+    ASSERT_EQ (1u, index.FindCompileUnits (ConstString ("main"), cu_indexes));
+    ASSERT_EQ (0u, cu_indexes[0]);
+
+    cu_indexes.clear();
+    ASSERT_EQ (0u, index.FindCompileUnits (ConstString ("bar"), cu_indexes));
+}
+
+TEST (DWARFGdbIndexTest, UnsupportedVersion)
+{
+    DWARFGdbIndex index;
+    ASSERT_FALSE (ExtractIndex (index, MakeIndex (5)));
+    ASSERT_FALSE (index.IsValid());
+
+    std::vector<uint8_t> truncated (MakeIndex (7));
+    truncated.resize (60);
+    ASSERT_FALSE (ExtractIndex (index, truncated));
+}
+
+TEST (DWARFGdbIndexTest, Names)
+{
+    ASSERT_STREQ ("bar", DWARFGdbIndex::GetBaseName ("ns::foo<a::b>::bar"));
+    ASSERT_STREQ ("foo", DWARFGdbIndex::GetBaseName ("(anonymous namespace)::foo"));
+    ASSERT_EQ (nullptr, DWARFGdbIndex::GetBaseName ("foo<a::b>"));
+
+    ASSERT_TRUE (DWARFGdbIndex::CanLookupName (ConstString ("ns::foo")));
+    ASSERT_FALSE (DWARFGdbIndex::CanLookupName (ConstString ("_ZN2ns3fooEv")));
+    ASSERT_FALSE (DWARFGdbIndex::CanLookupName (ConstString ("ns::foo(int)")));
+    ASSERT_FALSE (DWARFGdbIndex::CanLookupName (ConstString ("-[NSObject init]")));
+    ASSERT_FALSE (DWARFGdbIndex::CanLookupName (ConstString ()));
+}
@@ -0,0 +1,217 @@
+//===-- DWARFIndexCacheTest.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Host/FileSpec.h"
+
+#include "Plugins/SymbolFile/DWARF/DWARFIndexCache.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    const uint8_t g_uuid_bytes[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                       0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+    class DWARFIndexCacheTest : public ::testing::Test
+    {
+    protected:
+        void
+        SetUp () override
+        {
+            llvm::SmallString<128> path;
+            ASSERT_FALSE (llvm::sys::fs::createUniqueDirectory ("DWARFIndexCacheTest", path));
+            m_cache_dir = path.str().str();
+
+            m_key.uuid.SetBytes (g_uuid_bytes, sizeof(g_uuid_bytes));
+            m_key.mod_time = 1234567890;
+            m_key.file_offset = 0;
+            m_key.debug_info_size = 0x1000;
+
+            m_functions.Insert (ConstString ("main"), 0x10);
+            m_functions.Insert (ConstString ("foo"), 0x20);
+            m_functions.Insert (ConstString ("foo"), 0x30);
+            m_functions.Finalize();
+            m_types.Insert (ConstString ("foo"), 0x40);
+            m_types.Finalize();
+        }
+
+        void
+        TearDown () override
+        {
+            llvm::sys::fs::remove (GetCacheFile().GetPath());
+            llvm::sys::fs::remove (m_cache_dir);
+        }
+
+        DWARFIndexCache
+        GetCache () const
+        {
+            return DWARFIndexCache (FileSpec (m_cache_dir.c_str(), false));
+        }
+
+        FileSpec
+        GetCacheFile () const
+        {
+            return GetCache().GetCacheFileSpec (m_key);
+        }
+
+        void
+        Save ()
+        {
+            std::vector<const NameToDIE *> tables = { &m_functions, &m_types };
+            ASSERT_TRUE (GetCache().Save (m_key, tables).Success());
+        }
+
+        bool
+        Load (const DWARFIndexCache::Key &key, NameToDIE &functions, NameToDIE &types)
+        {
+            std::vector<NameToDIE *> tables = { &functions, &types };
+            return GetCache().Load (key, tables);
+        }
+
+        std::string
+        ReadCacheFile () const
+        {
+            std::string contents;
+            FILE *file = ::fopen (GetCacheFile().GetPath().c_str(), "rb");
+            if (file == NULL)
+                return contents;
+            char buffer[256];
+            size_t n;
+            while ((n = ::fread (buffer, 1, sizeof(buffer), file)) > 0)
+                contents.append (buffer, n);
+            ::fclose (file);
+            return contents;
+        }
+
+        void
+        WriteCacheFile (const std::string &contents) const
+        {
+            FILE *file = ::fopen (GetCacheFile().GetPath().c_str(), "wb");
+            ASSERT_TRUE (file != NULL);
+            ASSERT_EQ (contents.size(), ::fwrite (contents.data(), 1, contents.size(), file));
+            ::fclose (file);
+        }
+
+        std::string m_cache_dir;
+        DWARFIndexCache::Key m_key;
+        NameToDIE m_functions;
+        NameToDIE m_types;
+    };
+}
+
+TEST_F (DWARFIndexCacheTest, RoundTrip)
+{
+    Save ();
+
+    NameToDIE functions, types;
+    ASSERT_TRUE (Load (m_key, functions, types));
+
+    DIEArray die_offsets;
+    ASSERT_EQ (1u, functions.Find (ConstString ("main"), die_offsets));
+    ASSERT_EQ (0x10u, die_offsets[0]);
+
+    die_offsets.clear();
+    ASSERT_EQ (2u, functions.Find (ConstString ("foo"), die_offsets));
+    ASSERT_EQ (0x20u, die_offsets[0]);
+    ASSERT_EQ (0x30u, die_offsets[1]);
+
+    die_offsets.clear();
+    ASSERT_EQ (1u, types.Find (ConstString ("foo"), die_offsets));
+    ASSERT_EQ (0x40u, die_offsets[0]);
+
+    die_offsets.clear();
+    ASSERT_EQ (0u, types.Find (ConstString ("main"), die_offsets));
+}
+
+TEST_F (DWARFIndexCacheTest, MismatchedKey)
+{
+    Save ();
+
+    NameToDIE functions, types;
+    DIEArray die_offsets;
+
+    DWARFIndexCache::Key key (m_key);
+    key.mod_time += 1;
+    ASSERT_FALSE (Load (key, functions, types));
+
+    key = m_key;
+    key.debug_info_size += 1;
+    ASSERT_FALSE (Load (key, functions, types));
+
+    // A different file offset names a different cache file, so point the
+    // file for the new offset at the contents written for the old one.
+    const std::string contents (ReadCacheFile());
+    key = m_key;
+    key.file_offset = 0x2000;
+    const std::string other_path (GetCache().GetCacheFileSpec (key).GetPath());
+    FILE *file = ::fopen (other_path.c_str(), "wb");
+    ASSERT_TRUE (file != NULL);
+    ::fwrite (contents.data(), 1, contents.size(), file);
+    ::fclose (file);
+    const bool loaded = Load (key, functions, types);
+    llvm::sys::fs::remove (other_path);
+    ASSERT_FALSE (loaded);
+
+    ASSERT_EQ (0u, functions.Find (ConstString ("main"), die_offsets));
+    ASSERT_EQ (0u, types.Find (ConstString ("foo"), die_offsets));
+}
+
+TEST_F (DWARFIndexCacheTest, MismatchedVersion)
+{
+    Save ();
+
+    // The version is the 32 bit little endian integer after the magic.
+    std::string contents (ReadCacheFile());
+    ASSERT_LT (8u, contents.size());
+    contents[4] += 1;
+    WriteCacheFile (contents);
+
+    NameToDIE functions, types;
+    ASSERT_FALSE (Load (m_key, functions, types));
+
+    DIEArray die_offsets;
+    ASSERT_EQ (0u, functions.Find (ConstString ("main"), die_offsets));
+}
+
+TEST_F (DWARFIndexCacheTest, TruncatedFile)
+{
+    Save ();
+
+    const std::string contents (ReadCacheFile());
+    ASSERT_LT (4u, contents.size());
+
+    // Chop off the last DIE offset of the last table, then try a cut in
+    // the middle of the string table.
+    WriteCacheFile (contents.substr (0, contents.size() - 4));
+    NameToDIE functions, types;
+    ASSERT_FALSE (Load (m_key, functions, types));
+
+    WriteCacheFile (contents.substr (0, contents.size() / 2));
+    ASSERT_FALSE (Load (m_key, functions, types));
+
+    DIEArray die_offsets;
+    ASSERT_EQ (0u, functions.Find (ConstString ("main"), die_offsets));
+    ASSERT_EQ (0u, types.Find (ConstString ("foo"), die_offsets));
+
+    // The untouched file still loads.
+    WriteCacheFile (contents);
+    ASSERT_TRUE (Load (m_key, functions, types));
+}
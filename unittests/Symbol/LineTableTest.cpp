@@ -0,0 +1,206 @@
+//===-- LineTableTest.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/LineTable.h"
+
+#include <map>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace
+{
+    struct Row
+    {
+        lldb::addr_t file_addr;
+        uint32_t line;
+        uint16_t column;
+        uint16_t file_idx;
+        bool is_terminal_entry;
+    };
+
+    // Gives the tests access to the decoded entries of a line table
+    // that has no compile unit
+    class TestLineTable : public LineTable
+    {
+    public:
+        TestLineTable () :
+            LineTable (NULL)
+        {
+        }
+
+        bool
+        GetRow (uint32_t idx, Row &row)
+        {
+            const uint32_t sequence_idx = FindSequenceIndexForEntry (idx);
+            const Sequence *sequence = GetDecodedSequence (sequence_idx);
+            if (sequence == NULL)
+                return false;
+            entry_collection entries;
+            DecodeEntries (*sequence, idx - sequence->entry_idx, 1, entries);
+            if (entries.empty())
+                return false;
+            row.file_addr = entries[0].file_addr;
+            row.line = entries[0].line;
+            row.column = entries[0].column;
+            row.file_idx = entries[0].file_idx;
+            row.is_terminal_entry = entries[0].is_terminal_entry;
+            return true;
+        }
+    };
+
+    void
+    AppendRows (LineTable &line_table, LineSequence *sequence, const std::vector<Row> &rows)
+    {
+        for (const Row &row : rows)
+            line_table.AppendLineEntryToSequence (sequence, row.file_addr, row.line, row.column, row.file_idx,
+                                                  true, false, false, false, row.is_terminal_entry);
+    }
+
+    // Hands out the rows of lazy sequences by offset and counts how
+    // many were decoded
+    class TestDecoder : public LineSequenceDecoder
+    {
+    public:
+        TestDecoder (std::map<lldb::offset_t, std::vector<Row> > &sequences, uint32_t &num_decoded) :
+            m_sequences (sequences),
+            m_num_decoded (num_decoded)
+        {
+        }
+
+        virtual bool
+        DecodeSequence (LineTable &line_table, lldb::offset_t decode_offset, LineSequence *sequence)
+        {
+            std::map<lldb::offset_t, std::vector<Row> >::const_iterator pos = m_sequences.find (decode_offset);
+            if (pos == m_sequences.end())
+                return false;
+            ++m_num_decoded;
+            AppendRows (line_table, sequence, pos->second);
+            return true;
+        }
+
+    private:
+        std::map<lldb::offset_t, std::vector<Row> > &m_sequences;
+        uint32_t &m_num_decoded;
+    };
+
+    void
+    InsertLazySequence (LineTable &line_table, lldb::offset_t offset, const std::vector<Row> &rows)
+    {
+        uint64_t file_mask = 0;
+        for (const Row &row : rows)
+            file_mask |= LineTable::GetFileMask (row.file_idx);
+        line_table.InsertLazySequence (rows.front().file_addr, rows.back().file_addr, rows.size(), file_mask, offset);
+    }
+}
+
+TEST (LineTableTest, EncodedEntries)
+{
+    // Enough entries for several blocks, with lines that go back and
+    // forth and columns and files that change
+    std::vector<Row> rows;
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        Row row = { 0x100000000ull + i * 6 + (i % 3), (uint32_t)(2000 - (i % 7) * 300 + i), (uint16_t)(i % 5 == 0 ? 0 : i), (uint16_t)(1 + i / 20), false };
+        rows.push_back (row);
+    }
+    Row terminal = { rows.back().file_addr + 4, rows.back().line, 0, 3, true };
+    rows.push_back (terminal);
+
+    TestLineTable line_table;
+    std::unique_ptr<LineSequence> sequence_ap (line_table.CreateLineSequenceContainer());
+    AppendRows (line_table, sequence_ap.get(), rows);
+    line_table.InsertSequence (sequence_ap.get());
+
+    ASSERT_EQ (rows.size(), line_table.GetSize());
+    ASSERT_EQ (1u, line_table.GetNumSequences());
+    for (uint32_t i = 0; i < rows.size(); ++i)
+    {
+        Row row;
+        ASSERT_TRUE (line_table.GetRow (i, row));
+        ASSERT_EQ (rows[i].file_addr, row.file_addr);
+        ASSERT_EQ (rows[i].line, row.line);
+        ASSERT_EQ (rows[i].column, row.column);
+        ASSERT_EQ (rows[i].file_idx, row.file_idx);
+        ASSERT_EQ (rows[i].is_terminal_entry, row.is_terminal_entry);
+    }
+
+    // The encoded entries take much less than the decoded ones would
+    ASSERT_GT (rows.size() * 16, line_table.GetMemorySize());
+}
+
+TEST (LineTableTest, LazySequences)
+{
+    // A function in file 1 and one in file 2, inserted out of order
+    std::map<lldb::offset_t, std::vector<Row> > sequences;
+    const Row first[] = { { 0x1000, 10, 0, 1, false }, { 0x1008, 11, 0, 1, false }, { 0x1010, 11, 0, 1, true } };
+    const Row second[] = { { 0x2000, 20, 0, 2, false }, { 0x2004, 22, 0, 2, false }, { 0x2010, 23, 0, 2, false }, { 0x2020, 23, 0, 2, true } };
+    sequences[0x40] = std::vector<Row> (first, first + 3);
+    sequences[0x80] = std::vector<Row> (second, second + 4);
+
+    uint32_t num_decoded = 0;
+    TestLineTable line_table;
+    line_table.SetSequenceDecoder (new TestDecoder (sequences, num_decoded));
+    InsertLazySequence (line_table, 0x80, sequences[0x80]);
+    InsertLazySequence (line_table, 0x40, sequences[0x40]);
+
+    ASSERT_EQ (7u, line_table.GetSize());
+    ASSERT_EQ (0u, line_table.GetNumDecodedSequences());
+
+    // The address ranges are known without decoding anything
+    LineTable::FileAddressRanges file_ranges;
+    ASSERT_EQ (2u, line_table.GetContiguousFileAddressRanges (file_ranges, false));
+    ASSERT_EQ (0x1000u, file_ranges.GetEntryRef(0).GetRangeBase());
+    ASSERT_EQ (0x1010u, file_ranges.GetEntryRef(0).GetRangeEnd());
+    ASSERT_EQ (0x2000u, file_ranges.GetEntryRef(1).GetRangeBase());
+    ASSERT_EQ (0x2020u, file_ranges.GetEntryRef(1).GetRangeEnd());
+    ASSERT_EQ (0u, num_decoded);
+
+    // Looking up a line of file 2 only decodes the sequence with it
+    ASSERT_EQ (4u, line_table.FindLineEntryIndexByFileIndex (0, 2, 22, true, NULL));
+    ASSERT_EQ (1u, num_decoded);
+    ASSERT_EQ (1u, line_table.GetNumDecodedSequences());
+    ASSERT_EQ (UINT32_MAX, line_table.FindLineEntryIndexByFileIndex (0, 2, 21, true, NULL));
+    ASSERT_EQ (4u, line_table.FindLineEntryIndexByFileIndex (0, 2, 21, false, NULL));
+    ASSERT_EQ (5u, line_table.FindLineEntryIndexByFileIndex (5, 2, 23, true, NULL));
+    ASSERT_EQ (1u, num_decoded);
+
+    Row row;
+    ASSERT_TRUE (line_table.GetRow (1, row));
+    ASSERT_EQ (0x1008u, row.file_addr);
+    ASSERT_EQ (11u, row.line);
+    ASSERT_EQ (2u, num_decoded);
+
+    // Decoded sequences are kept
+    ASSERT_TRUE (line_table.GetRow (0, row));
+    ASSERT_EQ (2u, num_decoded);
+}
+
+TEST (LineTableTest, LazySequenceDecodeFailure)
+{
+    // A sequence that decodes to a different number of entries than it
+    // was inserted with would renumber the others, so it is dropped
+    std::map<lldb::offset_t, std::vector<Row> > sequences;
+    const Row rows[] = { { 0x1000, 10, 0, 1, false }, { 0x1010, 11, 0, 1, true } };
+    sequences[0x40] = std::vector<Row> (rows, rows + 2);
+
+    uint32_t num_decoded = 0;
+    TestLineTable line_table;
+    line_table.SetSequenceDecoder (new TestDecoder (sequences, num_decoded));
+    line_table.InsertLazySequence (0x1000, 0x1010, 3, LineTable::GetFileMask (1), 0x40);
+    line_table.InsertLazySequence (0x2000, 0x2010, 2, LineTable::GetFileMask (1), 0x80);
+
+    Row row;
+    ASSERT_FALSE (line_table.GetRow (0, row));
+    ASSERT_FALSE (line_table.GetRow (3, row));
+    ASSERT_EQ (UINT32_MAX, line_table.FindLineEntryIndexByFileIndex (0, 1, 10, true, NULL));
+    ASSERT_EQ (0u, line_table.GetNumDecodedSequences());
+}
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/TaskPool.h"
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+using namespace lldb_private;
+
+TEST (TaskPoolTest, AddTask)
+{
+    auto fn = [](int x) { return x * x + 1; };
+
+    auto f1 = TaskPool::AddTask(fn, 1);
+    auto f2 = TaskPool::AddTask(fn, 2);
+    auto f3 = TaskPool::AddTask(fn, 3);
+    auto f4 = TaskPool::AddTask(fn, 4);
+
+    ASSERT_EQ (10, f3.get());
+    ASSERT_EQ ( 2, f1.get());
+    ASSERT_EQ (17, f4.get());
+    ASSERT_EQ ( 5, f2.get());
+}
+
+TEST (TaskPoolTest, RunTasks)
+{
+    std::atomic<int> r1(0), r2(0), r3(0);
+
+    TaskPool::RunTasks([&r1]() { r1 = 1; },
+                       [&r2]() { r2 = 2; },
+                       [&r3]() { r3 = 3; });
+
+    ASSERT_EQ (1, r1.load());
+    ASSERT_EQ (2, r2.load());
+    ASSERT_EQ (3, r3.load());
+}
+
+TEST (TaskPoolTest, TaskMapOverInt)
+{
+    std::vector<int> data(1000, 0);
+
+    TaskMapOverInt(0, data.size(), [&data](size_t idx) { data[idx] = idx * 2; });
+
+    for (size_t i = 0; i < data.size(); ++i)
+        ASSERT_EQ ((int)(i * 2), data[i]);
+}
+
+TEST (TaskPoolTest, NestedTaskMapOverInt)
+{
+    std::atomic<uint64_t> sum(0);
+
+    TaskMapOverInt(0, 64, [&sum](size_t) {
+        TaskMapOverInt(0, 100, [&sum](size_t j) { sum += j; });
+    });
+
+    ASSERT_EQ (64u * 4950u, sum.load());
+}
+
+TEST (TaskPoolTest, RunTasksInTaskMapOverInt)
+{
+    // Keep every worker thread busy with a map that has more items than
+    // there are workers, and have each item wait in RunTasks. No worker is
+    // left to start the tasks RunTasks queues, so the threads that call
+    // it have to run them.
+    const uint32_t num_workers = TaskPool::GetMaxConcurrency();
+    const size_t num_items = 4 * num_workers + 1;
+    std::atomic<uint64_t> sum(0);
+
+    std::vector<std::future<void>> futures;
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        futures.push_back(TaskPool::AddTask([&sum, num_items]() {
+            TaskMapOverInt(0, num_items, [&sum](size_t) {
+                TaskPool::RunTasks([&sum]() { sum += 1; },
+                                   [&sum]() { sum += 2; },
+                                   [&sum]() { sum += 3; });
+            });
+        }));
+    }
+    for (std::future<void> &f : futures)
+        f.wait();
+
+    ASSERT_EQ (num_workers * num_items * 6, sum.load());
+}